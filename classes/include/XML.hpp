@@ -16,11 +16,13 @@ namespace XML_Lib {
 // ========================
 class IStringify;
 class IParser;
+class IParseHandler;
 class ISource;
 class IDestination;
 class IAction;
 class XML_Impl;
 struct Node;
+class XML_NameTable;
 
 /// @brief Options controlling parsing behaviour and resource limits.
 struct ParseOptions {
@@ -29,6 +31,9 @@ struct ParseOptions {
   std::size_t     maxAttributeCount       = 10000;  ///< Maximum number of attributes per element.
   bool            allowExternalEntities   = false;  ///< When false and no entityResolver set, external entities throw SyntaxError (XXE defence).
   IEntityResolver *entityResolver         = nullptr;///< Optional custom resolver; overrides allowExternalEntities when non-null.
+  std::size_t     parseThreads            = 1;      ///< Threads building the tree of a document held in memory whole (0 = one per hardware thread).
+  std::shared_ptr<XML_NameTable> nameTable{};      ///< Table element and attribute names are added to, shared between documents (a table for each document if null).
+  bool            inSitu                  = false;  ///< Attribute values and text needing no decoding refer into the caller's buffer (see ISource::inSituContents()), which must outlive the document.
 };
 
 /// @brief Top-level XML document class.
@@ -105,12 +110,20 @@ public:
   /// @brief Parse XML from an rvalue (temporary) source stream.
   void parse(ISource &&source, const ParseOptions &options = {}) const;
 
+  /// @brief Parse XML from an lvalue source stream, reporting it to @p handler as it is parsed.
+  /// No document tree is built and any previously parsed tree is left unchanged.
+  void parse(ISource &source, IParseHandler &handler, const ParseOptions &options = {}) const;
+
+  /// @brief Parse XML from an rvalue (temporary) source stream, reporting it to @p handler as it is parsed.
+  void parse(ISource &&source, IParseHandler &handler, const ParseOptions &options = {}) const;
+
   /// @brief Parse XML from a null-terminated C string (convenience overload).
   /// @param xmlString Null-terminated UTF-8 XML text.
   /// @param options Parser options such as nesting depth and entity handling.
   void parse(const char *xmlString, const ParseOptions &options = {}) const;
 
-  /// @brief Parse XML from a `string_view` (convenience overload).
+  /// @brief Parse XML from a `string_view` (convenience overload). With `options.inSitu` the
+  /// text is read where it is (not copied) and must outlive the document.
   /// @param xmlString UTF-8 XML text view.
   /// @param options Parser options such as nesting depth and entity handling.
   void parse(const std::string_view &xmlString, const ParseOptions &options = {}) const;
@@ -142,6 +155,14 @@ public:
   /// @brief Traverse the document tree (const overload).
   void traverse(IAction &action) const;
 
+  /// @brief Free the child storage of every node that is beyond that of the children it holds.
+  ///
+  /// A parsed document's child lists are already their exact size; this is for a tree built or
+  /// added to programmatically, whose child lists grow as children are added.  Nodes made outside
+  /// a parse have their storage on the heap, which is freed; storage in a document's arena is only
+  /// reclaimed along with the document.
+  void compact();
+
   /// @brief Read the entire content of @p filePath into a `std::string`.
   /// Rejects paths with null bytes or `..` components.
   [[nodiscard]] static std::string fromFile(const std::filesystem::path &filePath);
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <span>
+
+#include "XML.hpp"
+
+namespace XML_Lib {
+
+// ====================
+// Forward declarations
+// ====================
+class XMLFeedParser_Impl;
+
+/// @brief Incremental parser for XML that arrives a chunk at a time (e.g. over a network connection).
+///
+/// Each call to `feed()` passes the next chunk of the document; everything that the chunks
+/// fed so far complete is parsed straight away and reported to the `IParseHandler`, and
+/// parsing resumes where it left off when the next chunk arrives.  `finish()` marks the end
+/// of the document.  Only the part of the input not yet parsed is held, so memory use does
+/// not grow with document size.  The same grammar as `XML::parse()` is used, so the same
+/// documents are rejected with the same errors.
+///
+/// Input must be UTF-8 encoded (a byte order mark is skipped).  The DOCTYPE is parsed and its
+/// entities used but not passed to `IParseHandler::onDTD()`.  The last few bytes of a chunk may
+/// not be reported until the next chunk (or `finish()`) shows how they continue.
+///
+/// Example:
+/// @code
+/// RecordHandler handler;
+/// XML_Lib::XMLFeedParser parser{ handler };
+/// while (connection.receive(chunk)) { parser.feed(chunk); }
+/// parser.finish();
+/// @endcode
+///
+/// @note Copying and moving are disabled; the parser cannot be used after it has thrown.
+class XMLFeedParser
+{
+public:
+  /// @brief Exception thrown when the parser is used incorrectly.
+  struct Error final : std::runtime_error
+  {
+    explicit Error(const std::string_view &message)
+      : std::runtime_error(std::string("XMLFeedParser Error: ").append(message))
+    {}
+  };
+
+  /// @brief Construct a parser that reports what it parses to @p handler (which must outlive it).
+  /// @param handler Receives the parse events.
+  /// @param options Parser options such as nesting depth and entity handling.
+  explicit XMLFeedParser(IParseHandler &handler, const ParseOptions &options = {});
+  XMLFeedParser() = delete;
+  XMLFeedParser(const XMLFeedParser &) = delete;
+  XMLFeedParser &operator=(const XMLFeedParser &) = delete;
+  XMLFeedParser(XMLFeedParser &&) = delete;
+  XMLFeedParser &operator=(XMLFeedParser &&) = delete;
+  ~XMLFeedParser();
+
+  /// @brief Parse the next chunk of the document, reporting all that it completes.
+  /// @throws SyntaxError if the document is not well-formed.
+  /// @throws XMLFeedParser::Error if called after `finish()`.
+  void feed(std::span<const char> chunk);
+
+  /// @brief Mark the end of the document and parse what remains of it.
+  /// @throws SyntaxError if the document is not well-formed or is incomplete.
+  void finish();
+
+  /// @brief Return `true` once the whole document has been parsed.
+  [[nodiscard]] bool isComplete() const;
+
+private:
+  const std::unique_ptr<XMLFeedParser_Impl> implementation;
+};
+
+}// namespace XML_Lib
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <span>
+
+#include "XML.hpp"
+
+namespace XML_Lib {
+
+// ====================
+// Forward declarations
+// ====================
+class XMLReader_Impl;
+struct XMLAttribute;
+
+/// @brief Pull parser: reads a document from an `ISource` a token at a time.
+///
+/// Each call to `next()` parses only as far as the next token (start tag, end tag,
+/// character data and so on) so the consumer decides how far to read and can stop at any
+/// point.  No document tree is built; memory used grows with element nesting depth, not
+/// document size.  The same grammar as `XML::parse()` is used, so the same documents are
+/// rejected with the same errors (except within subtrees passed over by `skipSubtree()`).
+///
+/// The views returned by `name()`, `value()` and `attributes()` refer to the current
+/// token and are only valid until the next call to `next()` or `skipSubtree()`.  Where the
+/// source holds its input in memory (see `ISource::contents()`) names and character data
+/// needing no decoding are views straight into it, so reading them copies nothing.
+///
+/// Example:
+/// @code
+/// XML_Lib::BufferSource source{ "<root><item>1</item><item>2</item></root>" };
+/// XML_Lib::XMLReader reader{ source };
+/// while (reader.next() != XML_Lib::XMLReader::TokenType::endOfDocument) {
+///     if (reader.tokenType() == XML_Lib::XMLReader::TokenType::characters) { /* reader.value() */ }
+/// }
+/// @endcode
+///
+/// @note Copying and moving are disabled.
+class XMLReader
+{
+public:
+  /// @brief Kinds of token returned by `next()`.
+  enum class TokenType : uint8_t {
+    none = 0,///< Before the first call to `next()`.
+    declaration,///< XML declaration; version, encoding and standalone are its `attributes()`.
+    dtd,///< DOCTYPE declaration (its entities are used when expanding references).
+    startElement,///< Start tag: `name()`, `attributes()` and `isSelfClosing()`.
+    endElement,///< End tag (also follows a self-closing start tag): `name()`.
+    characters,///< Character data: `value()` and `isWhiteSpace()`.
+    cdata,///< CDATA section: `value()`.
+    comment,///< Comment: `value()`.
+    pi,///< Processing instruction: `name()` and its parameters as `value()`.
+    startEntityReference,///< Reference in content: `name()` is the reference, `value()` its replacement.
+    endEntityReference,///< End of the tokens a reference was replaced by.
+    endOfDocument///< The whole document has been read.
+  };
+
+  /// @brief Exception thrown when the reader is used incorrectly.
+  struct Error final : std::runtime_error
+  {
+    explicit Error(const std::string_view &message) : std::runtime_error(std::string("XMLReader Error: ").append(message))
+    {}
+  };
+
+  /// @brief Construct a reader of the document in @p source (which must outlive it).
+  /// @param source  Source of the XML document.
+  /// @param options Parser options such as nesting depth and entity handling.
+  explicit XMLReader(ISource &source, const ParseOptions &options = {});
+  XMLReader() = delete;
+  XMLReader(const XMLReader &) = delete;
+  XMLReader &operator=(const XMLReader &) = delete;
+  XMLReader(XMLReader &&) = delete;
+  XMLReader &operator=(XMLReader &&) = delete;
+  ~XMLReader();
+
+  /// @brief Move to the next token and return its type (`endOfDocument` once all is read).
+  /// @throws SyntaxError if the document is not well-formed.
+  TokenType next();
+
+  /// @brief Return the type of the current token.
+  [[nodiscard]] TokenType tokenType() const;
+
+  /// @brief Return the element, processing instruction or reference name of the current token.
+  [[nodiscard]] std::string_view name() const;
+
+  /// @brief Return the text of the current token.
+  [[nodiscard]] std::string_view value() const;
+
+  /// @brief Return the attributes of the current start element (or declaration) token.
+  [[nodiscard]] std::span<const XMLAttribute> attributes() const;
+
+  /// @brief Return `true` if the current start element token is a self-closing tag.
+  [[nodiscard]] bool isSelfClosing() const;
+
+  /// @brief Return `true` if the current characters token is only whitespace.
+  [[nodiscard]] bool isWhiteSpace() const;
+
+  /// @brief Return the number of elements the current token is nested in (0 for the root's tags).
+  [[nodiscard]] long depth() const;
+
+  /// @brief Skip the contents of the current start element without returning them as tokens;
+  /// its end element becomes the current token. The contents are only scanned for the tags,
+  /// comments, CDATA sections and processing instructions that find the element's end, so
+  /// errors within them are not reported.
+  /// @throws XMLReader::Error if the current token is not a start element.
+  void skipSubtree();
+
+private:
+  const std::unique_ptr<XMLReader_Impl> implementation;
+};
+
+}// namespace XML_Lib
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "XML.hpp"
+
+namespace XML_Lib {
+
+// ====================
+// Forward declarations
+// ====================
+class XMLRecordReader_Impl;
+
+/// @brief Record reader: reads a document from an `ISource` one repeated subtree (record) at a time.
+///
+/// Records are the elements at a path of element names from the root, such as
+/// `/feed/entry` (a `*` step matches an element of any name).  Each call to `next()`
+/// parses as far as the next record and builds a `Node` tree of just that record, so a
+/// record can be navigated, searched with `XPath` or stringified like a whole document;
+/// everything outside the records is read but no tree is kept for it (elements off the
+/// path to the records are skipped with `XMLReader::skipSubtree()`, so errors within them
+/// go unreported).  Each record's nodes are allocated from the same arena, which is freed
+/// when the next record is read, so memory used stays that of the largest record however
+/// long the document is.
+///
+/// The record returned by `record()` is only valid until the next call to `next()`.
+///
+/// Example:
+/// @code
+/// XML_Lib::FileSource source{ "feed.xml" };
+/// XML_Lib::XMLRecordReader reader{ source, "/feed/entry" };
+/// while (reader.next()) {
+///     const auto &entry = reader.record(); // entry["title"] ...
+/// }
+/// @endcode
+///
+/// @note Copying and moving are disabled.
+class XMLRecordReader
+{
+public:
+  /// @brief Exception thrown for an invalid record path or when no record has been read.
+  struct Error final : std::runtime_error
+  {
+    explicit Error(const std::string_view &message)
+      : std::runtime_error(std::string("XMLRecordReader Error: ").append(message))
+    {}
+  };
+
+  /// @brief Construct a reader of the records at @p recordPath in @p source (which must outlive it).
+  /// @param source     Source of the XML document.
+  /// @param recordPath Absolute path of element names to the records (for example `/feed/entry`).
+  /// @param options    Parser options such as nesting depth and entity handling.
+  /// @throws XMLRecordReader::Error if the record path is not valid.
+  XMLRecordReader(ISource &source, std::string_view recordPath, const ParseOptions &options = {});
+  XMLRecordReader() = delete;
+  XMLRecordReader(const XMLRecordReader &) = delete;
+  XMLRecordReader &operator=(const XMLRecordReader &) = delete;
+  XMLRecordReader(XMLRecordReader &&) = delete;
+  XMLRecordReader &operator=(XMLRecordReader &&) = delete;
+  ~XMLRecordReader();
+
+  /// @brief Read the next record, returning `false` once the whole document has been read.
+  /// @throws SyntaxError if the document is not well-formed.
+  bool next();
+
+  /// @brief Return the current record (a `Root` node, or a `Self` node for a self-closing record).
+  /// @throws XMLRecordReader::Error if there is no current record.
+  [[nodiscard]] const Node &record() const;
+
+  /// @brief Return the number of records read so far.
+  [[nodiscard]] std::size_t recordCount() const;
+
+private:
+  const std::unique_ptr<XMLRecordReader_Impl> implementation;
+};
+
+}// namespace XML_Lib
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "XML.hpp"
+#include "ITapeAction.hpp"
+
+namespace XML_Lib {
+
+// ====================
+// Forward declarations
+// ====================
+class XMLTape_Impl;
+
+/// @brief Handle to a node of an `XMLTape`.
+///
+/// A handle is just the tape and the node's position in it, so it is cheap to copy and
+/// compare; it stays valid for as long as the tape it came from.  An empty handle (as
+/// returned for the parent of the prolog or the sibling after the last) has `isEmpty()` true.
+class XMLTapeNode
+{
+public:
+  /// @brief Node kinds, matching the node types of the `Node` tree.
+  enum class Kind : uint8_t { prolog = 0, declaration, root, element, self, content, cdata, comment, pi };
+
+  XMLTapeNode() = default;
+
+  /// @brief Return `true` for a handle to no node.
+  [[nodiscard]] bool isEmpty() const { return tape == nullptr; }
+  /// @brief Return the node kind.
+  [[nodiscard]] Kind kind() const;
+  /// @brief Return the position of the node in the tape (document order).
+  [[nodiscard]] std::uint32_t index() const { return nodeIndex; }
+
+  /// @brief Return the name of an element or processing instruction (empty for other nodes).
+  [[nodiscard]] std::string_view name() const;
+  /// @brief Return the text of content, CDATA or a comment, or the parameters of a processing instruction.
+  [[nodiscard]] std::string_view value() const;
+  /// @brief Return the content of the node and its descendants concatenated (as `Node::getContents()`).
+  [[nodiscard]] std::string getContents() const;
+
+  /// @brief Return the parent node (empty for the prolog).
+  [[nodiscard]] XMLTapeNode parent() const;
+  /// @brief Return the first child node (empty if there are none).
+  [[nodiscard]] XMLTapeNode firstChild() const;
+  /// @brief Return the next sibling node (empty for the last child).
+  [[nodiscard]] XMLTapeNode nextSibling() const;
+  /// @brief Return the number of child nodes.
+  [[nodiscard]] std::size_t childCount() const;
+
+  /// @brief Return the number of attributes of an element (the declaration has version, encoding and standalone).
+  [[nodiscard]] std::size_t attributeCount() const;
+  /// @brief Return the name of attribute @p attribute (0 to `attributeCount()` - 1).
+  [[nodiscard]] std::string_view attributeName(std::size_t attribute) const;
+  /// @brief Return the parsed value of attribute @p attribute (as `XMLAttribute::getParsed()`).
+  [[nodiscard]] std::string_view attributeValue(std::size_t attribute) const;
+  /// @brief Return `true` if the node has an attribute called @p name.
+  [[nodiscard]] bool hasAttribute(std::string_view name) const;
+  /// @brief Return the value of the attribute called @p name (empty if there is none).
+  [[nodiscard]] std::string_view attribute(std::string_view name) const;
+
+  [[nodiscard]] bool operator==(const XMLTapeNode &other) const = default;
+
+private:
+  friend class XMLTape_Impl;
+  XMLTapeNode(const XMLTape_Impl *tape, const std::uint32_t nodeIndex) : tape(tape), nodeIndex(nodeIndex) {}
+  const XMLTape_Impl *tape{ nullptr };
+  std::uint32_t nodeIndex{ 0 };
+};
+
+/// @brief Immutable, compact representation of a parsed document for read-mostly use.
+///
+/// Rather than a tree of separately allocated nodes, a tape holds a document as a few
+/// arrays indexed by node position in document order (node kind, name, parent, next
+/// sibling and where its text and attributes are) with all of its text in one buffer and
+/// its names in a name table.  It is built by the parser directly from its events, without
+/// a `Node` tree, and is read through `XMLTapeNode` handles, traversed with an `ITapeAction`
+/// or searched with XPath.  Entity and character references are replaced in the text
+/// they occur in and the DTD is not kept.
+///
+/// Example:
+/// @code
+/// XML_Lib::XMLTape tape{ XML_Lib::FileSource{ "catalogue.xml" } };
+/// for (auto entry = tape.root().firstChild(); !entry.isEmpty(); entry = entry.nextSibling()) { … }
+/// @endcode
+///
+/// @note Copying and moving are disabled.
+class XMLTape
+{
+public:
+  /// @brief Exception thrown when a document is too large for a tape.
+  struct Error final : std::runtime_error
+  {
+    explicit Error(const std::string_view &message) : std::runtime_error(std::string("XMLTape Error: ").append(message))
+    {}
+  };
+
+  /// @brief Parse @p source into a tape.
+  /// @param source  Source of the XML document.
+  /// @param options Parser options such as nesting depth, entity handling and the name table to use.
+  /// @throws SyntaxError if the document is not well-formed.
+  explicit XMLTape(ISource &source, const ParseOptions &options = {});
+  /// @brief Parse an rvalue (temporary) @p source into a tape.
+  explicit XMLTape(ISource &&source, const ParseOptions &options = {});
+  XMLTape() = delete;
+  XMLTape(const XMLTape &) = delete;
+  XMLTape &operator=(const XMLTape &) = delete;
+  XMLTape(XMLTape &&) = delete;
+  XMLTape &operator=(XMLTape &&) = delete;
+  ~XMLTape();
+
+  /// @brief Return the prolog node (the first node of the tape, parent of the declaration and root).
+  [[nodiscard]] XMLTapeNode prolog() const;
+  /// @brief Return the XML declaration node.
+  [[nodiscard]] XMLTapeNode declaration() const;
+  /// @brief Return the document root element node.
+  [[nodiscard]] XMLTapeNode root() const;
+  /// @brief Return the node at position @p index of the tape.
+  [[nodiscard]] XMLTapeNode node(std::uint32_t index) const;
+  /// @brief Return the number of nodes in the tape.
+  [[nodiscard]] std::size_t size() const;
+  /// @brief Return the number of bytes of memory held by the tape (not counting its name table).
+  [[nodiscard]] std::size_t memoryUsed() const;
+
+  /// @brief Traverse the tape in document order, calling the appropriate `ITapeAction::on*` callback for each node.
+  void traverse(ITapeAction &action) const;
+
+#if defined(XML_LIB_ENABLE_XPATH)
+  /// @brief Evaluate an XPath 1.0 expression and return matching nodes.
+  /// @param expression XPath expression string.
+  [[nodiscard]] std::vector<XMLTapeNode> xpath(std::string_view expression) const;
+#endif
+
+private:
+  friend class XPath;
+  const std::unique_ptr<XMLTape_Impl> implementation;
+};
+
+}// namespace XML_Lib
@@ -2,3 +2,5 @@
 
 #include "XML_BufferSource.hpp"
 #include "XML_FileSource.hpp"
+#include "XML_MappedFileSource.hpp"
+#include "XML_StreamSource.hpp"
@@ -8,12 +8,14 @@ namespace XML_Lib {
 // Forward declarations
 // ====================
 class XPath_Impl;
+class XMLTape;
+class XMLTapeNode;
 struct Node;
 
 /// @brief XPath 1.0 evaluator.
 ///
-/// Evaluates XPath expressions against a parsed XML document tree.
-/// Construct with a reference to the root `Node` of the document.
+/// Evaluates XPath expressions against a parsed XML document tree or an `XMLTape`.
+/// Construct with a reference to the root `Node` of the document, or with the tape.
 ///
 /// @note Copying and moving are disabled.
 class XPath
@@ -29,6 +31,9 @@ public:
   /// @brief Construct an XPath evaluator bound to @p root.
   /// @param root The root `Node` of the parsed XML document.
   explicit XPath(const Node &root);
+  /// @brief Construct an XPath evaluator bound to @p tape.
+  /// @param tape A parsed `XMLTape`; node sets are returned by `evaluateTape()`.
+  explicit XPath(const XMLTape &tape);
   XPath() = delete;
   XPath(const XPath &) = delete;
   XPath &operator=(const XPath &) = delete;
@@ -39,8 +44,15 @@ public:
   /// @brief Evaluate @p expression and return all matching nodes.
   /// @param expression XPath 1.0 expression string.
   /// @return Pointers into the existing node tree — valid only while the owning `XML` object is alive.
+  /// @throws XPath::Error if the evaluator is bound to an `XMLTape`.
   [[nodiscard]] std::vector<const Node *> evaluate(std::string_view expression) const;
 
+  /// @brief Evaluate @p expression against the bound tape and return all matching nodes.
+  /// @param expression XPath 1.0 expression string.
+  /// @return Handles to nodes of the tape — valid only while the `XMLTape` is alive.
+  /// @throws XPath::Error if the evaluator is bound to a `Node` tree.
+  [[nodiscard]] std::vector<XMLTapeNode> evaluateTape(std::string_view expression) const;
+
   /// @brief Evaluate @p expression and convert the result to a string (XPath `string()` semantics).
   [[nodiscard]] std::string evaluateString(std::string_view expression) const;
 
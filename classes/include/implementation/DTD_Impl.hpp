@@ -4,6 +4,8 @@
 #include "XML_Core.hpp"
 #include "DTD_Validator.hpp"
 
+#include <functional>
+
 namespace XML_Lib {
 
 class DTD_Impl
@@ -74,8 +76,8 @@ private:
   [[nodiscard]] static bool checkIsEMPTY(const Node &xNode);
   void checkAgainstDTD(const Node &xNode);
 
-  std::set<std::string> assignedIDValues;
-  std::set<std::string> assignedIDREFValues;
+  std::set<std::string, std::less<>> assignedIDValues;
+  std::set<std::string, std::less<>> assignedIDREFValues;
   long lineNumber = 1;
   DTD &xDTD;
 };
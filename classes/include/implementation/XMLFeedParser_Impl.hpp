@@ -0,0 +1,37 @@
+#pragma once
+
+#include "XMLFeedParser.hpp"
+#include "XMLReader_Impl.hpp"
+#include "XML_FeedSource.hpp"
+
+namespace XML_Lib {
+
+class XMLFeedParser_Impl
+{
+public:
+  // Constructors/Destructors
+  XMLFeedParser_Impl(IParseHandler &handler, const ParseOptions &options);
+  XMLFeedParser_Impl(const XMLFeedParser_Impl &other) = delete;
+  XMLFeedParser_Impl &operator=(const XMLFeedParser_Impl &other) = delete;
+  XMLFeedParser_Impl(XMLFeedParser_Impl &&other) = delete;
+  XMLFeedParser_Impl &operator=(XMLFeedParser_Impl &&other) = delete;
+  ~XMLFeedParser_Impl() = default;
+
+  void feed(std::span<const char> chunk);
+  void finish();
+  [[nodiscard]] bool isComplete() const { return complete; }
+
+private:
+  // Parse and report as many tokens as the input held completes
+  void parseAvailable();
+  // Handler receiving the parse events
+  IParseHandler &handler;
+  // Input not yet parsed
+  FeedSource source;
+  // Reader parsing it a token at a time
+  XMLReader_Impl reader;
+  // Bytes to be held before a token found to be incomplete is parsed again
+  long retryAt{ 0 };
+  bool complete{ false };
+};
+}// namespace XML_Lib
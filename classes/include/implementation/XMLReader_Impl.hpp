@@ -0,0 +1,117 @@
+#pragma once
+
+#include <deque>
+#include <memory_resource>
+
+#include "XML.hpp"
+#include "XMLReader.hpp"
+#include "XML_Core.hpp"
+
+namespace XML_Lib {
+
+class XMLReader_Impl final : public IParseHandler
+{
+public:
+  // Constructors/Destructors
+  XMLReader_Impl(ISource &source, const ParseOptions &options);
+  XMLReader_Impl(const XMLReader_Impl &other) = delete;
+  XMLReader_Impl &operator=(const XMLReader_Impl &other) = delete;
+  XMLReader_Impl(XMLReader_Impl &&other) = delete;
+  XMLReader_Impl &operator=(XMLReader_Impl &&other) = delete;
+  ~XMLReader_Impl() override = default;
+
+  XMLReader::TokenType next();
+  [[nodiscard]] XMLReader::TokenType tokenType() const { return current().type; }
+  [[nodiscard]] std::string_view name() const { return current().name; }
+  [[nodiscard]] std::string_view value() const { return current().value; }
+  [[nodiscard]] std::span<const XMLAttribute> attributes() const { return current().attributes; }
+  [[nodiscard]] bool isSelfClosing() const { return current().type == XMLReader::TokenType::startElement && current().flag; }
+  [[nodiscard]] bool isWhiteSpace() const { return current().type == XMLReader::TokenType::characters && current().flag; }
+  [[nodiscard]] long depth() const { return current().depth; }
+  void skipSubtree();
+  void readSubtree(IParseHandler &handler);
+  void report(IParseHandler &handler) const;
+  // Name table of the names read
+  [[nodiscard]] XML_NameTable &getNameTable() const { return *nameTable; }
+
+  // Where the reader is in the document
+  enum class State : uint8_t { declaration, prolog, content, epilog, finished };
+  // Reader state before a token is parsed, returned to if the parse is cut short by the
+  // end of the input so far (see XMLFeedParser); the source is rewound separately
+  struct Checkpoint
+  {
+    State state{ State::declaration };
+    std::size_t openElementCount{ 0 };
+    long tokenDepth{ 0 };
+    Default_Parser::ItemState parserState;
+  };
+  [[nodiscard]] Checkpoint checkpoint() const;
+  void rollback(const Checkpoint &checkpoint);
+
+  // Parse events are queued as tokens
+  void onDeclaration(std::string_view version, std::string_view encoding, std::string_view standalone) override;
+  void onStartElement(std::string_view name, std::span<const XMLAttribute> attributes, bool isSelfClosing) override;
+  void onEndElement(std::string_view name) override;
+  void onCharacters(std::string_view characters, bool isWhiteSpace) override;
+  void onCDATA(std::string_view cdata) override;
+  void onComment(std::string_view comment) override;
+  void onPI(std::string_view name, std::string_view parameters) override;
+  void onStartEntityReference(const XMLValue &reference) override;
+  void onEndEntityReference(const XMLValue &reference) override;
+  void onDTD(Node &dtd) override;
+
+private:
+  // Token returned by the reader. Its name, value and attributes are views into the source's
+  // input (or the start tag attributes) where they can be; anything else is copied into its
+  // storage, which is reused from one token to the next.
+  struct Token
+  {
+    XMLReader::TokenType type{ XMLReader::TokenType::none };
+    std::string_view name;
+    std::string_view value;
+    std::span<const XMLAttribute> attributes;
+    bool flag{ false };
+    long depth{ 0 };
+    std::string nameStorage;
+    std::string valueStorage;
+    std::pmr::vector<XMLAttribute> attributeStorage;
+  };
+  [[nodiscard]] const Token &current() const { return tokens[currentToken]; }
+  // Parse the next item of the document, queuing the tokens it produces
+  void step();
+  // Parse an element's start tag / the end tag of the innermost open element
+  void openElement();
+  void closeElement();
+  // Queue a token of the given type
+  Token &addToken(XMLReader::TokenType type, std::string_view name = {}, std::string_view value = {});
+  // Return a view of text that stays valid until the next token is parsed, copying it into storage if need be
+  [[nodiscard]] std::string_view keep(std::string_view text, std::string &storage) const;
+  // Return an element name as a view into the tag just parsed if it can be
+  [[nodiscard]] std::string_view tagName(std::string_view name) const;
+  // XML source stream
+  ISource &source;
+  // All of the source's input if it is held in memory (empty if not)
+  std::string_view input;
+  // Input from the name of the start or end tag being parsed
+  std::string_view tagInput;
+  // Table the names read are added to
+  std::shared_ptr<XML_NameTable> nameTable;
+  // Entities defined for the document
+  XML_EntityMapper entityMapper;
+  // Parser providing the grammar
+  Default_Parser parser{ entityMapper };
+  // Attributes of the start tag being parsed, which its token refers to
+  std::pmr::unsynchronized_pool_resource attributeResource;
+  std::pmr::vector<XMLAttribute> startTagAttributes{ &attributeResource };
+  // Queued tokens (those before tokenCount are in use) and the current one; a deque so that
+  // tokens never move and views of their storage stay valid
+  std::deque<Token> tokens;
+  std::size_t tokenCount{ 0 };
+  std::size_t currentToken{ 0 };
+  // Elements whose end tag has not yet been parsed
+  std::vector<Default_Parser::ElementTag> openElements;
+  State state{ State::declaration };
+  // Element nesting of the tokens being queued
+  long tokenDepth{ 0 };
+};
+}// namespace XML_Lib
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "XMLRecordReader.hpp"
+#include "XMLReader_Impl.hpp"
+
+namespace XML_Lib {
+
+class XMLRecordReader_Impl
+{
+public:
+  // Constructors/Destructors
+  XMLRecordReader_Impl(ISource &source, std::string_view recordPath, const ParseOptions &options);
+  XMLRecordReader_Impl(const XMLRecordReader_Impl &other) = delete;
+  XMLRecordReader_Impl &operator=(const XMLRecordReader_Impl &other) = delete;
+  XMLRecordReader_Impl(XMLRecordReader_Impl &&other) = delete;
+  XMLRecordReader_Impl &operator=(XMLRecordReader_Impl &&other) = delete;
+  ~XMLRecordReader_Impl() = default;
+
+  bool next();
+  [[nodiscard]] const Node &record() const;
+  [[nodiscard]] std::size_t recordCount() const { return count; }
+
+private:
+  // Build the tree of the record whose start element is the reader's current token
+  void buildRecord();
+  // Element names of the record path (a "*" matching any name)
+  std::vector<std::string> path;
+  // Reader parsing the document a token at a time
+  XMLReader_Impl reader;
+  // Elements on the record path that the reader is in (kept for the namespaces they declare)
+  std::vector<Node> ancestors;
+  // Arena the current record is allocated from, released before the next is built
+  XML_Arena recordArena;
+  Node currentRecord;
+  std::size_t count{ 0 };
+};
+}// namespace XML_Lib
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "XMLTape.hpp"
+#include "XML_Core.hpp"
+
+namespace XML_Lib {
+
+class XMLTape_Impl
+{
+public:
+  using Kind = XMLTapeNode::Kind;
+  // Index of no node (the parent of the prolog, the sibling after the last)
+  static constexpr std::uint32_t kNoNode{ std::numeric_limits<std::uint32_t>::max() };
+
+  // Constructors/Destructors
+  XMLTape_Impl(ISource &source, const ParseOptions &options);
+  XMLTape_Impl(const XMLTape_Impl &other) = delete;
+  XMLTape_Impl &operator=(const XMLTape_Impl &other) = delete;
+  XMLTape_Impl(XMLTape_Impl &&other) = delete;
+  XMLTape_Impl &operator=(XMLTape_Impl &&other) = delete;
+  ~XMLTape_Impl() = default;
+
+  [[nodiscard]] XMLTapeNode node(const std::uint32_t index) const
+  {
+    if (index == kNoNode) { return {}; }
+    if (index >= kinds.size()) { XML_LIB_THROW(XMLTape::Error("Node index " + std::to_string(index) + " is past the end of the tape.")); }
+    return { this, index };
+  }
+  [[nodiscard]] XMLTapeNode root() const;
+  [[nodiscard]] std::size_t size() const { return kinds.size(); }
+  [[nodiscard]] std::size_t memoryUsed() const;
+  void traverse(ITapeAction &action) const;
+#if defined(XML_LIB_ENABLE_XPATH)
+  [[nodiscard]] std::vector<XMLTapeNode> xpath(std::string_view expression) const;
+#endif
+
+  // Node accessors (by index)
+  [[nodiscard]] Kind kind(const std::uint32_t index) const { return kinds[index]; }
+  [[nodiscard]] bool isElementLike(const std::uint32_t index) const
+  {
+    return kinds[index] == Kind::root || kinds[index] == Kind::element || kinds[index] == Kind::self;
+  }
+  [[nodiscard]] std::string_view name(const std::uint32_t index) const
+  {
+    return names[index] != XML_NameTable::kNoSymbol ? nameTable->name(names[index]) : std::string_view{};
+  }
+  [[nodiscard]] XML_NameTable::Symbol nameSymbol(const std::uint32_t index) const { return names[index]; }
+  [[nodiscard]] const XML_NameTable &getNameTable() const { return *nameTable; }
+  [[nodiscard]] std::string_view value(const std::uint32_t index) const
+  {
+    return std::string_view{ text }.substr(textOffsets[index], textLengths[index]);
+  }
+  [[nodiscard]] std::uint32_t parent(const std::uint32_t index) const { return parents[index]; }
+  [[nodiscard]] std::uint32_t nextSibling(const std::uint32_t index) const { return nextSiblings[index]; }
+  // A node's first child (if any) directly follows it on the tape
+  [[nodiscard]] std::uint32_t firstChild(const std::uint32_t index) const
+  {
+    return index + 1 < kinds.size() && parents[index + 1] == index ? index + 1 : kNoNode;
+  }
+  // Index one past the last descendant of a node (its descendants follow it on the tape)
+  [[nodiscard]] std::uint32_t subtreeEnd(std::uint32_t index) const
+  {
+    while (index != kNoNode && nextSiblings[index] == kNoNode) { index = parents[index]; }
+    return index == kNoNode ? static_cast<std::uint32_t>(kinds.size()) : nextSiblings[index];
+  }
+  [[nodiscard]] std::uint32_t attributeCount(const std::uint32_t index) const
+  {
+    return firstAttributes[index + 1] - firstAttributes[index];
+  }
+  [[nodiscard]] std::string_view attributeName(const std::uint32_t index, const std::uint32_t attribute) const
+  {
+    return nameTable->name(attributeNames[firstAttributes[index] + attribute]);
+  }
+  [[nodiscard]] std::string_view attributeValue(const std::uint32_t index, const std::uint32_t attribute) const
+  {
+    const auto tapeAttribute = firstAttributes[index] + attribute;
+    return std::string_view{ text }.substr(attributeValueOffsets[tapeAttribute], attributeValueLengths[tapeAttribute]);
+  }
+  // Index of a node's attribute called name, or kNoNode if it has none
+  [[nodiscard]] std::uint32_t findAttribute(std::uint32_t index, std::string_view name) const;
+  // Append the text of the content and CDATA nodes of a node and its descendants (as Node::getContents())
+  void appendContents(std::uint32_t index, std::string &contents) const;
+  // Append the text of just the content nodes of a node and its descendants (its XPath string value)
+  void appendStringValue(std::uint32_t index, std::string &value) const;
+  // XPath string value of a node, built in scratch only if it is not the text of a single content node
+  [[nodiscard]] std::string_view stringValue(std::uint32_t index, std::string &scratch) const;
+  // URI of the namespace of an element's name (empty if it is in none)
+  [[nodiscard]] std::string_view namespaceURI(std::uint32_t index) const;
+
+private:
+  friend class XML_TapeBuilder;
+  // Table the element, processing instruction and attribute names are in
+  std::shared_ptr<XML_NameTable> nameTable;
+  // Nodes, in document order: kind, name (kNoSymbol if none), parent and next sibling
+  // (kNoNode if none), and where their text is
+  std::vector<Kind> kinds;
+  std::vector<XML_NameTable::Symbol> names;
+  std::vector<std::uint32_t> parents;
+  std::vector<std::uint32_t> nextSiblings;
+  std::vector<std::uint32_t> textOffsets;
+  std::vector<std::uint32_t> textLengths;
+  // First attribute of each node (with one more entry, the end of the last node's)
+  std::vector<std::uint32_t> firstAttributes;
+  // Attributes, in node order: name and where their value is
+  std::vector<XML_NameTable::Symbol> attributeNames;
+  std::vector<std::uint32_t> attributeValueOffsets;
+  std::vector<std::uint32_t> attributeValueLengths;
+  // Text of every node and attribute value
+  std::string text;
+};
+}// namespace XML_Lib
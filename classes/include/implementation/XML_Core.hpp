@@ -14,9 +14,12 @@
 #include "common/XML_Error.hpp"
 #include "common/XML_Utility.hpp"
 #include "common/XML_Arena.hpp"
+#include "common/XML_NameTable.hpp"
+#include "common/XML_AllocationContext.hpp"
 #include "converter/XML_Converter.hpp"
 #include "data/XML_Value.hpp"
 #include "data/XML_Attribute.hpp"
+#include "data/XML_NameSpaceScope.hpp"
 #include "data/XML_ExternalReference.hpp"
 #include "nodes/XML_Variant.hpp"
 #include "node/XML_Node.hpp"
@@ -41,6 +44,7 @@
 #include "io/XML_Destinations.hpp"
 #include "common/XML_Parse.hpp"
 #include "common/XML_SourceHelpers.hpp"
+#include "parser/XML_TreeBuilder.hpp"
 #include "parser/Default_Parser.hpp"
 #if defined(XML_LIB_ENABLE_STRINGIFY)
 #include "stringify/Default_Stringify.hpp"
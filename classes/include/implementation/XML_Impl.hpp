@@ -24,11 +24,13 @@ public:
   [[nodiscard]] Node &root();
   [[nodiscard]] Node &declaration();
   void parse(ISource &source, const ParseOptions &options = {});
+  void parse(ISource &source, IParseHandler &handler, const ParseOptions &options = {});
 #if defined(XML_LIB_ENABLE_STRINGIFY)
   void stringify(IDestination &destination);
 #endif
   void traverse(IAction &action);
   void traverse(IAction &action) const;
+  void compact();
 #if defined(XML_LIB_ENABLE_DTD)
   void validate();
 #endif
@@ -45,16 +47,24 @@ public:
   [[nodiscard]] static XML::Format getFileFormat(const std::string_view &fileName);
 
 private:
-  // Embedded arena for parser-allocated nodes (size governed by XML_LIB_ARENA_SIZE_KB)
-  XML_Arena arena{ static_cast<std::size_t>(XML_LIB_ARENA_SIZE_KB) * 1024 };
+  // Arena the document's nodes are allocated from, and the arena the next document is parsed
+  // into; they are swapped once it has been parsed, so a parse that fails leaves the last
+  // document in place (sizes governed by XML_LIB_ARENA_SIZE_KB). Each is made when first
+  // parsed into, so an XML not yet parsed holds neither and one parsed once only one.
+  std::unique_ptr<XML_Arena> documentArena;
+  std::unique_ptr<XML_Arena> parseArena;
+  // Table of the document's element and attribute names (replaced along with its arena)
+  std::shared_ptr<XML_NameTable> documentNameTable;
   // Entity mapper
   std::unique_ptr<IEntityMapper> entityMapper;
   // XML stringifier
   std::unique_ptr<IStringify> xmlStringifier;
-  // XML parser (owns Default_Parser::arena; must outlive xmlRoot)
+  // XML parser
   std::unique_ptr<IParser> xmlParser;
-  // Root Node (children allocated in xmlParser's arena; must be destroyed before xmlParser)
+  // Root Node (allocated in documentArena; must be freed before it is released)
   Node xmlRoot;
+  // Free the document's nodes ahead of releasing the arena they were allocated from
+  void freeDocument() noexcept;
   // Traverse XML tree
   template<typename T> static void traverseNodes(T &xNode, IAction &action);
 };
@@ -63,6 +63,10 @@ struct XSD_ComplexType
 struct XSD_Particle
 {
   std::string elementName;
+  // Element name's symbol in the schema document's name table (matched as an integer
+  // against elements of documents sharing that table)
+  const XML_NameTable *nameTable{ nullptr };
+  XML_NameTable::Symbol elementSymbol{ XML_NameTable::kNoSymbol };
   uint32_t minOccurs{ 1 };
   uint32_t maxOccurs{ 1 };// 0 = unbounded
   std::string typeRef;
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "XML_Arena.hpp"
+#include "XML_NameTable.hpp"
+
+namespace XML_Lib {
+
+// Where the nodes of a document are allocated: the arena they (and their strings) come from,
+// the heap if none, and the table their names are interned in. A context is passed explicitly
+// to what builds a document, which makes it current on its thread only while it constructs a
+// node; nodes made by other threads, or elsewhere on the same one, are unaffected.
+struct XML_AllocationContext
+{
+  XML_Arena *arena{ nullptr };
+  XML_NameTable *nameTable{ &XML_NameTable::global() };
+  // Context of nodes made on this thread outside of any scope below
+  [[nodiscard]] static XML_AllocationContext current() noexcept
+  {
+    return { XML_Arena::getCurrent(), &XML_NameTable::getCurrent() };
+  }
+  // Make a context current on this thread while in scope
+  class Scope
+  {
+  public:
+    explicit Scope(const XML_AllocationContext &context) noexcept
+      : scopedArena(context.arena), scopedNameTable(*context.nameTable)
+    {}
+    Scope(const Scope &other) = delete;
+    Scope &operator=(const Scope &other) = delete;
+    ~Scope() = default;
+
+  private:
+    XML_Arena::ScopedCurrentArena scopedArena;
+    XML_NameTable::ScopedCurrentNameTable scopedNameTable;
+  };
+};
+}// namespace XML_Lib
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
+#include <memory>
 #include <memory_resource>
+#include <span>
+#include <unordered_set>
 #include <vector>
 
 namespace XML_Lib {
 
+struct Variant;// forward declaration — full definition in nodes/XML_Variant.hpp
+
 // Default arena size: use the CMake-controlled macro when available, otherwise 256 KB.
 #if !defined(XML_LIB_ARENA_SIZE_KB)
 #  define XML_LIB_ARENA_SIZE_KB 256
@@ -15,7 +21,7 @@ class XML_Arena
 {
 public:
   explicit XML_Arena(std::size_t initialSize = static_cast<std::size_t>(XML_LIB_ARENA_SIZE_KB) * 1024)
-    : buffer(initialSize), resource(buffer.data(), buffer.size())
+    : buffer(std::make_unique_for_overwrite<std::byte[]>(initialSize)), resource({ buffer.get(), initialSize }, *this)
   {}
 
   void *allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
@@ -23,6 +29,62 @@ public:
     return resource.allocate(bytes, alignment);
   }
 
+  // Free everything allocated (including from its sub-arenas) so the arena can be reused;
+  // nothing allocated from it may be used after
+  void release()
+  {
+    subArenas.clear();
+    resource.release();
+    foreignNodes = false;
+    exposedChildren.clear();
+  }
+
+  // Add an arena freed along with this one, for the nodes of the same document built on
+  // another thread (an arena is not safe to allocate from on more than one thread at once)
+  XML_Arena &addSubArena()
+  {
+    subArenas.push_back(std::make_unique<XML_Arena>());
+    subArenas.back()->parent = this;
+    return *subArenas.back();
+  }
+
+  // Note that a node not allocated from an arena has been added to one that was (allocated
+  // from resource, which is ignored if it is not an arena's), so that the nodes allocated from
+  // the arena cannot simply be dropped with it but must be destroyed one by one
+  static void addForeignNode(std::pmr::memory_resource *resource) noexcept
+  {
+    if (XML_Arena *arena = owner(resource)) { arena->top().foreignNodes = true; }
+  }
+  // Note that nodes not allocated from an arena may have been put anywhere among those that were
+  void addForeignNodes() noexcept { top().foreignNodes = true; }
+  // Have nodes not allocated from the arena (or its sub-arenas) been added to those that were
+  [[nodiscard]] bool hasForeignNodes() const noexcept { return foreignNodes; }
+
+  // Note that the children of a variant allocated from the arena have been handed out to be
+  // changed, so nodes not allocated from an arena may be put among them unseen; they are
+  // checked for such nodes before the arena is released (a variant destroyed before then
+  // is forgotten). Not needed once the arena has foreign nodes anyway.
+  void addExposedChildren(const Variant *variant)
+  {
+    if (!top().foreignNodes) { exposedChildren.insert(variant); }
+  }
+  void removeExposedChildren(const Variant *variant) noexcept { exposedChildren.erase(variant); }
+  // Does any variant whose children were handed out (from this arena or its sub-arenas) satisfy predicate
+  template<typename Predicate> [[nodiscard]] bool anyExposedChildren(Predicate predicate) const
+  {
+    return std::ranges::any_of(exposedChildren, predicate)
+           || std::ranges::any_of(subArenas, [&predicate](const auto &subArena) {
+                return subArena->anyExposedChildren(predicate);
+              });
+  }
+
+  // Arena that a memory resource is of (nullptr if it is not an arena's)
+  [[nodiscard]] static XML_Arena *owner(std::pmr::memory_resource *resource) noexcept
+  {
+    auto *blocks = dynamic_cast<BlockResource *>(resource);
+    return blocks != nullptr ? &blocks->arena : nullptr;
+  }
+
   std::pmr::memory_resource *memoryResource() noexcept
   {
     return &resource;
@@ -33,14 +95,24 @@ public:
     return currentArena;
   }
 
+  // Memory resource for nodes created on this thread: the scoped arena's, else the pmr default
+  static std::pmr::memory_resource *getCurrentResource() noexcept
+  {
+    return currentArena != nullptr ? currentArena->memoryResource() : std::pmr::get_default_resource();
+  }
+
+  // Nodes created on this thread while in scope allocate from the arena (from the heap if it is
+  // nullptr); the process-wide pmr default is left alone so other threads are not redirected into it
   class ScopedCurrentArena
   {
   public:
-    explicit ScopedCurrentArena(XML_Arena &arena) noexcept
+    explicit ScopedCurrentArena(XML_Arena *arena) noexcept
       : previousArena(currentArena)
     {
-      currentArena = &arena;
+      currentArena = arena;
     }
+    ScopedCurrentArena(const ScopedCurrentArena &other) = delete;
+    ScopedCurrentArena &operator=(const ScopedCurrentArena &other) = delete;
 
     ~ScopedCurrentArena() noexcept
     {
@@ -51,28 +123,85 @@ public:
     XML_Arena *previousArena;
   };
 
-  class ScopedDefaultResource
+private:
+  // Arena that this is a sub-arena of, at the top (itself if it is none's)
+  XML_Arena &top() noexcept
+  {
+    XML_Arena *arena = this;
+    while (arena->parent != nullptr) { arena = arena->parent; }
+    return *arena;
+  }
+  // Bump allocator over the arena's initial buffer and then blocks of a fixed size (not
+  // the ever larger blocks of std::pmr::monotonic_buffer_resource, which the C++ heap
+  // returns to the system when freed, so that each document parsed faults its memory in
+  // afresh); nothing is freed before release().
+  class BlockResource final : public std::pmr::memory_resource
   {
   public:
-    explicit ScopedDefaultResource(XML_Arena &arena) noexcept
-      : previousResource(std::pmr::get_default_resource())
+    BlockResource(const std::span<std::byte> initialBuffer, XML_Arena &arena) noexcept
+      : arena(arena), initialBuffer(initialBuffer)
     {
-      std::pmr::set_default_resource(arena.memoryResource());
+      release();
     }
-
-    ~ScopedDefaultResource() noexcept
+    BlockResource(const BlockResource &other) = delete;
+    BlockResource &operator=(const BlockResource &other) = delete;
+    BlockResource(BlockResource &&other) = delete;
+    BlockResource &operator=(BlockResource &&other) = delete;
+    ~BlockResource() override { freeBlocks(); }
+    void release() noexcept
     {
-      std::pmr::set_default_resource(previousResource);
+      freeBlocks();
+      next = initialBuffer.data();
+      remaining = initialBuffer.size();
     }
+    // Arena the resource belongs to
+    XML_Arena &arena;
 
   private:
-    std::pmr::memory_resource *previousResource;
+    static constexpr std::size_t kBlockSize{ 1024 * 1024 };
+    void *do_allocate(const std::size_t bytes, const std::size_t alignment) override
+    {
+      void *memory = next;
+      if (std::align(alignment, bytes, memory, remaining) == nullptr) {
+        const std::size_t blockSize = std::max(kBlockSize, bytes + alignment);
+        blocks.push_back(static_cast<std::byte *>(::operator new(blockSize)));
+        memory = blocks.back();
+        remaining = blockSize;
+        std::align(alignment, bytes, memory, remaining);
+      }
+      next = static_cast<std::byte *>(memory) + bytes;
+      remaining -= bytes;
+      return memory;
+    }
+    void do_deallocate([[maybe_unused]] void *memory,
+      [[maybe_unused]] const std::size_t bytes,
+      [[maybe_unused]] const std::size_t alignment) override
+    {}
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+      return this == &other;
+    }
+    void freeBlocks() noexcept
+    {
+      for (auto *block : blocks) { ::operator delete(block); }
+      blocks.clear();
+    }
+    std::span<std::byte> initialBuffer;
+    std::vector<std::byte *> blocks;
+    std::byte *next{ nullptr };
+    std::size_t remaining{ 0 };
   };
-
-private:
-  std::vector<std::byte> buffer;
-  std::pmr::monotonic_buffer_resource resource;
-  static inline XML_Arena *currentArena = nullptr;
+  // Initial buffer, left uninitialised so that its pages are not touched before they are used
+  std::unique_ptr<std::byte[]> buffer;
+  BlockResource resource;
+  std::vector<std::unique_ptr<XML_Arena>> subArenas;
+  // Arena this is a sub-arena of (nullptr if none)
+  XML_Arena *parent{ nullptr };
+  // Set once a node not allocated from the arena is added to one that was
+  bool foreignNodes{ false };
+  // Variants allocated from the arena whose children have been handed out to be changed
+  std::unordered_set<const Variant *> exposedChildren;
+  static inline thread_local XML_Arena *currentArena = nullptr;
 };
 
 } // namespace XML_Lib
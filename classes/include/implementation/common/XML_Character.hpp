@@ -1,8 +1,10 @@
 #pragma once
 
+#include <array>
 #include <string>
 #include <string_view>
 #include <cstdint>
+#include <utility>
 
 namespace XML_Lib {
 // ====================
@@ -10,12 +12,85 @@ namespace XML_Lib {
 // ====================
 using String = std::u16string;
 using Char = String::value_type;
+// =========================================
+// XML character classes (XML 1.0 fifth ed.)
+// =========================================
+// Ranges of NameStartChar within the BMP. Characters of the supplementary planes
+// [#x10000-#xEFFFF] are checked a UTF-16 code unit at a time, so surrogates are included.
+inline constexpr std::array<std::pair<Char, Char>, 17> kNameStartCharRanges{ { { ':', ':' },
+  { 'A', 'Z' },
+  { '_', '_' },
+  { 'a', 'z' },
+  { 0xC0, 0xD6 },
+  { 0xD8, 0xF6 },
+  { 0xF8, 0x2FF },
+  { 0x370, 0x37D },
+  { 0x37F, 0x1FFF },
+  { 0x200C, 0x200D },
+  { 0x2070, 0x218F },
+  { 0x2C00, 0x2FEF },
+  { 0x3001, 0xD7FF },
+  { 0xD800, 0xDB7F },
+  { 0xDC00, 0xDFFF },
+  { 0xF900, 0xFDCF },
+  { 0xFDF0, 0xFFFD } } };
+// Ranges of NameChar besides those of NameStartChar
+inline constexpr std::array<std::pair<Char, Char>, 5> kNameCharExtraRanges{
+  { { '-', '.' }, { '0', '9' }, { 0xB7, 0xB7 }, { 0x300, 0x36F }, { 0x203F, 0x2040 } }
+};
+// Flags of a Latin-1 character in kLatin1CharacterFlags
+inline constexpr std::uint8_t kValidCharFlag{ 0x01 };
+inline constexpr std::uint8_t kNameStartCharFlag{ 0x02 };
+inline constexpr std::uint8_t kNameCharFlag{ 0x04 };
+inline constexpr std::uint8_t kWhiteSpaceFlag{ 0x08 };
+// Markup delimiters: characters that end a run of character data ('<', '&' and ']')
+inline constexpr std::uint8_t kMarkupDelimiterFlag{ 0x10 };
+// Classes of the first 256 characters, built at compile time; the rest of the BMP is
+// looked up in bitmaps (validNameStartChar/validNameChar) or needs no table (validChar)
+inline constexpr std::array<std::uint8_t, 256> kLatin1CharacterFlags = [] {
+  std::array<std::uint8_t, 256> flags{};
+  for (std::size_t c = 0; c < flags.size(); c++) {
+    if (c == 0x09 || c == 0x0A || c == 0x0D || c >= 0x20) { flags[c] |= kValidCharFlag; }
+    if (c == 0x09 || c == 0x0A || c == 0x0D || c == 0x20) { flags[c] |= kWhiteSpaceFlag; }
+    if (c == '<' || c == '&' || c == ']') { flags[c] |= kMarkupDelimiterFlag; }
+  }
+  for (const auto &[first, last] : kNameStartCharRanges) {
+    for (std::size_t c = first; c <= last && c < flags.size(); c++) { flags[c] |= kNameStartCharFlag | kNameCharFlag; }
+  }
+  for (const auto &[first, last] : kNameCharExtraRanges) {
+    for (std::size_t c = first; c <= last && c < flags.size(); c++) { flags[c] |= kNameCharFlag; }
+  }
+  return flags;
+}();
 // ========================
 // XML character validation
 // ========================
-[[nodiscard]] bool validChar(Char c);
-[[nodiscard]] bool validNameStartChar(Char c);
-[[nodiscard]] bool validNameChar(Char c);
+[[nodiscard]] bool validNonLatin1NameStartChar(Char c);
+[[nodiscard]] bool validNonLatin1NameChar(Char c);
+[[nodiscard]] inline bool validChar(const Char c)
+{
+  return c < 0x100 ? (kLatin1CharacterFlags[c] & kValidCharFlag) != 0 : c <= 0xD7FF || (c >= 0xE000 && c <= 0xFFFD);
+}
+[[nodiscard]] inline bool validNameStartChar(const Char c)
+{
+  return c < 0x100 ? (kLatin1CharacterFlags[c] & kNameStartCharFlag) != 0 : validNonLatin1NameStartChar(c);
+}
+[[nodiscard]] inline bool validNameChar(const Char c)
+{
+  return c < 0x100 ? (kLatin1CharacterFlags[c] & kNameCharFlag) != 0 : validNonLatin1NameChar(c);
+}
+// Is a character whitespace (the S production: space, tab, carriage return or line feed)
+[[nodiscard]] inline bool validWhiteSpaceChar(const Char c)
+{
+  return c < 0x100 && (kLatin1CharacterFlags[c] & kWhiteSpaceFlag) != 0;
+}
+// Is a character valid in a run of character data (a Char that is not a markup delimiter)
+[[nodiscard]] inline bool validTextChar(const Char c)
+{
+  return c < 0x100 ? (kLatin1CharacterFlags[c] & (kValidCharFlag | kMarkupDelimiterFlag)) == kValidCharFlag
+                   : validChar(c);
+}
 [[nodiscard]] bool validName(const String &name);
+[[nodiscard]] bool validName(const std::string_view &name);
 [[nodiscard]] bool validAttributeValue(const std::string_view &value, char quote);
 }// namespace XML_Lib
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace XML_Lib {
+
+// Table of the element and attribute names (QNames) of documents. Each name is stored once
+// and given a symbol, so a node need only hold the symbol and names can be compared as
+// integers. A table is made for each document parsed unless ParseOptions::nameTable shares
+// one between documents; names made outside of a parse are in a process-wide table. A table
+// used from more than one thread at once (the process-wide one, one supplied to be shared, or
+// one a parse shares out between threads) is marked shared before it is, and only then are
+// names added and found under a lock; a table private to one parse is never locked. A name
+// already added is looked up from its symbol without locking in either case, as the storage
+// of a name never moves once added. The split
+// of a name into prefix and local name is recorded when it is added, so neither part need be
+// found again. Namespace URIs are added to the table too, so they can be compared as symbols.
+class XML_NameTable
+{
+public:
+  using Symbol = std::uint32_t;
+  // Symbol of no name (never that of a name added)
+  static constexpr Symbol kNoSymbol{ std::numeric_limits<Symbol>::max() };
+
+  // A name to be matched against names that may be in different tables; it is looked up
+  // in a table only when that differs from the last one matched against (so names should not
+  // be added to a table while it is being matched against)
+  class Matcher
+  {
+  public:
+    explicit Matcher(const std::string_view name) noexcept : matchName(name) {}
+    [[nodiscard]] bool matches(const XML_NameTable &nameTable, const Symbol symbol)
+    {
+      if (&nameTable != lastTable) {
+        lastTable = &nameTable;
+        lastSymbol = nameTable.find(matchName);
+      }
+      return symbol == lastSymbol;
+    }
+    [[nodiscard]] std::string_view name() const noexcept { return matchName; }
+
+  private:
+    std::string_view matchName;
+    const XML_NameTable *lastTable{ nullptr };
+    Symbol lastSymbol{ kNoSymbol };
+  };
+
+  // Constructors/Destructors
+  explicit XML_NameTable(const bool shared = false) noexcept : shared(shared) {}
+  XML_NameTable(const XML_NameTable &other) = delete;
+  XML_NameTable &operator=(const XML_NameTable &other) = delete;
+  XML_NameTable(XML_NameTable &&other) = delete;
+  XML_NameTable &operator=(XML_NameTable &&other) = delete;
+  ~XML_NameTable() = default;
+
+  // Return the symbol of a name, adding it to the table if not already there
+  [[nodiscard]] Symbol intern(const std::string_view name)
+  {
+    const auto lock = lockIfShared();
+    if (const auto entry = symbols.find(name); entry != symbols.end()) { return entry->second; }
+    const auto symbol = static_cast<Symbol>(nameCount);
+    const auto [block, offset] = locate(symbol);
+    if (blocks[block] == nullptr) { blocks[block] = std::make_unique<Entry[]>(kFirstBlockSize << block); }
+    Entry &stored = blocks[block][offset];
+    stored.name = name;
+    const auto colon = name.find(':');
+    stored.localNameStart = colon != std::string_view::npos ? static_cast<std::uint32_t>(colon + 1) : 0;
+    symbols.emplace(stored.name, symbol);
+    nameCount++;
+    return symbol;
+  }
+  // Return the symbol of a name, or kNoSymbol if it has not been added to the table
+  [[nodiscard]] Symbol find(const std::string_view name) const
+  {
+    const auto lock = lockIfShared();
+    const auto entry = symbols.find(name);
+    return entry != symbols.end() ? entry->second : kNoSymbol;
+  }
+  // Return the name of a symbol from the table
+  [[nodiscard]] std::string_view name(const Symbol symbol) const { return entry(symbol).name; }
+  // Return the prefix of the name of a symbol (empty if it has none) and its local name
+  [[nodiscard]] std::string_view prefix(const Symbol symbol) const
+  {
+    const Entry &named = entry(symbol);
+    return std::string_view(named.name).substr(0, named.localNameStart != 0 ? named.localNameStart - 1 : 0);
+  }
+  [[nodiscard]] std::string_view localName(const Symbol symbol) const
+  {
+    const Entry &named = entry(symbol);
+    return std::string_view(named.name).substr(named.localNameStart);
+  }
+  // Return the number of names in the table
+  [[nodiscard]] std::size_t size() const
+  {
+    const auto lock = lockIfShared();
+    return nameCount;
+  }
+
+  // Note that the table is to be used from more than one thread at once (before it is)
+  void markShared() noexcept { shared = true; }
+  [[nodiscard]] bool isShared() const noexcept { return shared; }
+  // Table for a parse: the one supplied in its options (marked shared, as it may be used by
+  // other documents on other threads), else a new table private to the document parsed
+  [[nodiscard]] static std::shared_ptr<XML_NameTable> forParse(const std::shared_ptr<XML_NameTable> &supplied)
+  {
+    if (supplied == nullptr) { return std::make_shared<XML_NameTable>(); }
+    supplied->markShared();
+    return supplied;
+  }
+  // Table that names made on this thread are added to: the scoped table, else the process-wide one
+  static XML_NameTable &getCurrent() noexcept { return currentTable != nullptr ? *currentTable : global(); }
+  // Process-wide table for names made outside of a parse
+  static XML_NameTable &global() noexcept
+  {
+    static XML_NameTable globalTable{ true };
+    return globalTable;
+  }
+
+  class ScopedCurrentNameTable
+  {
+  public:
+    explicit ScopedCurrentNameTable(XML_NameTable &nameTable) noexcept : previousTable(currentTable)
+    {
+      currentTable = &nameTable;
+    }
+    ScopedCurrentNameTable(const ScopedCurrentNameTable &other) = delete;
+    ScopedCurrentNameTable &operator=(const ScopedCurrentNameTable &other) = delete;
+    ~ScopedCurrentNameTable() noexcept { currentTable = previousTable; }
+
+  private:
+    XML_NameTable *previousTable;
+  };
+
+private:
+  // Names are stored in blocks each twice the size of the last, so that none ever moves
+  static constexpr std::size_t kFirstBlockSize{ 64 };
+  static constexpr std::size_t kMaxBlocks{ 32 };
+  [[nodiscard]] static std::pair<std::size_t, std::size_t> locate(const Symbol symbol) noexcept
+  {
+    const std::size_t block = std::bit_width(symbol / kFirstBlockSize + 1) - 1;
+    return { block, symbol - kFirstBlockSize * ((std::size_t{ 1 } << block) - 1) };
+  }
+  // Name of a symbol and where its local name starts (after the prefix and colon, if any)
+  struct Entry
+  {
+    std::string name;
+    std::uint32_t localNameStart{ 0 };
+  };
+  [[nodiscard]] const Entry &entry(const Symbol symbol) const
+  {
+    const auto [block, offset] = locate(symbol);
+    return blocks[block][offset];
+  }
+  // Lock the table for adding or finding a name if it is shared (else hold no lock)
+  [[nodiscard]] std::unique_lock<std::mutex> lockIfShared() const
+  {
+    return shared ? std::unique_lock<std::mutex>{ mutex } : std::unique_lock<std::mutex>{};
+  }
+  bool shared;
+  mutable std::mutex mutex;
+  std::array<std::unique_ptr<Entry[]>, kMaxBlocks> blocks;
+  std::unordered_map<std::string_view, Symbol> symbols;
+  std::size_t nameCount{ 0 };
+  static inline thread_local XML_NameTable *currentTable = nullptr;
+};
+
+}// namespace XML_Lib
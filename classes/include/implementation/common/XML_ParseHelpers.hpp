@@ -7,7 +7,7 @@
 
 namespace XML_Lib {
 
-String readName(ISource &source);
+std::string readName(ISource &source);
 std::string readUntil(ISource &source, Char terminator);
 std::string readEntityReferenceText(ISource &source);
 XMLValue decodeCharRef(ISource &source);
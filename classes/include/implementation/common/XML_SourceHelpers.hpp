@@ -9,30 +9,200 @@
 //
 // Include this header (not ISource.hpp directly) in any .cpp that calls
 // isWS / ignoreWS / match / getPosition on a source stream.
+//
+// The scanning helpers (match, readWhile, skipWhile, readUntil) work on the
+// contiguous spans exposed by ISource::peekUtf8() or ISource::peek() and only
+// drop back to current()/next() for characters a source cannot expose in bulk.
+// Text they read is returned UTF-8 encoded; from a UTF-8 span it is copied
+// straight from the input bytes.
 
 #include "interface/ISource.hpp"
+#include "XML_Converter.hpp"
+#include "XML_Utf8.hpp"
+#include <algorithm>
 #include <cstring>
-#include <cwctype>
+#include <initializer_list>
+#include <span>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 
 namespace XML_Lib {
 
-/// @brief Return `true` if the current source character is ASCII whitespace.
-[[nodiscard]] inline bool isWS(const ISource &source) { return std::iswspace(source.current()) != 0; }
+/// @brief Return `true` if @p ch is XML whitespace (space, tab, carriage return or line feed).
+[[nodiscard]] inline bool isWS(const Char ch) { return validWhiteSpaceChar(ch); }
+
+/// @brief Return `true` if the current source character is XML whitespace.
+[[nodiscard]] inline bool isWS(const ISource &source) { return isWS(source.current()); }
+
+/// @brief Return the span at the current position of @p source: UTF-8 bytes from `peekUtf8()`
+/// when @p CharT is `char`, otherwise UTF-16 characters from `peek()`.
+template<typename CharT> [[nodiscard]] std::basic_string_view<CharT> peekSpan(const ISource &source)
+{
+  if constexpr (std::is_same_v<CharT, char>) {
+    return source.peekUtf8();
+  } else {
+    return source.peek();
+  }
+}
+
+/// @brief Consume @p count elements of the span returned by `peekSpan<CharT>()`.
+template<typename CharT> void skipSpan(ISource &source, const std::size_t count)
+{
+  if constexpr (std::is_same_v<CharT, char>) {
+    source.skipUtf8(static_cast<long>(count));
+  } else {
+    source.skip(static_cast<long>(count));
+  }
+}
+
+/// @brief Append a span of source characters to UTF-8 @p text.
+inline void appendSpan(std::string &text, const std::string_view span) { text.append(span); }
+inline void appendSpan(std::string &text, const std::u16string_view span) { text += toUtf8(span); }
+
+/// @brief Append the current character of @p source (both halves of a surrogate pair) to UTF-8
+/// @p text and advance past it.
+inline void appendCurrent(ISource &source, std::string &text)
+{
+  if (const Char ch = source.current(); ch < 0x80) {
+    text += static_cast<char>(ch);
+    source.next();
+    return;
+  }
+  Char character[2]{ source.current() };
+  source.next();
+  std::size_t length = 1;
+  if (character[0] >= 0xD800 && character[0] <= 0xDBFF && source.more()) {
+    character[length++] = source.current();
+    source.next();
+  }
+  text += toUtf8(std::u16string_view{ character, length });
+}
+
+/// @brief Return the length of the leading run of @p span whose characters satisfy @p predicate.
+template<typename Predicate> [[nodiscard]] std::size_t leadingRun(const std::u16string_view span, Predicate predicate)
+{
+  return static_cast<std::size_t>(std::find_if_not(span.begin(), span.end(), predicate) - span.begin());
+}
+
+/// @brief Overload for UTF-8 spans; @p predicate is applied to each UTF-16 code unit of a
+/// character. The run stops short of an invalid sequence, which is left for the source to report.
+template<typename Predicate> [[nodiscard]] std::size_t leadingRun(const std::string_view span, Predicate predicate)
+{
+  std::size_t run = 0;
+  while (run < span.size()) {
+    if (const auto byte = static_cast<unsigned char>(span[run]); byte < 0x80) {
+      if (!predicate(static_cast<Char>(byte))) { break; }
+      run++;
+      continue;
+    }
+    char32_t codePoint{};
+    const auto length = decodeUtf8(span.substr(run), codePoint);
+    if (length == 0) { break; }
+    if (codePoint < 0x10000 ? !predicate(static_cast<Char>(codePoint))
+                            : !predicate(highSurrogate(codePoint)) || !predicate(lowSurrogate(codePoint))) {
+      break;
+    }
+    run += length;
+  }
+  return run;
+}
+
+/// @brief Append characters from @p source to UTF-8 @p text while @p predicate holds for them.
+template<typename Predicate> void readWhile(ISource &source, std::string &text, Predicate predicate)
+{
+  const auto readRun = [&]<typename CharT>(const std::basic_string_view<CharT> span) {
+    const auto run = leadingRun(span, predicate);
+    appendSpan(text, span.substr(0, run));
+    skipSpan<CharT>(source, run);
+    return run < span.size();
+  };
+  while (source.more()) {
+    if (const auto bytes = source.peekUtf8(); !bytes.empty()) {
+      if (readRun(bytes)) { return; }
+    } else if (const auto span = source.peek(); !span.empty()) {
+      if (readRun(span)) { return; }
+    } else {
+      if (!predicate(source.current())) { return; }
+      appendCurrent(source, text);
+    }
+  }
+}
+
+/// @brief Advance @p source past characters for which @p predicate holds.
+template<typename Predicate> void skipWhile(ISource &source, Predicate predicate)
+{
+  const auto skipRun = [&]<typename CharT>(const std::basic_string_view<CharT> span) {
+    const auto run = leadingRun(span, predicate);
+    skipSpan<CharT>(source, run);
+    return run < span.size();
+  };
+  while (source.more()) {
+    if (const auto bytes = source.peekUtf8(); !bytes.empty()) {
+      if (skipRun(bytes)) { return; }
+    } else if (const auto span = source.peek(); !span.empty()) {
+      if (skipRun(span)) { return; }
+    } else {
+      if (!predicate(source.current())) { return; }
+      source.next();
+    }
+  }
+}
 
 /// @brief Advance @p source past all leading whitespace characters.
 inline void ignoreWS(ISource &source)
 {
-  while (source.more() && isWS(source)) { source.next(); }
+  skipWhile(source, [](const Char ch) { return isWS(ch); });
+}
+
+/// @brief Keep the line/column bookkeeping of a character-by-character match attempt that
+/// got @p matched characters into @p span before failing and backing up.
+template<typename CharT> void replayPartialMatch(ISource &source, const std::basic_string_view<CharT> span, std::size_t matched)
+{
+  if constexpr (std::is_same_v<CharT, char>) {
+    // A character that only partly matched was never stepped over
+    while (matched > 0 && matched < span.size() && isUtf8Continuation(span[matched])) { matched--; }
+    if (matched > 0) { source.replayUtf8(static_cast<long>(matched)); }
+  } else {
+    if (matched == 0) { return; }
+    source.skip(static_cast<long>(matched));
+    source.backup(static_cast<long>(matched));
+  }
+}
+
+/// @brief Try to match @p target against the start of @p span, consuming it from @p source on
+/// success.
+template<typename SpanT, typename CharT>
+bool matchSpan(ISource &source, const std::basic_string_view<SpanT> span, const std::basic_string_view<CharT> target)
+{
+  const auto equal = [](const CharT targetCh, const SpanT ch) { return ch == static_cast<SpanT>(targetCh); };
+  const auto matched =
+    static_cast<std::size_t>(std::mismatch(target.begin(), target.end(), span.begin(), equal).first - target.begin());
+  if (matched == target.size()) {
+    skipSpan<SpanT>(source, matched);
+    return true;
+  }
+  replayPartialMatch(source, span, matched);
+  return false;
 }
 
 /// @brief Try to match @p target at the current position of @p source.
 /// Advances the stream and returns `true` on success; leaves the stream
-/// unchanged and returns `false` on failure.
-inline bool match(ISource &source, const String &target)
+/// unchanged and returns `false` on failure. A `char` target is UTF-8 encoded.
+template<typename CharT> bool match(ISource &source, const std::basic_string_view<CharT> target)
 {
+  if constexpr (std::is_same_v<CharT, char>) {
+    if (const auto bytes = source.peekUtf8(); bytes.size() >= target.size()) { return matchSpan(source, bytes, target); }
+    // Below, UTF-8 targets are compared a code unit at a time so must be plain ASCII
+    if (std::ranges::any_of(target, [](const char ch) { return static_cast<unsigned char>(ch) >= 0x80; })) {
+      const String utf16Target{ toUtf16(target) };
+      return match(source, std::u16string_view{ utf16Target });
+    }
+  }
+  if (const auto span = source.peek(); span.size() >= target.size()) { return matchSpan(source, span, target); }
+  const auto equal = [](const Char ch, const CharT targetCh) { return ch == static_cast<Char>(targetCh); };
   long index = 0;
-  while (source.more() && source.current() == target[index]) {
+  while (source.more() && equal(source.current(), target[index])) {
     source.next();
     if (++index == static_cast<long>(target.length())) { return true; }
   }
@@ -40,15 +210,116 @@ inline bool match(ISource &source, const String &target)
   return false;
 }
 
+/// @brief Try to match each of the ASCII @p targets in turn at the current position of @p source,
+/// as a call of match() for each would (partial matches being replayed), stopping at the first
+/// to match. Returns its index, or the number of targets if none matched. The source's UTF-8
+/// span is looked at once for all of them, rather than once for each.
+[[nodiscard]] inline std::size_t matchFirst(ISource &source, const std::span<const std::string_view> targets)
+{
+  auto bytes = source.peekUtf8();
+  for (std::size_t index = 0; index < targets.size(); index++) {
+    const auto target = targets[index];
+    if (bytes.size() < target.size()) {
+      if (match(source, target)) { return index; }
+      bytes = source.peekUtf8();
+      continue;
+    }
+    const auto matched =
+      static_cast<std::size_t>(std::ranges::mismatch(target, bytes.substr(0, target.size())).in1 - target.begin());
+    if (matched == target.size()) {
+      source.skipUtf8(static_cast<long>(matched));
+      return index;
+    }
+    if (matched > 0) {
+      replayPartialMatch(source, bytes, matched);
+      bytes = source.peekUtf8();
+    }
+  }
+  return targets.size();
+}
+
+/// @brief Overload for UTF-16 strings.
+inline bool match(ISource &source, const String &target) { return match(source, std::u16string_view{ target }); }
+
+/// @brief Overload for UTF-8 strings.
+inline bool match(ISource &source, const std::string &target) { return match(source, std::string_view{ target }); }
+
 /// @brief Overload for null-terminated C strings.
-inline bool match(ISource &source, const char *target)
+inline bool match(ISource &source, const char *target) { return match(source, std::string_view{ target }); }
+
+/// @brief Consume @p count elements of the current span which a character-by-character scan
+/// would have tested against each of the ASCII @p targets in turn. Partial matches are replayed
+/// (advance then back up) so that line/column tracking is identical to that scan.
+template<typename CharT>
+void skipScanned(ISource &source, std::size_t count, const std::initializer_list<std::string_view> targets)
 {
-  long index = 0;
-  while (source.more() && source.current() == static_cast<Char>(target[index])) {
-    source.next();
-    if (++index == static_cast<long>(std::strlen(target))) { return true; }
+  std::basic_string<CharT> firstCharacters;
+  for (const auto &target : targets) { firstCharacters += static_cast<CharT>(target[0]); }
+  while (count > 0) {
+    const auto span = peekSpan<CharT>(source).substr(0, count);
+    const auto candidate = span.find_first_of(firstCharacters);
+    if (candidate == std::basic_string_view<CharT>::npos) { break; }
+    skipSpan<CharT>(source, candidate);
+    count -= candidate;
+    for (const auto &target : targets) {
+      const auto rest = peekSpan<CharT>(source);
+      const auto length = std::min(rest.size(), target.size());
+      const auto equal = [](const char targetCh, const CharT ch) { return ch == static_cast<CharT>(targetCh); };
+      if (const auto matched = std::mismatch(target.begin(), target.begin() + length, rest.begin(), equal).first - target.begin();
+          matched > 0) {
+        skipSpan<CharT>(source, static_cast<std::size_t>(matched));
+        source.backup(matched);
+      }
+    }
+    skipSpan<CharT>(source, 1);
+    count--;
+  }
+  skipSpan<CharT>(source, count);
+}
+
+/// @brief Return the length of the prefix of @p span that can be consumed while keeping back
+/// @p keep elements, without splitting a UTF-8 sequence.
+template<typename CharT> [[nodiscard]] std::size_t safePrefix(const std::basic_string_view<CharT> span, const std::size_t keep)
+{
+  auto safe = span.size() - keep + 1;
+  if constexpr (std::is_same_v<CharT, char>) {
+    while (safe > 0 && isUtf8Continuation(span[safe])) { safe--; }
+  }
+  return safe;
+}
+
+/// @brief Append characters from @p source to UTF-8 @p text up to the next occurrence of the
+/// ASCII @p target, which is consumed. Returns `false` if the source ran out first.
+inline bool readUntil(ISource &source, std::string &text, const std::string_view target)
+{
+  // Returns true once the target has been found and consumed
+  const auto readSpan = [&]<typename CharT>(const std::basic_string_view<CharT> span) {
+    const std::basic_string<CharT> delimiter(target.begin(), target.end());
+    if (const auto found = span.find(delimiter); found != std::basic_string_view<CharT>::npos) {
+      appendSpan(text, span.substr(0, found));
+      skipScanned<CharT>(source, found, { target });
+      skipSpan<CharT>(source, target.size());
+      return true;
+    }
+    // Keep back enough characters for a terminator straddling the end of the span
+    if (const auto safe = safePrefix(span, target.size()); safe > 0) {
+      appendSpan(text, span.substr(0, safe));
+      skipScanned<CharT>(source, safe, { target });
+    } else {
+      appendCurrent(source, text);
+    }
+    return false;
+  };
+  while (source.more()) {
+    if (const auto bytes = source.peekUtf8(); bytes.size() >= target.size()) {
+      if (readSpan(bytes)) { return true; }
+    } else if (const auto span = source.peek(); span.size() >= target.size()) {
+      if (readSpan(span)) { return true; }
+    } else {
+      if (match(source, target)) { return true; }
+      appendCurrent(source, text);
+    }
   }
-  source.backup(index);
   return false;
 }
 
@@ -0,0 +1,135 @@
+#pragma once
+
+// XML_Utf8.hpp
+//
+// Decoding and validation of UTF-8 encoded input, used by the sources and
+// scanning helpers that work on UTF-8 bytes directly instead of converting
+// the whole input to UTF-16 first.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace XML_Lib {
+
+/// @brief Return `true` if @p byte is a UTF-8 continuation byte (10xxxxxx).
+[[nodiscard]] constexpr bool isUtf8Continuation(const char byte)
+{
+  return (static_cast<unsigned char>(byte) & 0xC0) == 0x80;
+}
+
+/// @brief Decode the UTF-8 sequence at the start of @p bytes into @p codePoint and return its
+/// length in bytes, or 0 if it is truncated, overlong, a surrogate or beyond U+10FFFF.
+[[nodiscard]] constexpr std::size_t decodeUtf8(const std::string_view bytes, char32_t &codePoint)
+{
+  if (bytes.empty()) { return 0; }
+  const auto lead = static_cast<unsigned char>(bytes[0]);
+  if (lead < 0x80) {
+    codePoint = lead;
+    return 1;
+  }
+  std::size_t length = 0;
+  char32_t minimum = 0;
+  if ((lead & 0xE0) == 0xC0) {
+    length = 2;
+    codePoint = lead & 0x1F;
+    minimum = 0x80;
+  } else if ((lead & 0xF0) == 0xE0) {
+    length = 3;
+    codePoint = lead & 0x0F;
+    minimum = 0x800;
+  } else if ((lead & 0xF8) == 0xF0) {
+    length = 4;
+    codePoint = lead & 0x07;
+    minimum = 0x10000;
+  } else {
+    return 0;
+  }
+  if (bytes.size() < length) { return 0; }
+  for (std::size_t index = 1; index < length; index++) {
+    if (!isUtf8Continuation(bytes[index])) { return 0; }
+    codePoint = codePoint << 6 | (static_cast<unsigned char>(bytes[index]) & 0x3F);
+  }
+  if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) { return 0; }
+  return length;
+}
+
+// Longest UTF-8 encoding of a code point
+inline constexpr std::size_t kMaxUtf8Length{ 4 };
+
+/// @brief Encode @p codePoint (at most U+10FFFF) as UTF-8 into @p bytes, which must have room
+/// for kMaxUtf8Length, and return its length in bytes; nothing is allocated.
+[[nodiscard]] constexpr std::size_t encodeUtf8(const char32_t codePoint, char *bytes)
+{
+  if (codePoint < 0x80) {
+    bytes[0] = static_cast<char>(codePoint);
+    return 1;
+  }
+  if (codePoint < 0x800) {
+    bytes[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+    bytes[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    return 2;
+  }
+  if (codePoint < 0x10000) {
+    bytes[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+    bytes[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    bytes[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    return 3;
+  }
+  bytes[0] = static_cast<char>(0xF0 | (codePoint >> 18));
+  bytes[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+  bytes[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+  bytes[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+  return 4;
+}
+
+/// @brief Return the offset of the first invalid UTF-8 sequence in @p bytes, or
+/// `std::string_view::npos` if they are all valid.
+[[nodiscard]] inline std::size_t findInvalidUtf8(const std::string_view bytes)
+{
+  static constexpr std::uint64_t kHighBits{ 0x8080808080808080 };
+  std::size_t index = 0;
+  while (index < bytes.size()) {
+    // Step over plain ASCII a word at a time
+    if (index + sizeof(std::uint64_t) <= bytes.size()) {
+      std::uint64_t word{};
+      std::memcpy(&word, bytes.data() + index, sizeof(word));
+      if ((word & kHighBits) == 0) {
+        index += sizeof(word);
+        continue;
+      }
+    }
+    char32_t codePoint{};
+    const auto length = decodeUtf8(bytes.substr(index), codePoint);
+    if (length == 0) { return index; }
+    index += length;
+  }
+  return std::string_view::npos;
+}
+
+/// @brief Return the number of UTF-16 code units needed to hold the UTF-8 encoded @p bytes.
+[[nodiscard]] inline long utf16Length(const std::string_view bytes)
+{
+  long length = 0;
+  for (const char byte : bytes) {
+    if (!isUtf8Continuation(byte)) { length++; }
+    // Four byte sequences become a surrogate pair
+    if ((static_cast<unsigned char>(byte) & 0xF8) == 0xF0) { length++; }
+  }
+  return length;
+}
+
+/// @brief Return the UTF-16 high surrogate for supplementary plane @p codePoint.
+[[nodiscard]] constexpr char16_t highSurrogate(const char32_t codePoint)
+{
+  return static_cast<char16_t>(0xD800 + ((codePoint - 0x10000) >> 10));
+}
+
+/// @brief Return the UTF-16 low surrogate for supplementary plane @p codePoint.
+[[nodiscard]] constexpr char16_t lowSurrogate(const char32_t codePoint)
+{
+  return static_cast<char16_t>(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+}
+
+}// namespace XML_Lib
@@ -12,4 +12,5 @@ namespace XML_Lib {
 [[nodiscard]] std::string trimString(const std::string_view &target);
 [[nodiscard]] std::string toUpperString(const std::string_view &target);
 [[nodiscard]] std::string toLowerString(const std::string_view &target);
+[[nodiscard]] bool isWithin(const std::string_view &part, const std::string_view &whole);
 }// namespace XML_Lib
@@ -1,16 +1,18 @@
 #pragma once
 
-#include <codecvt>
-#include <locale>
 #include <string>
+#include <string_view>
 
 namespace XML_Lib {
 // ==================
 // Conversion methods
 // ==================
+// Malformed input (an unpaired surrogate or an invalid UTF-8 sequence) throws std::range_error.
 // UTF-8
 [[nodiscard]] std::string toUtf8(char16_t utf16);
-[[nodiscard]] std::string toUtf8(const std::u16string &utf16);
+[[nodiscard]] std::string toUtf8(std::u16string_view utf16);
+// Append the UTF-8 encoding of code point (at most U+10FFFF) to utf8 without a temporary
+void appendUtf8(std::string &utf8, char32_t codePoint);
 // UTF-16
-[[nodiscard]] std::u16string toUtf16(const std::string &utf8);
-}// namespace XML_Lib
\ No newline at end of file
+[[nodiscard]] std::u16string toUtf16(std::string_view utf8);
+}// namespace XML_Lib
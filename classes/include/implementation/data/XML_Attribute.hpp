@@ -1,56 +1,333 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
 #include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
+#include "common/XML_NameTable.hpp"
+
 namespace XML_Lib {
 
-struct XMLAttribute final : XMLValue
+struct XMLAttribute final
 {
   // XMLAttribute Error
   struct Error final : std::runtime_error
   {
     explicit Error(const std::string_view &message) : std::runtime_error(std::string("Attribute Error: ").append(message)) {}
   };
-  // Constructors/Destructors
-  XMLAttribute(const std::string_view &name, const XMLValue &value) : XMLValue(value), name(name) {}
+  // Allocator for the value characters (an attribute in a node's storage allocates from the node's resource)
+  using allocator_type = std::pmr::polymorphic_allocator<char>;
+  // Constructors/Destructors. The name is added to the current name table; a copy made
+  // with an allocator (by a node's attribute list) refers to the same table, while a plain
+  // copy is detached from the document: it is in no table, holding its name and namespace
+  // URI with its value. Assignment keeps the table (or detachment) of the attribute assigned
+  // to. A value held in situ is shared by copies made with an allocator.
+  XMLAttribute(const std::string_view &name, const XMLValue &value, const allocator_type &allocator = {})
+    : nameTable(&XML_NameTable::getCurrent()), allocator(allocator), singleQuoted(value.getQuote() == '\''),
+      nameSymbol(nameTable->intern(name))
+  {
+    setValue(value.getUnparsed(), value.getParsed());
+  }
+  // Attribute whose value has no references (so its parsed and unparsed forms are the same)
+  XMLAttribute(const std::string_view &name, const std::string_view &value, const char quote, const allocator_type &allocator = {})
+    : nameTable(&XML_NameTable::getCurrent()), allocator(allocator), singleQuoted(quote == '\''),
+      nameSymbol(nameTable->intern(name))
+  {
+    setValue(value, value);
+  }
+  // Attribute whose value (with no references) is left in situ, in characters held by the
+  // caller that must outlive it and any copies of it
+  [[nodiscard]] static XMLAttribute
+    inSitu(const std::string_view &name, const std::string_view &value, const char quote, const allocator_type &allocator = {})
+  {
+    XMLAttribute attribute{ name, std::string_view{}, quote, allocator };
+    if (value.size() > kMaxValueLength) { XML_LIB_THROW(Error("Attribute value too long.")); }
+    attribute.characters = value.data();
+    attribute.parsedLength = static_cast<std::uint32_t>(value.size());
+    attribute.valueInSitu = 1;
+    return attribute;
+  }
   XMLAttribute() = delete;
-  XMLAttribute(const XMLAttribute &other) = default;
-  XMLAttribute &operator=(const XMLAttribute &other) = default;
-  XMLAttribute(XMLAttribute &&other) = default;
-  XMLAttribute &operator=(XMLAttribute &&other) = default;
-  XMLAttribute &operator=(const XMLValue &other) override
+  XMLAttribute(const XMLAttribute &other) : nameTable(nullptr), singleQuoted(other.singleQuoted), nameSymbol(0), nameSpaceSymbol(0)
+  {
+    setDetached(other.getUnparsed(), other.getParsed(), other.getName(), other.getNamespaceURI());
+  }
+  XMLAttribute(const XMLAttribute &other, const allocator_type &allocator)
+    : nameTable(other.nameTable), allocator(allocator), singleQuoted(other.singleQuoted), nameSymbol(other.nameSymbol),
+      nameSpaceSymbol(other.nameSpaceSymbol)
+  {
+    copyValue(other);
+  }
+  XMLAttribute &operator=(const XMLAttribute &other)
+  {
+    if (this != &other) {
+      if (!isDetached()) {
+        nameSymbol = other.symbolIn(*nameTable);
+        nameSpaceSymbol = other.nameSpaceIn(*nameTable);
+      }
+      singleQuoted = other.singleQuoted;
+      copyValue(other);
+    }
+    return *this;
+  }
+  XMLAttribute(XMLAttribute &&other) noexcept
+    : nameTable(other.nameTable), allocator(other.allocator), singleQuoted(other.singleQuoted),
+      nameSymbol(other.nameSymbol), nameSpaceSymbol(other.nameSpaceSymbol)
+  {
+    takeValue(other);
+  }
+  XMLAttribute(XMLAttribute &&other, const allocator_type &allocator)
+    : nameTable(other.nameTable), allocator(allocator), singleQuoted(other.singleQuoted), nameSymbol(other.nameSymbol),
+      nameSpaceSymbol(other.nameSpaceSymbol)
+  {
+    if (allocator == other.allocator) {
+      takeValue(other);
+    } else {
+      copyValue(other);
+    }
+  }
+  XMLAttribute &operator=(XMLAttribute &&other)
+  {
+    if (this != &other) {
+      if (!isDetached()) {
+        nameSymbol = other.symbolIn(*nameTable);
+        nameSpaceSymbol = other.nameSpaceIn(*nameTable);
+      }
+      singleQuoted = other.singleQuoted;
+      if (allocator == other.allocator && !isDetached() && !other.isDetached()) {
+        freeValue();
+        takeValue(other);
+      } else {
+        copyValue(other);
+      }
+    }
+    return *this;
+  }
+  XMLAttribute &operator=(const XMLValue &other)
   {
     setValue(other.getUnparsed(), other.getParsed());
     return *this;
   }
-  ~XMLAttribute() override = default;
+  ~XMLAttribute() { freeValue(); }
   // Get attribute name
-  [[nodiscard]] const std::string &getName() const { return name; }
+  [[nodiscard]] std::string_view getName() const
+  {
+    return isDetached() ? std::string_view{ characters + valueLength(), nameSymbol } : nameTable->name(nameSymbol);
+  }
+  // Is the attribute detached from any document (a plain copy, in no name table)
+  [[nodiscard]] bool isDetached() const { return nameTable == nullptr; }
+  // Get name table of attribute name and its symbol there (a detached attribute reports the
+  // process-wide table, where its name is only looked up, so is kNoSymbol unless already there)
+  [[nodiscard]] XML_NameTable &getNameTable() const { return isDetached() ? XML_NameTable::global() : *nameTable; }
+  [[nodiscard]] XML_NameTable::Symbol getNameSymbol() const
+  {
+    return isDetached() ? XML_NameTable::global().find(getName()) : nameSymbol;
+  }
+  // Symbol of the attribute name, and of its namespace URI (kNoSymbol if none), in a table
+  // (added to it if not already there)
+  [[nodiscard]] XML_NameTable::Symbol symbolIn(XML_NameTable &otherTable) const
+  {
+    return &otherTable == nameTable ? nameSymbol : otherTable.intern(getName());
+  }
+  [[nodiscard]] XML_NameTable::Symbol nameSpaceIn(XML_NameTable &otherTable) const
+  {
+    if (&otherTable == nameTable) { return nameSpaceSymbol; }
+    const auto uri = getNamespaceURI();
+    return uri.empty() ? XML_NameTable::kNoSymbol : otherTable.intern(uri);
+  }
+  // Does the attribute have the name being matched
+  [[nodiscard]] bool matches(XML_NameTable::Matcher &matcher) const
+  {
+    return isDetached() ? getName() == matcher.name() : matcher.matches(*nameTable, nameSymbol);
+  }
+  // QName support: get prefix (empty if none) and local name
+  [[nodiscard]] std::string_view getPrefix() const
+  {
+    if (!isDetached()) { return nameTable->prefix(nameSymbol); }
+    const auto name = getName();
+    const auto colon = name.find(':');
+    return colon != std::string_view::npos ? name.substr(0, colon) : std::string_view{};
+  }
+  [[nodiscard]] std::string_view getLocalName() const
+  {
+    if (!isDetached()) { return nameTable->localName(nameSymbol); }
+    const auto name = getName();
+    const auto colon = name.find(':');
+    return colon != std::string_view::npos ? name.substr(colon + 1) : name;
+  }
+  // QName support: get namespace URI (empty if none) and its symbol in the name table (kNoSymbol if none)
+  [[nodiscard]] std::string_view getNamespaceURI() const
+  {
+    if (isDetached()) { return { characters + valueLength() + nameSymbol, nameSpaceSymbol }; }
+    return nameSpaceSymbol != XML_NameTable::kNoSymbol ? nameTable->name(nameSpaceSymbol) : std::string_view{};
+  }
+  [[nodiscard]] XML_NameTable::Symbol getNameSpaceSymbol() const
+  {
+    if (!isDetached()) { return nameSpaceSymbol; }
+    return nameSpaceSymbol != 0 ? XML_NameTable::global().find(getNamespaceURI()) : XML_NameTable::kNoSymbol;
+  }
+  // Set the namespace URI of the attribute (resolved from its prefix by the element it is on)
+  void setNamespaceURI(const std::string_view &uri)
+  {
+    if (isDetached()) {
+      setDetached(getUnparsed(), getParsed(), getName(), uri);
+    } else {
+      nameSpaceSymbol = nameTable->intern(uri);
+    }
+  }
+  // Is a reference value?
+  [[nodiscard]] bool isReference() const
+  {
+    const auto unparsed = getUnparsed();
+    return !unparsed.empty() && unparsed.front() == '&' && unparsed.back() == ';';
+  }
+  [[nodiscard]] bool isEntityReference() const { return isReference() && getUnparsed()[1] != '#'; }
+  [[nodiscard]] bool isCharacterReference() const { return isReference() && getUnparsed()[1] == '#'; }
+  // Get value (the unparsed value is only held apart from the parsed when it contained references)
+  [[nodiscard]] std::string_view getParsed() const { return { characters, parsedLength }; }
+  [[nodiscard]] std::string_view getUnparsed() const
+  {
+    return unparsedLength == kSameAsParsed ? getParsed() : std::string_view{ characters + parsedLength, unparsedLength };
+  }
+  [[nodiscard]] char getQuote() const { return singleQuoted ? '\'' : '\"'; }
+  // Is the value left in situ (in characters held by the caller)
+  [[nodiscard]] bool isInSitu() const { return valueInSitu != 0; }
+  // Get allocator of value characters
+  [[nodiscard]] allocator_type get_allocator() const { return allocator; }
   // Search for an attribute in any contiguous range of attributes
   [[nodiscard]] static bool contains(std::span<const XMLAttribute> attributes, const std::string_view &name);
   // Return attribute entry
   [[nodiscard]] static XMLAttribute &find(std::span<XMLAttribute> attributes, const std::string_view &name);
 
 private:
-  // Attribute name
-  std::string name;
+  // Unparsed length of a value whose unparsed and parsed forms are the same
+  static constexpr std::uint32_t kSameAsParsed{ std::numeric_limits<std::uint32_t>::max() >> 1 };
+  // Longest value held (its parsed and unparsed forms together)
+  static constexpr std::size_t kMaxValueLength{ kSameAsParsed - 1 };
+  // Length of the value characters (parsed, then unparsed if it differs)
+  [[nodiscard]] std::size_t valueLength() const
+  {
+    return parsedLength + (unparsedLength == kSameAsParsed ? 0 : unparsedLength);
+  }
+  // Replace the value with a copy of unparsed/parsed in a single allocation (parsed first)
+  void setValue(const std::string_view &unparsed, const std::string_view &parsed)
+  {
+    if (isDetached()) {
+      setDetached(unparsed, parsed, getName(), getNamespaceURI());
+      return;
+    }
+    const bool sameAsParsed = unparsed == parsed;
+    const std::size_t length = parsed.size() + (sameAsParsed ? 0 : unparsed.size());
+    if (length > kMaxValueLength) { XML_LIB_THROW(Error("Attribute value too long.")); }
+    char *newCharacters = length != 0 ? allocator.allocate(length) : nullptr;
+    std::ranges::copy(parsed, newCharacters);
+    if (!sameAsParsed) { std::ranges::copy(unparsed, newCharacters + parsed.size()); }
+    freeValue();
+    characters = newCharacters;
+    parsedLength = static_cast<std::uint32_t>(parsed.size());
+    unparsedLength = sameAsParsed ? kSameAsParsed : static_cast<std::uint32_t>(unparsed.size());
+  }
+  // Replace the value of a detached attribute, and its name and namespace URI, with copies in a
+  // single allocation after the value (their lengths held in place of their symbols)
+  void setDetached(const std::string_view &unparsed,
+    const std::string_view &parsed,
+    const std::string_view &name,
+    const std::string_view &uri)
+  {
+    const bool sameAsParsed = unparsed == parsed;
+    const std::size_t valueSize = parsed.size() + (sameAsParsed ? 0 : unparsed.size());
+    if (valueSize > kMaxValueLength) { XML_LIB_THROW(Error("Attribute value too long.")); }
+    const std::size_t length = valueSize + name.size() + uri.size();
+    char *newCharacters = length != 0 ? allocator.allocate(length) : nullptr;
+    auto *next = std::ranges::copy(parsed, newCharacters).out;
+    if (!sameAsParsed) { next = std::ranges::copy(unparsed, next).out; }
+    std::ranges::copy(uri, std::ranges::copy(name, next).out);
+    freeValue();
+    characters = newCharacters;
+    parsedLength = static_cast<std::uint32_t>(parsed.size());
+    unparsedLength = sameAsParsed ? kSameAsParsed : static_cast<std::uint32_t>(unparsed.size());
+    nameSymbol = static_cast<XML_NameTable::Symbol>(name.size());
+    nameSpaceSymbol = static_cast<XML_NameTable::Symbol>(uri.size());
+  }
+  // Replace the value with that of another attribute, sharing it if it is in situ (a detached
+  // attribute takes a copy along with the name and namespace URI)
+  void copyValue(const XMLAttribute &other)
+  {
+    if (isDetached()) {
+      setDetached(other.getUnparsed(), other.getParsed(), other.getName(), other.getNamespaceURI());
+      return;
+    }
+    if (other.valueInSitu == 0) {
+      setValue(other.getUnparsed(), other.getParsed());
+      return;
+    }
+    freeValue();
+    characters = other.characters;
+    parsedLength = other.parsedLength;
+    unparsedLength = kSameAsParsed;
+    valueInSitu = 1;
+  }
+  // Take over the value characters of another attribute with the same allocator
+  void takeValue(XMLAttribute &other) noexcept
+  {
+    characters = std::exchange(other.characters, nullptr);
+    parsedLength = other.parsedLength;
+    other.parsedLength = 0;
+    unparsedLength = other.unparsedLength;
+    other.unparsedLength = kSameAsParsed;
+    valueInSitu = other.valueInSitu;
+    other.valueInSitu = 0;
+    if (other.isDetached()) {
+      other.nameSymbol = 0;
+      other.nameSpaceSymbol = 0;
+    }
+  }
+  // Free the value characters (those in situ are not the attribute's)
+  void freeValue() noexcept
+  {
+    if (characters != nullptr && valueInSitu == 0) {
+      allocator.deallocate(const_cast<char *>(characters), valueLength() + (isDetached() ? nameSymbol + nameSpaceSymbol : 0));
+    }
+    characters = nullptr;
+    valueInSitu = 0;
+  }
+  // Attribute name (symbol in name table; nullptr if detached)
+  XML_NameTable *nameTable;
+  // Resource the value characters are allocated from
+  allocator_type allocator;
+  // Value characters: the parsed value, then the unparsed value if it differs
+  const char *characters{ nullptr };
+  std::uint32_t parsedLength : 31 { 0 };
+  // Quote used for value (single if set, else double)
+  std::uint32_t singleQuoted : 1 { 0 };
+  std::uint32_t unparsedLength : 31 { kSameAsParsed };
+  // Value characters are in situ (not allocated, so never freed)
+  std::uint32_t valueInSitu : 1 { 0 };
+  // Name and namespace URI (symbols in name table, kNoSymbol if no URI; lengths if detached)
+  XML_NameTable::Symbol nameSymbol;
+  XML_NameTable::Symbol nameSpaceSymbol{ XML_NameTable::kNoSymbol };
 };
 
 [[nodiscard]] inline bool XMLAttribute::contains(std::span<const XMLAttribute> attributes, const std::string_view &name)
 {
-  return std::find_if(attributes.rbegin(), attributes.rend(), [&name](const XMLAttribute &attr) {
-    return attr.getName() == name;
+  XML_NameTable::Matcher matcher{ name };
+  return std::find_if(attributes.rbegin(), attributes.rend(), [&matcher](const XMLAttribute &attr) {
+    return attr.matches(matcher);
   }) != attributes.rend();
 }
 
 [[nodiscard]] inline XMLAttribute &XMLAttribute::find(std::span<XMLAttribute> attributes, const std::string_view &name)
 {
-  const auto attribute = std::find_if(
-    attributes.rbegin(), attributes.rend(), [&name](const XMLAttribute &attr) { return attr.getName() == name; });
+  XML_NameTable::Matcher matcher{ name };
+  const auto attribute = std::find_if(attributes.rbegin(), attributes.rend(), [&matcher](const XMLAttribute &attr) {
+    return attr.matches(matcher);
+  });
   // ReSharper disable once CppDFALocalValueEscapesFunction
   if (attribute != attributes.rend()) return *attribute;
   XML_LIB_THROW(Error("Attribute '" + std::string(name) + "' does not exist."));
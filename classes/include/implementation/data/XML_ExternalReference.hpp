@@ -38,7 +38,7 @@ public:
   XMLExternalReference &operator=(XMLExternalReference &&other) = default;
   ~XMLExternalReference() = default;
   // Get external reference details
-  [[nodiscard]] std::string getType() const
+  [[nodiscard]] std::string_view getType() const
   {
     if (type == Type::publicID) { return kPublicID; }
     if (type == Type::systemID) { return kSystemID; }
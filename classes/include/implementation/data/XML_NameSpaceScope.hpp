@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace XML_Lib {
+
+// Frame of a namespace scope chain: the namespaces declared by one element (keyed by prefix,
+// ":" for the default namespace) linked to the frame of the scope it is nested in. A frame is
+// only made where namespaces are declared and is shared by every element in its scope. The
+// namespace URI of a declaration is the URI it declares, so it is interned once per frame.
+struct XMLNameSpaceScope
+{
+  using Pointer = std::shared_ptr<const XMLNameSpaceScope>;
+  // Constructors/Destructors
+  XMLNameSpaceScope(Pointer outer, std::pmr::memory_resource *resource)
+    : outer(std::move(outer)), declarations(resource)
+  {}
+  XMLNameSpaceScope(const XMLNameSpaceScope &other) = delete;
+  XMLNameSpaceScope &operator=(const XMLNameSpaceScope &other) = delete;
+  XMLNameSpaceScope(XMLNameSpaceScope &&other) = delete;
+  XMLNameSpaceScope &operator=(XMLNameSpaceScope &&other) = delete;
+  ~XMLNameSpaceScope() = default;
+  // Return the scope within outer of an element with the given attributes (outer if none are xmlns)
+  [[nodiscard]] static Pointer
+    declare(const Pointer &outer, std::span<const XMLAttribute> attributes, std::pmr::memory_resource *resource)
+  {
+    const auto isDeclaration = [](const XMLAttribute &attribute) { return attribute.getName().starts_with("xmlns"); };
+    if (std::ranges::none_of(attributes, isDeclaration)) { return outer; }
+    auto scope = make(outer, resource);
+    for (const auto &attribute : attributes) {
+      if (isDeclaration(attribute)) {
+        scope->declarations.emplace_back(attribute.getName().size() > 5 ? attribute.getName().substr(6) : ":",
+          XMLValue{ attribute.getUnparsed(), attribute.getParsed() });
+        scope->declarations.back().setNamespaceURI(attribute.getParsed());
+      }
+    }
+    return scope;
+  }
+  // Return a scope within outer adding the given namespaces (already keyed by prefix)
+  [[nodiscard]] static Pointer
+    add(const Pointer &outer, std::span<const XMLAttribute> nameSpaces, std::pmr::memory_resource *resource)
+  {
+    if (nameSpaces.empty()) { return outer; }
+    auto scope = make(outer, resource);
+    scope->declarations.assign(nameSpaces.begin(), nameSpaces.end());
+    for (auto &declaration : scope->declarations) { declaration.setNamespaceURI(declaration.getParsed()); }
+    return scope;
+  }
+  // Return the innermost declaration of a prefix in a scope (nullptr if it is not in scope)
+  [[nodiscard]] static const XMLAttribute *find(const XMLNameSpaceScope *scope, const std::string_view &prefix)
+  {
+    XML_NameTable::Matcher matcher{ prefix };
+    for (; scope != nullptr; scope = scope->outer.get()) {
+      const auto &declared = scope->declarations;
+      const auto declaration = std::find_if(declared.rbegin(), declared.rend(), [&matcher](const XMLAttribute &attr) {
+        return attr.matches(matcher);
+      });
+      if (declaration != declared.rend()) { return &*declaration; }
+    }
+    return nullptr;
+  }
+  // View of every declaration in a scope, outermost first (shadowed declarations included),
+  // walking the chain in place. Valid while the innermost frame is held; a frame follows the
+  // one before it by walking in from the innermost, so a step costs the depth of the chain.
+  class Declarations
+  {
+  public:
+    class Iterator
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = XMLAttribute;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const XMLAttribute *;
+      using reference = const XMLAttribute &;
+      Iterator() = default;
+      Iterator(const XMLNameSpaceScope *innermost, const XMLNameSpaceScope *frame) noexcept
+        : innermost(innermost), frame(frame)
+      {
+        skipEmpty();
+      }
+      [[nodiscard]] reference operator*() const { return frame->declarations[index]; }
+      [[nodiscard]] pointer operator->() const { return &frame->declarations[index]; }
+      Iterator &operator++()
+      {
+        if (++index == frame->declarations.size()) { nextFrame(); }
+        return *this;
+      }
+      Iterator operator++(int)
+      {
+        auto previous = *this;
+        ++*this;
+        return previous;
+      }
+      [[nodiscard]] bool operator==(const Iterator &other) const noexcept
+      {
+        return frame == other.frame && index == other.index;
+      }
+
+    private:
+      // Step to the first declaration of the frame nested next in the current one (the end if none)
+      void nextFrame() noexcept
+      {
+        const XMLNameSpaceScope *next = frame != innermost ? innermost : nullptr;
+        while (next != nullptr && next->outer.get() != frame) { next = next->outer.get(); }
+        frame = next;
+        index = 0;
+        skipEmpty();
+      }
+      void skipEmpty() noexcept
+      {
+        if (frame != nullptr && frame->declarations.empty()) { nextFrame(); }
+      }
+      const XMLNameSpaceScope *innermost{ nullptr };
+      const XMLNameSpaceScope *frame{ nullptr };
+      std::size_t index{ 0 };
+    };
+    explicit Declarations(const XMLNameSpaceScope *innermost) noexcept : innermost(innermost) {}
+    [[nodiscard]] Iterator begin() const noexcept
+    {
+      const XMLNameSpaceScope *outermost = innermost;
+      while (outermost != nullptr && outermost->outer != nullptr) { outermost = outermost->outer.get(); }
+      return { innermost, outermost };
+    }
+    [[nodiscard]] Iterator end() const noexcept { return { innermost, nullptr }; }
+    [[nodiscard]] bool empty() const noexcept { return begin() == end(); }
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+      std::size_t count{ 0 };
+      for (const auto *frame = innermost; frame != nullptr; frame = frame->outer.get()) {
+        count += frame->declarations.size();
+      }
+      return count;
+    }
+
+  private:
+    const XMLNameSpaceScope *innermost;
+  };
+  // Return every declaration in a scope copied out of it, outermost first (shadowed declarations
+  // included); the copies are detached from the document, so this allocates for each of them
+  [[nodiscard]] static std::vector<XMLAttribute> collect(const XMLNameSpaceScope *scope)
+  {
+    const Declarations declarations{ scope };
+    return { declarations.begin(), declarations.end() };
+  }
+  // Get outer scope and the declarations of this one
+  [[nodiscard]] const Pointer &getOuter() const { return outer; }
+  [[nodiscard]] const std::pmr::vector<XMLAttribute> &getDeclarations() const { return declarations; }
+
+private:
+  // Make an empty frame within outer, allocated (with its declarations) from resource
+  [[nodiscard]] static std::shared_ptr<XMLNameSpaceScope> make(const Pointer &outer, std::pmr::memory_resource *resource)
+  {
+    return std::allocate_shared<XMLNameSpaceScope>(std::pmr::polymorphic_allocator<XMLNameSpaceScope>(resource), outer, resource);
+  }
+  // Scope nested in (nullptr at the outermost)
+  Pointer outer;
+  // Namespaces declared (an attribute named by prefix, ":" for the default namespace)
+  std::pmr::vector<XMLAttribute> declarations;
+};
+}// namespace XML_Lib
@@ -1,17 +1,30 @@
 #pragma once
 
+#include <memory_resource>
+
 namespace XML_Lib {
 
 struct XMLValue
 {
+  // Allocator for the value strings (a value in a node's storage allocates from the node's resource)
+  using allocator_type = std::pmr::polymorphic_allocator<char>;
   // Constructors/Destructors
-  explicit XMLValue(const std::string_view &unparsed = "", const std::string_view &parsed = "", const char quote = '\"')
-    : unparsed(unparsed), parsed(parsed), quote(quote)
+  explicit XMLValue(const std::string_view &unparsed = "",
+    const std::string_view &parsed = "",
+    const char quote = '\"',
+    const allocator_type &allocator = {})
+    : unparsed(unparsed, allocator), parsed(parsed, allocator), quote(quote)
   {}
   XMLValue() = delete;
   XMLValue(const XMLValue &other) = default;
+  XMLValue(const XMLValue &other, const allocator_type &allocator)
+    : unparsed(other.unparsed, allocator), parsed(other.parsed, allocator), quote(other.quote)
+  {}
   virtual XMLValue &operator=(const XMLValue &other) = default;
   XMLValue(XMLValue &&other) = default;
+  XMLValue(XMLValue &&other, const allocator_type &allocator)
+    : unparsed(std::move(other.unparsed), allocator), parsed(std::move(other.parsed), allocator), quote(other.quote)
+  {}
   XMLValue &operator=(XMLValue &&other) = default;
   virtual ~XMLValue() = default;
   // Is a reference value?
@@ -19,9 +32,11 @@ struct XMLValue
   [[nodiscard]] bool isEntityReference() const { return isReference() && unparsed[1] != '#'; }
   [[nodiscard]] bool isCharacterReference() const { return isReference() && unparsed[1] == '#'; }
   // Get value
-  [[nodiscard]] const std::string &getUnparsed() const { return unparsed; }
-  [[nodiscard]] const std::string &getParsed() const { return parsed; }
+  [[nodiscard]] std::string_view getUnparsed() const { return unparsed; }
+  [[nodiscard]] std::string_view getParsed() const { return parsed; }
   [[nodiscard]] char getQuote() const { return quote; }
+  // Get allocator of value strings
+  [[nodiscard]] allocator_type get_allocator() const { return unparsed.get_allocator(); }
 
 protected:
    void setValue(const std::string_view &str1, const std::string_view &str2)
@@ -32,8 +47,8 @@ protected:
 
 private:
   // Parsed/Unparsed value
-  std::string unparsed{};
-  std::string parsed{};
+  std::pmr::string unparsed;
+  std::pmr::string parsed;
   // Quote used for value
   char quote;
 };
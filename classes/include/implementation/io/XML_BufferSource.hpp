@@ -2,7 +2,7 @@
 #include "common/XML_Error.hpp"
 #include "XML_Converter.hpp"
 
-#include "ISource.hpp"
+#include "XML_Utf8Source.hpp"
 
 #include <algorithm>
 #include <cstdint>
@@ -14,7 +14,7 @@
 
 namespace XML_Lib {
 
-class BufferSource final : public ISource
+class BufferSource final : public Utf8Source
 {
 public:
   // Bits per byte
@@ -33,13 +33,13 @@ public:
         return static_cast<char16_t>(static_cast<uint16_t>(ch) >> kBitsPerByte | static_cast<uint16_t>(ch) << kBitsPerByte);
       });
     }
-    buffer = utf16xml;
-    convertCRLFToLF(buffer);
+    buffer = toUtf8(utf16xml);
+    setInput(buffer);
   }
-  explicit BufferSource(const std::string_view &sourceBuffer) : buffer{ toUtf16(std::string(sourceBuffer)) }
+  explicit BufferSource(const std::string_view &sourceBuffer) : buffer{ sourceBuffer }
   {
     if (sourceBuffer.empty()) { XML_LIB_THROW(Error("Empty source buffer passed to be parsed.")); }
-    convertCRLFToLF(buffer);
+    setInput(buffer);
   }
   BufferSource() = default;
   BufferSource(const BufferSource &other) = delete;
@@ -48,50 +48,9 @@ public:
   BufferSource &operator=(BufferSource &&other) = delete;
   ~BufferSource() override = default;
 
-  [[nodiscard]] Char current() const override
-  {
-    if (more()) { return buffer[bufferPosition]; }
-    return static_cast<Char>(EOF);
-  }
-  void next() override
-  {
-    if (!more()) { XML_LIB_THROW(Error("Parse buffer empty before parse complete.")); }
-    bufferPosition++;
-    columnNo++;
-    if (current() == kLineFeed) {
-      lineNo++;
-      columnNo = 1;
-    }
-  }
-  [[nodiscard]] bool more() const override { return bufferPosition < static_cast<long>(buffer.size()); }
-  void backup(const long length) override
-  {
-    bufferPosition -= length;
-    if (bufferPosition < 0) { bufferPosition = 0; }
-  }
-  [[nodiscard]] long position() const override { return bufferPosition; }
-  [[nodiscard]] std::string getRange(const long start, const long end) override
-  {
-    return toUtf8(buffer.substr(start, static_cast<std::size_t>(end) - start));
-  }
-  void reset() override
-  {
-    lineNo = 1;
-    columnNo = 1;
-    bufferPosition = 0;
-  }
-
 private:
-  static void convertCRLFToLF(String &xmlString)
-  {
-    size_t pos = xmlString.find(u"\x0D\x0A");
-    while (pos != std::string::npos) {
-      xmlString.replace(pos, 2, u"\x0A");
-      pos = xmlString.find(u"\x0D\x0A", pos + 1);
-    }
-  }
+  [[noreturn]] void throwError(const std::string_view &message) const override { XML_LIB_THROW(Error(message)); }
 
-  long bufferPosition = 0;
-  String buffer;
+  std::string buffer;
 };
 }// namespace XML_Lib
\ No newline at end of file
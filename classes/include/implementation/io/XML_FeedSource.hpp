@@ -0,0 +1,110 @@
+#pragma once
+#include "common/XML_Error.hpp"
+
+#include "XML_Utf8Source.hpp"
+
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace XML_Lib {
+
+// Holds UTF-8 encoded input that is passed to it a chunk at a time (as it arrives over a
+// network connection, say). Until finish() is called, reading up to the end of what has
+// been appended so far throws Incomplete rather than reporting the end of the input, so
+// that a parse can be abandoned at the mark() taken before it and retried with more input.
+// Only input from the position onwards is held; what has been read is discarded as new
+// input is appended.
+class FeedSource final : public Utf8Source
+{
+public:
+  // FeedSource Error
+#ifndef XML_LIB_NO_EXCEPTIONS
+  XML_LIB_DEFINE_ERROR("FeedSource");
+#endif
+  // Thrown when what is being parsed runs past the input appended so far
+  struct Incomplete final : std::runtime_error
+  {
+    Incomplete() : std::runtime_error("FeedSource Error: More input needed.") {}
+  };
+  // Constructors/Destructors
+  FeedSource() = default;
+  FeedSource(const FeedSource &other) = delete;
+  FeedSource &operator=(const FeedSource &other) = delete;
+  FeedSource(FeedSource &&other) = delete;
+  FeedSource &operator=(FeedSource &&other) = delete;
+  ~FeedSource() override = default;
+
+  [[nodiscard]] bool more() const override
+  {
+    const bool held = Utf8Source::more();
+    if (!held && !finished) { XML_LIB_THROW(Incomplete()); }
+    return held;
+  }
+  void reset() override
+  {
+    if (windowBase() > 0) { throwError("Cannot reset once the start of the input has been discarded."); }
+    Utf8Source::reset();
+  }
+  [[nodiscard]] std::string_view contents() const override { return {}; }
+
+  // Add the next chunk of input
+  void append(const std::span<const char> chunk)
+  {
+    if (finished) { throwError("Input appended after it was finished."); }
+    if (!started) {
+      buffer.append(chunk.data(), chunk.size());
+      if (static_cast<long>(buffer.size()) >= kLookAhead) { start(); }
+      return;
+    }
+    const long dropped = windowPosition();
+    buffer.erase(0, static_cast<std::size_t>(dropped));
+    buffer.append(chunk.data(), chunk.size());
+    slideInput(buffer, dropped);
+  }
+  // Mark the end of the input
+  void finish()
+  {
+    finished = true;
+    if (!started) { start(); }
+  }
+  // Has enough input been appended to start reading it
+  [[nodiscard]] bool isReady() const { return started; }
+  [[nodiscard]] bool isFinished() const { return finished; }
+  // Bytes held from the position onwards
+  [[nodiscard]] long available() const { return static_cast<long>(buffer.size()) - windowPosition(); }
+  // Position to return to if what is parsed next turns out to be incomplete
+  [[nodiscard]] Cursor mark() const { return saveCursor(); }
+  void rewind(const Cursor &cursor) { restoreCursor(cursor); }
+
+private:
+  // UTF-8 byte order mark skipped at the start of the input
+  static constexpr std::string_view kByteOrderMark{ "\xEF\xBB\xBF" };
+
+  // Move to the start of the input once enough is held to look ahead from it
+  void start()
+  {
+    if (!byteOrderMarkChecked && std::string_view{ buffer }.starts_with(kByteOrderMark)) {
+      buffer.erase(0, kByteOrderMark.size());
+    }
+    byteOrderMarkChecked = true;
+    if (!finished && static_cast<long>(buffer.size()) < kLookAhead) { return; }
+    started = true;
+    setInput(buffer);
+  }
+  // Input runs out where the chunks appended so far end, not when the stream does
+  bool refill() override
+  {
+    if (!finished && started) { XML_LIB_THROW(Incomplete()); }
+    return false;
+  }
+
+  [[noreturn]] void throwError(const std::string_view &message) const override { XML_LIB_THROW(Error(message)); }
+
+  std::string buffer;
+  bool byteOrderMarkChecked{ false };
+  bool started{ false };
+  bool finished{ false };
+};
+}// namespace XML_Lib
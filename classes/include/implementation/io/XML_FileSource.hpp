@@ -1,7 +1,7 @@
 #pragma once
 #include "common/XML_Error.hpp"
 
-#include "ISource.hpp"
+#include "XML_Utf8Source.hpp"
 
 #include <fstream>
 #include <stdexcept>
@@ -10,9 +10,18 @@
 
 namespace XML_Lib {
 
-class FileSource final : public ISource
+// Reads a UTF-8 encoded file a block at a time, decoding it just as the sources that hold
+// all of their input in memory do (XML::parse(path) maps files of MappedFileSource::kMappedFileThreshold
+// bytes or more instead). Only the block being read plus the last kLookBehind bytes before
+// the position are held; getRange() reads anything older back from the file and reset()
+// rereads the file from its start.
+class FileSource final : public Utf8Source
 {
 public:
+  // Bytes read from the file per block
+  static constexpr long kBlockSize{ 64 * 1024 };
+  // Bytes kept behind the position; covers the tokens backed over while parsing
+  static constexpr long kLookBehind{ 64 * 1024 };
   // FileSource Error
 #ifndef XML_LIB_NO_EXCEPTIONS
   XML_LIB_DEFINE_ERROR("FileSource");
@@ -20,12 +29,10 @@ public:
   // Constructors/Destructors
   explicit FileSource(const std::string_view &sourceFileName) : filename(sourceFileName)
   {
-    source.open(sourceFileName.data(), std::ios_base::binary);
+    source.open(filename, std::ios_base::binary);
     if (!source.is_open()) { XML_LIB_THROW(Error("File input stream failed to open or does not exist.")); }
-    if (current_character() == kCarriageReturn) {
-      source.get();
-      if (current_character() != kLineFeed) { source.unget(); }
-    }
+    buffer.reserve(static_cast<std::size_t>(kLookBehind + 2 * kBlockSize + kLookAhead));
+    readStart();
   }
   FileSource() = default;
   FileSource(const FileSource &other) = delete;
@@ -34,54 +41,77 @@ public:
   FileSource &operator=(FileSource &&other) = delete;
   ~FileSource() override = default;
 
-  [[nodiscard]] Char current() const override { return current_character(); }
-  void next() override
+  void reset() override
   {
-    if (!more()) { XML_LIB_THROW(Error("Parse buffer empty before parse complete.")); }
-    source.get();
-    if (current() == kCarriageReturn) {
-      source.get();
-      if (current() != kLineFeed) { source.unget(); }
-    }
-    columnNo++;
-    if (current() == kLineFeed) {
-      lineNo++;
-      columnNo = 1;
+    if (windowBase() > 0) {
+      readStart();
+    } else {
+      Utf8Source::reset();
     }
   }
-  [[nodiscard]] bool more() const override { return source.peek() != EOF; }
-  void backup(const long length) override
+  [[nodiscard]] std::string getRange(const long start, const long end) override
   {
-    if (static_cast<long>(source.tellg()) - length >= 0 || current() == static_cast<Char>(EOF)) {
-      source.clear();
-      source.seekg(-length, std::ios_base::cur);
-    } else {
-      source.seekg(0, std::ios_base::beg);
-    }
+    if (start >= windowBase()) { return Utf8Source::getRange(start, end); }
+    // Read the range (and the byte after it) back from the file, then return to where reading left off
+    source.clear();
+    const auto resume = source.tellg();
+    std::string bytes(static_cast<std::size_t>(end - start + 1), ' ');
+    source.seekg(byteOrderMarkLength + start, std::ios_base::beg);
+    source.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    bytes.resize(static_cast<std::size_t>(source.gcount()));
+    source.clear();
+    source.seekg(resume);
+    return translateLineBreaks(bytes, static_cast<std::size_t>(end - start));
   }
-  [[nodiscard]] long position() const override { return static_cast<long>(source.tellg()); }
-  void reset() override
+  [[nodiscard]] std::string_view contents() const override { return {}; }
+  std::string getFileName() { return filename; }
+  void close() { source.close(); }
+
+private:
+  // UTF-8 byte order mark skipped at the start of the file
+  static constexpr std::string_view kByteOrderMark{ "\xEF\xBB\xBF" };
+
+  // Read the file into an empty window from its start (past any byte order mark)
+  void readStart()
   {
-    lineNo = 1;
-    columnNo = 1;
+    buffer.clear();
     source.clear();
     source.seekg(0, std::ios_base::beg);
+    static_cast<void>(readBlock());
+    byteOrderMarkLength = std::string_view{ buffer }.starts_with(kByteOrderMark) ? static_cast<long>(kByteOrderMark.size()) : 0;
+    buffer.erase(0, static_cast<std::size_t>(byteOrderMarkLength));
+    setInput(buffer);
   }
-  [[nodiscard]] std::string getRange(const long start, const long end) override
+  // Append the next block of the file to the buffer; false if nothing was left to read
+  bool readBlock()
   {
-    std::string rangeBuffer(static_cast<std::size_t>(end) - start, ' ');
-    const long currentPosition = static_cast<long>(source.tellg());
-    source.seekg(start, std::ios_base::beg);
-    source.read(&rangeBuffer[0], static_cast<std::streamsize>(end) - start);
-    source.seekg(currentPosition, std::ios_base::beg);
-    return rangeBuffer;
+    const auto held = buffer.size();
+    buffer.resize(held + static_cast<std::size_t>(kBlockSize));
+    source.read(buffer.data() + held, static_cast<std::streamsize>(kBlockSize));
+    buffer.resize(held + static_cast<std::size_t>(source.gcount()));
+    return source.gcount() > 0;
+  }
+  // Discard what has fallen out of the look-behind window (a block or more at a time) then
+  // read the next block
+  bool refill() override
+  {
+    long dropped = windowPosition() - kLookBehind;
+    if (dropped < kBlockSize) {
+      dropped = 0;
+    } else {
+      dropped = characterBoundary(buffer, dropped);
+      buffer.erase(0, static_cast<std::size_t>(dropped));
+    }
+    const bool read = readBlock();
+    slideInput(buffer, dropped);
+    return read;
   }
-  std::string getFileName() { return filename; }
-  void close() { source.close(); }
 
-private:
-  [[nodiscard]] Char current_character() const { return static_cast<Char>(source.peek()); }
-  mutable std::ifstream source;
+  [[noreturn]] void throwError(const std::string_view &message) const override { XML_LIB_THROW(Error(message)); }
+
+  std::ifstream source;
   std::string filename;
+  std::string buffer;
+  long byteOrderMarkLength = 0;
 };
-}// namespace XML_Lib
\ No newline at end of file
+}// namespace XML_Lib
@@ -0,0 +1,84 @@
+#pragma once
+#include "common/XML_Error.hpp"
+
+#include "XML_Utf8Source.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace XML_Lib {
+
+class MappedFileSource final : public Utf8Source
+{
+public:
+  // Files of at least this many bytes are parsed through a MappedFileSource by XML::parse(path)
+  static constexpr std::uintmax_t kMappedFileThreshold{ 1024 * 1024 };
+  // MappedFileSource Error
+#ifndef XML_LIB_NO_EXCEPTIONS
+  XML_LIB_DEFINE_ERROR("MappedFileSource");
+#endif
+  // Constructors/Destructors
+  explicit MappedFileSource(const std::string_view &sourceFileName) : filename(sourceFileName)
+  {
+    const int fileDescriptor = ::open(filename.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) { XML_LIB_THROW(Error("File input stream failed to open or does not exist.")); }
+    struct stat fileStatus{};
+    if (::fstat(fileDescriptor, &fileStatus) != 0) {
+      ::close(fileDescriptor);
+      XML_LIB_THROW(Error("File size could not be determined."));
+    }
+    if (fileStatus.st_size > 0) {
+      void *address = ::mmap(nullptr, static_cast<std::size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+      ::close(fileDescriptor);
+      if (address == MAP_FAILED) { XML_LIB_THROW(Error("File could not be memory mapped.")); }
+      mapping.bytes = static_cast<const char *>(address);
+      mapping.size = static_cast<std::size_t>(fileStatus.st_size);
+      ::madvise(address, mapping.size, MADV_SEQUENTIAL);
+    } else {
+      ::close(fileDescriptor);
+    }
+    std::string_view bytes{ mapping.bytes, mapping.size };
+    if (bytes.starts_with(kByteOrderMark)) { bytes.remove_prefix(kByteOrderMark.size()); }
+    setInput(bytes);
+  }
+  MappedFileSource() = delete;
+  MappedFileSource(const MappedFileSource &other) = delete;
+  MappedFileSource &operator=(const MappedFileSource &other) = delete;
+  MappedFileSource(MappedFileSource &&other) = delete;
+  MappedFileSource &operator=(MappedFileSource &&other) = delete;
+  ~MappedFileSource() override = default;
+
+  std::string getFileName() { return filename; }
+
+private:
+  // UTF-8 byte order mark skipped at the start of the file
+  static constexpr std::string_view kByteOrderMark{ "\xEF\xBB\xBF" };
+  // Unmaps the file however the source goes out of scope (including a throwing constructor)
+  struct Mapping
+  {
+    Mapping() = default;
+    Mapping(const Mapping &other) = delete;
+    Mapping &operator=(const Mapping &other) = delete;
+    ~Mapping()
+    {
+      if (bytes != nullptr) { ::munmap(const_cast<char *>(bytes), size); }
+    }
+    const char *bytes = nullptr;
+    std::size_t size = 0;
+  };
+
+  [[noreturn]] void throwError(const std::string_view &message) const override { XML_LIB_THROW(Error(message)); }
+
+  std::string filename;
+  Mapping mapping;
+};
+}// namespace XML_Lib
+#endif
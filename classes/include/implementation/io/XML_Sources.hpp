@@ -1,4 +1,7 @@
 #pragma once
 
 #include "XML_BufferSource.hpp"
-#include "XML_FileSource.hpp"
\ No newline at end of file
+#include "XML_FileSource.hpp"
+#include "XML_MappedFileSource.hpp"
+#include "XML_StreamSource.hpp"
+#include "XML_ViewSource.hpp"
\ No newline at end of file
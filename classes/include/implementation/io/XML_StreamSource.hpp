@@ -0,0 +1,88 @@
+#pragma once
+#include "common/XML_Error.hpp"
+
+#include "XML_Utf8Source.hpp"
+
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace XML_Lib {
+
+// Reads UTF-8 encoded input from a stream (stdin, a pipe, a socket) that cannot seek or be
+// mapped. Input is read a block at a time and only a bounded window of it is held: the
+// block being read plus the last lookBehind bytes before the position, which is what
+// backup() and getRange() can reach. Memory use is constant whatever the size of the input.
+class StreamSource final : public Utf8Source
+{
+public:
+  // Bytes read from the stream per block
+  static constexpr long kBlockSize{ 64 * 1024 };
+  // Bytes kept behind the position; covers the tokens backed over and the ranges taken while parsing
+  static constexpr long kLookBehind{ 64 * 1024 };
+  // StreamSource Error
+#ifndef XML_LIB_NO_EXCEPTIONS
+  XML_LIB_DEFINE_ERROR("StreamSource");
+#endif
+  // Constructors/Destructors
+  explicit StreamSource(std::istream &sourceStream, const long blockSize = kBlockSize, const long lookBehind = kLookBehind)
+    : stream(sourceStream), blockSize(blockSize), lookBehind(lookBehind)
+  {
+    if (blockSize < 1 || lookBehind < 0) { XML_LIB_THROW(Error("Invalid block or look-behind size.")); }
+    buffer.reserve(static_cast<std::size_t>(lookBehind + 2 * blockSize + kLookAhead));
+    while (static_cast<long>(buffer.size()) < static_cast<long>(kByteOrderMark.size()) && readBlock()) {}
+    if (std::string_view{ buffer }.starts_with(kByteOrderMark)) { buffer.erase(0, kByteOrderMark.size()); }
+    setInput(buffer);
+  }
+  StreamSource() = delete;
+  StreamSource(const StreamSource &other) = delete;
+  StreamSource &operator=(const StreamSource &other) = delete;
+  StreamSource(StreamSource &&other) = delete;
+  StreamSource &operator=(StreamSource &&other) = delete;
+  ~StreamSource() override = default;
+
+  void reset() override
+  {
+    if (windowBase() > 0) { throwError("Cannot reset once the start of the stream has been discarded."); }
+    Utf8Source::reset();
+  }
+  [[nodiscard]] std::string_view contents() const override { return {}; }
+
+private:
+  // UTF-8 byte order mark skipped at the start of the stream
+  static constexpr std::string_view kByteOrderMark{ "\xEF\xBB\xBF" };
+
+  // Append the next block of the stream to the buffer; false if nothing was left to read
+  bool readBlock()
+  {
+    const auto held = buffer.size();
+    buffer.resize(held + static_cast<std::size_t>(blockSize));
+    stream.read(buffer.data() + held, static_cast<std::streamsize>(blockSize));
+    buffer.resize(held + static_cast<std::size_t>(stream.gcount()));
+    return stream.gcount() > 0;
+  }
+  // Discard what has fallen out of the look-behind window (a block or more at a time, and
+  // never part way through a character or CRLF) then read the next block
+  bool refill() override
+  {
+    long dropped = windowPosition() - lookBehind;
+    if (dropped < blockSize) {
+      dropped = 0;
+    } else {
+      dropped = characterBoundary(buffer, dropped);
+      buffer.erase(0, static_cast<std::size_t>(dropped));
+    }
+    const bool read = readBlock();
+    slideInput(buffer, dropped);
+    return read;
+  }
+
+  [[noreturn]] void throwError(const std::string_view &message) const override { XML_LIB_THROW(Error(message)); }
+
+  std::istream &stream;
+  long blockSize;
+  long lookBehind;
+  std::string buffer;
+};
+}// namespace XML_Lib
@@ -0,0 +1,266 @@
+#pragma once
+#include "common/XML_Error.hpp"
+#include "common/XML_Utf8.hpp"
+
+#include "ISource.hpp"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+namespace XML_Lib {
+
+// Cursor shared by the sources that hold their UTF-8 encoded input in memory as one
+// contiguous view (BufferSource, MappedFileSource, StreamSource). Characters are validated
+// as the position lands on them, a carriage return that precedes a line feed is stepped
+// over and any other carriage return reads as a line feed, so line breaks read as LF
+// (XML 1.0 section 2.11) without the input having to be rewritten.
+//
+// A streaming source holds only a window of its input; refill() is called whenever fewer
+// than kLookAhead bytes remain past the position and the window is moved on with slideInput().
+// Positions are always byte offsets from the start of the input as a whole.
+class Utf8Source : public ISource
+{
+public:
+  Utf8Source(const Utf8Source &other) = delete;
+  Utf8Source &operator=(const Utf8Source &other) = delete;
+  Utf8Source(Utf8Source &&other) = delete;
+  Utf8Source &operator=(Utf8Source &&other) = delete;
+  ~Utf8Source() override = default;
+
+  [[nodiscard]] Char current() const override
+  {
+    if (!more()) { return static_cast<Char>(EOF); }
+    const auto lead = static_cast<unsigned char>(input[static_cast<std::size_t>(inputPosition)]);
+    if (lead < 0x80) { return lead == kCarriageReturn ? kLineFeed : lead; }
+    char32_t codePoint{};
+    static_cast<void>(decodeUtf8(input.substr(static_cast<std::size_t>(inputPosition)), codePoint));
+    if (codePoint < 0x10000) { return static_cast<Char>(codePoint); }
+    return onLowSurrogate ? lowSurrogate(codePoint) : highSurrogate(codePoint);
+  }
+  void next() override
+  {
+    if (!more()) { throwError("Parse buffer empty before parse complete."); }
+    if (const auto length = sequenceLength(inputPosition); length == 4 && !onLowSurrogate) {
+      onLowSurrogate = true;
+    } else {
+      inputPosition += length;
+      onLowSurrogate = false;
+      land();
+    }
+    columnNo++;
+    if (onLineFeed()) {
+      lineNo++;
+      columnNo = 1;
+    }
+  }
+  [[nodiscard]] bool more() const override { return inputPosition < static_cast<long>(input.size()); }
+  void backup(long length) override
+  {
+    while (length-- > 0 && (inputPosition > startPosition || onLowSurrogate)) {
+      if (onLowSurrogate) {
+        onLowSurrogate = false;
+        continue;
+      }
+      inputPosition--;
+      // A carriage return stepped over going forward is stepped over going back too
+      if (inputPosition > startPosition && isLineBreak(inputPosition)) { inputPosition--; }
+      while (inputPosition > 0 && isUtf8Continuation(input[static_cast<std::size_t>(inputPosition)])) { inputPosition--; }
+      onLowSurrogate = sequenceLength(inputPosition) == 4;
+    }
+  }
+  [[nodiscard]] long position() const override { return inputBase + inputPosition; }
+  [[nodiscard]] std::string getRange(long start, long end) override
+  {
+    start -= inputBase;
+    end -= inputBase;
+    if (start < 0 || end > static_cast<long>(input.size())) { throwError("Range is no longer held by the source."); }
+    return translateLineBreaks(input.substr(static_cast<std::size_t>(start)), static_cast<std::size_t>(end - start));
+  }
+  void reset() override
+  {
+    lineNo = 1;
+    columnNo = 1;
+    inputPosition = 0;
+    onLowSurrogate = false;
+    land();
+    startPosition = inputPosition;
+  }
+  // The view ends before the next carriage return, so that skipping it never has to translate line breaks.
+  [[nodiscard]] std::string_view peekUtf8() const override
+  {
+    if (!more() || onLowSurrogate) { return {}; }
+    const auto from = static_cast<std::size_t>(inputPosition);
+    if (from < lineBreakSearchedFrom || from > nextLineBreak) {
+      nextLineBreak = input.find(kCarriageReturn, from);
+      lineBreakSearchedFrom = from;
+    }
+    return input.substr(from, nextLineBreak == std::string_view::npos ? std::string_view::npos : nextLineBreak - from);
+  }
+  // A streaming source holds only a window of its input and overrides this
+  [[nodiscard]] std::string_view contents() const override { return input; }
+  void skipUtf8(const long count) override
+  {
+    if (count > static_cast<long>(input.size()) - inputPosition) { throwError("Parse buffer empty before parse complete."); }
+    if (count <= 0) { return; }
+    const auto skipped = input.substr(static_cast<std::size_t>(inputPosition), static_cast<std::size_t>(count));
+    // Characters landed on are those after the current one, ending with the one skipped onto.
+    // They are counted before moving as landing may refill (and so invalidate) the input, in
+    // one pass that also finds whether any byte is not ASCII (and so must be validated).
+    long lineFeeds = 0;
+    std::size_t lastLineFeed = std::string_view::npos;
+    auto highBits = static_cast<unsigned char>(skipped.front());
+    for (std::size_t index = 1; index < skipped.size(); index++) {
+      const auto byte = static_cast<unsigned char>(skipped[index]);
+      highBits |= byte;
+      if (byte == kLineFeed) {
+        lineFeeds++;
+        lastLineFeed = index;
+      }
+    }
+    long columns = lastLineFeed == std::string_view::npos ? count : count - static_cast<long>(lastLineFeed) + 1;
+    if (highBits >= 0x80) {
+      if (findInvalidUtf8(skipped) != std::string_view::npos) { throwError("Invalid UTF-8 sequence encountered."); }
+      columns =
+        lastLineFeed == std::string_view::npos ? utf16Length(skipped) : 1 + utf16Length(skipped.substr(lastLineFeed));
+    }
+    inputPosition += count;
+    land();
+    if (onLineFeed()) {
+      lineNo += lineFeeds + 1;
+      columnNo = 1;
+    } else if (lineFeeds > 0) {
+      lineNo += lineFeeds;
+      columnNo = columns;
+    } else {
+      columnNo += columns;
+    }
+  }
+  // Backing up over bytes just skipped (none of them a carriage return, which ends the view)
+  // returns to where they started, so that is restored without walking back over them
+  void replayUtf8(const long count) override
+  {
+    const auto from = position();
+    Utf8Source::skipUtf8(count);
+    inputPosition = std::max(from - inputBase, startPosition);
+  }
+
+protected:
+  // Bytes that must be held past the position: the longest UTF-8 sequence or a CRLF
+  static constexpr long kLookAhead{ 4 };
+
+  Utf8Source() = default;
+  // Set the UTF-8 encoded bytes to be read and move to the start of them
+  void setInput(const std::string_view bytes)
+  {
+    input = bytes;
+    inputBase = 0;
+    lineBreakSearchedFrom = std::string_view::npos;
+    reset();
+  }
+  // Replace the input with a window whose first @p dropped bytes have been discarded from
+  // the front of the current one; the position within the input as a whole is unchanged.
+  void slideInput(const std::string_view bytes, const long dropped)
+  {
+    input = bytes;
+    inputBase += dropped;
+    inputPosition -= dropped;
+    startPosition = std::max(0L, startPosition - dropped);
+    lineBreakSearchedFrom = std::string_view::npos;
+  }
+  // Offset of the position within the current window
+  [[nodiscard]] long windowPosition() const { return inputPosition; }
+  // Offset of the current window within the input as a whole
+  [[nodiscard]] long windowBase() const { return inputBase; }
+  // Extend the input (calling slideInput()) and return true, or return false if there is no more
+  [[nodiscard]] virtual bool refill() { return false; }
+  // Report an error using the derived source's error type
+  [[noreturn]] virtual void throwError(const std::string_view &message) const = 0;
+  // Copy the first length bytes with each CRLF and each lone carriage return translated to
+  // LF (the byte after them, if any, decides whether a final carriage return is half of a CRLF)
+  [[nodiscard]] static std::string translateLineBreaks(const std::string_view bytes, const std::size_t length)
+  {
+    const auto range = bytes.substr(0, length);
+    if (range.find(kCarriageReturn) == std::string_view::npos) { return std::string{ range }; }
+    std::string translated;
+    translated.reserve(range.size());
+    for (std::size_t index = 0; index < range.size(); index++) {
+      if (!isLineBreak(bytes, index)) { translated += bytes[index] == kCarriageReturn ? kLineFeed : bytes[index]; }
+    }
+    return translated;
+  }
+  // Move an offset into a window back until it is not part way through a character or CRLF,
+  // so that the bytes before it can be discarded
+  [[nodiscard]] static long characterBoundary(const std::string_view bytes, long offset)
+  {
+    while (offset > 0
+           && (isUtf8Continuation(bytes[static_cast<std::size_t>(offset)])
+               || (bytes[static_cast<std::size_t>(offset)] == kLineFeed
+                   && bytes[static_cast<std::size_t>(offset - 1)] == kCarriageReturn))) {
+      offset--;
+    }
+    return offset;
+  }
+
+  // Position (with its line/column) that the source can later be returned to
+  struct Cursor
+  {
+    long position{ 0 };
+    long lineNo{ 1 };
+    long columnNo{ 1 };
+    bool onLowSurrogate{ false };
+  };
+  [[nodiscard]] Cursor saveCursor() const { return { position(), lineNo, columnNo, onLowSurrogate }; }
+  // The position saved must still be held in the current window
+  void restoreCursor(const Cursor &cursor)
+  {
+    inputPosition = cursor.position - inputBase;
+    onLowSurrogate = cursor.onLowSurrogate;
+    lineNo = cursor.lineNo;
+    columnNo = cursor.columnNo;
+  }
+
+private:
+  // Is index the carriage return of a CRLF pair
+  [[nodiscard]] static bool isLineBreak(const std::string_view bytes, const std::size_t index)
+  {
+    return index + 1 < bytes.size() && bytes[index] == kCarriageReturn && bytes[index + 1] == kLineFeed;
+  }
+  [[nodiscard]] bool isLineBreak(const long offset) const { return isLineBreak(input, static_cast<std::size_t>(offset)); }
+  // Length in bytes of the (validated) UTF-8 sequence at offset
+  [[nodiscard]] long sequenceLength(const long offset) const
+  {
+    const auto lead = static_cast<unsigned char>(input[static_cast<std::size_t>(offset)]);
+    if (lead < 0x80) { return 1; }
+    if ((lead & 0xE0) == 0xC0) { return 2; }
+    if ((lead & 0xF0) == 0xE0) { return 3; }
+    return 4;
+  }
+  // Is the current character a line feed (a carriage return left after land() reads as one)
+  [[nodiscard]] bool onLineFeed() const
+  {
+    if (onLowSurrogate || !more()) { return false; }
+    const char lead = input[static_cast<std::size_t>(inputPosition)];
+    return lead == kLineFeed || lead == kCarriageReturn;
+  }
+  // Step over the carriage return of a CRLF and validate the character arrived at
+  void land()
+  {
+    while (static_cast<long>(input.size()) - inputPosition < kLookAhead && refill()) {}
+    if (isLineBreak(inputPosition)) { inputPosition++; }
+    if (!more() || static_cast<unsigned char>(input[static_cast<std::size_t>(inputPosition)]) < 0x80) { return; }
+    char32_t codePoint{};
+    if (decodeUtf8(input.substr(static_cast<std::size_t>(inputPosition)), codePoint) == 0) {
+      throwError("Invalid UTF-8 sequence encountered.");
+    }
+  }
+
+  std::string_view input;
+  long inputBase = 0;
+  long inputPosition = 0;
+  long startPosition = 0;
+  bool onLowSurrogate = false;
+  mutable std::size_t nextLineBreak = std::string_view::npos;
+  mutable std::size_t lineBreakSearchedFrom = std::string_view::npos;
+};
+}// namespace XML_Lib
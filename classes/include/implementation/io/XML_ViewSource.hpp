@@ -0,0 +1,34 @@
+#pragma once
+#include "common/XML_Error.hpp"
+
+#include "XML_Utf8Source.hpp"
+
+#include <string_view>
+
+namespace XML_Lib {
+
+// Reads UTF-8 encoded input held by the caller (which must outlive it) without copying it;
+// used to parse a part of another source's contents, such as a worker thread's share of a
+// document being parsed in parallel, or a document parsed in situ (ParseOptions::inSitu).
+class ViewSource final : public Utf8Source
+{
+public:
+  // ViewSource Error
+#ifndef XML_LIB_NO_EXCEPTIONS
+  XML_LIB_DEFINE_ERROR("ViewSource");
+#endif
+  // Constructors/Destructors
+  explicit ViewSource(const std::string_view &bytes) { setInput(bytes); }
+  ViewSource() = delete;
+  ViewSource(const ViewSource &other) = delete;
+  ViewSource &operator=(const ViewSource &other) = delete;
+  ViewSource(ViewSource &&other) = delete;
+  ViewSource &operator=(ViewSource &&other) = delete;
+  ~ViewSource() override = default;
+
+  [[nodiscard]] std::string_view inSituContents() const override { return contents(); }
+
+private:
+  [[noreturn]] void throwError(const std::string_view &message) const override { XML_LIB_THROW(Error(message)); }
+};
+}// namespace XML_Lib
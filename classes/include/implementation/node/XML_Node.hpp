@@ -1,6 +1,8 @@
 #pragma once
 
+#include <memory>
 #include <memory_resource>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -17,6 +19,7 @@ struct Node
   };
   // Constructors/Destructors
   Node() = default;
+  // A Node that does not own its variant only destroys it; the memory is freed with its arena
   explicit Node(Variant *variant, bool ownsVariant = true) noexcept
     : xmlVariant(variant), ownsVariant(ownsVariant)
   {}
@@ -31,7 +34,7 @@ struct Node
   Node &operator=(Node &&other) noexcept
   {
     if (this != &other) {
-      if (xmlVariant && ownsVariant) { delete xmlVariant; }
+      destroyVariant();
       xmlVariant = other.xmlVariant;
       ownsVariant = other.ownsVariant;
       other.xmlVariant = nullptr;
@@ -39,24 +42,25 @@ struct Node
     }
     return *this;
   }
-  ~Node()
-  {
-    if (xmlVariant && ownsVariant) { delete xmlVariant; }
-  }
+  ~Node() { destroyVariant(); }
   // Check what Node variant
   [[nodiscard]] bool isEmpty() const { return xmlVariant == nullptr; }
+  // Was the Node variant allocated on the heap (not from an arena)
+  [[nodiscard]] bool isHeapAllocated() const { return xmlVariant != nullptr && ownsVariant; }
   [[nodiscard]] bool isNameable() const { return xmlVariant->isNameable(); }
   [[nodiscard]] bool isIndexable() const { return xmlVariant->isIndexable(); }
   // Return Node contents
-  [[nodiscard]] std::string getContents() const { return xmlVariant->getContents(); }
+  [[nodiscard]] std::string_view getContents() const { return xmlVariant->getContents(); }
   // Node Index overloads
   [[nodiscard]] const Node &operator[](int index) const;
   [[nodiscard]] const Node &operator[](const std::string_view &name) const;
   // Add child
   void addChild(Node &child) const { xmlVariant->addChild(child); }
   void addChild(Node &&child) const { xmlVariant->addChild(child); }
-  // Reserve child storage when the parse context expects multiple children
-  void reserveChildren(size_t count) { xmlVariant->reserveChildren(count); }
+  // Add children, moving them in (child storage is grown once to fit them all)
+  void addChildren(std::span<Node> children) const { xmlVariant->addChildren(children); }
+  // Free any child storage beyond that of the children held
+  void compactChildren() const { xmlVariant->compactChildren(); }
   // Get Node children reference
   [[nodiscard]] std::pmr::vector<Node> &getChildren() { return xmlVariant->getChildren(); }
   [[nodiscard]] const std::pmr::vector<Node> &getChildren() const { return xmlVariant->getChildren(); }
@@ -66,16 +70,33 @@ struct Node
   // Make Node
   template<typename T, typename... Args> static Node make(Args &&...args)
   {
-#if defined(XML_LIB_EMBEDDED)
     if (XML_Arena *arena = XML_Arena::getCurrent()) {
       void *memory = arena->allocate(sizeof(T), alignof(T));
       return Node{ new (memory) T(std::forward<Args>(args)...), false };
     }
-#endif
     return Node{ new T(std::forward<Args>(args)...), true };
   }
+  // Let go of a variant allocated from an arena without destroying it or its children, which
+  // the arena's release then frees whole (they must own no memory from elsewhere); a variant
+  // allocated on the heap is destroyed as usual
+  void releaseToArena() noexcept
+  {
+    if (ownsVariant) { destroyVariant(); }
+    xmlVariant = nullptr;
+    ownsVariant = false;
+  }
 
 private:
+  // Destroy Node variant, deleting it unless it was allocated from an arena
+  void destroyVariant() noexcept
+  {
+    if (xmlVariant == nullptr) { return; }
+    if (ownsVariant) {
+      delete xmlVariant;
+    } else {
+      std::destroy_at(xmlVariant);
+    }
+  }
   // Node Variant
   Variant *xmlVariant = nullptr;
   bool ownsVariant = true;
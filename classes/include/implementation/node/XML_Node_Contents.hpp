@@ -5,15 +5,17 @@ namespace XML_Lib {
 // ==========================
 // Get XML content from Node
 // ==========================
-[[nodiscard]] inline std::string EntityReference::getContents() const
+[[nodiscard]] inline std::string_view EntityReference::getContents() const
 {
-  if (std::string result; !getChildren().empty()) {
-    for (const auto &child : getChildren()) { result += child.getContents(); }
-    return result;
+  if (getChildren().empty()) { return entityReferenceValue.getParsed(); }
+  if (const auto currentChildCount = getChildren().size(); currentChildCount != contentCacheChildCount) {
+    contentCache.clear();
+    for (const auto &child : getChildren()) { contentCache += child.getContents(); }
+    contentCacheChildCount = currentChildCount;
   }
-  return entityReferenceValue.getParsed();
+  return contentCache;
 }
-[[nodiscard]] inline std::string Element::getContents() const
+[[nodiscard]] inline std::string_view Element::getContents() const
 {
   // name() and child text are already UTF-8 — no re-encoding occurs.
   // Cache the concatenated result and revalidate only when the child count changes.
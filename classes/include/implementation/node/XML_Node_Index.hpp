@@ -20,8 +20,12 @@ inline const Node &Node::operator[](const int index) const
 inline const Node &Node::operator[](const std::string_view &name) const
 {
   if (isIndexable()) {
+    XML_NameTable::Matcher matcher{ name };
     if (const auto xNode = std::find_if(getChildren().begin(), getChildren().end(),
-          [&name](const Node &child) { return child.isNameable() && NRef<Element>(child).name() == name; });
+          [&matcher](const Node &child) {
+            return child.isNameable()
+                   && matcher.matches(NRef<Element>(child).getNameTable(), NRef<Element>(child).getNameSymbol());
+          });
         xNode != getChildren().end()) {
       return *xNode;
     }
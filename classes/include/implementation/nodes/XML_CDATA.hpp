@@ -5,14 +5,14 @@ namespace XML_Lib {
 struct CDATA final : Variant
 {
   // Constructors/Destructors
-  explicit CDATA(const std::string_view &cdata) : Variant(Type::cdata), cdata(cdata) {}
+  explicit CDATA(const std::string_view &cdata) : Variant(Type::cdata), cdata(cdata, memoryResource()) {}
   XML_LIB_NO_COPY_MOVE_DTOR(CDATA);
   // Return reference to cdata
   [[nodiscard]] std::string_view value() const { return cdata; }
   // Return Variant contents
-  [[nodiscard]] std::string getContents() const override { return cdata; }
-  
+  [[nodiscard]] std::string_view getContents() const override { return cdata; }
+
 private:
-  std::string cdata;
+  std::pmr::string cdata;
 };
 }// namespace XML_Lib
\ No newline at end of file
@@ -5,12 +5,12 @@ namespace XML_Lib {
 struct Comment final : Variant
 {
   // Constructors/Destructors
-  explicit Comment(const std::string_view &comment = "") : Variant(Type::comment), xmlComment(comment) {}
+  explicit Comment(const std::string_view &comment = "") : Variant(Type::comment), xmlComment(comment, memoryResource()) {}
   XML_LIB_NO_COPY_MOVE_DTOR(Comment);
   // Return reference to comment
-  [[nodiscard]] const std::string &value() const { return xmlComment; }
+  [[nodiscard]] std::string_view value() const { return xmlComment; }
 
 private:
-  std::string xmlComment;
+  std::pmr::string xmlComment;
 };
 }// namespace XML_Lib
\ No newline at end of file
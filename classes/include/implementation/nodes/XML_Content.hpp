@@ -5,21 +5,38 @@ namespace XML_Lib {
 struct Content final : Variant
 {
   // Constructors/Destructors
-  explicit Content(const std::string_view &content, const bool whiteSpaceDefault = true) : Variant(Type::content), xmlContent(content), whiteSpace(whiteSpaceDefault) {}
+  explicit Content(const std::string_view &content, const bool whiteSpaceDefault = true) : Variant(Type::content), xmlContent(content, memoryResource()), whiteSpace(whiteSpaceDefault) {}
   XML_LIB_NO_COPY_MOVE_DTOR(Content);
   // Get reference to content string
-  [[nodiscard]] std::string value() const { return xmlContent; }
+  [[nodiscard]] std::string_view value() const { return text(); }
   // Add to content
-  void addContent(const std::string_view &content) { xmlContent += content; }
+  void addContent(const std::string_view &content)
+  {
+    if (inSituContent.data() != nullptr) { xmlContent.assign(std::exchange(inSituContent, {})); }
+    xmlContent += content;
+  }
+  // Set content to characters left in situ, held by the caller (they must outlive the node);
+  // they are only copied if more content is added
+  void setInSituContent(const std::string_view &content)
+  {
+    xmlContent.clear();
+    inSituContent = content;
+  }
   // Is content all whitespace
   [[nodiscard]] bool isWhiteSpace() const { return whiteSpace; }
   // Set whitespace boolean
   void setIsWhiteSpace(const bool isWhiteSpace) { whiteSpace = isWhiteSpace; }
   // Return Variant contents
-  [[nodiscard]]  std::string getContents() const override { return xmlContent; }
+  [[nodiscard]] std::string_view getContents() const override { return text(); }
 
 private:
-  std::string xmlContent;
+  // Content characters, wherever they are held
+  [[nodiscard]] std::string_view text() const
+  {
+    return inSituContent.data() != nullptr ? inSituContent : std::string_view{ xmlContent };
+  }
+  std::pmr::string xmlContent;
+  std::string_view inSituContent;
   bool whiteSpace;
 };
 }// namespace XML_Lib
\ No newline at end of file
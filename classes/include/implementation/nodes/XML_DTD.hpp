@@ -75,33 +75,40 @@ struct DTD final : Variant
   DTD(DTD &&other) = default;
   DTD &operator=(DTD &&other) = delete;
   ~DTD() override = default;
-  [[nodiscard]] std::string unparsed() const { return unparsedDTD; }
+  [[nodiscard]] std::string_view unparsed() const { return unparsedDTD; }
   void setUnparsed(const std::string_view &unparsed) { unparsedDTD = unparsed; }
   [[nodiscard]] uint16_t getType() const { return dtdNodeType; }
   void setType(const uint16_t type) { dtdNodeType = type; }
-  [[nodiscard]] std::string getRootName() const { return dtdNodeName; }
+  [[nodiscard]] std::string_view getRootName() const { return dtdNodeName; }
   void setRootName(const std::string_view &name) { dtdNodeName = name; }
-  [[nodiscard]] XMLExternalReference getExternalReference() const { return externalReference; }
+  [[nodiscard]] const XMLExternalReference &getExternalReference() const { return externalReference; }
   void setExternalReference(const XMLExternalReference &reference) { externalReference = reference; }
   [[nodiscard]] bool isElementPresent(const std::string_view &elementName) const
   {
-    return elements.contains(std::string(elementName));
+    return elements.contains(nameTable->find(elementName));
   }
   [[nodiscard]] Element &getElement(const std::string_view &elementName)
   {
-    if (const auto element = elements.find(std::string(elementName)); element != elements.end()) {
+    if (const auto element = elements.find(nameTable->find(elementName)); element != elements.end()) {
       return element->second;
     }
     XML_LIB_THROW(Error("Could not find notation name."));
   }
+  // Return the definition of a document element (found by its name's symbol when in the same table)
+  [[nodiscard]] Element &getElement(const XML_Lib::Element &element)
+  {
+    const auto symbol = &element.getNameTable() == nameTable ? element.getNameSymbol() : nameTable->find(element.name());
+    if (const auto definition = elements.find(symbol); definition != elements.end()) { return definition->second; }
+    XML_LIB_THROW(Error("Could not find notation name."));
+  }
   void addElement(const std::string_view &elementName, const Element &element)
   {
-    elements.emplace(elementName, element);
+    elements.emplace(nameTable->intern(elementName), element);
   }
   [[nodiscard]] std::size_t getElementCount() const { return elements.size(); }
   [[nodiscard]] XMLExternalReference &getNotation(const std::string_view &notationName)
   {
-    if (const auto notation = notations.find(std::string(notationName)); notation != notations.end()) {
+    if (const auto notation = notations.find(notationName); notation != notations.end()) {
       return notation->second;
     }
     XML_LIB_THROW(Error("Could not find notation name."));
@@ -112,7 +119,7 @@ struct DTD final : Variant
   }
   [[nodiscard]] std::size_t getNotationCount(const std::string_view &notationName) const
   {
-    return notations.count(std::string(notationName));
+    return notations.count(notationName);
   }
   [[nodiscard]] std::size_t getLineCount() const { return lineCount; }
   void setLineCount(const std::size_t newLineCount) { lineCount = newLineCount; }
@@ -121,12 +128,25 @@ struct DTD final : Variant
 
 
 private:
+  // Transparent hash/equality functors so that notations are found by std::string_view
+  struct NotationHash
+  {
+    using is_transparent = void;
+    [[nodiscard]] size_t operator()(const std::string_view &sv) const noexcept { return std::hash<std::string_view>{}(sv); }
+  };
+  struct NotationEq
+  {
+    using is_transparent = void;
+    [[nodiscard]] bool operator()(const std::string_view &lhs, const std::string_view &rhs) const noexcept { return lhs == rhs; }
+  };
   uint16_t dtdNodeType{};
   std::size_t lineCount{};
   std::string dtdNodeName;
   XMLExternalReference externalReference{ "" };
-  std::unordered_map<std::string, Element> elements;
-  std::unordered_map<std::string, XMLExternalReference> notations;
+  // Element definitions keyed by the symbol of their name in the document's name table
+  XML_NameTable *nameTable{ &XML_NameTable::getCurrent() };
+  std::unordered_map<XML_NameTable::Symbol, Element> elements;
+  std::unordered_map<std::string, XMLExternalReference, NotationHash, NotationEq> notations;
   std::string unparsedDTD;
   IEntityMapper &entityMapper;
 };
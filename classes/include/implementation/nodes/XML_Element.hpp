@@ -3,6 +3,7 @@
 #include <limits>
 #include <memory_resource>
 #include <span>
+#include <vector>
 
 namespace XML_Lib {
 
@@ -10,24 +11,28 @@ struct Element : Variant
 {
   // Constructors/Destructors
   explicit Element(const std::string_view &name = "", const Type nodeType = Type::element)
-    : Variant(nodeType), elementName(name),
-      attributes(memoryResource()), namespaces(memoryResource())
+    : Variant(nodeType), nameTable(&XML_NameTable::getCurrent()), nameSymbol(nameTable->intern(name)),
+      attributes(memoryResource()), contentCache(memoryResource())
   {}
+  // Element in an outer namespace scope (the scope of the element it is nested in)
   Element(const std::string_view &name,
     std::span<const XMLAttribute> attributes,
-    std::span<const XMLAttribute> namespaces,
+    const XMLNameSpaceScope::Pointer &outerNameSpaces,
     const Type nodeType = Type::element)
-    : Variant(nodeType), elementName(name),
+    : Variant(nodeType), nameTable(&XML_NameTable::getCurrent()), nameSymbol(nameTable->intern(name)),
       attributes(attributes.begin(), attributes.end(), memoryResource()),
-      namespaces(namespaces.begin(), namespaces.end(), memoryResource())
+      nameSpaces(XMLNameSpaceScope::declare(outerNameSpaces, attributes, memoryResource())),
+      contentCache(memoryResource())
   {
-    for (const auto &attribute : attributes) {
-      if (attribute.getName().starts_with("xmlns")) {
-        this->namespaces.emplace_back(attribute.getName().size() > 5 ? attribute.getName().substr(6) : ":",
-          XMLValue{ attribute.getUnparsed(), attribute.getParsed() });
-      }
-    }
+    resolveNameSpaces();
   }
+  // Element with outer namespaces given as a list (keyed by prefix)
+  Element(const std::string_view &name,
+    std::span<const XMLAttribute> attributes,
+    std::span<const XMLAttribute> outerNameSpaces,
+    const Type nodeType = Type::element)
+    : Element(name, attributes, XMLNameSpaceScope::add(nullptr, outerNameSpaces, XML_Arena::getCurrentResource()), nodeType)
+  {}
   XML_LIB_NO_COPY_MOVE_DTOR(Element);
   // Is an attribute present?
   [[nodiscard]] bool hasAttribute(const std::string_view &attributeName) const
@@ -35,62 +40,90 @@ struct Element : Variant
     return XMLAttribute::contains(attributes, attributeName);
   }
   // Add an attribute
-  void addAttribute(const std::string_view &name, const XMLValue &value) const { attributes.emplace_back(name, value); }
+  void addAttribute(const std::string_view &name, const XMLValue &value) const
+  {
+    resolveNameSpace(attributes.emplace_back(name, value));
+  }
   // Return reference to an attribute list
   [[nodiscard]] const std::pmr::vector<XMLAttribute> &getAttributes() const { return attributes; }
   // Is namespace present?
   [[nodiscard]] bool hasNameSpace(const std::string_view &name) const
   {
-    return XMLAttribute::contains(namespaces, name);
+    return XMLNameSpaceScope::find(nameSpaces.get(), name) != nullptr;
   }
   // Add a namespace
   void addNameSpace(const std::string_view &name, const XMLValue &value) const
   {
-    namespaces.emplace_back(name, value);
+    const XMLAttribute nameSpace{ name, value };
+    nameSpaces = XMLNameSpaceScope::add(nameSpaces, std::span(&nameSpace, 1), memoryResource());
     addAttribute(name, value);
+    resolveNameSpaces();
   }
   [[nodiscard]] const XMLAttribute &getNameSpace(const std::string_view &name) const
   {
-    return XMLAttribute::find(namespaces, name);
-  }
-  // Return reference to a namespace list
-  [[nodiscard]] const std::pmr::vector<XMLAttribute> &getNameSpaces() const { return namespaces; }
-  // Return reference to the element tag name
-  [[nodiscard]] const std::string &name() const { return elementName; }
-  // QName support: get namespace prefix (empty string if no prefix)
-  [[nodiscard]] std::string getPrefix() const
-  {
-    const auto pos = elementName.find(':');
-    return pos != std::string::npos ? elementName.substr(0, pos) : "";
+    const auto *nameSpace = XMLNameSpaceScope::find(nameSpaces.get(), name);
+    if (nameSpace == nullptr) { XML_LIB_THROW(XMLAttribute::Error("Attribute '" + std::string(name) + "' does not exist.")); }
+    return *nameSpace;
   }
-  // QName support: get local name (without prefix)
-  [[nodiscard]] std::string getLocalName() const
+  // Return a view of the namespaces in scope, outermost declaration first (walked in place,
+  // valid while the element's scope is unchanged), or copies of them
+  [[nodiscard]] XMLNameSpaceScope::Declarations getNameSpaces() const
   {
-    const auto pos = elementName.find(':');
-    return pos != std::string::npos ? elementName.substr(pos + 1) : elementName;
+    return XMLNameSpaceScope::Declarations{ nameSpaces.get() };
   }
-  // QName support: get namespace URI for this element (based on prefix and in-scope namespaces)
-  [[nodiscard]] std::string getNamespaceURI() const
+  [[nodiscard]] std::vector<XMLAttribute> collectNameSpaces() const { return XMLNameSpaceScope::collect(nameSpaces.get()); }
+  // Return the namespace scope of the element (nullptr if no namespaces are in scope)
+  [[nodiscard]] const XMLNameSpaceScope::Pointer &getNameSpaceScope() const { return nameSpaces; }
+  // Return reference to the element tag name
+  [[nodiscard]] std::string_view name() const { return nameTable->name(nameSymbol); }
+  // Return the name table of the element tag name and its symbol there
+  [[nodiscard]] XML_NameTable &getNameTable() const { return *nameTable; }
+  [[nodiscard]] XML_NameTable::Symbol getNameSymbol() const { return nameSymbol; }
+  // QName support: get namespace prefix (empty if no prefix) and local name (without prefix)
+  [[nodiscard]] std::string_view getPrefix() const { return nameTable->prefix(nameSymbol); }
+  [[nodiscard]] std::string_view getLocalName() const { return nameTable->localName(nameSymbol); }
+  // QName support: get namespace URI for this element (empty if none) and its symbol in the name
+  // table (kNoSymbol if none); both are resolved from the prefix when the element is made
+  [[nodiscard]] std::string_view getNamespaceURI() const
   {
-    const auto prefix = getPrefix();
-    const auto nsKey = prefix.empty() ? ":" : prefix;
-    if (hasNameSpace(nsKey)) { return getNameSpace(nsKey).getParsed(); }
-    return "";
+    return nameSpaceSymbol != XML_NameTable::kNoSymbol ? nameTable->name(nameSpaceSymbol) : std::string_view{};
   }
+  [[nodiscard]] XML_NameTable::Symbol getNameSpaceSymbol() const { return nameSpaceSymbol; }
   // XElement Index overloads
   [[nodiscard]] const Element &operator[](int index) const;
   [[nodiscard]] Element &operator[](int index);
   [[nodiscard]] const XMLAttribute &operator[](const std::string_view &name) const;
   [[nodiscard]] XMLAttribute &operator[](const std::string_view &name);
   // Return Variant contents
-  [[nodiscard]] std::string getContents() const override;
+  [[nodiscard]] std::string_view getContents() const override;
 
 private:
-  std::string elementName;
+  // Resolve the namespace URIs of the element and of its prefixed attributes (an unprefixed
+  // attribute is in no namespace) from the namespaces in scope
+  void resolveNameSpaces() const
+  {
+    const auto *declaration = XMLNameSpaceScope::find(nameSpaces.get(), getPrefix().empty() ? ":" : getPrefix());
+    nameSpaceSymbol = XML_NameTable::kNoSymbol;
+    if (declaration != nullptr) { nameSpaceSymbol = declaration->nameSpaceIn(*nameTable); }
+    for (auto &attribute : attributes) { resolveNameSpace(attribute); }
+  }
+  void resolveNameSpace(XMLAttribute &attribute) const
+  {
+    if (const auto prefix = attribute.getPrefix(); !prefix.empty() && prefix != "xmlns") {
+      if (const auto *declaration = XMLNameSpaceScope::find(nameSpaces.get(), prefix)) {
+        attribute.setNamespaceURI(declaration->getNamespaceURI());
+      }
+    }
+  }
+  // Element tag name (symbol in name table) and namespace URI (kNoSymbol if none)
+  XML_NameTable *nameTable;
+  XML_NameTable::Symbol nameSymbol;
+  mutable XML_NameTable::Symbol nameSpaceSymbol{ XML_NameTable::kNoSymbol };
   mutable std::pmr::vector<XMLAttribute> attributes;
-  mutable std::pmr::vector<XMLAttribute> namespaces;
+  // Namespaces in scope (shared with the elements nested in it that declare none of their own)
+  mutable XMLNameSpaceScope::Pointer nameSpaces;
   // Lazy content cache — invalidated when the child count changes.
-  mutable std::string contentCache;
+  mutable std::pmr::string contentCache;
   mutable std::size_t contentCacheChildCount{ std::numeric_limits<std::size_t>::max() };
 };
 }// namespace XML_Lib
\ No newline at end of file
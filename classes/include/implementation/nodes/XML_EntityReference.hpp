@@ -5,14 +5,19 @@ namespace XML_Lib {
 struct EntityReference final : Variant
 {
   // Constructors/Destructors
-  explicit EntityReference(XMLValue value) : Variant(Type::entity), entityReferenceValue(std::move(value)) {}
+  explicit EntityReference(XMLValue value)
+    : Variant(Type::entity), entityReferenceValue(std::move(value), memoryResource()), contentCache(memoryResource())
+  {}
   XML_LIB_NO_COPY_MOVE_DTOR(EntityReference);
   // Return reference to entity reference
   [[nodiscard]] const XMLValue &value() const { return entityReferenceValue; }
   // Return Variant contents
-  [[nodiscard]] std::string getContents() const override;
+  [[nodiscard]] std::string_view getContents() const override;
 
 private:
   XMLValue entityReferenceValue;
+  // Contents of the children (the replacement of an entity) concatenated, rebuilt when their count changes
+  mutable std::pmr::string contentCache;
+  mutable std::size_t contentCacheChildCount{ 0 };
 };
 }// namespace XML_Lib
\ No newline at end of file
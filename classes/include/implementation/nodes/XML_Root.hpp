@@ -10,8 +10,13 @@ struct Root final : Element
   explicit Root(const std::string_view &name="") : Element(name ,Type::root) {}
   Root(const std::string_view &name,
     std::span<const XMLAttribute> attributes,
-    std::span<const XMLAttribute> namespaces)
-    : Element(name, attributes, namespaces, Type::root)
+    const XMLNameSpaceScope::Pointer &outerNameSpaces)
+    : Element(name, attributes, outerNameSpaces, Type::root)
+  {}
+  Root(const std::string_view &name,
+    std::span<const XMLAttribute> attributes,
+    std::span<const XMLAttribute> outerNameSpaces)
+    : Element(name, attributes, outerNameSpaces, Type::root)
   {}
   XML_LIB_NO_COPY_MOVE_DTOR(Root);
 };
@@ -10,8 +10,13 @@ struct Self final : Element
   explicit Self(const std::string_view &name="") : Element(name,Type::self) {}
   Self(const std::string_view &name,
     std::span<const XMLAttribute> attributes,
-    std::span<const XMLAttribute> namespaces)
-    : Element(name, attributes, namespaces, Type::self)
+    const XMLNameSpaceScope::Pointer &outerNameSpaces)
+    : Element(name, attributes, outerNameSpaces, Type::self)
+  {}
+  Self(const std::string_view &name,
+    std::span<const XMLAttribute> attributes,
+    std::span<const XMLAttribute> outerNameSpaces)
+    : Element(name, attributes, outerNameSpaces, Type::self)
   {}
   XML_LIB_NO_COPY_MOVE_DTOR(Self);
 };
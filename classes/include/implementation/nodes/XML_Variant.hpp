@@ -10,6 +10,9 @@
   ~TypeName() override = default
 
 #include <memory_resource>
+#include <span>
+
+#include "common/XML_Arena.hpp"
 
 namespace XML_Lib {
 
@@ -21,12 +24,18 @@ struct Variant
   enum class Type { base = 0, prolog, declaration, root, self, element, content, entity, comment, cdata, pi, dtd };
 
   // Constructors/Destructors
-  explicit Variant(Type nodeType = Type::base, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+  explicit Variant(Type nodeType = Type::base, std::pmr::memory_resource *resource = XML_Arena::getCurrentResource());
   Variant(const Variant &other) = delete;
   Variant &operator=(const Variant &other) = delete;
-  Variant(Variant &&other) = default;
-  Variant &operator=(Variant &&other) = default;
-  virtual ~Variant() = default;
+  // The children of a variant moved to have not yet been handed out to be changed
+  Variant(Variant &&other) noexcept : xmlNodeType(other.xmlNodeType), children(std::move(other.children)) {}
+  Variant &operator=(Variant &&other)
+  {
+    xmlNodeType = other.xmlNodeType;
+    children = std::move(other.children);
+    return *this;
+  }
+  virtual ~Variant();
   // Check what Node variant
   [[nodiscard]] bool isNameable() const { return xmlNodeType >= Type::root && xmlNodeType <= Type::element; }
   [[nodiscard]] bool isIndexable() const { return xmlNodeType > Type::base && xmlNodeType <= Type::element; }
@@ -34,16 +43,18 @@ struct Variant
   [[nodiscard]] Type getNodeType() const {
     return xmlNodeType;
   }
-  // Get Node children reference
+  // Get Node children reference (to be changed, so noted with any arena the Variant is in)
   [[nodiscard]] std::pmr::vector<Node> &getChildren();
   [[nodiscard]] const std::pmr::vector<Node> &getChildren() const;
-  // Reserve child storage when parse context predicts children
-  void reserveChildren(size_t count);
   // Add child
   void addChild(Node &child) const;
   void addChild(Node &&child) const;
-  // Return Variant contents
-  [[nodiscard]] virtual std::string getContents() const { return ""; }
+  // Add children, moving them in with their storage grown once to fit them all
+  void addChildren(std::span<Node> newChildren) const;
+  // Free any child storage beyond that of the children held
+  void compactChildren() const;
+  // Return Variant contents (valid until the Node is changed)
+  [[nodiscard]] virtual std::string_view getContents() const { return {}; }
 
 protected:
   // Return the memory resource used by this Variant's children storage.
@@ -55,6 +66,8 @@ private:
   Type xmlNodeType{ Type::base };
   // Node children container (inline to improve locality)
   mutable std::pmr::vector<Node> children;
+  // Have the children been handed out to be changed
+  bool childrenExposed{ false };
 };
 
 }// namespace XML_Lib
\ No newline at end of file
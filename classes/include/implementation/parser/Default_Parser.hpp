@@ -2,6 +2,7 @@
 
 #include "XML.hpp"
 #include "XML_Core.hpp"
+#include <memory_resource>
 #include <span>
 
 namespace XML_Lib {
@@ -18,49 +19,90 @@ public:
   ~Default_Parser() override = default;
 
   [[nodiscard]] Node parse(ISource &source, const ParseOptions &options) override;
+  [[nodiscard]] Node parse(ISource &source, const ParseOptions &options, const XML_AllocationContext &context) override;
+  void parse(ISource &source, IParseHandler &handler, const ParseOptions &options) override;
   [[nodiscard]] bool canValidate() override;
   void validate(Node &xProlog) override;
 
+  // Element whose start tag has been parsed; what is needed to parse its end
+  struct ElementTag
+  {
+    std::string name;
+    std::size_t outerNameSpaces{ 0 };
+    bool isSelfClosing{ false };
+    std::string nameSpaceError;
+  };
+  // Grammar steps, used by XMLReader to parse a document an item at a time
+  void beginDocument(const ParseOptions &options);
+  void setInSituInput(const std::string_view input) { inSituInput = input; }
+  static void parseDeclaration(ISource &source, IParseHandler &handler);
+  [[nodiscard]] bool parsePrologItem(ISource &source, IParseHandler &handler);
+  static void parseRootStart(ISource &source);
+  [[nodiscard]] ElementTag parseStartTag(ISource &source, IParseHandler &handler);
+  [[nodiscard]] ElementTag
+    parseStartTag(ISource &source, IParseHandler &handler, std::pmr::vector<XMLAttribute> &attributes);
+  [[nodiscard]] bool parseContentItem(ISource &source, IParseHandler &handler);
+  void skipElementContent(ISource &source, IParseHandler &handler);
+  static void scanElementContent(ISource &source);
+  void parseEndTag(ISource &source, IParseHandler &handler, const ElementTag &tag);
+  static void parseEpilogItem(ISource &source, IParseHandler &handler);
+  // Parser state changed by parsing an item, saved so that an item cut short can be abandoned
+  struct ItemState
+  {
+    std::size_t nameSpaceCount{ 0 };
+    std::size_t elementNestingDepth{ 0 };
+    bool hasValidator{ false };
+  };
+  [[nodiscard]] ItemState saveItemState() const;
+  void restoreItemState(const ItemState &state);
+
 private:
   // XML Parser
-  static void parseEntityReferenceXML(Node &xNode, const XMLValue &entityReference, IEntityMapper & entityMapper);
+  void parseDocument(ISource &source, IParseHandler &handler, const ParseOptions &options);
+  void parseEntityReferenceXML(IParseHandler &handler, const XMLValue &entityReference);
   [[nodiscard]] static std::string
     parseDeclarationAttribute(ISource &source, const std::string_view &name, std::span<const std::string_view> values);
-  [[nodiscard]] static bool tryParseCommentOrPI(ISource &source, Node &xNode);
-  [[nodiscard]] static bool parseCommentsPIAndWhiteSpace(ISource &source, Node &xProlog);
-  static void  parseContent(ISource &source, Node &xNode, IEntityMapper &entityMapper);
-  static void appendEntityOrContent(Node &xNode, const XMLValue &value, IEntityMapper &entityMapper);
+  [[nodiscard]] static bool tryParseCommentOrPI(ISource &source, IParseHandler &handler);
+  [[nodiscard]] static bool parseCommentsPIAndWhiteSpace(ISource &source, IParseHandler &handler);
+  void parseContent(ISource &source, IParseHandler &handler);
+  void reportEntityOrContent(IParseHandler &handler, const XMLValue &value);
   [[nodiscard]] static std::string parseTagName(ISource &source);
-  [[nodiscard]] static std::vector<XMLAttribute> parseAttributes(ISource &source, IEntityMapper &entityMapper);
-  [[nodiscard]] static Node parseComment(ISource &source);
-  [[nodiscard]] static Node parseCDATA(ISource &source);
-  [[nodiscard]] static Node parsePI(ISource &source);
-  static void parseWhiteSpaceToContent(ISource &source, Node &xNode);
-  static void parseElementInternal(ISource &source, Node &xNode, IEntityMapper &entityMapper);
-  [[nodiscard]] static Node parseElement(ISource &source, std::span<const XMLAttribute> namespaces, IEntityMapper & entityMapper);
-  [[nodiscard]] static Node parseDeclaration(ISource &source);
-  [[nodiscard]] static Node parseDTD(ISource &source, IEntityMapper &entityMapper);
-  [[nodiscard]] static Node parseProlog(ISource &source, IEntityMapper &entityMapper);
-  static void parseEpilog(ISource &source, Node &xProlog);
-  // XML tree has root
-  inline static bool hasRoot{ false };
+  void parseAttributes(ISource &source, std::pmr::vector<XMLAttribute> &attributes);
+  [[nodiscard]] bool
+    parsePlainAttribute(ISource &source, const std::string_view &name, std::pmr::vector<XMLAttribute> &attributes) const;
+  [[nodiscard]] std::string findUndefinedNameSpace(const std::string_view &name, std::span<const XMLAttribute> attributes) const;
+  static void parseComment(ISource &source, IParseHandler &handler);
+  static void parseCDATA(ISource &source, IParseHandler &handler);
+  static void parsePI(ISource &source, IParseHandler &handler);
+  static void parseWhiteSpaceToContent(ISource &source, IParseHandler &handler);
+  void parseElementInternal(ISource &source, IParseHandler &handler);
+  // Markup found at the start of an item of element content, in the order it is looked for
+  enum class ContentMarkup : std::size_t { endTag, comment, pi, cdata, startTag, cdataEnd, none };
+  [[nodiscard]] static ContentMarkup matchContentMarkup(ISource &source, bool endTagAllowed);
+  [[nodiscard]] bool parseContentItem(ISource &source, IParseHandler &handler, ContentMarkup markup);
+  void parseElement(ISource &source, IParseHandler &handler);
+  void parseDTD(ISource &source, IParseHandler &handler);
+  void parseProlog(ISource &source, IParseHandler &handler);
+  static void parseEpilog(ISource &source, IParseHandler &handler);
+  // Parallel parse of the children of the root element (Default_Parser_Parallel.cpp)
+  struct ParallelShare;
+  [[nodiscard]] bool parseInParallel(ISource &source, XML_TreeBuilder &treeBuilder, const ParseOptions &options);
+  static void parseShare(std::string_view contents, const ParseOptions &options, ParallelShare &share);
+  // Namespaces in scope for the element being parsed (declared by it and the elements it is nested in)
+  std::vector<XMLAttribute> nameSpaces;
+  // Caller's input that attribute values may be left in situ in (empty unless parsing in situ)
+  std::string_view inSituInput;
   // Parser validator
-  inline static std::unique_ptr<IValidator> validator;
-  // Current entity expansion depth (reset at the start of each parse)
-  inline static std::size_t entityExpansionDepth{ 0 };
-  // Maximum allowed expansion depth (copied from ParseOptions at parse start)
-  inline static std::size_t maxEntityExpansionDepth{ 512 };
-  // Current element nesting depth (reset at the start of each parse)
-  inline static std::size_t elementNestingDepth{ 0 };
-  // Maximum allowed nesting depth (copied from ParseOptions at parse start)
-  inline static std::size_t maxElementNestingDepth{ 1000 };
-  // Maximum allowed attribute count per element (copied from ParseOptions at parse start)
-  inline static std::size_t maxAttributeCount{ 10000 };
+  std::unique_ptr<IValidator> validator;
+  // Current entity expansion and element nesting depths (reset at the start of each parse; their
+  // limits are those of parseOptions)
+  std::size_t entityExpansionDepth{ 0 };
+  std::size_t elementNestingDepth{ 0 };
+  // Where the nodes of the tree being built are allocated (set by parse(); none when only reporting)
+  XML_AllocationContext allocationContext;
   // Entity mapper reference
   IEntityMapper &entityMapper;
   // Parse options (set at the start of each parse() call)
   ParseOptions parseOptions{};
-  // Embedded node arena
-  XML_Arena arena;
 };
 }// namespace XML_Lib
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "XMLTape_Impl.hpp"
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace XML_Lib {
+
+// Parse handler that builds the tape of a document from the parser's events.
+class XML_TapeBuilder final : public IParseHandler
+{
+public:
+  // Constructors/Destructors
+  explicit XML_TapeBuilder(XMLTape_Impl &tape);
+  XML_TapeBuilder(const XML_TapeBuilder &other) = delete;
+  XML_TapeBuilder &operator=(const XML_TapeBuilder &other) = delete;
+  XML_TapeBuilder(XML_TapeBuilder &&other) = delete;
+  XML_TapeBuilder &operator=(XML_TapeBuilder &&other) = delete;
+  ~XML_TapeBuilder() override = default;
+
+  void onDeclaration(std::string_view version, std::string_view encoding, std::string_view standalone) override;
+  void onStartElement(std::string_view name, std::span<const XMLAttribute> attributes, bool isSelfClosing) override;
+  void onEndElement(std::string_view name) override;
+  void onCharacters(std::string_view characters, bool isWhiteSpace) override;
+  void onCDATA(std::string_view cdata) override;
+  void onComment(std::string_view comment) override;
+  void onPI(std::string_view name, std::string_view parameters) override;
+  // Finish the tape once the document has been parsed
+  void finish();
+
+private:
+  // Add a node to the innermost open node, returning its index
+  std::uint32_t addNode(XMLTape_Impl::Kind kind, XML_NameTable::Symbol name, std::string_view value);
+  // Add an attribute to the last node added
+  void addAttribute(XML_NameTable::Symbol name, std::string_view value);
+  // Append text to the tape's text, returning its offset
+  std::uint32_t addText(std::string_view value);
+  // Tape being built
+  XMLTape_Impl &tape;
+  // Nodes not yet closed: the prolog then the elements being parsed
+  std::vector<std::uint32_t> openNodes;
+  // Last child added to each open node (kNoNode if none yet)
+  std::vector<std::uint32_t> lastChildren;
+};
+}// namespace XML_Lib
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace XML_Lib {
+
+// Parse handler that builds the Node tree for a document from the parser's events, its nodes
+// being allocated as the context it is given directs.
+class XML_TreeBuilder final : public IParseHandler
+{
+public:
+  // Constructors/Destructors
+  explicit XML_TreeBuilder(const XML_AllocationContext &context);
+  XML_TreeBuilder(const XML_AllocationContext &context, XMLNameSpaceScope::Pointer outerNameSpaces);
+  XML_TreeBuilder(const XML_TreeBuilder &other) = delete;
+  XML_TreeBuilder &operator=(const XML_TreeBuilder &other) = delete;
+  XML_TreeBuilder(XML_TreeBuilder &&other) = delete;
+  XML_TreeBuilder &operator=(XML_TreeBuilder &&other) = delete;
+  ~XML_TreeBuilder() override = default;
+
+  void onDeclaration(std::string_view version, std::string_view encoding, std::string_view standalone) override;
+  void onStartElement(std::string_view name, std::span<const XMLAttribute> attributes, bool isSelfClosing) override;
+  void onEndElement(std::string_view name) override;
+  void onCharacters(std::string_view characters, bool isWhiteSpace) override;
+  void onCDATA(std::string_view cdata) override;
+  void onComment(std::string_view comment) override;
+  void onPI(std::string_view name, std::string_view parameters) override;
+  void onStartEntityReference(const XMLValue &reference) override;
+  void onEndEntityReference(const XMLValue &reference) override;
+  void onDTD(Node &dtd) override;
+  // Return the children added so far to the innermost Node not yet closed
+  [[nodiscard]] std::span<Node> openChildren() { return std::span(childStack).subspan(firstChildren.back()); }
+  // Add a child to the innermost Node not yet closed
+  void addChild(Node &&child) { childStack.push_back(std::move(child)); }
+  // Leave content that lies within input (held by the caller) in situ instead of copying it
+  void setInSituInput(const std::string_view input) { inSituInput = input; }
+  // Return the prolog Node of the document built
+  [[nodiscard]] Node releaseProlog();
+
+private:
+  // Make a Node allocated as the builder's context directs
+  template<typename T, typename... Args> [[nodiscard]] Node make(Args &&...args) const
+  {
+    const XML_AllocationContext::Scope scope(context);
+    return Node::make<T>(std::forward<Args>(args)...);
+  }
+  // Open a Node, its children being added to the child stack until it is closed
+  void openNode(Node &&xNode);
+  // Close the innermost open Node and add it to its parent
+  void closeNode();
+  // Move the children of the innermost open Node from the child stack into it
+  void commitChildren();
+  // Return the last child added to the innermost open Node (or to its parent), or nullptr if none
+  [[nodiscard]] Node *lastChild();
+  [[nodiscard]] Node *lastParentChild();
+  // Add characters to the content Node that is the last child of the innermost open Node
+  void addContent(std::string_view content, bool isWhiteSpace);
+  // Where the nodes built are allocated
+  XML_AllocationContext context;
+  // Nodes not yet closed: the prolog then the elements (and entity references) being parsed
+  std::vector<Node> openNodes;
+  // Children of the open Nodes, those of each after those of its parent; a Node's are moved
+  // into it when it closes, so its child list is allocated once at its exact size
+  std::vector<Node> childStack;
+  // Position in the child stack of the first child of each open Node
+  std::vector<std::size_t> firstChildren;
+  // Namespace scope of the first element (declared by elements outside the tree built)
+  XMLNameSpaceScope::Pointer outerNameSpaces;
+  // Caller's input that content may be left in situ in (empty if none)
+  std::string_view inSituInput;
+  // Nesting of character references, whose replacement is not added to the tree
+  long characterReferenceDepth{ 0 };
+};
+}// namespace XML_Lib
@@ -37,20 +37,33 @@ private:
   // XML declaration
   else if (isA<Declaration>(xNode)) {
     auto &xNodeDeclaration = NRef<Declaration>(xNode);
-    destination.add("<?xml version=\"" + xNodeDeclaration.version() + "\"" + " encoding=\""
-                    + xNodeDeclaration.encoding() + "\"" + " standalone=\"" + xNodeDeclaration.standalone() + "\"?>");
+    destination.add("<?xml version=\"");
+    destination.add(xNodeDeclaration.version());
+    destination.add("\" encoding=\"");
+    destination.add(xNodeDeclaration.encoding());
+    destination.add("\" standalone=\"");
+    destination.add(xNodeDeclaration.standalone());
+    destination.add("\"?>");
   }
   // XML root or child elements
   else if (isA<Root>(xNode) || isA<Element>(xNode) || isA<Self>(xNode)) {
     const auto &xElement = NRef<Element>(xNode);
-    destination.add("<" + xElement.name());
+    destination.add("<");
+    destination.add(xElement.name());
     for (auto &attribute : xElement.getAttributes()) {
-      destination.add(" " + attribute.getName() + "=" + attribute.getQuote() + attribute.getUnparsed() + attribute.getQuote());
+      destination.add(" ");
+      destination.add(attribute.getName());
+      destination.add("=");
+      destination.add(attribute.getQuote());
+      destination.add(attribute.getUnparsed());
+      destination.add(attribute.getQuote());
     }
     if (!isA<Self>(xNode)) {
       destination.add(">");
       for (auto &child : xNode.getChildren()) { stringifyNodes(child, destination, indent); }
-      destination.add("</" + xElement.name() + ">");
+      destination.add("</");
+      destination.add(xElement.name());
+      destination.add(">");
     } else {
       destination.add("/>");
     }
@@ -58,7 +71,9 @@ private:
   // XML comments
   else if (isA<Comment>(xNode)) {
     const auto &xNodeComment = NRef<Comment>(xNode);
-    destination.add("<!--" + xNodeComment.value() + "-->");
+    destination.add("<!--");
+    destination.add(xNodeComment.value());
+    destination.add("-->");
   }
   // XML element content
   else if (isA<Content>(xNode)) {
@@ -73,12 +88,18 @@ private:
   // XML processing instruction
   else if (isA<PI>(xNode)) {
     const PI &xNodePI = NRef<PI>(xNode);
-    destination.add("<?" + xNodePI.name() + " " + xNodePI.parameters() + "?>");
+    destination.add("<?");
+    destination.add(xNodePI.name());
+    destination.add(" ");
+    destination.add(xNodePI.parameters());
+    destination.add("?>");
   }
   // XML CDATA section
   else if (isA<CDATA>(xNode)) {
     const auto &xNodeCDATA = NRef<CDATA>(xNode);
-    destination.add("<![CDATA[" + std::string(xNodeCDATA.value()) + "]]>");
+    destination.add("<![CDATA[");
+    destination.add(xNodeCDATA.value());
+    destination.add("]]>");
   }
   // XML DTD_Validator
   else if (isA<DTD>(xNode)) {
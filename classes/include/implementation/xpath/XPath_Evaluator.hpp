@@ -0,0 +1,74 @@
+#pragma once
+
+#include "XPath_Impl.hpp"
+#include "XPath_NodeModels.hpp"
+
+namespace XML_Lib {
+
+// XPath 1.0 evaluator for a document model (XPath_TreeModel or XPath_TapeModel);
+// walks the document executing an expression's AST (XPath_Evaluator.cpp)
+template<typename Model> class XPath_Evaluator
+{
+public:
+  using Handle = typename Model::Handle;
+  using Result = XPathResultOf<Handle>;
+
+  XPath_Evaluator(const Model model, const Handle documentRoot) : model(model), documentRoot(documentRoot) {}
+
+  // Tokenize, parse and evaluate an expression against the document root
+  [[nodiscard]] Result evaluate(std::string_view expression) const;
+  // Type conversions
+  [[nodiscard]] std::string toString(const Result &r) const;
+  [[nodiscard]] double toNumber(const Result &r) const;
+  [[nodiscard]] static bool toBool(const Result &r);
+
+private:
+  // Candidate (node, attribute name) produced by an axis
+  struct CandidateNode
+  {
+    Handle node{};
+    std::string attrName;// non-empty only for attribute axis
+    bool isAttr{ false };
+  };
+  [[nodiscard]] std::string_view toStringView(const Result &r, std::string &scratch) const;
+  [[nodiscard]] Result
+    evalExpr(const XPathExpr &expr, Handle contextNode, size_t contextPosition, size_t contextSize, const std::vector<Handle> &ancestorStack) const;
+  [[nodiscard]] bool matchNodeTest(Handle node,
+    const XPathNodeTest &test,
+    XML_NameTable::Matcher &nameTest,
+    const std::string &attrName = "",
+    bool isAttrNode = false) const;
+  [[nodiscard]] bool evalPredicate(const XPathPredicate &pred,
+    Handle node,
+    size_t position,
+    size_t total,
+    const std::vector<Handle> &ancestors) const;
+  [[nodiscard]] std::vector<CandidateNode>
+    axisNodes(XPathAxis axis, Handle contextNode, const std::vector<Handle> &ancestorStack) const;
+  [[nodiscard]] Result
+    evalStepResult(const XPathStep &step, const std::vector<Handle> &inputNodeSet, const std::vector<Handle> &ancestorsOfContext) const;
+  [[nodiscard]] Result
+    evalPathExpr(const XPathPathExpr &pathExpr, Handle contextNode, const std::vector<Handle> &ancestorStack) const;
+  [[nodiscard]] Result evalBuiltinFunction(const std::string &name,
+    const std::vector<XPathExprPtr> &argExprs,
+    Handle contextNode,
+    size_t contextPosition,
+    size_t contextSize,
+    const std::vector<Handle> &ancestorStack) const;
+  [[nodiscard]] std::string nodeStringValue(const Handle node) const
+  {
+    std::string result;
+    result.reserve(64);
+    model.appendStringValue(node, result);
+    return result;
+  }
+  [[nodiscard]] std::string_view nodeStringView(const Handle node, std::string &scratch) const
+  {
+    return model.stringValue(node, scratch);
+  }
+  // Document evaluated against and the node absolute paths start from
+  const Model model;
+  const Handle documentRoot;
+};
+
+}// namespace XML_Lib
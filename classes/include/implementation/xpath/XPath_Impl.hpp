@@ -1,28 +1,34 @@
 #pragma once
 
 #include "XML.hpp"
+#include "XMLTape.hpp"
 #include "XML_Core.hpp"
 #include "XPath_AST.hpp"
 
 namespace XML_Lib {
 
+class XMLTape_Impl;
+
 // -------------------------------------------------------
 // XPath result type
 // -------------------------------------------------------
 enum class XPathResultType : uint8_t { NodeSet, String, Number, Boolean };
 
-struct XPathResult
+// Result of an expression; a node set holds handles to nodes of the document model
+// evaluated against (Node pointers for a tree, indices for a tape)
+template<typename Handle> struct XPathResultOf
 {
   XPathResultType type{ XPathResultType::NodeSet };
-  std::vector<const Node *> nodeSet;
-  // For attribute-axis results: maps node ptr → attribute value.
+  std::vector<Handle> nodeSet;
+  // For attribute-axis results: maps node handle → attribute value.
   // When non-empty, nodeSet members are "attribute proxy" nodes whose string-value
-  // must be looked up here rather than from nodeStringValue().
-  std::unordered_map<const Node *, std::string> attrValues;
+  // must be looked up here rather than from the node's string value.
+  std::unordered_map<Handle, std::string> attrValues;
   std::string stringValue;
   double numberValue{ 0.0 };
   bool boolValue{ false };
 };
+using XPathResult = XPathResultOf<const Node *>;
 
 // -------------------------------------------------------
 // Pimpl class
@@ -31,6 +37,7 @@ class XPath_Impl
 {
 public:
   explicit XPath_Impl(const Node &root);
+  explicit XPath_Impl(const XMLTape_Impl &tape);
   XPath_Impl(const XPath_Impl &) = delete;
   XPath_Impl &operator=(const XPath_Impl &) = delete;
   XPath_Impl(XPath_Impl &&) = delete;
@@ -38,12 +45,15 @@ public:
   ~XPath_Impl() = default;
 
   [[nodiscard]] std::vector<const Node *> evaluate(std::string_view expression) const;
+  [[nodiscard]] std::vector<XMLTapeNode> evaluateTape(std::string_view expression) const;
   [[nodiscard]] std::string evaluateString(std::string_view expression) const;
   [[nodiscard]] bool evaluateBool(std::string_view expression) const;
   [[nodiscard]] double evaluateNumber(std::string_view expression) const;
 
 private:
-  const Node &xmlRoot;
+  // Document evaluated against: the root of a Node tree, or a tape
+  const Node *xmlRoot{ nullptr };
+  const XMLTape_Impl *xmlTape{ nullptr };
 };
 
 }// namespace XML_Lib
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "XPath_EvalHelpers.hpp"
+#include "XPath_AxisHelpers.hpp"
+#include "XMLTape_Impl.hpp"
+
+namespace XML_Lib {
+
+// Document models the XPath evaluator is instantiated for. Each gives the Handle a node
+// is held by in node sets and the few operations on nodes that evaluation needs.
+
+// Node tree: nodes are handled by pointer
+struct XPath_TreeModel
+{
+  using Handle = const Node *;
+
+  template<typename Visit> void forEachChild(const Handle node, Visit &&visit) const
+  {
+    for (const auto &child : node->getChildren()) { visit(&child); }
+  }
+  // Collect all descendants (depth-first, not including self; the subtrees of the node's
+  // children are collected last child first)
+  void collectDescendants(const Handle node, std::vector<Handle> &out) const
+  {
+    std::vector<Handle> stack;
+    stack.reserve(16);
+    for (const auto &child : node->getChildren()) { stack.push_back(&child); }
+    while (!stack.empty()) {
+      const Handle current = stack.back();
+      stack.pop_back();
+      out.push_back(current);
+      const auto &children = current->getChildren();
+      for (auto it = children.rbegin(); it != children.rend(); ++it) { stack.push_back(&*it); }
+    }
+  }
+  [[nodiscard]] bool isContent(const Handle node) const { return isA<Content>(*node); }
+  [[nodiscard]] bool isComment(const Handle node) const { return isA<Comment>(*node); }
+  [[nodiscard]] bool isPI(const Handle node) const { return isA<PI>(*node); }
+  [[nodiscard]] bool isElementLike(const Handle node) const { return isElementLikeNode(*node); }
+  [[nodiscard]] bool matchName(const Handle node, XML_NameTable::Matcher &nameTest) const
+  {
+    return matchNodeName(*node, nameTest);
+  }
+  [[nodiscard]] std::string_view name(const Handle node) const { return nodeNameView(*node); }
+  [[nodiscard]] std::string_view localName(const Handle node) const { return nodeLocalNameView(*node); }
+  [[nodiscard]] std::string_view namespaceURI(const Handle node) const
+  {
+    return isElementLikeNode(*node) ? NRef<Element>(*node).getNamespaceURI() : std::string_view{};
+  }
+  void appendStringValue(const Handle node, std::string &out) const { appendNodeStringValue(*node, out); }
+  // String value of a node, built in scratch only if it is not held whole by a single text node
+  [[nodiscard]] std::string_view stringValue(const Handle node, std::string &scratch) const
+  {
+    return nodeStringValueView(*node, scratch);
+  }
+  template<typename Visit> void forEachAttribute(const Handle node, Visit &&visit) const
+  {
+    if (const auto *attrs = nodeAttributes(*node); attrs != nullptr) {
+      for (const auto &attr : *attrs) { visit(attr.getName()); }
+    }
+  }
+  [[nodiscard]] std::string attributeValue(const Handle node, const std::string_view attrName) const
+  {
+    return findAttributeValue(*node, attrName);
+  }
+};
+
+// Tape: nodes are handled by index, and a node's descendants are those that follow it
+// up to the end of its subtree
+struct XPath_TapeModel
+{
+  using Handle = std::uint32_t;
+
+  const XMLTape_Impl &tape;
+
+  template<typename Visit> void forEachChild(const Handle node, Visit &&visit) const
+  {
+    for (auto child = tape.firstChild(node); child != XMLTape_Impl::kNoNode; child = tape.nextSibling(child)) {
+      visit(child);
+    }
+  }
+  void collectDescendants(const Handle node, std::vector<Handle> &out) const
+  {
+    for (auto descendant = node + 1, end = tape.subtreeEnd(node); descendant < end; descendant++) {
+      out.push_back(descendant);
+    }
+  }
+  [[nodiscard]] bool isContent(const Handle node) const { return tape.kind(node) == XMLTape_Impl::Kind::content; }
+  [[nodiscard]] bool isComment(const Handle node) const { return tape.kind(node) == XMLTape_Impl::Kind::comment; }
+  [[nodiscard]] bool isPI(const Handle node) const { return tape.kind(node) == XMLTape_Impl::Kind::pi; }
+  [[nodiscard]] bool isElementLike(const Handle node) const { return tape.isElementLike(node); }
+  [[nodiscard]] bool matchName(const Handle node, XML_NameTable::Matcher &nameTest) const
+  {
+    const std::string_view nodeName = tape.name(node);
+    if (nodeName.empty()) { return false; }
+    if (nameTest.name() == "*" || nameTest.matches(tape.getNameTable(), tape.nameSymbol(node))) { return true; }
+    // Otherwise only a prefixed name can match, by its local name
+    return !tape.getNameTable().prefix(tape.nameSymbol(node)).empty() && localName(node) == nameTest.name();
+  }
+  [[nodiscard]] std::string_view name(const Handle node) const { return tape.name(node); }
+  [[nodiscard]] std::string_view localName(const Handle node) const
+  {
+    const auto symbol = tape.nameSymbol(node);
+    return symbol != XML_NameTable::kNoSymbol ? tape.getNameTable().localName(symbol) : std::string_view{};
+  }
+  [[nodiscard]] std::string_view namespaceURI(const Handle node) const
+  {
+    return tape.isElementLike(node) ? tape.namespaceURI(node) : std::string_view{};
+  }
+  void appendStringValue(const Handle node, std::string &out) const { tape.appendStringValue(node, out); }
+  [[nodiscard]] std::string_view stringValue(const Handle node, std::string &scratch) const
+  {
+    return tape.stringValue(node, scratch);
+  }
+  template<typename Visit> void forEachAttribute(const Handle node, Visit &&visit) const
+  {
+    for (std::uint32_t attribute = 0; attribute < tape.attributeCount(node); attribute++) {
+      visit(tape.attributeName(node, attribute));
+    }
+  }
+  [[nodiscard]] std::string attributeValue(const Handle node, const std::string_view attrName) const
+  {
+    const auto attribute = tape.findAttribute(node, attrName);
+    return attribute != XMLTape_Impl::kNoNode ? std::string(tape.attributeValue(node, attribute)) : std::string{};
+  }
+};
+
+}// namespace XML_Lib
@@ -14,8 +14,8 @@ namespace XML_Lib {
 /// Collect element-child occurrence counts from xNode's children.
 [[nodiscard]] std::unordered_map<std::string, uint32_t> collectElementChildCounts(const Node &xNode);
 
-/// Find a declared particle in a complex type by element name; returns nullptr if not found.
-[[nodiscard]] const XSD_Particle *findDeclaredParticle(const XSD_ComplexType &type, std::string_view childName);
+/// Find the declared particle in a complex type of a child element; returns nullptr if not found.
+[[nodiscard]] const XSD_Particle *findDeclaredParticle(const XSD_ComplexType &type, const Element &child);
 
 /// Throw if any child element name in childCounts is not declared in type.particles.
 void validateUnexpectedChildren(const std::unordered_map<std::string, uint32_t> &childCounts,
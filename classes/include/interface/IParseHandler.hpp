@@ -0,0 +1,70 @@
+#pragma once
+
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace XML_Lib {
+
+// ====================
+// Forward declarations
+// ====================
+struct Node;
+struct XMLValue;
+struct XMLAttribute;
+
+/// @brief Event interface for parsing without building a document tree.
+///
+/// Derive from `IParseHandler` and override the `on*` methods you care about, then pass
+/// an instance to `XML::parse(ISource &, IParseHandler &)`.  Events are reported in document
+/// order as the parser reaches them; the views passed are only valid for the duration of
+/// the call.  Memory used by the parse grows with element nesting depth, not document size.
+///
+/// Entity and character references in content are bracketed by `onStartEntityReference()` /
+/// `onEndEntityReference()`, with their replacement reported as events in between, so a
+/// handler that ignores the bracketing events sees the expanded document.
+///
+/// Example:
+/// @code
+/// struct MyHandler : XML_Lib::IParseHandler {
+///     void onStartElement(std::string_view name, std::span<const XML_Lib::XMLAttribute>, bool) override { /* … */ }
+/// };
+/// @endcode
+class IParseHandler
+{
+public:
+  /// @brief Exception thrown when a handler encounters an error during parsing.
+  struct Error final : std::runtime_error
+  {
+    explicit Error(const std::string_view &message)
+      : std::runtime_error(std::string("IParseHandler Error: ").append(message))
+    {}
+  };
+
+  virtual ~IParseHandler() = default;
+
+  /// @brief XML declaration (defaults are reported when the document has none).
+  virtual void onDeclaration([[maybe_unused]] std::string_view version,
+    [[maybe_unused]] std::string_view encoding,
+    [[maybe_unused]] std::string_view standalone)
+  {}
+  /// @brief Start tag; @p isSelfClosing is true for `<name/>`, which is followed directly by its end.
+  virtual void onStartElement([[maybe_unused]] std::string_view name,
+    [[maybe_unused]] std::span<const XMLAttribute> attributes,
+    [[maybe_unused]] bool isSelfClosing)
+  {}
+  /// @brief End tag (or the end of a self-closing element).
+  virtual void onEndElement([[maybe_unused]] std::string_view name) {}
+  /// @brief Character data; a run of text may be reported over several calls.
+  virtual void onCharacters([[maybe_unused]] std::string_view characters, [[maybe_unused]] bool isWhiteSpace) {}
+  virtual void onCDATA([[maybe_unused]] std::string_view cdata) {}
+  virtual void onComment([[maybe_unused]] std::string_view comment) {}
+  virtual void onPI([[maybe_unused]] std::string_view name, [[maybe_unused]] std::string_view parameters) {}
+  /// @brief Reference in content; @p reference holds its text and replacement.
+  virtual void onStartEntityReference([[maybe_unused]] const XMLValue &reference) {}
+  virtual void onEndEntityReference([[maybe_unused]] const XMLValue &reference) {}
+  /// @brief Parsed DOCTYPE; move from @p dtd to keep it (and DTD validation) beyond the call.
+  virtual void onDTD([[maybe_unused]] Node &dtd) {}
+};
+}// namespace XML_Lib
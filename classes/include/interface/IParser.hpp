@@ -11,8 +11,10 @@ namespace XML_Lib {
 // ====================
 
 class ISource;
+class IParseHandler;
 struct Node;
 struct ParseOptions;
+struct XML_AllocationContext;
 
 /// @brief Abstract interface for an XML parser.
 ///
@@ -32,6 +34,13 @@ public:
   /// @brief Parse @p source and return the document root `Node`.
   virtual Node parse(ISource &source, const ParseOptions &options) = 0;
 
+  /// @brief Parse @p source and return the document root `Node`, its nodes and names being
+  /// allocated as @p context directs. The default makes @p context current for the whole parse.
+  virtual Node parse(ISource &source, const ParseOptions &options, const XML_AllocationContext &context);
+
+  /// @brief Parse @p source reporting its content to @p handler instead of building a tree.
+  virtual void parse(ISource &source, IParseHandler &handler, const ParseOptions &options) = 0;
+
   /// @brief Return `true` if this parser supports validation (DTD/XSD).
   virtual bool canValidate() = 0;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "XML_Types.hpp"
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -18,6 +19,17 @@ constexpr char kLineFeed{ 0x0A };
 /// Implementations (`BufferSource`, `FileSource`) wrap a string or file and expose a
 /// cursor-based character-by-character API.  The parser reads through `current()` / `next()`
 /// and can `backup()` when it needs to un-read characters.
+///
+/// Sources that hold their characters contiguously can also expose them in bulk through
+/// `peek()` / `skip()` / `find()`, letting the parser scan whole runs without a virtual call
+/// per character.  The bulk methods have per-character defaults, so a source only needs to
+/// override them when it can do better.
+///
+/// Sources that hold UTF-8 encoded input expose it through `peekUtf8()` / `skipUtf8()` instead,
+/// so that names, text and values can be copied straight from the input bytes.  Their
+/// `current()` still returns UTF-16 code units (a supplementary character is returned as its
+/// surrogate pair over two `next()` calls), `backup()` counts those code units, and
+/// `position()` / `getRange()` are in bytes.
 class ISource
 {
 public:
@@ -50,6 +62,51 @@ public:
   /// @brief Reset the stream to the beginning.
   virtual void reset() = 0;
 
+  /// @brief Return a contiguous view of the characters starting at the current position.
+  /// The view may hold fewer characters than remain in the stream and is empty when none can
+  /// be exposed; callers then fall back to `current()` / `next()` for the next character.
+  /// It is invalidated by any call that moves the stream position.
+  [[nodiscard]] virtual std::u16string_view peek() const { return {}; }
+
+  /// @brief Consume @p count characters, equivalent to calling `next()` @p count times.
+  virtual void skip(long count)
+  {
+    while (count-- > 0) { next(); }
+  }
+
+  /// @brief Return a contiguous view of the UTF-8 encoded bytes starting at the current position.
+  /// Empty for sources that do not hold UTF-8 input; callers then use `peek()`. It is
+  /// invalidated by any call that moves the stream position.
+  [[nodiscard]] virtual std::string_view peekUtf8() const { return {}; }
+
+  /// @brief Consume @p count bytes of the view returned by `peekUtf8()`, which must end on a
+  /// character boundary. Line/column tracking is as if `next()` had been called for each
+  /// UTF-16 code unit consumed.
+  virtual void skipUtf8([[maybe_unused]] long count) {}
+
+  /// @brief Track @p count bytes of the view returned by `peekUtf8()` as if they had been
+  /// consumed and then backed up over (as a match failing part way through them is), leaving
+  /// the position where it is. The view is invalidated as by `skipUtf8()`.
+  virtual void replayUtf8([[maybe_unused]] long count) {}
+
+  /// @brief Return the offset from the current position of the next @p delimiter within the
+  /// view returned by `peek()`, or -1 if it does not occur there.
+  [[nodiscard]] virtual long find(const std::u16string_view delimiter) const
+  {
+    const auto offset = peek().find(delimiter);
+    return offset != std::u16string_view::npos ? static_cast<long>(offset) : -1;
+  }
+
+  /// @brief Return all of the UTF-8 encoded input when the source holds it in memory at once
+  /// (positions are byte offsets into it), or an empty view if it does not.  A parser can use
+  /// it to look ahead over the whole document, for example to divide it between threads.
+  [[nodiscard]] virtual std::string_view contents() const { return {}; }
+
+  /// @brief Return the UTF-8 encoded input when it is held by the caller and read in place
+  /// (so outlives the source), or an empty view if the source holds its own copy.  A document
+  /// parsed with `ParseOptions::inSitu` refers into it instead of copying what it can.
+  [[nodiscard]] virtual std::string_view inSituContents() const { return {}; }
+
   /// @brief Return the current `{line, column}` position within the source stream.
   [[nodiscard]] std::pair<long, long> getPosition() const { return std::make_pair(lineNo, columnNo); }
 
@@ -58,6 +115,18 @@ public:
   // Include that header in implementation code that needs them.
 
 protected:
+  /// @brief Update line/column as `next()` would when stepping onto each of @p landed in turn.
+  void trackPosition(const std::u16string_view landed)
+  {
+    const auto lastLineFeed = landed.rfind(kLineFeed);
+    if (lastLineFeed == std::u16string_view::npos) {
+      columnNo += static_cast<long>(landed.size());
+      return;
+    }
+    lineNo += static_cast<long>(std::count(landed.begin(), landed.end(), kLineFeed));
+    columnNo = 1 + static_cast<long>(landed.size() - 1 - lastLineFeed);
+  }
+
   long lineNo = 1;
   long columnNo = 1;
 };
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdexcept>
+#include <string_view>
+
+namespace XML_Lib {
+
+// ====================
+// Forward declarations
+// ====================
+class XMLTapeNode;
+
+/// @brief Visitor interface for traversal of an `XMLTape`.
+///
+/// The tape counterpart of `IAction`: derive from `ITapeAction` and override the `on*`
+/// methods you care about, then pass an instance to `XMLTape::traverse()`.  A tape is
+/// immutable, so each node type has a single (const) callback.
+///
+/// Example:
+/// @code
+/// struct MyAction : XML_Lib::ITapeAction {
+///     void onElement(const XML_Lib::XMLTapeNode &node) override { /* … */ }
+/// };
+/// @endcode
+class ITapeAction
+{
+public:
+  /// @brief Exception thrown when an action encounters an error during traversal.
+  struct Error final : std::runtime_error
+  {
+    explicit Error(const std::string_view &message)
+      : std::runtime_error(std::string("ITapeAction Error: ").append(message))
+    {}
+  };
+
+  virtual ~ITapeAction() = default;
+
+  virtual void onNode([[maybe_unused]] const XMLTapeNode &node) {}
+  virtual void onCDATA([[maybe_unused]] const XMLTapeNode &node) {}
+  virtual void onComment([[maybe_unused]] const XMLTapeNode &node) {}
+  virtual void onContent([[maybe_unused]] const XMLTapeNode &node) {}
+  virtual void onDeclaration([[maybe_unused]] const XMLTapeNode &node) {}
+  virtual void onElement([[maybe_unused]] const XMLTapeNode &node) {}
+  virtual void onPI([[maybe_unused]] const XMLTapeNode &node) {}
+  virtual void onProlog([[maybe_unused]] const XMLTapeNode &node) {}
+  virtual void onRoot([[maybe_unused]] const XMLTapeNode &node) {}
+  virtual void onSelf([[maybe_unused]] const XMLTapeNode &node) {}
+};
+}// namespace XML_Lib
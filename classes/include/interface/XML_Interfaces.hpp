@@ -18,6 +18,8 @@
 #include "IDestination.hpp"
 #include "IEntityMapper.hpp"
 #include "IValidator.hpp"
+#include "IParseHandler.hpp"
 #include "IParser.hpp"
 #include "IStringify.hpp"
-#include "IAction.hpp"
\ No newline at end of file
+#include "IAction.hpp"
+#include "ITapeAction.hpp"
\ No newline at end of file
@@ -105,24 +105,48 @@ void XML::parse(ISource &source, const ParseOptions &options) const { implementa
 void XML::parse(ISource &&source, const ParseOptions &options) const { implementation->parse(source, options); }
 
 /// <summary>
-/// Convenience overload: parse XML directly from a string without needing a BufferSource.
+/// Parse XML read from source stream reporting what is found to an event handler
+/// rather than building a tree, generating an exception if a syntax error in the
+/// XML is found (not well-formed).
 /// </summary>
-void XML::parse(const char *xmlString, const ParseOptions &options) const
+void XML::parse(ISource &source, IParseHandler &handler, const ParseOptions &options) const
 {
-  BufferSource source{ std::string_view{ xmlString } };
-  implementation->parse(source, options);
+  implementation->parse(source, handler, options);
+}
+void XML::parse(ISource &&source, IParseHandler &handler, const ParseOptions &options) const
+{
+  implementation->parse(source, handler, options);
 }
+
+/// <summary>
+/// Convenience overload: parse XML directly from a string without needing a BufferSource.
+/// </summary>
+void XML::parse(const char *xmlString, const ParseOptions &options) const { parse(std::string_view{ xmlString }, options); }
 void XML::parse(const std::string_view &xmlString, const ParseOptions &options) const
 {
-  BufferSource source{ xmlString };
-  implementation->parse(source, options);
+  // Parsed in situ the string is read where it is, else a copy of it is
+  if (options.inSitu && !xmlString.empty()) {
+    ViewSource source{ xmlString };
+    implementation->parse(source, options);
+  } else {
+    BufferSource source{ xmlString };
+    implementation->parse(source, options);
+  }
 }
 
 /// <summary>
 /// Convenience overload: parse XML directly from a file path without needing a FileSource.
+/// Large files are memory mapped where the platform supports it.
 /// </summary>
 void XML::parse(const std::filesystem::path &filePath, const ParseOptions &options) const
 {
+#if defined(__linux__)
+  if (std::error_code error; std::filesystem::file_size(filePath, error) >= MappedFileSource::kMappedFileThreshold && !error) {
+    MappedFileSource source{ filePath.string() };
+    implementation->parse(source, options);
+    return;
+  }
+#endif
   FileSource source{ filePath.string() };
   implementation->parse(source, options);
 }
@@ -165,6 +189,11 @@ void XML::traverse(IAction &action) { implementation->traverse(action); }
 // Traverse using const JSON so cannot change JSON tree
 void XML::traverse(IAction &action) const { std::as_const(*implementation).traverse(action); }
 
+/// <summary>
+/// Free the child storage of every node beyond that of the children it holds.
+/// </summary>
+void XML::compact() { implementation->compact(); }
+
 /// <summary>
 /// Open an XML file, read its contents into a string buffer and return
 /// the buffer.
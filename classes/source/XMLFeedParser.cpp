@@ -0,0 +1,25 @@
+//
+// Class: XMLFeedParser
+//
+// Description: Thin public forwarder to XMLFeedParser_Impl (Pimpl pattern).
+//
+// Dependencies: C++20 - Language standard features used.
+//
+
+#include "XMLFeedParser_Impl.hpp"
+
+namespace XML_Lib {
+
+XMLFeedParser::XMLFeedParser(IParseHandler &handler, const ParseOptions &options)
+  : implementation(std::make_unique<XMLFeedParser_Impl>(handler, options))
+{}
+
+XMLFeedParser::~XMLFeedParser() = default;
+
+void XMLFeedParser::feed(const std::span<const char> chunk) { implementation->feed(chunk); }
+
+void XMLFeedParser::finish() { implementation->finish(); }
+
+bool XMLFeedParser::isComplete() const { return implementation->isComplete(); }
+
+}// namespace XML_Lib
@@ -0,0 +1,37 @@
+//
+// Class: XMLReader
+//
+// Description: Thin public forwarder to XMLReader_Impl (Pimpl pattern).
+//
+// Dependencies: C++20 - Language standard features used.
+//
+
+#include "XMLReader_Impl.hpp"
+
+namespace XML_Lib {
+
+XMLReader::XMLReader(ISource &source, const ParseOptions &options)
+  : implementation(std::make_unique<XMLReader_Impl>(source, options))
+{}
+
+XMLReader::~XMLReader() = default;
+
+XMLReader::TokenType XMLReader::next() { return implementation->next(); }
+
+XMLReader::TokenType XMLReader::tokenType() const { return implementation->tokenType(); }
+
+std::string_view XMLReader::name() const { return implementation->name(); }
+
+std::string_view XMLReader::value() const { return implementation->value(); }
+
+std::span<const XMLAttribute> XMLReader::attributes() const { return implementation->attributes(); }
+
+bool XMLReader::isSelfClosing() const { return implementation->isSelfClosing(); }
+
+bool XMLReader::isWhiteSpace() const { return implementation->isWhiteSpace(); }
+
+long XMLReader::depth() const { return implementation->depth(); }
+
+void XMLReader::skipSubtree() { implementation->skipSubtree(); }
+
+}// namespace XML_Lib
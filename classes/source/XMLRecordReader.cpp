@@ -0,0 +1,25 @@
+//
+// Class: XMLRecordReader
+//
+// Description: Thin public forwarder to XMLRecordReader_Impl (Pimpl pattern).
+//
+// Dependencies: C++20 - Language standard features used.
+//
+
+#include "XMLRecordReader_Impl.hpp"
+
+namespace XML_Lib {
+
+XMLRecordReader::XMLRecordReader(ISource &source, const std::string_view recordPath, const ParseOptions &options)
+  : implementation(std::make_unique<XMLRecordReader_Impl>(source, recordPath, options))
+{}
+
+XMLRecordReader::~XMLRecordReader() = default;
+
+bool XMLRecordReader::next() { return implementation->next(); }
+
+const Node &XMLRecordReader::record() const { return implementation->record(); }
+
+std::size_t XMLRecordReader::recordCount() const { return implementation->recordCount(); }
+
+}// namespace XML_Lib
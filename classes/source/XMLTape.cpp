@@ -0,0 +1,96 @@
+//
+// Class: XMLTape
+//
+// Description: Thin public forwarder to XMLTape_Impl (Pimpl pattern), and the
+// XMLTapeNode handle, which reads its node from the tape by index.
+//
+// Dependencies: C++20 - Language standard features used.
+//
+
+#include "XMLTape_Impl.hpp"
+
+namespace XML_Lib {
+
+XMLTapeNode::Kind XMLTapeNode::kind() const { return tape->kind(nodeIndex); }
+
+std::string_view XMLTapeNode::name() const { return tape->name(nodeIndex); }
+
+std::string_view XMLTapeNode::value() const { return tape->value(nodeIndex); }
+
+std::string XMLTapeNode::getContents() const
+{
+  std::string contents;
+  tape->appendContents(nodeIndex, contents);
+  return contents;
+}
+
+XMLTapeNode XMLTapeNode::parent() const { return tape->node(tape->parent(nodeIndex)); }
+
+XMLTapeNode XMLTapeNode::firstChild() const { return tape->node(tape->firstChild(nodeIndex)); }
+
+XMLTapeNode XMLTapeNode::nextSibling() const { return tape->node(tape->nextSibling(nodeIndex)); }
+
+std::size_t XMLTapeNode::childCount() const
+{
+  std::size_t count = 0;
+  for (auto child = tape->firstChild(nodeIndex); child != XMLTape_Impl::kNoNode; child = tape->nextSibling(child)) {
+    count++;
+  }
+  return count;
+}
+
+std::size_t XMLTapeNode::attributeCount() const { return tape->attributeCount(nodeIndex); }
+
+std::string_view XMLTapeNode::attributeName(const std::size_t attribute) const
+{
+  if (attribute >= attributeCount()) { XML_LIB_THROW(XMLTape::Error("Attribute index out of range.")); }
+  return tape->attributeName(nodeIndex, static_cast<std::uint32_t>(attribute));
+}
+
+std::string_view XMLTapeNode::attributeValue(const std::size_t attribute) const
+{
+  if (attribute >= attributeCount()) { XML_LIB_THROW(XMLTape::Error("Attribute index out of range.")); }
+  return tape->attributeValue(nodeIndex, static_cast<std::uint32_t>(attribute));
+}
+
+bool XMLTapeNode::hasAttribute(const std::string_view name) const
+{
+  return tape->findAttribute(nodeIndex, name) != XMLTape_Impl::kNoNode;
+}
+
+std::string_view XMLTapeNode::attribute(const std::string_view name) const
+{
+  const auto attribute = tape->findAttribute(nodeIndex, name);
+  return attribute != XMLTape_Impl::kNoNode ? tape->attributeValue(nodeIndex, attribute) : std::string_view{};
+}
+
+XMLTape::XMLTape(ISource &source, const ParseOptions &options)
+  : implementation(std::make_unique<XMLTape_Impl>(source, options))
+{}
+
+XMLTape::XMLTape(ISource &&source, const ParseOptions &options) : XMLTape(source, options) {}
+
+XMLTape::~XMLTape() = default;
+
+XMLTapeNode XMLTape::prolog() const { return implementation->node(0); }
+
+XMLTapeNode XMLTape::declaration() const { return implementation->node(1); }
+
+XMLTapeNode XMLTape::root() const { return implementation->root(); }
+
+XMLTapeNode XMLTape::node(const std::uint32_t index) const { return implementation->node(index); }
+
+std::size_t XMLTape::size() const { return implementation->size(); }
+
+std::size_t XMLTape::memoryUsed() const { return implementation->memoryUsed(); }
+
+void XMLTape::traverse(ITapeAction &action) const { implementation->traverse(action); }
+
+#if defined(XML_LIB_ENABLE_XPATH)
+std::vector<XMLTapeNode> XMLTape::xpath(const std::string_view expression) const
+{
+  return implementation->xpath(expression);
+}
+#endif
+
+}// namespace XML_Lib
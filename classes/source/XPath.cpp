@@ -8,11 +8,14 @@
 
 #include "XPath_Impl.hpp"
 #include "XPath.hpp"
+#include "XMLTape_Impl.hpp"
 
 namespace XML_Lib {
 
 XPath::XPath(const Node &root) : implementation(std::make_unique<XPath_Impl>(root)) {}
 
+XPath::XPath(const XMLTape &tape) : implementation(std::make_unique<XPath_Impl>(*tape.implementation)) {}
+
 XPath::~XPath() = default;
 
 std::vector<const Node *> XPath::evaluate(const std::string_view expression) const
@@ -20,6 +23,11 @@ std::vector<const Node *> XPath::evaluate(const std::string_view expression) con
   return implementation->evaluate(expression);
 }
 
+std::vector<XMLTapeNode> XPath::evaluateTape(const std::string_view expression) const
+{
+  return implementation->evaluateTape(expression);
+}
+
 std::string XPath::evaluateString(const std::string_view expression) const
 {
   return implementation->evaluateString(expression);
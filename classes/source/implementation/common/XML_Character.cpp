@@ -16,41 +16,42 @@ namespace XML_Lib {
 
 XMLValue parseCharacterReference(ISource &source);
 
+// One bit per BMP character
+using BMPBitmap = std::array<std::uint64_t, 0x10000 / 64>;
+
 /// <summary>
-/// Check whether a character is valid for XML.
+/// Build at compile time the bitmap of the BMP characters within a set of ranges.
 /// </summary>
-/// <param name="c">Character to validate.</param>
-/// <returns>True then valid otherwise false.</returns>
-bool validChar(const Char c)
+/// <param name="rangeSets">Ranges of the characters in the set.</param>
+/// <returns>Bitmap of the set.</returns>
+template<typename... Ranges> static constexpr BMPBitmap makeBMPBitmap(const Ranges &...rangeSets)
 {
-  return c == 0x09 || c == kLineFeed || c == kCarriageReturn || (c >= 0x20 && c <= 0xD7FF)
-         || (c >= 0xE000 && c <= 0xFFFD);
+  BMPBitmap bitmap{};
+  const auto addRanges = [&bitmap](const auto &ranges) {
+    for (const auto &[first, last] : ranges) {
+      for (std::size_t c = first; c <= last; c++) { bitmap[c / 64] |= std::uint64_t{ 1 } << (c % 64); }
+    }
+  };
+  (addRanges(rangeSets), ...);
+  return bitmap;
 }
 
+static constexpr BMPBitmap kNameStartCharBitmap{ makeBMPBitmap(kNameStartCharRanges) };
+static constexpr BMPBitmap kNameCharBitmap{ makeBMPBitmap(kNameStartCharRanges, kNameCharExtraRanges) };
+
 /// <summary>
-/// Check whether character is a valid to start an XML name with.
+/// Check whether a character (beyond Latin-1) is valid to start an XML name with.
 /// </summary>
 /// <param name="c">Character value to validate.</param>
 /// <returns>true then valid otherwise false.</returns>
-bool validNameStartChar(const Char c)
-{
-  return c == ':' || c == '_' || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= 0xC0 && c <= 0xD6)
-         || (c >= 0xD8 && c <= 0xF6) || (c >= 0xF8 && c <= 0x2FF) || (c >= 0x370 && c <= 0x37D)
-         || (c >= 0x37F && c <= 0x1FFF) || (c >= 0x200C && c <= 0x200D) || (c >= 0x2070 && c <= 0x218F)
-         || (c >= 0x2C00 && c <= 0x2FEF) || (c >= 0x3001 && c <= 0xD7FF) || (c >= 0xF900 && c <= 0xFDCF)
-         || (c >= 0xFDF0 && c <= 0xFFFD);
-}
+bool validNonLatin1NameStartChar(const Char c) { return (kNameStartCharBitmap[c / 64] >> (c % 64) & 1) != 0; }
 
 /// <summary>
-/// Check whether a character is valid for an XML name.
+/// Check whether a character (beyond Latin-1) is valid for an XML name.
 /// </summary>
-/// <param name="c">Name to validate.</param>
+/// <param name="c">Character value to validate.</param>
 /// <returns>true then valid otherwise false.</returns>
-bool validNameChar(const Char c)
-{
-  return validNameStartChar(c) || c == '-' || c == '.' || (c >= '0' && c <= '9') || c == 0xB7
-         || (c >= 0x0300 && c <= 0x036F) || (c >= 0x203F && c <= 0x2040);
-}
+bool validNonLatin1NameChar(const Char c) { return (kNameCharBitmap[c / 64] >> (c % 64) & 1) != 0; }
 
 /// <summary>
 /// Check name that starts with xml is a valid reserved name.
@@ -83,6 +84,24 @@ bool validName(const String &name)
   return true;
 }
 
+/// <summary>
+/// Validate UTF-8 encoded XML tag/attribute names.
+/// </summary>
+/// <param name="name">XML name to check.</param>
+/// <returns>true then valid otherwise false.</returns>
+bool validName(const std::string_view &name)
+{
+  if (std::ranges::all_of(name, [](const char c) { return static_cast<unsigned char>(c) < 0x80; })) {
+    // ASCII names are checked in place; only those that may be reserved need the full check
+    if (name.size() >= 3 && std::tolower(name[0]) == 'x' && std::tolower(name[1]) == 'm' && std::tolower(name[2]) == 'l') {
+      return validName(String(name.begin(), name.end()));
+    }
+    return !name.empty() && validNameStartChar(static_cast<Char>(name[0]))
+           && std::all_of(name.begin() + 1, name.end(), [](const char c) { return validNameChar(static_cast<Char>(c)); });
+  }
+  return validName(toUtf16(name));
+}
+
 /// <summary>
 /// Make sure that the XML attribute value does not contain any illegal characters.
 /// </summary>
@@ -22,12 +22,12 @@ namespace XML_Lib {
 /// <returns>XML name.</returns>
 std::string parseName(ISource &source)
 {
-  const String name = readName(source);
+  std::string name = readName(source);
   ignoreWS(source);
-  if (!validName(name)) {
-    XML_LIB_THROW(SyntaxError(source.getPosition(), "Invalid name '" + toUtf8(name) + "' encountered."));
+  if (!validName(std::string_view{ name })) {
+    XML_LIB_THROW(SyntaxError(source.getPosition(), "Invalid name '" + name + "' encountered."));
   }
-  return toUtf8(name);
+  return name;
 }
 
 /// <summary>
@@ -36,34 +36,30 @@ XMLValue decodeCharRef(ISource &source)
     XML_LIB_THROW(SyntaxError(source.getPosition(), "Character reference invalid character."));
   }
   if (ec == std::errc() && ptr == digits.data() + digits.size()) {
-    if (result < 0 || !validChar(static_cast<Char>(result))) {
+    // Supplementary plane characters (beyond a single UTF-16 code unit) are all valid
+    if (result < 0 || result > 0x10FFFF || (result <= 0xFFFF && !validChar(static_cast<Char>(result)))) {
       XML_LIB_THROW(SyntaxError(source.getPosition(), "Character reference invalid character."));
     }
-    return XMLValue{ unparsed, toUtf8(static_cast<Char>(result)) };
+    std::string parsed;
+    appendUtf8(parsed, static_cast<char32_t>(result));
+    return XMLValue{ unparsed, parsed };
   }
   XML_LIB_THROW(SyntaxError(source.getPosition(), "Cannot convert character reference."));
 }
 
-String readName(ISource &source)
+std::string readName(ISource &source)
 {
-  String name;
-  name.reserve(16);
-  while (source.more() && validNameChar(source.current())) {
-    name += source.current();
-    source.next();
-  }
+  std::string name;
+  readWhile(source, name, [](const Char ch) { return validNameChar(ch); });
   return name;
 }
 
 std::string readUntil(ISource &source, Char terminator)
 {
-  String buffer;
+  std::string buffer;
   buffer.reserve(64);
-  while (source.more() && source.current() != terminator) {
-    buffer += source.current();
-    source.next();
-  }
-  return toUtf8(buffer);
+  readWhile(source, buffer, [terminator](const Char ch) { return ch != terminator; });
+  return buffer;
 }
 
 std::string readEntityReferenceText(ISource &source)
@@ -90,8 +86,8 @@ XMLValue parseCharacterOrReference(ISource &source)
     return parseEntityReference(source);
   }
   if (validChar(source.current())) {
-    const std::string character{ toUtf8(source.current()) };
-    source.next();
+    std::string character;
+    appendCurrent(source, character);
     return XMLValue{ character, character };
   }
   XML_LIB_THROW(SyntaxError(source.getPosition(), "Invalid character value encountered."));
@@ -9,6 +9,7 @@
 #include "XML_Utility.hpp"
 #include <algorithm>
 #include <cwctype>
+#include <functional>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -67,4 +68,17 @@ std::string toUpperString(const std::string_view &target) { return transformStri
 /// </summary>
 /// <param name="target">String to convert.</param>
 std::string toLowerString(const std::string_view &target) { return transformStringCase(target, std::tolower); }
+
+/// <summary>
+/// Are the characters of one string view held within those of another.
+/// </summary>
+/// <param name="part">String view to look for.</param>
+/// <param name="whole">String view to look in (never contains anything if empty).</param>
+/// <returns>True if part lies within whole.</returns>
+bool isWithin(const std::string_view &part, const std::string_view &whole)
+{
+  const std::less_equal<const char *> notAfter;
+  return !whole.empty() && notAfter(whole.data(), part.data())
+         && notAfter(part.data() + part.size(), whole.data() + whole.size());
+}
 }// namespace  XML_Lib
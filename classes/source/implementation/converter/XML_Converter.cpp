@@ -0,0 +1,136 @@
+//
+// Class: Converter
+//
+// Description: Convert characters to/from UTF8/UTF16. Runs of ASCII are copied
+// sixteen characters at a time; anything else is transcoded a code point at a
+// time straight into a result sized up front, so no conversion allocates more
+// than the string it returns.
+//
+// Dependencies: C++20 - Language standard features used.
+//
+
+#include "XML_Converter.hpp"
+#include "common/XML_Error.hpp"
+#include "common/XML_Utf8.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace XML_Lib {
+
+// Characters checked (and copied) at once by the ASCII fast paths
+static constexpr std::size_t kAsciiBlock{ 16 };
+
+/// <summary>
+/// Are the kAsciiBlock UTF-8 bytes at bytes all ASCII.
+/// </summary>
+/// <param name="bytes">First of the bytes.</param>
+/// <returns>true if none has its top bit set.</returns>
+static bool isAsciiBlock(const char *bytes)
+{
+  std::uint64_t words[2];
+  std::memcpy(words, bytes, sizeof(words));
+  return ((words[0] | words[1]) & 0x8080808080808080) == 0;
+}
+
+/// <summary>
+/// Are the kAsciiBlock UTF-16 code units at units all ASCII.
+/// </summary>
+/// <param name="units">First of the code units.</param>
+/// <returns>true if all are below 0x80.</returns>
+static bool isAsciiBlock(const char16_t *units)
+{
+  std::uint64_t words[4];
+  std::memcpy(words, units, sizeof(words));
+  return ((words[0] | words[1] | words[2] | words[3]) & 0xFF80FF80FF80FF80) == 0;
+}
+
+/// <summary>
+/// Return the length of the UTF-8 encoding of UTF-16 (a surrogate counts two bytes, so
+/// that a pair counts the four of the code point it encodes).
+/// </summary>
+/// <param name="utf16">UTF-16 to measure.</param>
+/// <returns>Length in bytes.</returns>
+static std::size_t utf8Length(const std::u16string_view utf16)
+{
+  std::size_t length = 0;
+  for (const char16_t unit : utf16) {
+    length += unit < 0x80 ? 1 : unit < 0x800 || (unit >= 0xD800 && unit <= 0xDFFF) ? 2 : 3;
+  }
+  return length;
+}
+
+/// <summary>
+/// Convert to UTF-8 strings.
+/// </summary>
+std::string toUtf8(const char16_t utf16) { return toUtf8(std::u16string_view(&utf16, 1)); }
+std::string toUtf8(const std::u16string_view utf16)
+{
+  std::string utf8(utf8Length(utf16), '\0');
+  char *out = utf8.data();
+  const char16_t *unit = utf16.data();
+  const char16_t *const end = unit + utf16.size();
+  while (unit != end) {
+    if (static_cast<std::size_t>(end - unit) >= kAsciiBlock && isAsciiBlock(unit)) {
+      for (std::size_t index = 0; index < kAsciiBlock; index++) { out[index] = static_cast<char>(unit[index]); }
+      out += kAsciiBlock;
+      unit += kAsciiBlock;
+      continue;
+    }
+    if (*unit < 0x80) {
+      *out++ = static_cast<char>(*unit++);
+      continue;
+    }
+    char32_t codePoint = *unit++;
+    if (codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+      if (codePoint > 0xDBFF || unit == end || *unit < 0xDC00 || *unit > 0xDFFF) {
+        XML_LIB_THROW(std::range_error("UTF-16 has an unpaired surrogate."));
+      }
+      codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (*unit++ - 0xDC00);
+    }
+    out += encodeUtf8(codePoint, out);
+  }
+  return utf8;
+}
+void appendUtf8(std::string &utf8, const char32_t codePoint)
+{
+  char bytes[kMaxUtf8Length];
+  utf8.append(bytes, encodeUtf8(codePoint, bytes));
+}
+/// <summary>
+/// Convert to UTF-16 strings.
+/// </summary>
+std::u16string toUtf16(const std::string_view utf8)
+{
+  std::u16string utf16(static_cast<std::size_t>(utf16Length(utf8)), u'\0');
+  char16_t *out = utf16.data();
+  std::size_t index = 0;
+  while (index < utf8.size()) {
+    if (utf8.size() - index >= kAsciiBlock && isAsciiBlock(utf8.data() + index)) {
+      for (std::size_t offset = 0; offset < kAsciiBlock; offset++) {
+        out[offset] = static_cast<unsigned char>(utf8[index + offset]);
+      }
+      out += kAsciiBlock;
+      index += kAsciiBlock;
+      continue;
+    }
+    if (static_cast<unsigned char>(utf8[index]) < 0x80) {
+      *out++ = static_cast<char16_t>(utf8[index++]);
+      continue;
+    }
+    char32_t codePoint{};
+    const auto length = decodeUtf8(utf8.substr(index), codePoint);
+    if (length == 0) { XML_LIB_THROW(std::range_error("Invalid UTF-8 sequence.")); }
+    if (codePoint < 0x10000) {
+      *out++ = static_cast<char16_t>(codePoint);
+    } else {
+      *out++ = highSurrogate(codePoint);
+      *out++ = lowSurrogate(codePoint);
+    }
+    index += length;
+  }
+  return utf16;
+}
+
+}// namespace XML_Lib
@@ -42,7 +42,7 @@ void DTD_Impl::parseValidateAttribute(const std::string_view &elementName, const
   }
   // Enumeration contains unique values and default is valid value
   else if (dtdAttribute.type == (DTD::AttributeType::enumeration | DTD::AttributeType::normal)) {
-    std::set<std::string> options;
+    std::set<std::string, std::less<>> options;
     for (auto &option : splitString(dtdAttribute.enumeration.substr(1, dtdAttribute.enumeration.size() - 2), '|')) {
       if (!options.contains(option)) {
         options.insert(option);
@@ -52,7 +52,7 @@ void DTD_Impl::parseValidateAttribute(const std::string_view &elementName, const
       }
     }
     if (!options.contains(dtdAttribute.value.getParsed())) {
-      XML_LIB_THROW(SyntaxError("Default value '" + dtdAttribute.value.getParsed() + "' for enumeration attribute '"
+      XML_LIB_THROW(SyntaxError("Default value '" + std::string(dtdAttribute.value.getParsed()) + "' for enumeration attribute '"
                         + dtdAttribute.name + "' is invalid."));
     }
   }
@@ -197,7 +197,7 @@ void DTD_Impl::parseEntity(ISource &source) const
   if (source.current() == '\'' || source.current() == '"') {
     const XMLValue entityValue = parseValue(source);
     // Force expansion to trigger recursion detection
-    std::string expanded = entityValue.getParsed();
+    std::string expanded{ entityValue.getParsed() };
     if (expanded.find('&') != std::string::npos) {
       std::set<std::string> currentEntities;
       xDTD.getEntityMapper().checkRecursiveEntity(entityName, expanded, currentEntities);
@@ -329,7 +329,6 @@ void DTD_Impl::parseDTD(ISource &source)
   // Make sure no defined entity contains recursion
   xDTD.getEntityMapper().checkForRecursion();
   // Count lines in DTD
-  std::string unparsedDTD = xDTD.unparsed();
-  xDTD.setLineCount(std::ranges::count(unparsedDTD, kLineFeed) + 1);
+  xDTD.setLineCount(std::ranges::count(xDTD.unparsed(), kLineFeed) + 1);
 }
 }// namespace XML_Lib
@@ -33,12 +33,13 @@ void DTD_Impl::parseGroupBody(ISource &src,
 bool DTD_Impl::parseIsChoiceOrSequence(ISource &contentSpecSource)
 {
   bool choice = false;
-  const long start = contentSpecSource.position();
+  long scanned = 0;
   while (contentSpecSource.more() && contentSpecSource.current() != '|' && contentSpecSource.current() != ',') {
     contentSpecSource.next();
+    scanned++;
   }
   if (contentSpecSource.more() && contentSpecSource.current() == '|') { choice = true; }
-  contentSpecSource.backup(contentSpecSource.position() - start);
+  contentSpecSource.backup(scanned);
   return choice;
 }
 
@@ -187,7 +188,7 @@ XMLValue DTD_Impl::parseElementInternalSpecification(const std::string_view &ele
       if (match(contentSpecSource, "#PCDATA")) {
         parseElementMixedContent(contentSpecSource, contentSpecDestination);
       } else {
-        contentSpecSource.backup(contentSpecSource.position());
+        contentSpecSource.reset();
         parseElementChildren(contentSpecSource, contentSpecDestination);
       }
     } else {
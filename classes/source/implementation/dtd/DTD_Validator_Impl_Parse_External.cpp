@@ -116,7 +116,7 @@ XMLExternalReference DTD_Impl::parseExternalReference(ISource &source) const
 {
   if (match(source, "SYSTEM")) {
     ignoreWS(source);
-    return XMLExternalReference{ "SYSTEM", parseValue(source, xDTD.getEntityMapper()).getParsed(), "" };
+    return XMLExternalReference{ "SYSTEM", std::string(parseValue(source, xDTD.getEntityMapper()).getParsed()), "" };
   }
   if (match(source, XMLExternalReference::kPublicID)) {
     ignoreWS(source);
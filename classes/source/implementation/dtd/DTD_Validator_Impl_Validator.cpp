@@ -16,9 +16,9 @@
 namespace XML_Lib {
 
 namespace {
-static std::set<std::string> buildEnumerationSet(const std::string &enumStr)
+static std::set<std::string, std::less<>> buildEnumerationSet(const std::string &enumStr)
 {
-  std::set<std::string> result;
+  std::set<std::string, std::less<>> result;
   for (auto &item : splitString(enumStr.substr(1, enumStr.size() - 2), '|')) { result.insert(item); }
   return result;
 }
@@ -31,7 +31,7 @@ static std::set<std::string> buildEnumerationSet(const std::string &enumStr)
 /// <param name="error">Error text string.</param>
 void DTD_Impl::elementError(const Element &xElement, const std::string_view &error) const
 {
-  XML_LIB_THROW(ValidationError(lineNumber, "Element <" + xElement.name() + "> " + std::string(error)));
+  XML_LIB_THROW(ValidationError(lineNumber, "Element <" + std::string(xElement.name()) + "> " + std::string(error)));
 }
 
 /// <summary>
@@ -106,11 +106,11 @@ void DTD_Impl::checkAttributeValue(const Node &xNode, const DTD::Attribute &attr
     if (!attributePresent) { elementError(xElement, "is missing required attribute '" + attribute.name + "'."); }
   } else if ((attribute.type & DTD::AttributeType::fixed) != 0) {
     if (attributePresent) {
-      if (const XMLAttribute elementAttribute = xElement[attribute.name];
+      if (const auto &elementAttribute = xElement[attribute.name];
           attribute.value.getParsed() != elementAttribute.getParsed()) {
         elementError(xElement,
-          "attribute '" + attribute.name + "' is '" + elementAttribute.getParsed() + "' instead of '"
-            + attribute.value.getParsed() + "'.");
+          "attribute '" + attribute.name + "' is '" + std::string(elementAttribute.getParsed()) + "' instead of '"
+            + std::string(attribute.value.getParsed()) + "'.");
       }
     }
   }
@@ -154,12 +154,12 @@ void DTD_Impl::checkAttributeType(const Node &xNode, const DTD::Attribute &attri
     if (assignedIDValues.contains(elementAttribute.getParsed())) {
       elementError(xElement, "ID attribute '" + attribute.name + "' is not unique.");
     }
-    assignedIDValues.insert(elementAttribute.getParsed());
+    assignedIDValues.emplace(elementAttribute.getParsed());
   } else if ((attribute.type & DTD::AttributeType::idref) != 0) {
     if (!checkIsIDOK(elementAttribute.getParsed())) {
       elementError(xElement, "IDREF attribute '" + attribute.name + "' is invalid.");
     }
-    assignedIDREFValues.insert(elementAttribute.getParsed());
+    assignedIDREFValues.emplace(elementAttribute.getParsed());
   } else if ((attribute.type & DTD::AttributeType::idrefs) != 0) {
     for (const auto &id : splitString(elementAttribute.getParsed(), ' ')) {
       if (!checkIsIDOK(id)) {
@@ -181,10 +181,10 @@ void DTD_Impl::checkAttributeType(const Node &xNode, const DTD::Attribute &attri
              || (attribute.type & DTD::AttributeType::entities) != 0) {
     const bool isEntities = (attribute.type & DTD::AttributeType::entities) != 0;
     const std::string typeLabel = isEntities ? "ENTITIES" : "ENTITY";
-    const auto checkEntity = [&](const std::string &entityName) {
-      if (!xDTD.getEntityMapper().isPresent("&" + entityName + ";")) {
+    const auto checkEntity = [&](const std::string_view &entityName) {
+      if (!xDTD.getEntityMapper().isPresent("&" + std::string(entityName) + ";")) {
         elementError(xElement,
-          typeLabel + " attribute '" + attribute.name + "' value '" + entityName + "' is not defined.");
+          typeLabel + " attribute '" + attribute.name + "' value '" + std::string(entityName) + "' is not defined.");
       }
     };
     if (isEntities) {
@@ -195,13 +195,13 @@ void DTD_Impl::checkAttributeType(const Node &xNode, const DTD::Attribute &attri
   } else if ((attribute.type & DTD::AttributeType::notation) != 0) {
     if (!buildEnumerationSet(attribute.enumeration).contains(elementAttribute.getParsed())) {
       elementError(xElement,
-        "NOTATION attribute '" + attribute.name + "' value '" + elementAttribute.getParsed() + "' is not defined.");
+        "NOTATION attribute '" + attribute.name + "' value '" + std::string(elementAttribute.getParsed()) + "' is not defined.");
     }
   } else if ((attribute.type & DTD::AttributeType::enumeration) != 0) {
     if (!buildEnumerationSet(attribute.enumeration).contains(elementAttribute.getParsed())) {
       elementError(xElement,
-        "attribute '" + attribute.name + "' contains invalid enumeration value '" + elementAttribute.getParsed()
-          + "'.");
+        "attribute '" + attribute.name + "' contains invalid enumeration value '"
+          + std::string(elementAttribute.getParsed()) + "'.");
     }
   }
 }
@@ -213,7 +213,7 @@ void DTD_Impl::checkAttributeType(const Node &xNode, const DTD::Attribute &attri
 /// <param name="xNode">Current element Node.</param>
 void DTD_Impl::checkAttributes(const Node &xNode)
 {
-  for (const auto &xElement = NRef<Element>(xNode); auto &attribute : xDTD.getElement(xElement.name()).attributes) {
+  for (const auto &xElement = NRef<Element>(xNode); auto &attribute : xDTD.getElement(xElement).attributes) {
     if (xElement.hasAttribute(attribute.name)) { checkAttributeType(xNode, attribute); }
     checkAttributeValue(xNode, attribute);
   }
@@ -227,7 +227,7 @@ void DTD_Impl::checkContentSpecification(const Node &xNode) const
 {
   const auto &xElement = NRef<Element>(xNode);
   if (xDTD.getElementCount() == 0) { return; }
-  const auto &elemDecl = xDTD.getElement(xElement.name());
+  const auto &elemDecl = xDTD.getElement(xElement);
   if (elemDecl.content.getParsed() == "((<#PCDATA>))") {
     if (!checkIsPCDATA(xNode)) { elementError(xElement, "does not contain just any parsable data."); }
     return;
@@ -237,18 +237,20 @@ void DTD_Impl::checkContentSpecification(const Node &xNode) const
     return;
   }
   if (elemDecl.content.getParsed() == "ANY") { return; }
-  const std::regex match{ elemDecl.content.getParsed() };
+  const std::regex match{ std::string(elemDecl.content.getParsed()) };
   std::string elements;
   for (auto &child : xElement.getChildren()) {
     if (isA<Element>(child) || isA<Self>(child)) {
-      elements += "<" + NRef<Element>(child).name() + ">";
+      elements += "<";
+      elements += NRef<Element>(child).name();
+      elements += ">";
     } else if (isA<Content>(child)) {
       if (!NRef<Content>(child).isWhiteSpace()) { elements += "<#PCDATA>"; }
     }
   }
   if (!std::regex_match(elements, match)) {
     elementError(xElement,
-      "does not conform to the content specification " + elemDecl.content.getUnparsed() + ".");
+      "does not conform to the content specification " + std::string(elemDecl.content.getUnparsed()) + ".");
   }
 }
 
@@ -277,7 +279,7 @@ void DTD_Impl::handleElementNode(const Node &xNode)
 {
   if (isA<Root>(xNode) && NRef<Element>(xNode).name() != xDTD.getRootName()) {
     XML_LIB_THROW(ValidationError(
-      lineNumber, "DOCTYPE name does not match that of root element " + NRef<Element>(xNode).name() + " of DTD."));
+      lineNumber, "DOCTYPE name does not match that of root element " + std::string(NRef<Element>(xNode).name()) + " of DTD."));
   }
   checkElement(xNode);
   for (auto &child : xNode.getChildren()) { checkElements(child); }
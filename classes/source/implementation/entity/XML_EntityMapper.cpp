@@ -179,14 +179,14 @@ XMLValue XML_EntityMapper::map(const XMLValue &entityReference)
         if (std::filesystem::exists(systemID)) {
           parsed = getFileMappingContents(systemID);
         } else {
-          XML_LIB_THROW(SyntaxError("Entity '" + entityReference.getUnparsed() + "' source file '"
+          XML_LIB_THROW(SyntaxError("Entity '" + std::string(entityReference.getUnparsed()) + "' source file '"
                             + systemID + "' does not exist."));
         }
       }
     }
     return XMLValue{ entityReference.getUnparsed(), parsed };
   }
-  XML_LIB_THROW(SyntaxError("Entity '" + entityReference.getUnparsed() + "' does not exist."));
+  XML_LIB_THROW(SyntaxError("Entity '" + std::string(entityReference.getUnparsed()) + "' does not exist."));
 }
 /// <summary>
 /// Translate any entity reference to be found in a string.
@@ -9,30 +9,69 @@
 #include "XML_Impl.hpp"
 
 namespace XML_Lib {
+/// <summary>
+/// Note a child about to be added if it was allocated on the heap, as a variant allocated
+/// from an arena is then no longer freed by just releasing the arena.
+/// </summary>
+/// <param name="child">Child Node.</param>
+/// <param name="resource">Memory resource of the parent's children.</param>
+static void noteHeapChild(const Node &child, std::pmr::memory_resource *resource)
+{
+  if (child.isHeapAllocated()) { XML_Arena::addForeignNode(resource); }
+}
 void Variant::addChild(Node &child) const
 {
+  noteHeapChild(child, memoryResource());
   children.push_back(std::move(child));
 }
 void Variant::addChild(Node &&child) const
 {
+  noteHeapChild(child, memoryResource());
   children.push_back(std::move(child));
 }
-// Get Node children reference
+/// <summary>
+/// Get Node children reference to be changed. A Variant allocated from an arena is noted
+/// with it the first time, as nodes not allocated from the arena may then be put among them
+/// without addChild() seeing them.
+/// </summary>
+/// <returns>Reference to the Node children.</returns>
 std::pmr::vector<Node> &Variant::getChildren()
 {
+  if (!childrenExposed) {
+    childrenExposed = true;
+    if (XML_Arena *arena = XML_Arena::owner(memoryResource())) { arena->addExposedChildren(this); }
+  }
   return children;
 }
 const std::pmr::vector<Node> &Variant::getChildren() const
 {
   return children;
 }
-void Variant::reserveChildren(const size_t count)
+void Variant::addChildren(const std::span<Node> newChildren) const
+{
+  children.reserve(children.size() + newChildren.size());
+  for (auto &child : newChildren) {
+    noteHeapChild(child, memoryResource());
+    children.push_back(std::move(child));
+  }
+}
+void Variant::compactChildren() const
 {
-  children.reserve(count);
+  if (children.capacity() == children.size()) { return; }
+  std::pmr::vector<Node> compacted(children.get_allocator());
+  compacted.reserve(children.size());
+  for (auto &child : children) { compacted.push_back(std::move(child)); }
+  children.swap(compacted);
 }
 Variant::Variant(const Type nodeType, std::pmr::memory_resource *resource)
   : xmlNodeType(nodeType), children(resource)
 {}
+Variant::~Variant()
+{
+  if (childrenExposed) {
+    if (XML_Arena *arena = XML_Arena::owner(memoryResource())) { arena->removeExposedChildren(this); }
+  }
+}
 
 std::pmr::memory_resource *Variant::memoryResource() const noexcept
 {
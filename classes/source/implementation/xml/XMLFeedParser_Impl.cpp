@@ -0,0 +1,69 @@
+//
+// Class: XMLFeedParser_Impl
+//
+// Description: Incremental parser implementation. Chunks fed are appended to a source
+// whose input ends where the chunks so far do; a reader parses it a token at a time and
+// each token is passed on to the handler as it is completed. A token that runs past the
+// input held is abandoned (the reader and source returning to where it started) and parsed
+// again once more input has arrived. So that a large token arriving in many small chunks is
+// not rescanned for each one, it is only tried again once the input held has doubled.
+//
+// Dependencies: C++20 - Language standard features used.
+//
+
+#include "XMLFeedParser_Impl.hpp"
+
+namespace XML_Lib {
+
+/// <summary>
+/// XMLFeedParser_Impl constructor.
+/// </summary>
+/// <param name="handler">Handler receiving the parse events.</param>
+/// <param name="options">Parse options.</param>
+XMLFeedParser_Impl::XMLFeedParser_Impl(IParseHandler &handler, const ParseOptions &options)
+  : handler(handler), reader(source, options)
+{}
+
+/// <summary>
+/// Parse the next chunk of the document.
+/// </summary>
+/// <param name="chunk">Next chunk of the document.</param>
+void XMLFeedParser_Impl::feed(const std::span<const char> chunk)
+{
+  if (source.isFinished()) { XML_LIB_THROW(XMLFeedParser::Error("Chunk fed after the end of the document.")); }
+  source.append(chunk);
+  if (source.available() >= retryAt) { parseAvailable(); }
+}
+
+/// <summary>
+/// Mark the end of the document and parse what remains of it.
+/// </summary>
+void XMLFeedParser_Impl::finish()
+{
+  if (source.isFinished()) { return; }
+  source.finish();
+  parseAvailable();
+}
+
+/// <summary>
+/// Parse and report as many tokens as the input held completes.
+/// </summary>
+void XMLFeedParser_Impl::parseAvailable()
+{
+  if (!source.isReady()) { return; }
+  while (!complete) {
+    const auto mark = source.mark();
+    const auto checkpoint = reader.checkpoint();
+    try {
+      complete = reader.next() == XMLReader::TokenType::endOfDocument;
+    } catch (const FeedSource::Incomplete &) {
+      source.rewind(mark);
+      reader.rollback(checkpoint);
+      retryAt = 2 * source.available();
+      return;
+    }
+    reader.report(handler);
+  }
+}
+
+}// namespace XML_Lib
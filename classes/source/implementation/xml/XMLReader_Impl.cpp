@@ -0,0 +1,334 @@
+//
+// Class: XMLReader_Impl
+//
+// Description: Pull parser implementation. The document is parsed an item at a
+// time using the grammar steps of Default_Parser, the events each step reports
+// being queued as tokens to be returned by next(). Tokens refer into the source's
+// input (or the attributes of the start tag just parsed) for anything that needed
+// no decoding, copying only what did. Skipped subtrees are not parsed: their content
+// is only scanned for the markup that balances their start and end tags.
+//
+// Dependencies: C++20 - Language standard features used.
+//
+
+#include "XMLReader_Impl.hpp"
+
+namespace XML_Lib {
+
+/// <summary>
+/// XMLReader_Impl constructor.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="options">Parse options.</param>
+XMLReader_Impl::XMLReader_Impl(ISource &source, const ParseOptions &options)
+  : source(source), input(source.contents()),
+    nameTable(XML_NameTable::forParse(options.nameTable))
+{
+  parser.beginDocument(options);
+  if (options.inSitu) { parser.setInSituInput(source.inSituContents()); }
+  tokens.resize(1);
+  tokenCount = 1;
+}
+
+/// <summary>
+/// Move to the next token, parsing as far as needed to produce it.
+/// </summary>
+/// <returns>Type of the new current token.</returns>
+XMLReader::TokenType XMLReader_Impl::next()
+{
+  XML_NameTable::ScopedCurrentNameTable scopedNameTable(*nameTable);
+  if (currentToken + 1 < tokenCount) {
+    currentToken++;
+  } else {
+    tokenCount = 0;
+    currentToken = 0;
+    while (tokenCount == 0) { step(); }
+  }
+  return current().type;
+}
+
+/// <summary>
+/// Skip the contents of the current start element, making its end element the
+/// current token. Content not yet parsed is only scanned to find the element's end
+/// tag, so nothing within it is checked for well-formedness.
+/// </summary>
+void XMLReader_Impl::skipSubtree()
+{
+  if (current().type != XMLReader::TokenType::startElement) {
+    XML_LIB_THROW(XMLReader::Error("The current token is not a start element."));
+  }
+  XML_NameTable::ScopedCurrentNameTable scopedNameTable(*nameTable);
+  // An element from an entity's replacement has already been queued whole
+  const long elementDepth = current().depth;
+  while (currentToken + 1 < tokenCount) {
+    currentToken++;
+    if (current().type == XMLReader::TokenType::endElement && current().depth == elementDepth) { return; }
+  }
+  tokenCount = 0;
+  currentToken = 0;
+  Default_Parser::scanElementContent(source);
+  closeElement();
+}
+
+/// <summary>
+/// Pass the contents of the current start element on to a handler rather than
+/// returning them as tokens, making its end element the current token.
+/// </summary>
+/// <param name="handler">Handler to receive the parse events of the contents.</param>
+void XMLReader_Impl::readSubtree(IParseHandler &handler)
+{
+  if (current().type != XMLReader::TokenType::startElement) {
+    XML_LIB_THROW(XMLReader::Error("The current token is not a start element."));
+  }
+  XML_NameTable::ScopedCurrentNameTable scopedNameTable(*nameTable);
+  // An element from an entity's replacement has already been queued whole
+  const long elementDepth = current().depth;
+  while (currentToken + 1 < tokenCount) {
+    currentToken++;
+    if (current().type == XMLReader::TokenType::endElement && current().depth == elementDepth) { return; }
+    report(handler);
+  }
+  // Otherwise its content is parsed straight to the handler before parsing its end
+  tokenCount = 0;
+  currentToken = 0;
+  parser.skipElementContent(source, handler);
+  closeElement();
+}
+
+/// <summary>
+/// Save the reader state before parsing the next token.
+/// </summary>
+/// <returns>Reader state to return to with rollback().</returns>
+XMLReader_Impl::Checkpoint XMLReader_Impl::checkpoint() const
+{
+  return { state, openElements.size(), tokenDepth, parser.saveItemState() };
+}
+
+/// <summary>
+/// Abandon the tokens of a parse that was cut short, returning to the state before it.
+/// Open elements are only removed once their end tag is parsed whole, so one cut short
+/// can only have added to them.
+/// </summary>
+/// <param name="checkpoint">Reader state saved before the parse.</param>
+void XMLReader_Impl::rollback(const Checkpoint &checkpoint)
+{
+  state = checkpoint.state;
+  openElements.resize(checkpoint.openElementCount);
+  tokenDepth = checkpoint.tokenDepth;
+  tokenCount = 0;
+  currentToken = 0;
+  parser.restoreItemState(checkpoint.parserState);
+}
+
+/// <summary>
+/// Pass the current token on to a handler as the parse event it was queued from.
+/// </summary>
+/// <param name="handler">Handler to receive the event.</param>
+void XMLReader_Impl::report(IParseHandler &handler) const
+{
+  switch (tokenType()) {
+  case XMLReader::TokenType::declaration: {
+    const auto declaration = attributes();
+    handler.onDeclaration(declaration[0].getParsed(), declaration[1].getParsed(), declaration[2].getParsed());
+    break;
+  }
+  case XMLReader::TokenType::startElement:
+    handler.onStartElement(name(), attributes(), isSelfClosing());
+    break;
+  case XMLReader::TokenType::endElement:
+    handler.onEndElement(name());
+    break;
+  case XMLReader::TokenType::characters:
+    handler.onCharacters(value(), isWhiteSpace());
+    break;
+  case XMLReader::TokenType::cdata:
+    handler.onCDATA(value());
+    break;
+  case XMLReader::TokenType::comment:
+    handler.onComment(value());
+    break;
+  case XMLReader::TokenType::pi:
+    handler.onPI(name(), value());
+    break;
+  case XMLReader::TokenType::startEntityReference:
+    handler.onStartEntityReference(XMLValue{ name(), value() });
+    break;
+  case XMLReader::TokenType::endEntityReference:
+    handler.onEndEntityReference(XMLValue{ name(), value() });
+    break;
+  default:
+    break;
+  }
+}
+/// <summary>
+/// Parse the next item of the document, queuing the tokens it produces.
+/// </summary>
+void XMLReader_Impl::step()
+{
+  switch (state) {
+  case State::declaration:
+    Default_Parser::parseDeclaration(source, *this);
+    state = State::prolog;
+    break;
+  case State::prolog:
+    if (source.more() && parser.parsePrologItem(source, *this)) { break; }
+    Default_Parser::parseRootStart(source);
+    openElement();
+    break;
+  case State::content:
+    if (!source.more() || match(source, "</")) {
+      closeElement();
+    } else if (!parser.parseContentItem(source, *this)) {
+      openElement();
+    }
+    break;
+  case State::epilog:
+    if (source.more()) {
+      Default_Parser::parseEpilogItem(source, *this);
+    } else {
+      state = State::finished;
+    }
+    break;
+  case State::finished:
+    addToken(XMLReader::TokenType::endOfDocument);
+    break;
+  }
+}
+
+/// <summary>
+/// Parse the start tag of an element, which stays open until its end tag is parsed
+/// unless it is self-closing.
+/// </summary>
+void XMLReader_Impl::openElement()
+{
+  tagInput = source.peekUtf8();
+  auto tag = parser.parseStartTag(source, *this, startTagAttributes);
+  if (tag.isSelfClosing) {
+    parser.parseEndTag(source, *this, tag);
+  } else {
+    openElements.push_back(std::move(tag));
+  }
+  state = openElements.empty() ? State::epilog : State::content;
+}
+
+/// <summary>
+/// Parse the end tag of the innermost open element (its "</" already consumed).
+/// </summary>
+void XMLReader_Impl::closeElement()
+{
+  tagInput = source.peekUtf8();
+  parser.parseEndTag(source, *this, openElements.back());
+  openElements.pop_back();
+  if (openElements.empty()) { state = State::epilog; }
+}
+
+/// <summary>
+/// Queue a token, reusing the storage of any token previously held in its place.
+/// Its name and value are only copied if they are not views into the source's input.
+/// </summary>
+/// <param name="type">Token type.</param>
+/// <param name="name">Token name.</param>
+/// <param name="value">Token value.</param>
+/// <returns>Reference to the token queued.</returns>
+XMLReader_Impl::Token &XMLReader_Impl::addToken(const XMLReader::TokenType type,
+  const std::string_view name,
+  const std::string_view value)
+{
+  if (tokenCount == tokens.size()) { tokens.emplace_back(); }
+  auto &token = tokens[tokenCount++];
+  token.type = type;
+  token.name = keep(name, token.nameStorage);
+  token.value = keep(value, token.valueStorage);
+  token.attributes = {};
+  token.flag = false;
+  token.depth = tokenDepth;
+  return token;
+}
+
+/// <summary>
+/// Return a view of text that is valid until the next token is parsed: text within the
+/// source's input is viewed where it is, anything else (decoded or built by the parser)
+/// is copied into storage.
+/// </summary>
+/// <param name="text">Text reported by the parser.</param>
+/// <param name="storage">Storage of the token the text is for.</param>
+/// <returns>View of the text.</returns>
+std::string_view XMLReader_Impl::keep(const std::string_view text, std::string &storage) const
+{
+  if (text.empty() || isWithin(text, input)) { return text; }
+  storage.assign(text);
+  return storage;
+}
+
+/// <summary>
+/// Return an element name reported by the parser (which reads names into strings of its
+/// own) as a view into the source's input if that is where the tag just parsed was read from.
+/// </summary>
+/// <param name="name">Element name.</param>
+/// <returns>View of the name in the input, or the name passed if it is not there.</returns>
+std::string_view XMLReader_Impl::tagName(const std::string_view name) const
+{
+  if (isWithin(tagInput, input) && tagInput.starts_with(name)) { return tagInput.substr(0, name.size()); }
+  return name;
+}
+
+void XMLReader_Impl::onDeclaration(const std::string_view version,
+  const std::string_view encoding,
+  const std::string_view standalone)
+{
+  auto &token = addToken(XMLReader::TokenType::declaration);
+  token.attributeStorage.clear();
+  token.attributeStorage.emplace_back("version", XMLValue{ version, version });
+  token.attributeStorage.emplace_back("encoding", XMLValue{ encoding, encoding });
+  token.attributeStorage.emplace_back("standalone", XMLValue{ standalone, standalone });
+  token.attributes = token.attributeStorage;
+}
+
+void XMLReader_Impl::onStartElement(const std::string_view name,
+  const std::span<const XMLAttribute> attributes,
+  const bool isSelfClosing)
+{
+  auto &token = addToken(XMLReader::TokenType::startElement, tagName(name));
+  // Those of an element from an entity's replacement are gone once it has been parsed
+  if (attributes.data() == startTagAttributes.data()) {
+    token.attributes = attributes;
+  } else {
+    token.attributeStorage.assign(attributes.begin(), attributes.end());
+    token.attributes = token.attributeStorage;
+  }
+  token.flag = isSelfClosing;
+  tokenDepth++;
+}
+
+void XMLReader_Impl::onEndElement(const std::string_view name)
+{
+  tokenDepth--;
+  addToken(XMLReader::TokenType::endElement, tagName(name));
+}
+
+void XMLReader_Impl::onCharacters(const std::string_view characters, const bool isWhiteSpace)
+{
+  addToken(XMLReader::TokenType::characters, {}, characters).flag = isWhiteSpace;
+}
+
+void XMLReader_Impl::onCDATA(const std::string_view cdata) { addToken(XMLReader::TokenType::cdata, {}, cdata); }
+
+void XMLReader_Impl::onComment(const std::string_view comment) { addToken(XMLReader::TokenType::comment, {}, comment); }
+
+void XMLReader_Impl::onPI(const std::string_view name, const std::string_view parameters)
+{
+  addToken(XMLReader::TokenType::pi, name, parameters);
+}
+
+void XMLReader_Impl::onStartEntityReference(const XMLValue &reference)
+{
+  addToken(XMLReader::TokenType::startEntityReference, reference.getUnparsed(), reference.getParsed());
+}
+
+void XMLReader_Impl::onEndEntityReference(const XMLValue &reference)
+{
+  addToken(XMLReader::TokenType::endEntityReference, reference.getUnparsed(), reference.getParsed());
+}
+
+void XMLReader_Impl::onDTD([[maybe_unused]] Node &dtd) { addToken(XMLReader::TokenType::dtd); }
+}// namespace XML_Lib
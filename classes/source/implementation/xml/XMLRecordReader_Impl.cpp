@@ -0,0 +1,113 @@
+//
+// Class: XMLRecordReader_Impl
+//
+// Description: Record reader implementation. The document is read a token at a time
+// by a reader; elements not on the record path have their subtrees skipped, while an
+// element at the end of it has its subtree passed to a tree builder to make the record.
+// The elements on the path that the reader is in are kept (without their contents) so
+// that the namespaces they declare are in scope for each record. Records are built in
+// an arena that is released when the next record is read, so they take no more memory
+// than the largest one.
+//
+// Dependencies: C++20 - Language standard features used.
+//
+
+#include "XMLRecordReader_Impl.hpp"
+
+namespace XML_Lib {
+
+/// <summary>
+/// Split a record path ("/feed/entry") into its element names.
+/// </summary>
+/// <param name="recordPath">Absolute path of element names.</param>
+/// <returns>Element names of path.</returns>
+static std::vector<std::string> splitRecordPath(const std::string_view recordPath)
+{
+  if (!recordPath.starts_with("/") || recordPath.size() == 1) {
+    XML_LIB_THROW(XMLRecordReader::Error("Invalid record path '" + std::string(recordPath) + "'."));
+  }
+  std::vector<std::string> path;
+  for (std::size_t start = 1, end = 0; start <= recordPath.size(); start = end + 1) {
+    end = std::min(recordPath.find('/', start), recordPath.size());
+    if (end == start) { XML_LIB_THROW(XMLRecordReader::Error("Invalid record path '" + std::string(recordPath) + "'.")); }
+    path.emplace_back(recordPath.substr(start, end - start));
+  }
+  return path;
+}
+
+/// <summary>
+/// XMLRecordReader_Impl constructor.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="recordPath">Absolute path of element names to the records.</param>
+/// <param name="options">Parse options.</param>
+XMLRecordReader_Impl::XMLRecordReader_Impl(ISource &source, const std::string_view recordPath, const ParseOptions &options)
+  : path(splitRecordPath(recordPath)), reader(source, options)
+{}
+
+/// <summary>
+/// Read as far as the next record and build its tree.
+/// </summary>
+/// <returns>True if a record was read, false if the document has been read.</returns>
+bool XMLRecordReader_Impl::next()
+{
+  // The last record is freed before the arena it was built in is reused
+  currentRecord = Node{};
+  recordArena.release();
+  // Records and the elements on their path share the reader's names, kept from one record to the next
+  XML_NameTable::ScopedCurrentNameTable scopedNameTable(reader.getNameTable());
+  while (true) {
+    switch (reader.next()) {
+    case XMLReader::TokenType::endOfDocument:
+      return false;
+    case XMLReader::TokenType::startElement: {
+      const auto depth = static_cast<std::size_t>(reader.depth());
+      if (depth >= path.size() || (path[depth] != "*" && path[depth] != reader.name())) {
+        if (!reader.isSelfClosing()) { reader.skipSubtree(); }
+      } else if (depth + 1 == path.size()) {
+        buildRecord();
+        count++;
+        return true;
+      } else if (!reader.isSelfClosing()) {
+        XMLNameSpaceScope::Pointer nameSpaces;
+        if (!ancestors.empty()) { nameSpaces = NRef<Element>(ancestors.back()).getNameSpaceScope(); }
+        ancestors.push_back(Node::make<Element>(reader.name(), reader.attributes(), nameSpaces));
+      }
+      break;
+    }
+    case XMLReader::TokenType::endElement:
+      while (ancestors.size() > static_cast<std::size_t>(reader.depth())) { ancestors.pop_back(); }
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+/// <summary>
+/// Return the current record.
+/// </summary>
+/// <returns>Root (or Self) Node of record.</returns>
+const Node &XMLRecordReader_Impl::record() const
+{
+  if (currentRecord.isEmpty()) { XML_LIB_THROW(XMLRecordReader::Error("There is no current record.")); }
+  return currentRecord;
+}
+
+/// <summary>
+/// Build the tree of the record whose start element is the reader's current token,
+/// leaving its end element the current token.
+/// </summary>
+void XMLRecordReader_Impl::buildRecord()
+{
+  XMLNameSpaceScope::Pointer nameSpaces;
+  if (!ancestors.empty()) { nameSpaces = NRef<Element>(ancestors.back()).getNameSpaceScope(); }
+  XML_TreeBuilder treeBuilder{ XML_AllocationContext{ &recordArena, &reader.getNameTable() }, nameSpaces };
+  const std::string name{ reader.name() };
+  treeBuilder.onStartElement(name, reader.attributes(), reader.isSelfClosing());
+  if (!reader.isSelfClosing()) { reader.readSubtree(treeBuilder); }
+  treeBuilder.onEndElement(name);
+  auto prolog = treeBuilder.releaseProlog();
+  currentRecord = std::move(prolog.getChildren().front());
+}
+}// namespace XML_Lib
@@ -0,0 +1,195 @@
+//
+// Class: XMLTape_Impl
+//
+// Description: Tape implementation. The document is parsed with the default parser
+// reporting to a tape builder, so no Node tree is made; the tape is then read by
+// index. As a node's descendants directly follow it on the tape, its first child and
+// the extent of its subtree are found without any links to them being stored.
+//
+// Dependencies: C++20 - Language standard features used.
+//
+
+#include "XML_TapeBuilder.hpp"
+#if defined(XML_LIB_ENABLE_XPATH)
+#include "XPath_Impl.hpp"
+#endif
+
+namespace XML_Lib {
+
+/// <summary>
+/// XMLTape_Impl constructor; parse a document into the tape.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="options">Parse options.</param>
+XMLTape_Impl::XMLTape_Impl(ISource &source, const ParseOptions &options)
+  : nameTable(XML_NameTable::forParse(options.nameTable))
+{
+  XML_NameTable::ScopedCurrentNameTable scopedNameTable(*nameTable);
+  XML_EntityMapper entityMapper;
+  Default_Parser parser{ entityMapper };
+  XML_TapeBuilder tapeBuilder{ *this };
+  parser.parse(source, tapeBuilder, options);
+  tapeBuilder.finish();
+}
+
+/// <summary>
+/// Return the document root element node.
+/// </summary>
+/// <returns>Root element node.</returns>
+XMLTapeNode XMLTape_Impl::root() const
+{
+  for (auto child = firstChild(0); child != kNoNode; child = nextSibling(child)) {
+    if (kinds[child] == Kind::root) { return { this, child }; }
+  }
+  XML_LIB_THROW(XMLTape::Error("No root element found."));
+}
+
+/// <summary>
+/// Return the number of bytes of memory held by the tape's arrays and text.
+/// </summary>
+/// <returns>Bytes held by tape.</returns>
+std::size_t XMLTape_Impl::memoryUsed() const
+{
+  return kinds.capacity() * sizeof(Kind) + names.capacity() * sizeof(XML_NameTable::Symbol)
+         + (parents.capacity() + nextSiblings.capacity() + textOffsets.capacity() + textLengths.capacity()
+             + firstAttributes.capacity() + attributeValueOffsets.capacity() + attributeValueLengths.capacity())
+             * sizeof(std::uint32_t)
+         + attributeNames.capacity() * sizeof(XML_NameTable::Symbol) + text.capacity();
+}
+
+/// <summary>
+/// Traverse the tape in document order calling the ITapeAction method for each node.
+/// </summary>
+/// <param name="action">Action methods to call during traversal.</param>
+void XMLTape_Impl::traverse(ITapeAction &action) const
+{
+  for (std::uint32_t index = 0; index < kinds.size(); index++) {
+    const XMLTapeNode tapeNode{ this, index };
+    action.onNode(tapeNode);
+    switch (kinds[index]) {
+    case Kind::prolog:
+      action.onProlog(tapeNode);
+      break;
+    case Kind::declaration:
+      action.onDeclaration(tapeNode);
+      break;
+    case Kind::root:
+      action.onRoot(tapeNode);
+      break;
+    case Kind::element:
+      action.onElement(tapeNode);
+      break;
+    case Kind::self:
+      action.onSelf(tapeNode);
+      break;
+    case Kind::content:
+      action.onContent(tapeNode);
+      break;
+    case Kind::cdata:
+      action.onCDATA(tapeNode);
+      break;
+    case Kind::comment:
+      action.onComment(tapeNode);
+      break;
+    case Kind::pi:
+      action.onPI(tapeNode);
+      break;
+    }
+  }
+}
+
+/// <summary>
+/// Find a node's attribute by name.
+/// </summary>
+/// <param name="index">Node index.</param>
+/// <param name="name">Attribute name.</param>
+/// <returns>Attribute (0 to attribute count - 1), or kNoNode if not found.</returns>
+std::uint32_t XMLTape_Impl::findAttribute(const std::uint32_t index, const std::string_view name) const
+{
+  const auto symbol = nameTable->find(name);
+  if (symbol == XML_NameTable::kNoSymbol) { return kNoNode; }
+  for (auto attribute = firstAttributes[index]; attribute < firstAttributes[index + 1]; attribute++) {
+    if (attributeNames[attribute] == symbol) { return attribute - firstAttributes[index]; }
+  }
+  return kNoNode;
+}
+
+/// <summary>
+/// Append the text of the content and CDATA nodes of a node and its descendants.
+/// </summary>
+/// <param name="index">Node index.</param>
+/// <param name="contents">String to append to.</param>
+void XMLTape_Impl::appendContents(const std::uint32_t index, std::string &contents) const
+{
+  for (auto descendant = index, end = subtreeEnd(index); descendant < end; descendant++) {
+    if (kinds[descendant] == Kind::content || kinds[descendant] == Kind::cdata) { contents += value(descendant); }
+  }
+}
+
+/// <summary>
+/// Append the text of just the content nodes of a node and its descendants; this is
+/// its string value for XPath, which like that of a Node tree leaves out CDATA.
+/// </summary>
+/// <param name="index">Node index.</param>
+/// <param name="value">String to append to.</param>
+void XMLTape_Impl::appendStringValue(const std::uint32_t index, std::string &value) const
+{
+  for (auto descendant = index, end = subtreeEnd(index); descendant < end; descendant++) {
+    if (kinds[descendant] == Kind::content) { value += this->value(descendant); }
+  }
+}
+
+/// <summary>
+/// Return the XPath string value of a node. The text of a node with only one content
+/// node in its subtree is returned where it is on the tape.
+/// </summary>
+/// <param name="index">Node index.</param>
+/// <param name="scratch">String the value is built in if it must be.</param>
+/// <returns>String value of node.</returns>
+std::string_view XMLTape_Impl::stringValue(const std::uint32_t index, std::string &scratch) const
+{
+  auto content = kNoNode;
+  for (auto descendant = index, end = subtreeEnd(index); descendant < end; descendant++) {
+    if (kinds[descendant] != Kind::content) { continue; }
+    if (content != kNoNode) {
+      scratch.clear();
+      appendStringValue(index, scratch);
+      return scratch;
+    }
+    content = descendant;
+  }
+  return content != kNoNode ? value(content) : std::string_view{};
+}
+
+/// <summary>
+/// Find the URI of the namespace of an element's name, declared on it or an ancestor.
+/// </summary>
+/// <param name="index">Element node index.</param>
+/// <returns>Namespace URI (empty if it is in none).</returns>
+std::string_view XMLTape_Impl::namespaceURI(const std::uint32_t index) const
+{
+  const auto elementName = name(index);
+  const auto colon = elementName.find(':');
+  const std::string declaration = colon == std::string_view::npos
+                                    ? std::string("xmlns")
+                                    : "xmlns:" + std::string(elementName.substr(0, colon));
+  for (auto element = index; element != kNoNode; element = parents[element]) {
+    if (const auto attribute = findAttribute(element, declaration); attribute != kNoNode) {
+      return attributeValue(element, attribute);
+    }
+  }
+  return {};
+}
+
+#if defined(XML_LIB_ENABLE_XPATH)
+/// <summary>
+/// Evaluate an XPath expression against the tape.
+/// </summary>
+/// <param name="expression">XPath expression.</param>
+/// <returns>Matching nodes.</returns>
+std::vector<XMLTapeNode> XMLTape_Impl::xpath(const std::string_view expression) const
+{
+  return XPath_Impl(*this).evaluateTape(expression);
+}
+#endif
+}// namespace XML_Lib
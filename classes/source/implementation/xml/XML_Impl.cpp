@@ -48,7 +48,7 @@ XML_Impl::XML_Impl(IStringify *stringify, IParser *parser)
 #endif
 }
 
-XML_Impl::~XML_Impl() = default;
+XML_Impl::~XML_Impl() { freeDocument(); }
 
 std::string XML_Impl::version()
 {
@@ -107,11 +107,66 @@ std::vector<const Node *> XML_Impl::xpath(const std::string_view expression)
 }
 #endif
 
+/// <summary>
+/// Parse into a tree allocated as context directs, for a parser that allocates nodes
+/// only where current (the context is current on this thread for the whole parse).
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="options">Parse options.</param>
+/// <param name="context">Where the document's nodes and names are allocated.</param>
+/// <returns>Prolog Node.</returns>
+Node IParser::parse(ISource &source, const ParseOptions &options, const XML_AllocationContext &context)
+{
+  const XML_AllocationContext::Scope scope(context);
+  return parse(source, options);
+}
+
 void XML_Impl::parse(ISource &source, const ParseOptions &options)
 {
-  XML_Arena::ScopedCurrentArena scopedCurrentArena(arena);
-  XML_Arena::ScopedDefaultResource scopedDefaultResource(arena);
-  xmlRoot = xmlParser->parse(source, options);
+  // The document's arena and name table are passed to the parser, not made current on this thread
+  auto parseNameTable = XML_NameTable::forParse(options.nameTable);
+  // Anything left by a parse that failed was destroyed as the failure unwound
+  if (parseArena == nullptr) {
+    parseArena = std::make_unique<XML_Arena>();
+  } else {
+    parseArena->release();
+  }
+  Node parsed = xmlParser->parse(source, options, XML_AllocationContext{ parseArena.get(), parseNameTable.get() });
+  // The last document's arena is freed whole and kept for the next parse
+  freeDocument();
+  xmlRoot = std::move(parsed);
+  std::swap(documentArena, parseArena);
+  if (parseArena != nullptr) { parseArena->release(); }
+  documentNameTable = std::move(parseNameTable);
+}
+
+/// <summary>
+/// Free the document's nodes ahead of releasing the arena they were allocated from. Only
+/// the nodes of the prolog besides the root element are destroyed (the declaration and DTD
+/// own memory from elsewhere); the root element and all nested in it are left for the
+/// arena's release to free whole. If nodes allocated on the heap have been added to the
+/// document (by addChild(), or found among the children of a node handed out to be changed),
+/// every node is destroyed one by one instead.
+/// </summary>
+void XML_Impl::freeDocument() noexcept
+{
+  if (xmlRoot.isEmpty()) { return; }
+  const auto hasHeapChild = [](const Variant *variant) {
+    return std::ranges::any_of(std::as_const(*variant).getChildren(), &Node::isHeapAllocated);
+  };
+  if (!documentArena->hasForeignNodes() && !documentArena->anyExposedChildren(hasHeapChild)) {
+    for (auto &child : xmlRoot.getChildren()) {
+      if (isA<Root>(child) || isA<Self>(child)) { child.releaseToArena(); }
+    }
+  }
+  xmlRoot = Node{};
+}
+void XML_Impl::parse(ISource &source, IParseHandler &handler, const ParseOptions &options)
+{
+  // Names reported are only valid during the parse, so need a table only for as long
+  const auto nameTable = XML_NameTable::forParse(options.nameTable);
+  XML_NameTable::ScopedCurrentNameTable scopedNameTable(*nameTable);
+  xmlParser->parse(source, handler, options);
 }
 #if defined(XML_LIB_ENABLE_STRINGIFY)
 void XML_Impl::stringify(IDestination &destination) { xmlStringifier->stringify(prolog(), destination, 0); }
@@ -120,6 +175,8 @@ void XML_Impl::stringify(IDestination &destination) { xmlStringifier->stringify(
 void XML_Impl::traverse(IAction &action)
 {
   if (xmlRoot.isEmpty()) { XML_LIB_THROW(Error("No XML to traverse.")); }
+  // The action may change any node, so the document is no longer just dropped with its arena
+  documentArena->addForeignNodes();
   traverseNodes(xmlRoot, action);
 }
 void XML_Impl::traverse(IAction &action) const
@@ -127,4 +184,19 @@ void XML_Impl::traverse(IAction &action) const
   if (xmlRoot.isEmpty()) { XML_LIB_THROW(Error("No XML to traverse.")); }
   traverseNodes(xmlRoot, action);
 }
+
+/// <summary>
+/// Free the child storage of every node of the document beyond that of the children it holds.
+/// </summary>
+void XML_Impl::compact()
+{
+  if (xmlRoot.isEmpty()) { XML_LIB_THROW(Error("No XML to compact.")); }
+  std::vector<const Node *> nodes{ &xmlRoot };
+  while (!nodes.empty()) {
+    const Node *xNode = nodes.back();
+    nodes.pop_back();
+    xNode->compactChildren();
+    for (auto &child : xNode->getChildren()) { nodes.push_back(&child); }
+  }
+}
 }// namespace XML_Lib
@@ -11,9 +11,9 @@
 //
 
 #include "XML_Impl.hpp"
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
-#include <sstream>
 #include <string_view>
 
 namespace XML_Lib {
@@ -70,37 +70,71 @@ void writeXMLString(std::ofstream &xmlFile, const std::u16string &xmlString, con
 /// </summary>
 /// <param name="xmlFile">XML file stream</param>
 /// <returns>XML string.</returns>
-std::string readXMLString(const std::ifstream &xmlFile)
+std::string readXMLString(std::ifstream &xmlFile)
 {
-  std::ostringstream xmlFileBuffer;
-  xmlFileBuffer << xmlFile.rdbuf();
-  return xmlFileBuffer.str();
+  const auto start = xmlFile.tellg();
+  xmlFile.seekg(0, std::ios_base::end);
+  std::string xmlString(static_cast<std::size_t>(xmlFile.tellg() - start), ' ');
+  xmlFile.seekg(start);
+  xmlFile.read(xmlString.data(), static_cast<std::streamsize>(xmlString.size()));
+  return xmlString;
 }
+/// <summary>
+/// Read UTF-16 XML string from a file stream, translating each CRLF and each
+/// lone CR to LF as the code units are decoded.
+/// </summary>
+/// <param name="xmlFile">XML file stream</param>
+/// <param name="format">XML file format</param>
+/// <returns>XML string.</returns>
 std::u16string readXMLString(std::ifstream &xmlFile, const XML::Format format)
 {
-  std::u16string utf16String;
+  if (format != XML::Format::utf16BE && format != XML::Format::utf16LE) {
+    XML_LIB_THROW(Error("Unsupported XML file format (Byte Order Mark) specified in call to readXMLString()."));
+  }
   // Move past byte order mark
   xmlFile.seekg(2);
-  if (format == XML::Format::utf16BE)
-    while (true) {
-      char16_t ch16 = static_cast<unsigned char>(xmlFile.get()) << 8;
-      ch16 |= static_cast<unsigned char>(xmlFile.get());
-      if (xmlFile.eof()) break;
-      utf16String.push_back(ch16);
-    }
-  else if (format == XML::Format::utf16LE) {
-    while (true) {
-      char16_t ch16 = static_cast<unsigned char>(xmlFile.get());
-      ch16 |= static_cast<unsigned char>(xmlFile.get()) << 8;
-      if (xmlFile.eof()) break;
-      utf16String.push_back(ch16);
+  const std::string bytes{ readXMLString(xmlFile) };
+  const std::size_t high = format == XML::Format::utf16BE ? 0 : 1;
+  std::u16string utf16String;
+  utf16String.reserve(bytes.size() / 2);
+  bool afterCarriageReturn = false;
+  for (std::size_t index = 0; index + 1 < bytes.size(); index += 2) {
+    const auto ch16 = static_cast<char16_t>(static_cast<unsigned char>(bytes[index + high]) << 8
+                                            | static_cast<unsigned char>(bytes[index + 1 - high]));
+    if (ch16 != kLineFeed || !afterCarriageReturn) {
+      utf16String.push_back(ch16 == kCarriageReturn ? static_cast<char16_t>(kLineFeed) : ch16);
     }
-  } else {
-    XML_LIB_THROW(Error("Unsupported XML file format (Byte Order Mark) specified in call to readXMLString()."));
+    afterCarriageReturn = ch16 == kCarriageReturn;
   }
   return utf16String;
 }
 
+/// <summary>
+/// Translate the line breaks of an XML string to LF in a single pass (XML 1.0
+/// section 2.11): each CRLF and each CR not followed by LF becomes LF, each run
+/// of characters between them being moved down just once.
+/// </summary>
+/// <param name="xmlString">XML string</param>
+static void translateLineBreaks(std::string &xmlString)
+{
+  std::size_t carriageReturn = xmlString.find(kCarriageReturn);
+  std::size_t translatedEnd = carriageReturn;
+  while (carriageReturn != std::string::npos) {
+    xmlString[translatedEnd++] = kLineFeed;
+    // Keep what follows the line break up to the next carriage return
+    std::size_t runStart = carriageReturn + 1;
+    if (runStart < xmlString.size() && xmlString[runStart] == kLineFeed) { runStart++; }
+    const std::size_t nextCarriageReturn = xmlString.find(kCarriageReturn, runStart);
+    const std::size_t runEnd = nextCarriageReturn == std::string::npos ? xmlString.size() : nextCarriageReturn;
+    std::copy(xmlString.begin() + static_cast<std::ptrdiff_t>(runStart),
+      xmlString.begin() + static_cast<std::ptrdiff_t>(runEnd),
+      xmlString.begin() + static_cast<std::ptrdiff_t>(translatedEnd));
+    translatedEnd += runEnd - runStart;
+    carriageReturn = nextCarriageReturn;
+  }
+  if (translatedEnd != std::string::npos) { xmlString.resize(translatedEnd); }
+}
+
 /// <summary>
 /// Return format of an XML file after checking for any byte order marks at
 /// the beginning of the XML file.
@@ -125,8 +159,8 @@ XML::Format XML_Impl::getFileFormat(const std::string_view &fileName)
 
 /// <summary>
 /// Open a XML file, read its contents into a string buffer and return
-/// the buffer. Note any CRLF in the source file are translated to just a
-/// LF internally.
+/// the buffer. Note any CRLF or lone CR in the source file are translated to
+/// just a LF internally.
 /// </summary>
 /// <param name="filePath">XML file path</param>
 /// <returns>XML string.</returns>
@@ -134,7 +168,6 @@ std::string XML_Impl::fromFile(const std::filesystem::path &filePath)
 {
   validateFilePath(filePath);
   const std::string fileName = filePath.string();
-  const auto kCRLF = "\x0D\x0A";
   // Get a file format
   const XML::Format format = getFileFormat(fileName);
   // Read in XML
@@ -145,22 +178,17 @@ std::string XML_Impl::fromFile(const std::filesystem::path &filePath)
     xmlFile.seekg(3);// Move past the byte order mark
   case XML::Format::utf8:
     translated = readXMLString(xmlFile);
+    translateLineBreaks(translated);
     break;
   case XML::Format::utf16BE:
   case XML::Format::utf16LE:
+    // Line breaks are translated as the UTF-16 is decoded
     translated = toUtf8(readXMLString(xmlFile, format));
     break;
   default:
     XML_LIB_THROW(Error("Unsupported XML file format (Byte Order Mark) encountered."));
   }
   xmlFile.close();
-  // Translate CRLF -> LF
-  size_t pos = translated.find(kCRLF);
-  while (pos != std::string::npos) {
-    const auto kLF = "\x0A";
-    translated.replace(pos, 2, kLF);
-    pos = translated.find(kCRLF, pos + 1);
-  }
   return translated;
 }
 
@@ -1,82 +1,70 @@
 //
 // Class: XML_Parser
 //
-// Description: XML parser code. All parsings of characters take place having
-// converted the characters to UTF-16 to make the process easier (any data once
-// parsed is stored in UTF-8 strings).
+// Description: XML parser code. Characters are examined as UTF-16 code units but
+// names, text and values are built directly from the source's UTF-8 bytes when
+// it holds UTF-8 input (any data once parsed is stored in UTF-8 strings). What is
+// parsed is reported to an IParseHandler; the Node tree is built by XML_TreeBuilder.
+// Parsed in situ (ParseOptions::inSitu), attribute values and text needing no decoding
+// are left in the caller's input rather than copied.
 //
 // Dependencies: C++20 - Language standard features used.
 //
 
 #include "Default_Parser.hpp"
+
+#include <array>
 #if defined(XML_LIB_ENABLE_DTD)
 #include "DTD_Validator.hpp"
 #endif
 
 namespace XML_Lib {
 
+// Bytes on the stack for the attributes of a start tag, and the number of attributes reserved there
+static constexpr std::size_t kAttributeBufferSize{ 1024 };
+static constexpr std::size_t kAttributesReserved{ 8 };
+// Markup an item of element content can start with, indexed by Default_Parser::ContentMarkup
+static constexpr std::array<std::string_view, 6> kContentMarkup{ "</", "<!--", "<?", "<![CDATA[", "<", "]]>" };
+
 /// <summary>
-/// Add content Node to element's child list.
+/// Is text made up only of whitespace.
 /// </summary>
-/// <param name="xNode">Current element Node.</param>
-/// <param name="content">Content to add to new content Node (XMLNodeContent).</param>
-void addContentToElementChildList(Node &xNode, const std::string_view &content)
+/// <param name="text">Text to check.</param>
+/// <returns>True if text is all whitespace.</returns>
+static bool isWhiteSpaceText(const std::string_view &text)
 {
-  // Make sure there is a content Node to receive characters
-  if (xNode.getChildren().empty() || !isA<Content>(xNode.getChildren().back())) {
-    bool isWhiteSpace = true;
-    if (!xNode.getChildren().empty()) {
-      if (isA<CDATA>(xNode.getChildren().back()) || isA<EntityReference>(xNode.getChildren().back())) {
-        isWhiteSpace = false;
-      }
-    }
-    xNode.addChild(Node::make<Content>("", isWhiteSpace));
-  }
-  auto &xmlContent = NRef<Content>(xNode.getChildren().back());
-  if (xmlContent.isWhiteSpace()) {
-    if (std::ranges::all_of(content, [](const char ch) { return std::iswspace(ch); })) {
-      xmlContent.setIsWhiteSpace(true);
-    } else {
-      xmlContent.setIsWhiteSpace(false);
-    }
-  }
-  xmlContent.addContent(content);
+  return std::ranges::all_of(text, [](const char ch) { return isWS(static_cast<unsigned char>(ch)); });
 }
 
 /// <summary>
-/// Parse entity reference as XML and add Nodes produced to the current Node.
+/// Parse entity reference replacement as XML reporting what it contains.
 /// </summary>
-/// <param name="xNode">Current element Node.</param>
+/// <param name="handler">Parse event handler.</param>
 /// <param name="entityReference">Entity reference to be parsed for XML.</param>
-/// <param name="entityMapper">Entity mapper interface object.</param>
-void Default_Parser::parseEntityReferenceXML(Node &xNode, const XMLValue &entityReference, IEntityMapper &entityMapper)
+void Default_Parser::parseEntityReferenceXML(IParseHandler &handler, const XMLValue &entityReference)
 {
-  auto xElement = Node::make<Element>();
   BufferSource entitySource(entityReference.getParsed());
-  // Parse entity XML
-  while (entitySource.more()) { parseElementInternal(entitySource, xNode, entityMapper); }
-  // Place into Node (element) child list
-  for (auto &child : xElement.getChildren()) { xNode.addChild(child); }
+  while (entitySource.more()) { parseElementInternal(entitySource, handler); }
 }
 
 /// <summary>
 /// Parse any comments, PI or whitespace in prolog/epilog of the XML file.
 /// </summary>
 /// <param name="source">XML source stream.</param>
-/// <param name="xProlog">XML prolog Node.</param>
+/// <param name="handler">Parse event handler.</param>
 /// <returns>True then items parsed.</returns>
-bool Default_Parser::tryParseCommentOrPI(ISource &source, Node &xNode)
+bool Default_Parser::tryParseCommentOrPI(ISource &source, IParseHandler &handler)
 {
-  if (match(source, "<!--")) { xNode.addChild(parseComment(source)); return true; }
-  if (match(source, "<?"))   { xNode.addChild(parsePI(source));      return true; }
+  if (match(source, "<!--")) { parseComment(source, handler); return true; }
+  if (match(source, "<?"))   { parsePI(source, handler);      return true; }
   return false;
 }
 
-bool Default_Parser::parseCommentsPIAndWhiteSpace(ISource &source, Node &xProlog)
+bool Default_Parser::parseCommentsPIAndWhiteSpace(ISource &source, IParseHandler &handler)
 {
-  if (tryParseCommentOrPI(source, xProlog)) { return true; }
+  if (tryParseCommentOrPI(source, handler)) { return true; }
   if (isWS(source)) {
-    parseWhiteSpaceToContent(source, xProlog);
+    parseWhiteSpaceToContent(source, handler);
     return true;
   }
   return false;
@@ -116,63 +104,134 @@ std::string Default_Parser::parseDeclarationAttribute(ISource &source,
 }
 
 /// <summary>
-/// Parse a XML comment, create a XComment for it and add to the list
-/// of elements for the current XElement.
+/// Parse a XML comment and report it.
 /// </summary>
 /// <param name="source">XML source stream.</param>
-/// <returns>Pointer to comment Node.</returns>
-Node Default_Parser::parseComment(ISource &source)
+/// <param name="handler">Parse event handler.</param>
+void Default_Parser::parseComment(ISource &source, IParseHandler &handler)
 {
-  String comment;
+  std::string comment;
   comment.reserve(64);
-  while (source.more() && !match(source, "--")) {
-    comment += source.current();
-    source.next();
-  }
+  readUntil(source, comment, "--");
   if (!match(source, ">")) { XML_LIB_THROW(SyntaxError(source.getPosition(), "Missing closing '>' for comment line.")); }
-  return Node::make<Comment>(toUtf8(comment));
+  handler.onComment(comment);
 }
 
 /// <summary>
-/// Parse an XML process instruction, create an XPI for it and add it to
-/// the list of elements under the current XElement.
+/// Parse an XML process instruction and report it.
 /// </summary>
 /// <param name="source">XML source stream.</param>
-/// <returns>Pointer to PI Node.</returns>
-Node Default_Parser::parsePI(ISource &source)
+/// <param name="handler">Parse event handler.</param>
+void Default_Parser::parsePI(ISource &source, IParseHandler &handler)
 {
   std::string name{ parseName(source) };
   // Check not a declaration
   if (name == "xml") {
     XML_LIB_THROW(SyntaxError(source.getPosition(), "Declaration allowed only at the start of the document."));
   }
-  String parameters;
+  std::string parameters;
   parameters.reserve(64);
-  while (source.more() && !match(source, "?>")) {
-    parameters += source.current();
-    source.next();
+  if (!readUntil(source, parameters, "?>")) {
+    XML_LIB_THROW(SyntaxError(source.getPosition(), "Missing closing '?>' for processing instruction."));
+  }
+  handler.onPI(name, parameters);
+}
+
+// CDATA section delimiters
+static constexpr std::string_view kCDATAEnd{ "]]>" };
+static constexpr std::string_view kCDATAStart{ "<![CDATA[" };
+
+/// <summary>
+/// Read CDATA section text from a span of source characters (UTF-8 bytes or UTF-16).
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="cdata">CDATA text read so far.</param>
+/// <param name="span">Span at the current source position.</param>
+/// <returns>True once the end of the section has been consumed.</returns>
+template<typename CharT>
+static bool readCDATASpan(ISource &source, std::string &cdata, const std::basic_string_view<CharT> span)
+{
+  static const std::basic_string<CharT> end(kCDATAEnd.begin(), kCDATAEnd.end());
+  static const std::basic_string<CharT> start(kCDATAStart.begin(), kCDATAStart.end());
+  const auto endPosition = span.find(end);
+  if (const auto nested = span.substr(0, endPosition).find(start); nested != std::basic_string_view<CharT>::npos) {
+    skipScanned<CharT>(source, nested, { kCDATAEnd, kCDATAStart });
+    skipSpan<CharT>(source, kCDATAStart.size());
+    XML_LIB_THROW(SyntaxError(source.getPosition(), "Nesting of CDATA sections is not allowed."));
+  }
+  if (endPosition != std::basic_string_view<CharT>::npos) {
+    appendSpan(cdata, span.substr(0, endPosition));
+    skipScanned<CharT>(source, endPosition, { kCDATAEnd, kCDATAStart });
+    skipSpan<CharT>(source, kCDATAEnd.size());
+    return true;
+  }
+  // Keep back enough characters for a nested start straddling the end of the span
+  if (const auto safe = safePrefix(span, kCDATAStart.size()); safe > 0) {
+    appendSpan(cdata, span.substr(0, safe));
+    skipScanned<CharT>(source, safe, { kCDATAEnd, kCDATAStart });
+  } else {
+    appendCurrent(source, cdata);
   }
-  return Node::make<PI>(name, toUtf8(parameters));
+  return false;
 }
 
 /// <summary>
-/// Parse an XML CDATA section, create an XCDATA for it and add it to
-/// the list of elements under the current XElement.
+/// Parse an XML CDATA section and report it.
 /// </summary>
 /// <param name="source">XML source stream.</param>
-/// <returns>Pointer to CDATA Node.</returns>
-Node Default_Parser::parseCDATA(ISource &source)
+/// <param name="handler">Parse event handler.</param>
+void Default_Parser::parseCDATA(ISource &source, IParseHandler &handler)
 {
-  String cdata;
+  std::string cdata;
   cdata.reserve(128);
-  while (source.more() && !match(source, "]]>") ) {
-    if (match(source, "<![CDATA[")) {
-      XML_LIB_THROW(SyntaxError(source.getPosition(), "Nesting of CDATA sections is not allowed."));
+  bool ended = false;
+  while (!ended && source.more()) {
+    if (const auto bytes = source.peekUtf8(); bytes.size() >= kCDATAStart.size()) {
+      ended = readCDATASpan(source, cdata, bytes);
+    } else if (const auto span = source.peek(); span.size() >= kCDATAStart.size()) {
+      ended = readCDATASpan(source, cdata, span);
+    } else if (match(source, kCDATAEnd)) {
+      ended = true;
+    } else {
+      if (match(source, kCDATAStart)) {
+        XML_LIB_THROW(SyntaxError(source.getPosition(), "Nesting of CDATA sections is not allowed."));
+      }
+      appendCurrent(source, cdata);
     }
-    cdata += source.current();
-    source.next();
   }
-  return Node::make<CDATA>(toUtf8(cdata));
+  if (!ended) { XML_LIB_THROW(SyntaxError(source.getPosition(), "Missing closing ']]>' for CDATA section.")); }
+  handler.onCDATA(cdata);
+}
+
+/// <summary>
+/// Parse an attribute value that is a run of plain characters (no references, or line
+/// breaks to normalise) within the source's UTF-8 span and add the attribute with it,
+/// straight from the span. The value is left in situ if it lies within the caller's input.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="name">Attribute name.</param>
+/// <param name="attributes">Attributes of the start tag being parsed.</param>
+/// <returns>False (nothing consumed) if the value is not such a run.</returns>
+bool Default_Parser::parsePlainAttribute(ISource &source,
+  const std::string_view &name,
+  std::pmr::vector<XMLAttribute> &attributes) const
+{
+  const auto bytes = source.peekUtf8();
+  if (bytes.empty() || (bytes.front() != '"' && bytes.front() != '\'')) { return false; }
+  const char quote = bytes.front();
+  const auto run = leadingRun(bytes.substr(1), [quote](const Char ch) {
+    return ch != static_cast<Char>(quote) && ch != '&' && ch != '<' && validChar(ch);
+  });
+  if (run + 1 >= bytes.size() || bytes[run + 1] != quote) { return false; }
+  const auto value = bytes.substr(1, run);
+  if (isWithin(value, inSituInput)) {
+    attributes.push_back(XMLAttribute::inSitu(name, value, quote));
+  } else {
+    attributes.emplace_back(name, value, quote);
+  }
+  source.skipUtf8(static_cast<long>(run + 2));
+  ignoreWS(source);
+  return true;
 }
 
 /// <summary>
@@ -180,192 +239,482 @@ Node Default_Parser::parseCDATA(ISource &source)
 /// the list of attributes associated with the current XElement.
 /// </summary>
 /// <param name="source">XML source stream.</param>
-/// <param name="entityMapper">Entity mapper interface object.</param>
-/// <returns>XML element attribute list.</returns>
-std::vector<XMLAttribute> Default_Parser::parseAttributes(ISource &source, IEntityMapper &entityMapper)
+/// <param name="attributes">XML element attribute list.</param>
+void Default_Parser::parseAttributes(ISource &source, std::pmr::vector<XMLAttribute> &attributes)
 {
-  std::vector<XMLAttribute> attributes{};
-  attributes.reserve(8);
   while (source.more() && source.current() != '/' && source.current() != '>') {
     std::string attributeName{ parseName(source) };
     if (!match(source, "=")) {
       XML_LIB_THROW(SyntaxError(source.getPosition(), "Missing '=' between attribute name and value."));
     }
     ignoreWS(source);
-    XMLValue attributeValue = parseValue(source, entityMapper);
-    if (!validAttributeValue(attributeValue.getParsed(), attributeValue.getQuote())) {
-      XML_LIB_THROW(SyntaxError(source.getPosition(), "Attribute value contains invalid character '<', '\"', ''' or '&'."));
-    }
-    if (XMLAttribute::contains(attributes, attributeName)) {
-      XML_LIB_THROW(SyntaxError("Attribute '" + attributeName + "' defined more than once within start tag."));
+    // A duplicate is left to the full parse, so that errors are reported in the same order
+    if (XMLAttribute::contains(attributes, attributeName) || !parsePlainAttribute(source, attributeName, attributes)) {
+      XMLValue attributeValue = parseValue(source, entityMapper);
+      if (!validAttributeValue(attributeValue.getParsed(), attributeValue.getQuote())) {
+        XML_LIB_THROW(SyntaxError(source.getPosition(), "Attribute value contains invalid character '<', '\"', ''' or '&'."));
+      }
+      if (XMLAttribute::contains(attributes, attributeName)) {
+        XML_LIB_THROW(SyntaxError("Attribute '" + attributeName + "' defined more than once within start tag."));
+      }
+      attributes.emplace_back(attributeName, attributeValue);
     }
-    attributes.emplace_back(attributeName, attributeValue);
-    if (attributes.size() > maxAttributeCount) {
+    if (attributes.size() > parseOptions.maxAttributeCount) {
       XML_LIB_THROW(SyntaxError("Maximum attribute count exceeded."));
     }
   }
-  return attributes;
 }
 
 /// <summary>
-/// Parse white spaces and add to the current Nodes child list.
+/// Parse white spaces and report them as characters.
 /// </summary>
 /// <param name="source">XML source stream.</param>
-/// <param name="xNode">Current Node.</param>
-void Default_Parser::parseWhiteSpaceToContent(ISource &source, Node &xNode)
+/// <param name="handler">Parse event handler.</param>
+void Default_Parser::parseWhiteSpaceToContent(ISource &source, IParseHandler &handler)
 {
-  String whiteSpace;
+  std::string whiteSpace;
   whiteSpace.reserve(32);
-  while (source.more() && isWS(source)) {
-    whiteSpace += source.current();
-    source.next();
-  }
-  addContentToElementChildList(xNode, toUtf8(whiteSpace));
-}
-
-/// <summary>
-/// Mark the trailing Content child of xNode as non-whitespace, if one exists.
-/// </summary>
-/// <param name="xNode">Current element Node.</param>
-static void markTrailingContentNonWhitespace(Node &xNode)
-{
-  if (!xNode.getChildren().empty()) {
-    if (isA<Content>(xNode.getChildren().back())) {
-      NRef<Content>(xNode.getChildren().back()).setIsWhiteSpace(false);
-    }
-  }
+  readWhile(source, whiteSpace, [](const Char ch) { return isWS(ch); });
+  handler.onCharacters(whiteSpace, true);
 }
 
 /// <summary>
-/// Append a parsed character value to xNode as entity reference or plain content.
+/// Report a parsed character value as a reference or as plain characters. The
+/// replacement of a reference is reported between its start and end events, an
+/// entity's replacement being parsed as XML.
 /// </summary>
-/// <param name="xNode">Current element Node.</param>
+/// <param name="handler">Parse event handler.</param>
 /// <param name="value">Parsed character value.</param>
-/// <param name="entityMapper">Entity mapper interface object.</param>
-void Default_Parser::appendEntityOrContent(Node &xNode, const XMLValue &value, IEntityMapper &entityMapper)
+void Default_Parser::reportEntityOrContent(IParseHandler &handler, const XMLValue &value)
 {
   if (value.isReference()) {
     XMLValue content = value;
     if (content.isEntityReference()) { content = entityMapper.map(content); }
-    auto xEntityReference = Node::make<EntityReference>(content);
+    handler.onStartEntityReference(content);
     if (content.isEntityReference()) {
-      if (entityExpansionDepth >= maxEntityExpansionDepth) {
+      if (entityExpansionDepth >= parseOptions.maxEntityExpansionDepth) {
         XML_LIB_THROW(SyntaxError("Entity expansion depth limit exceeded."));
       }
       ++entityExpansionDepth;
-      // Does entity contain start tag ?
-      // YES then XML into current element list
-      if (content.getParsed().starts_with("<")) {
-        parseEntityReferenceXML(xNode, content, entityMapper);
-        --entityExpansionDepth;
-        return;
-      }
-      // NO XML into entity elements list.
-      parseEntityReferenceXML(xEntityReference, content, entityMapper);
+      parseEntityReferenceXML(handler, content);
       --entityExpansionDepth;
-      markTrailingContentNonWhitespace(xNode);
+    } else {
+      handler.onCharacters(content.getParsed(), isWhiteSpaceText(content.getParsed()));
     }
-    xNode.addChild(std::move(xEntityReference));
+    handler.onEndEntityReference(content);
   } else {
-    addContentToElementChildList(xNode, value.getParsed());
+    handler.onCharacters(value.getParsed(), isWhiteSpaceText(value.getParsed()));
   }
 }
 
 /// <summary>
-/// Parse any content found inside an element.
+/// Parse any content found inside an element. Character data is scanned as a run up
+/// to the next markup or reference and added in one go; references and any character
+/// needing a closer look (']' or one that is invalid) are parsed singly.
 /// </summary>
 /// <param name="source">XML source stream.</param>
-/// <param name="xNode">Current element Node.</param>
-/// <param name="entityMapper">Entity mapper interface object.</param>
-void Default_Parser::parseContent(ISource &source, Node &xNode, IEntityMapper &entityMapper)
+/// <param name="handler">Parse event handler.</param>
+void Default_Parser::parseContent(ISource &source, IParseHandler &handler)
 {
-  appendEntityOrContent(xNode, parseCharacter(source), entityMapper);
+  bool isWhiteSpace = true;
+  const auto isText = [&isWhiteSpace](const Char ch) {
+    if (!validTextChar(ch)) { return false; }
+    isWhiteSpace = isWhiteSpace && isWS(ch);
+    return true;
+  };
+  // A run ending within the source's UTF-8 span is reported straight from it (before moving
+  // on, which may refill and so invalidate the span)
+  if (const auto bytes = source.peekUtf8(); !bytes.empty()) {
+    if (const auto run = leadingRun(bytes, isText); run > 0 && run < bytes.size()) {
+      handler.onCharacters(bytes.substr(0, run), isWhiteSpace);
+      source.skipUtf8(static_cast<long>(run));
+      return;
+    }
+    isWhiteSpace = true;
+  }
+  std::string content;
+  readWhile(source, content, isText);
+  if (content.empty()) {
+    reportEntityOrContent(handler, parseCharacter(source));
+  } else {
+    handler.onCharacters(content, isWhiteSpace);
+  }
 }
 
 /// <summary>
-/// Parse element internal area, generating any Node(s) and adding them
-/// to the child list of the current XElement. This can be anything from
-/// comments, program instructions, CDATA, nested elements or even content.
+/// Find any namespace prefix used by an element's name or attributes that has not
+/// been declared by it or an element it is nested in.
 /// </summary>
-/// <param name="source">XML source stream.</param>
-/// <param name="xNode">Current element Node.</param>
-/// <param name="entityMapper">Entity mapper interface object.</param>
-void Default_Parser::parseElementInternal(ISource &source, Node &xNode, IEntityMapper &entityMapper)
+/// <param name="name">Element name.</param>
+/// <param name="attributes">Element attributes.</param>
+/// <returns>Error message for the first prefix not declared or empty if all are.</returns>
+std::string Default_Parser::findUndefinedNameSpace(const std::string_view &name, std::span<const XMLAttribute> attributes) const
 {
-  if (tryParseCommentOrPI(source, xNode)) {
-    // comment or PI handled
-  } else if (match(source, "<![CDATA[")) {
-    markTrailingContentNonWhitespace(xNode);
-    xNode.addChild(parseCDATA(source));
-  } else if (match(source, "<")) {
-    xNode.addChild(parseElement(source, NRef<Element>(xNode).getNameSpaces(), entityMapper));
-    const Element &xNodeChildElement = NRef<Element>(xNode.getChildren().back());
-    if (const auto pos = xNodeChildElement.name().find(':'); pos != std::string::npos) {
-      if (!xNodeChildElement.hasNameSpace(xNodeChildElement.name().substr(0, pos))) {
-        XML_LIB_THROW(SyntaxError(source.getPosition(), "Namespace used but not defined."));
-      }
-    }
-    for (const auto &attr : xNodeChildElement.getAttributes()) {
-      if (!attr.getName().starts_with("xmlns")) {
-        if (const auto attrPos = attr.getName().find(':'); attrPos != std::string::npos) {
-          if (!xNodeChildElement.hasNameSpace(attr.getName().substr(0, attrPos))) {
-            XML_LIB_THROW(SyntaxError(
-              source.getPosition(), "Namespace used but not defined in attribute '" + attr.getName() + "'."));
-          }
+  if (const auto pos = name.find(':'); pos != std::string_view::npos) {
+    if (!XMLAttribute::contains(nameSpaces, name.substr(0, pos))) { return "Namespace used but not defined."; }
+  }
+  for (const auto &attr : attributes) {
+    if (!attr.getName().starts_with("xmlns")) {
+      if (const auto attrPos = attr.getName().find(':'); attrPos != std::string_view::npos) {
+        if (!XMLAttribute::contains(nameSpaces, attr.getName().substr(0, attrPos))) {
+          return "Namespace used but not defined in attribute '" + std::string(attr.getName()) + "'.";
         }
       }
     }
-  } else {
-    if (match(source, "</")) { XML_LIB_THROW(SyntaxError(source.getPosition(), "Missing closing tag.")); }
-    if (match(source, "]]>")) { XML_LIB_THROW(SyntaxError(source.getPosition(), "']]>' invalid in element content area.")); }
-    parseContent(source, xNode, entityMapper);
   }
+  return "";
 }
 
 /// <summary>
-/// Parse the current XML element found.
+/// Match the markup (if any) that the next item of an element's content starts with,
+/// consuming it. Each kind of markup is tried in turn as if matched singly (so the source
+/// position is kept as it would be), but the source is looked at only once for them all.
 /// </summary>
 /// <param name="source">XML source stream.</param>
-/// <param name="namespaces">Current list of outer namespaces.</param>
-/// <param name="entityMapper">Entity mapper interface object.</param>
-/// <returns>Pointer to element Node.</returns>
-Node Default_Parser::parseElement(ISource &source,
-  std::span<const XMLAttribute> namespaces,
-  IEntityMapper &entityMapper)
+/// <param name="endTagAllowed">True if the content may end here with an end tag.</param>
+/// <returns>Markup matched, or none if the item is character data.</returns>
+Default_Parser::ContentMarkup Default_Parser::matchContentMarkup(ISource &source, const bool endTagAllowed)
 {
-  // Parse tag and attributes
-  const std::string name{ parseTagName(source) };
-  const std::vector attributes{ parseAttributes(source, entityMapper) };
-  // Create element Node
-  if (Node xNode; match(source, ">")) {
-    // Normal element tag
-    if (!hasRoot) {
-      xNode = Node::make<Root>(name, attributes, namespaces);
-      hasRoot = true;
-    } else {
-      xNode = Node::make<Element>(name, attributes, namespaces);
+  if (endTagAllowed) { return static_cast<ContentMarkup>(matchFirst(source, kContentMarkup)); }
+  return static_cast<ContentMarkup>(matchFirst(source, std::span(kContentMarkup).subspan(1)) + 1);
+}
+
+/// <summary>
+/// Parse the next item of an element's content, reporting it, unless it is a nested
+/// element in which case only its opening '<' is consumed. This can be anything from
+/// comments, program instructions, CDATA or content.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="handler">Parse event handler.</param>
+/// <returns>False if the start tag of a nested element is next.</returns>
+bool Default_Parser::parseContentItem(ISource &source, IParseHandler &handler)
+{
+  return parseContentItem(source, handler, matchContentMarkup(source, false));
+}
+
+/// <summary>
+/// Parse the item of an element's content whose starting markup has been matched.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="handler">Parse event handler.</param>
+/// <param name="markup">Markup matched (and consumed) at the start of the item.</param>
+/// <returns>False if the item is a nested element (its start tag still to be parsed).</returns>
+bool Default_Parser::parseContentItem(ISource &source, IParseHandler &handler, const ContentMarkup markup)
+{
+  switch (markup) {
+  case ContentMarkup::comment:
+    parseComment(source, handler);
+    break;
+  case ContentMarkup::pi:
+    parsePI(source, handler);
+    break;
+  case ContentMarkup::cdata:
+    parseCDATA(source, handler);
+    break;
+  case ContentMarkup::startTag:
+    return false;
+  case ContentMarkup::cdataEnd:
+    XML_LIB_THROW(SyntaxError(source.getPosition(), "']]>' invalid in element content area."));
+  default:
+    parseContent(source, handler);
+    break;
+  }
+  return true;
+}
+
+/// <summary>
+/// Parse element internal area, reporting anything found there including any
+/// nested element as a whole.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="handler">Parse event handler.</param>
+void Default_Parser::parseElementInternal(ISource &source, IParseHandler &handler)
+{
+  if (!parseContentItem(source, handler)) { parseElement(source, handler); }
+}
+
+/// <summary>
+/// Parse an element's start tag (its opening '<' already consumed) and report it,
+/// bringing any namespaces it declares into scope. The element is open (nested in
+/// by what follows) until its end tag is parsed.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="handler">Parse event handler.</param>
+/// <returns>What is needed to parse the element's end.</returns>
+Default_Parser::ElementTag Default_Parser::parseStartTag(ISource &source, IParseHandler &handler)
+{
+  // Attributes are gathered on the stack (unless there are too many), the element taking copies
+  std::array<std::byte, kAttributeBufferSize> attributeBuffer;
+  std::pmr::monotonic_buffer_resource attributeResource{ attributeBuffer.data(), attributeBuffer.size() };
+  std::pmr::vector<XMLAttribute> attributes{ &attributeResource };
+  attributes.reserve(kAttributesReserved);
+  return parseStartTag(source, handler, attributes);
+}
+
+/// <summary>
+/// Parse an element's start tag as above, gathering its attributes in the caller's list
+/// (emptied first) so that they can outlive the parse.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="handler">Parse event handler.</param>
+/// <param name="attributes">List the attributes of the start tag are parsed into.</param>
+/// <returns>What is needed to parse the element's end.</returns>
+Default_Parser::ElementTag
+  Default_Parser::parseStartTag(ISource &source, IParseHandler &handler, std::pmr::vector<XMLAttribute> &attributes)
+{
+  ElementTag tag{ .name = parseTagName(source), .outerNameSpaces = nameSpaces.size() };
+  attributes.clear();
+  parseAttributes(source, attributes);
+  for (const auto &attribute : attributes) {
+    if (attribute.getName().starts_with("xmlns")) {
+      nameSpaces.emplace_back(attribute.getName().size() > 5 ? attribute.getName().substr(6) : ":",
+        XMLValue{ attribute.getUnparsed(), attribute.getParsed() });
     }
-    xNode.reserveChildren(8);
-    if (elementNestingDepth >= maxElementNestingDepth) {
+  }
+  // Namespace use is not checked for the root element; any error is reported at the element's end
+  if (elementNestingDepth > 0) { tag.nameSpaceError = findUndefinedNameSpace(tag.name, attributes); }
+  if (match(source, ">")) {
+    // Normal element tag
+    if (elementNestingDepth >= parseOptions.maxNestingDepth) {
       XML_LIB_THROW(SyntaxError(source.getPosition(), "Maximum element nesting depth exceeded."));
     }
+    handler.onStartElement(tag.name, attributes, false);
     ++elementNestingDepth;
-    while (source.more() && !match(source, "</")) { parseElementInternal(source, xNode, entityMapper); }
-    --elementNestingDepth;
-    if (match(source, toUtf16(NRef<Element>(xNode).name()) + u">")) { return xNode; }
   } else if (match(source, "/>")) {
     // Self-closing element tag
-    return Node::make<Self>(name, attributes, namespaces);
+    handler.onStartElement(tag.name, attributes, true);
+    tag.isSelfClosing = true;
+  } else {
+    XML_LIB_THROW(SyntaxError(source.getPosition(), "Missing closing tag."));
+  }
+  return tag;
+}
+
+/// <summary>
+/// Parse the end of an element (the name and '>' of its end tag, whose "</" has already
+/// been consumed, unless it is self-closing) and report it.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="handler">Parse event handler.</param>
+/// <param name="tag">Element start tag details.</param>
+void Default_Parser::parseEndTag(ISource &source, IParseHandler &handler, const ElementTag &tag)
+{
+  if (!tag.isSelfClosing) {
+    --elementNestingDepth;
+    // Matched straight from the source's UTF-8 span when it holds the name and '>'
+    if (const auto bytes = source.peekUtf8();
+        bytes.size() > tag.name.size() && bytes.starts_with(tag.name) && bytes[tag.name.size()] == '>') {
+      source.skipUtf8(static_cast<long>(tag.name.size() + 1));
+    } else if (!match(source, tag.name + ">")) {
+      XML_LIB_THROW(SyntaxError(source.getPosition(), "Missing closing tag."));
+    }
+  }
+  if (!tag.nameSpaceError.empty()) { XML_LIB_THROW(SyntaxError(source.getPosition(), tag.nameSpaceError)); }
+  nameSpaces.erase(nameSpaces.begin() + static_cast<std::ptrdiff_t>(tag.outerNameSpaces), nameSpaces.end());
+  handler.onEndElement(tag.name);
+}
+
+/// <summary>
+/// Parse the current XML element found, reporting its start, contents and end.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="handler">Parse event handler.</param>
+void Default_Parser::parseElement(ISource &source, IParseHandler &handler)
+{
+  const ElementTag tag{ parseStartTag(source, handler) };
+  if (!tag.isSelfClosing) { skipElementContent(source, handler); }
+  parseEndTag(source, handler, tag);
+}
+
+/// <summary>
+/// Parse the content of an open element up to and including the "</" of its end tag.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="handler">Parse event handler.</param>
+void Default_Parser::skipElementContent(ISource &source, IParseHandler &handler)
+{
+  while (source.more()) {
+    const auto markup = matchContentMarkup(source, true);
+    if (markup == ContentMarkup::endTag) { return; }
+    if (!parseContentItem(source, handler, markup)) { parseElement(source, handler); }
+  }
+}
+
+namespace {
+/// <summary>
+/// Scanner of element content that looks only for the markup starting and ending
+/// elements, fed a character at a time (UTF-8 bytes, or UTF-16 characters narrowed
+/// so that only ASCII matches). Comments, CDATA sections, processing instructions and
+/// the quoted attribute values of start tags are stepped over whole.
+/// </summary>
+class ContentScanner
+{
+public:
+  // Take the next character, returning true once it is the '/' of the end tag of the
+  // element being scanned
+  bool scan(const char ch)
+  {
+    switch (state) {
+    case State::text:
+      if (ch == '<') { state = State::markup; }
+      break;
+    case State::markup:
+      if (ch == '/') {
+        if (depth == 0) { return true; }
+        depth--;
+        state = State::endTag;
+      } else if (ch == '!') {
+        state = State::bang;
+      } else if (ch == '?') {
+        enter(State::pi);
+      } else {
+        state = State::startTag;
+        scanStartTag(ch);
+      }
+      break;
+    case State::startTag:
+      scanStartTag(ch);
+      break;
+    case State::startTagSlash:
+      if (ch == '>') {
+        state = State::text;
+      } else {
+        state = State::startTag;
+        scanStartTag(ch);
+      }
+      break;
+    case State::quoted:
+      if (ch == quote) { state = State::startTag; }
+      break;
+    case State::endTag:
+    case State::declaration:
+      if (ch == '>') { state = State::text; }
+      break;
+    case State::bang:
+      if (ch == '-') {
+        state = State::bangDash;
+      } else if (ch == '[') {
+        state = State::cdataStart;
+        opened = 0;
+      } else {
+        state = State::declaration;
+      }
+      break;
+    case State::bangDash:
+      enter(State::comment);
+      break;
+    case State::cdataStart:
+      // "CDATA[" follows "<!["
+      if (++opened == 6) { enter(State::cdata); }
+      break;
+    case State::comment:
+      closeOn(ch, '-', '-');
+      break;
+    case State::cdata:
+      closeOn(ch, ']', ']');
+      break;
+    case State::pi:
+      if (ch == '>' && previous[1] == '?') {
+        state = State::text;
+      } else {
+        previous[1] = ch;
+      }
+      break;
+    }
+    return false;
+  }
+
+private:
+  enum class State : uint8_t {
+    text,
+    markup,
+    startTag,
+    startTagSlash,
+    quoted,
+    endTag,
+    declaration,
+    bang,
+    bangDash,
+    cdataStart,
+    comment,
+    cdata,
+    pi
+  };
+  void scanStartTag(const char ch)
+  {
+    if (ch == '"' || ch == '\'') {
+      quote = ch;
+      state = State::quoted;
+    } else if (ch == '/') {
+      state = State::startTagSlash;
+    } else if (ch == '>') {
+      depth++;
+      state = State::text;
+    }
+  }
+  // Enter a comment, CDATA section or processing instruction, which no character yet precedes
+  void enter(const State construct)
+  {
+    state = construct;
+    previous[0] = previous[1] = '\0';
+  }
+  // Leave the construct on a '>' preceded by the two characters that end it
+  void closeOn(const char ch, const char first, const char second)
+  {
+    if (ch == '>' && previous[0] == first && previous[1] == second) {
+      state = State::text;
+    } else {
+      previous[0] = previous[1];
+      previous[1] = ch;
+    }
+  }
+  State state{ State::text };
+  std::size_t depth{ 0 };
+  int opened{ 0 };
+  char quote{ '"' };
+  char previous[2]{};
+};
+}// namespace
+
+/// <summary>
+/// Skip the content of an open element up to and including the "</" of its end tag,
+/// looking only for the markup that starts and ends elements. The source's UTF-8 spans
+/// are scanned a byte at a time and stepped over whole. As the content is not parsed,
+/// nothing in it is checked, so unlike skipElementContent() an error within it goes
+/// unreported.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+void Default_Parser::scanElementContent(ISource &source)
+{
+  // Bytes in the longest UTF-8 sequence
+  constexpr std::size_t kMaxUtf8Length{ 4 };
+  ContentScanner scanner;
+  while (source.more()) {
+    // A streaming source's span may end part way through a character, so only the characters
+    // wholly within it (keeping back the longest UTF-8 sequence) are scanned and skipped
+    const auto bytes = source.peekUtf8();
+    if (const auto safe = bytes.size() > kMaxUtf8Length ? safePrefix(bytes, kMaxUtf8Length) : 0; safe > 0) {
+      const auto scanned = bytes.substr(0, safe);
+      const auto found = std::ranges::find_if(scanned, [&scanner](const char ch) { return scanner.scan(ch); });
+      if (found != scanned.end()) {
+        source.skipUtf8(static_cast<long>(found - scanned.begin() + 1));
+        return;
+      }
+      source.skipUtf8(static_cast<long>(safe));
+    } else {
+      const Char ch = source.current();
+      source.next();
+      if (scanner.scan(ch < 0x80 ? static_cast<char>(ch) : '\0')) { return; }
+    }
   }
-  XML_LIB_THROW(SyntaxError(source.getPosition(), "Missing closing tag."));
 }
 
 /// <summary>
-/// Parse XML declaration and return Node for it.
+/// Parse XML declaration and report it (with default values if there is none).
 /// </summary>
 /// <param name="source">XML source stream.</param>
-/// <returns>Pointer to declaration Node.</returns>
-Node Default_Parser::parseDeclaration(ISource &source)
+/// <param name="handler">Parse event handler.</param>
+void Default_Parser::parseDeclaration(ISource &source, IParseHandler &handler)
 {
   std::string version{ "1.0" };
   std::string encoding{ "UTF-8" };
@@ -412,105 +761,213 @@ Node Default_Parser::parseDeclaration(ISource &source)
     }
     if (!match(source, "?>")) { XML_LIB_THROW(SyntaxError(source.getPosition(), "Declaration end tag not found.")); }
   }
-  return Node::make<Declaration>(version, encoding, standalone);
+  handler.onDeclaration(version, encoding, standalone);
 }
 
 /// <summary>
 /// Parse any XML tail that is present. This can include comments, PI and white space.
 /// </summary>
 /// <param name="source">XML source stream.</param>
-/// <param name="xProlog">Prolog Node.</param>
-void Default_Parser::parseEpilog(ISource &source, Node &xProlog)
+/// <param name="handler">Parse event handler.</param>
+void Default_Parser::parseEpilog(ISource &source, IParseHandler &handler)
 {
-  while (source.more()) {
-    if (!parseCommentsPIAndWhiteSpace(source, xProlog)) {
-      XML_LIB_THROW(SyntaxError(source.getPosition(), "Extra content at the end of document."));
-    }
+  while (source.more()) { parseEpilogItem(source, handler); }
+}
+
+/// <summary>
+/// Parse the next item of the epilog of the XML file.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="handler">Parse event handler.</param>
+void Default_Parser::parseEpilogItem(ISource &source, IParseHandler &handler)
+{
+  if (!parseCommentsPIAndWhiteSpace(source, handler)) {
+    XML_LIB_THROW(SyntaxError(source.getPosition(), "Extra content at the end of document."));
   }
 }
 
 /// <summary>
-/// Parse XML DTD and return any Node created for it.
+/// Parse XML DTD and report the Node created for it. The validator refers to the
+/// Node so is only kept if the handler takes the Node.
 /// </summary>
 /// <param name="source">XML source stream.</param>
-/// <param name="entityMapper">Entity mapper interface object.</param>
-/// <returns>Pointer to DTD Node.</returns>
+/// <param name="handler">Parse event handler.</param>
 #if defined(XML_LIB_ENABLE_DTD)
-Node Default_Parser::parseDTD(ISource &source, IEntityMapper &entityMapper)
+void Default_Parser::parseDTD(ISource &source, IParseHandler &handler)
 {
   if (validator != nullptr) { XML_LIB_THROW(SyntaxError(source.getPosition(), "More than one DOCTYPE declaration.")); }
-  auto xNode = Node::make<DTD>(entityMapper);
+  Node xNode;
+  {
+    const XML_Arena::ScopedCurrentArena scopedArena(allocationContext.arena);
+    xNode = Node::make<DTD>(entityMapper);
+  }
   validator = std::make_unique<DTD_Validator>(xNode);
   validator->parse(source);
-  return xNode;
+  handler.onDTD(xNode);
+  if (!xNode.isEmpty()) { validator.reset(); }
 }
 #else
-Node Default_Parser::parseDTD([[maybe_unused]] ISource &source, [[maybe_unused]] IEntityMapper &entityMapper)
+void Default_Parser::parseDTD([[maybe_unused]] ISource &source, [[maybe_unused]] IParseHandler &handler)
 {
   XML_LIB_THROW(SyntaxError(source.getPosition(), "DTD support disabled in this build."));
 }
 #endif
 /// <summary>
-/// Parse XML prolog and create the necessary element Nodes for it. Valid
-/// parts of the prolog include declaration (first line if present),
-/// processing instructions, comments, whitespace and a Document Type Declaration (DTD).
+/// Parse XML prolog reporting what is found. Valid parts of the prolog include
+/// declaration (first line if present), processing instructions, comments,
+/// whitespace and a Document Type Declaration (DTD).
 /// </summary>
 /// <param name="source">XML source stream.</param>
-/// <param name="entityMapper">Entity mapper interface object.</param>
-/// <returns>Pointer to prolog Node.</returns>
-Node Default_Parser::parseProlog(ISource &source, IEntityMapper &entityMapper)
+/// <param name="handler">Parse event handler.</param>
+void Default_Parser::parseProlog(ISource &source, IParseHandler &handler)
+{
+  parseDeclaration(source, handler);
+  while (source.more() && parsePrologItem(source, handler)) {}
+}
+
+/// <summary>
+/// Parse the next item of the prolog after the declaration.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="handler">Parse event handler.</param>
+/// <returns>False if what is next is a potential root element.</returns>
+bool Default_Parser::parsePrologItem(ISource &source, IParseHandler &handler)
 {
-  auto xProlog = Node::make<Prolog>();
-  xProlog.addChild(parseDeclaration(source));
-  while (source.more()) {
 #if defined(XML_LIB_ENABLE_DTD)
-    if (match(source, "<!DOCTYPE")) {
-      xProlog.addChild(parseDTD(source, entityMapper));
-    } else
-#endif
-    if (parseCommentsPIAndWhiteSpace(source, xProlog)) {
-    } else if (source.current() == '<') {
-      break;// --- Break out as potential root element detected ---
-    } else {
-      XML_LIB_THROW(SyntaxError(source.getPosition(), "Content detected before root element."));
-    }
+  if (match(source, "<!DOCTYPE")) {
+    parseDTD(source, handler);
+    return true;
   }
-  return xProlog;
+#endif
+  if (parseCommentsPIAndWhiteSpace(source, handler)) { return true; }
+  if (source.current() == '<') { return false; }
+  XML_LIB_THROW(SyntaxError(source.getPosition(), "Content detected before root element."));
 }
 
 /// <summary>
-/// Parse XML read from source stream into internal object generating an exception
-/// if a syntax error in the XML is found (not well-formed).
+/// Parse XML read from source stream reporting what is found to an event handler,
+/// generating an exception if a syntax error in the XML is found (not well-formed).
 /// </summary>
 /// <param name="source">XML source stream.</param>
-/// <returns>Prolog Node.</returns>
-Node Default_Parser::parse(ISource &source, const ParseOptions &options)
+/// <param name="handler">Parse event handler.</param>
+/// <param name="options">Parse options.</param>
+void Default_Parser::parseDocument(ISource &source, IParseHandler &handler, const ParseOptions &options)
+{
+  beginDocument(options);
+  if (options.inSitu) { inSituInput = source.inSituContents(); }
+  // Handle prolog
+  parseProlog(source, handler);
+  // Handle main body
+  parseRootStart(source);
+  parseElement(source, handler);
+  // Handle any epilog
+  parseEpilog(source, handler);
+}
+
+/// <summary>
+/// Reset the parser ready to parse a new document with the given options.
+/// </summary>
+/// <param name="options">Parse options.</param>
+void Default_Parser::beginDocument(const ParseOptions &options)
 {
   parseOptions = options;
   entityExpansionDepth = 0;
-  maxEntityExpansionDepth = options.maxEntityExpansionDepth;
   elementNestingDepth = 0;
-  maxElementNestingDepth = options.maxNestingDepth;
-  maxAttributeCount = options.maxAttributeCount;
   entityMapper.setExternalEntityPolicy(options.allowExternalEntities, options.entityResolver);
-  XML_Arena::ScopedCurrentArena scopedCurrentArena(arena);
-  XML_Arena::ScopedDefaultResource scopedDefaultResource(arena);
   // Reset XML before next parse
   entityMapper.reset();
-  hasRoot = false;
+  nameSpaces.clear();
   validator.reset();
-  // Handle prolog
-  Node xmlRoot = parseProlog(source, entityMapper);
-  // Handle main body
-  if (match(source, "<")) {
-    xmlRoot.addChild(parseElement(source, {}, entityMapper));
-  } else {
-    XML_LIB_THROW(SyntaxError(source.getPosition(), "Missing root element."));
+  inSituInput = {};
+}
+
+/// <summary>
+/// Save the parser state that parsing the next item may change.
+/// </summary>
+/// <returns>Parser state before the item.</returns>
+Default_Parser::ItemState Default_Parser::saveItemState() const
+{
+  return { nameSpaces.size(), elementNestingDepth, validator != nullptr };
+}
+
+/// <summary>
+/// Return the parser to its state before an item whose parse was cut short. Namespaces
+/// in scope are only removed once an end tag has been parsed whole, so an abandoned
+/// item can only have added to them.
+/// </summary>
+/// <param name="state">Parser state saved before the item.</param>
+void Default_Parser::restoreItemState(const ItemState &state)
+{
+  if (nameSpaces.size() > state.nameSpaceCount) {
+    nameSpaces.erase(nameSpaces.begin() + static_cast<std::ptrdiff_t>(state.nameSpaceCount), nameSpaces.end());
   }
-  // Handle any epilog
-  parseEpilog(source, xmlRoot);
-  return xmlRoot;
+  elementNestingDepth = state.elementNestingDepth;
+  if (!state.hasValidator) { validator.reset(); }
+}
+
+/// <summary>
+/// Parse the opening '<' of the root element that must follow the prolog.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+void Default_Parser::parseRootStart(ISource &source)
+{
+  if (!match(source, "<")) { XML_LIB_THROW(SyntaxError(source.getPosition(), "Missing root element.")); }
+}
+
+/// <summary>
+/// Parse XML read from source stream into internal object generating an exception
+/// if a syntax error in the XML is found (not well-formed). Nodes are allocated as
+/// this thread's current context directs.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="options">Parse options.</param>
+/// <returns>Prolog Node.</returns>
+Node Default_Parser::parse(ISource &source, const ParseOptions &options)
+{
+  return parse(source, options, XML_AllocationContext::current());
+}
+
+/// <summary>
+/// Parse XML read from source stream into internal object generating an exception
+/// if a syntax error in the XML is found (not well-formed). A document held in memory
+/// whole may have the children of its root element parsed on several threads; if it
+/// cannot be divided between them it is parsed again on this thread, so that any
+/// error is reported exactly as it would be otherwise. Nodes are allocated from the
+/// context's arena (that of the document being parsed into) if it has one.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="options">Parse options.</param>
+/// <param name="context">Where the document's nodes and names are allocated.</param>
+/// <returns>Prolog Node.</returns>
+Node Default_Parser::parse(ISource &source, const ParseOptions &options, const XML_AllocationContext &context)
+{
+  allocationContext = context;
+  // Names met by the grammar (those of attributes) go into the document's table
+  const XML_NameTable::ScopedCurrentNameTable scopedNameTable(*context.nameTable);
+  if (options.parseThreads != 1 && !source.contents().empty()) {
+    XML_TreeBuilder treeBuilder{ context };
+    if (parseInParallel(source, treeBuilder, options)) { return treeBuilder.releaseProlog(); }
+    source.reset();
+  }
+  XML_TreeBuilder treeBuilder{ context };
+  if (options.inSitu) { treeBuilder.setInSituInput(source.inSituContents()); }
+  parseDocument(source, treeBuilder, options);
+  return treeBuilder.releaseProlog();
 }
+
+/// <summary>
+/// Parse XML read from source stream reporting it to an event handler without
+/// building a tree.
+/// </summary>
+/// <param name="source">XML source stream.</param>
+/// <param name="handler">Parse event handler.</param>
+/// <param name="options">Parse options.</param>
+void Default_Parser::parse(ISource &source, IParseHandler &handler, const ParseOptions &options)
+{
+  allocationContext = XML_AllocationContext::current();
+  parseDocument(source, handler, options);
+}
+
 /// <summary>
 /// Validate XML against parsed DTD.
 /// </summary>
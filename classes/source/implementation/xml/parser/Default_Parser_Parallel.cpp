@@ -0,0 +1,210 @@
+//
+// Class: XML_Parser
+//
+// Description: Parallel parse of a document held in memory whole. The prolog and
+// root start tag are parsed on the calling thread, then the root element's content
+// is divided into shares at the start tags of elements speculated to be its
+// children (found by searching from evenly spaced offsets for the tag name of its
+// first child element). The split points are speculative, not known to be safe: a
+// tag name found may lie in a nested element, comment, CDATA section, processing
+// instruction or text, and it is only the parse that shows whether it did. Each share is parsed on its own thread by a worker with
+// its own parser, entity mapper and arena (a sub-arena of the document's), adding
+// names to the document's name table; a worker first parses the prolog and root
+// start tag itself so that it has the document's entities and namespaces.
+// The children built are then added to the root in document order.
+//
+// A share that does not start at a child of the root leaves the share before it
+// ending inside an element, comment, CDATA section or processing instruction. Each
+// share but the last is parsed on past its end, so the construct cut through is
+// read whole, and must end exactly where the share does; otherwise (or if any share
+// fails to parse) the document is parsed again on one thread.
+//
+// Dependencies: C++20 - Language standard features used.
+//
+
+#include "Default_Parser.hpp"
+#include "XML_ViewSource.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace XML_Lib {
+
+// Smallest share of a document worth giving a thread of its own
+static constexpr std::size_t kMinimumShareSize{ 64 * 1024 };
+
+// Part of the root element's content parsed by one worker
+struct Default_Parser::ParallelShare
+{
+  // Byte offsets of the share in the document (the last runs to the end of the document)
+  std::size_t begin{ 0 };
+  std::size_t end{ 0 };
+  bool isLast{ false };
+  // Where the share's nodes are allocated (a sub-arena of the document's) and their names added
+  XML_AllocationContext context;
+  // Children of the root element parsed, then (last share only) the nodes after the root
+  std::vector<Node> children;
+  std::vector<Node> epilog;
+  bool failed{ false };
+};
+
+/// <summary>
+/// Is character one that may follow an element name in a start tag.
+/// </summary>
+/// <param name="ch">Character to check.</param>
+/// <returns>True if the name ends before it.</returns>
+static bool isNameEnd(const char ch) { return ch == '>' || ch == '/' || ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r'; }
+
+/// <summary>
+/// Find the first start tag of the given element after an offset.
+/// </summary>
+/// <param name="contents">Document contents.</param>
+/// <param name="tag">Start of tag ("<" followed by element name).</param>
+/// <param name="from">Offset to search from.</param>
+/// <returns>Offset of the start tag or npos if not found.</returns>
+static std::size_t findStartTag(const std::string_view &contents, const std::string_view &tag, std::size_t from)
+{
+  for (from = contents.find(tag, from); from != std::string_view::npos; from = contents.find(tag, from + 1)) {
+    if (from + tag.size() < contents.size() && isNameEnd(contents[from + tag.size()])) { return from; }
+  }
+  return std::string_view::npos;
+}
+
+/// <summary>
+/// Return the start of the first child start tag in the root element content ("<" and its name).
+/// </summary>
+/// <param name="contents">Document contents.</param>
+/// <param name="from">Offset of the start of the root element content.</param>
+/// <returns>Start of tag, or empty if no child element was found.</returns>
+static std::string_view firstChildTag(const std::string_view &contents, const std::size_t from)
+{
+  for (auto start = contents.find('<', from); start != std::string_view::npos; start = contents.find('<', start + 1)) {
+    if (start + 1 >= contents.size() || contents[start + 1] == '/') { return {}; }
+    if (contents[start + 1] == '!' || contents[start + 1] == '?') { continue; }
+    auto end = start + 1;
+    while (end < contents.size() && !isNameEnd(contents[end])) { end++; }
+    return contents.substr(start, end - start);
+  }
+  return {};
+}
+
+/// <summary>
+/// Parse the prolog, root start tag and then share of a document's root element content
+/// on a worker thread, keeping the children of the root element parsed.
+/// </summary>
+/// <param name="contents">Document contents.</param>
+/// <param name="options">Parse options.</param>
+/// <param name="share">Share of the root element content to parse.</param>
+void Default_Parser::parseShare(const std::string_view contents, const ParseOptions &options, ParallelShare &share)
+{
+  try {
+    const XML_NameTable::ScopedCurrentNameTable scopedNameTable(*share.context.nameTable);
+    XML_EntityMapper shareEntityMapper;
+    Default_Parser parser{ shareEntityMapper };
+    parser.allocationContext = share.context;
+    XML_TreeBuilder treeBuilder{ share.context };
+    parser.beginDocument(options);
+    ViewSource prologSource{ contents };
+    parser.parseProlog(prologSource, treeBuilder);
+    parseRootStart(prologSource);
+    const auto rootTag = parser.parseStartTag(prologSource, treeBuilder);
+    if (rootTag.isSelfClosing) { XML_LIB_THROW(SyntaxError("Root element has no content to share.")); }
+    if (!share.isLast) {
+      // Parsed on into the shares after it, so a construct the split cut through is read whole
+      // and then found not to end where the share does
+      ViewSource source{ contents.substr(share.begin) };
+      const auto shareEnd = static_cast<long>(share.end - share.begin);
+      while (source.position() < shareEnd) {
+        if (match(source, "</")) { XML_LIB_THROW(SyntaxError(source.getPosition(), "Root element ended within share.")); }
+        parser.parseElementInternal(source, treeBuilder);
+      }
+      if (source.position() != shareEnd) {
+        XML_LIB_THROW(SyntaxError(source.getPosition(), "Share does not end between children of the root element."));
+      }
+      for (auto &child : treeBuilder.openChildren()) { share.children.push_back(std::move(child)); }
+      return;
+    }
+    ViewSource source{ contents.substr(share.begin) };
+    parser.skipElementContent(source, treeBuilder);
+    parser.parseEndTag(source, treeBuilder, rootTag);
+    parseEpilog(source, treeBuilder);
+    const auto prologChildren = treeBuilder.openChildren();
+    const auto root = std::ranges::find_if(prologChildren, [](const Node &node) { return isA<Root>(node); });
+    for (auto &child : root->getChildren()) { share.children.push_back(std::move(child)); }
+    for (auto epilogNode = root + 1; epilogNode != prologChildren.end(); ++epilogNode) {
+      share.epilog.push_back(std::move(*epilogNode));
+    }
+  } catch (...) {
+    share.failed = true;
+  }
+}
+
+/// <summary>
+/// Parse a document held in memory whole, the children of its root element being
+/// parsed on several threads.
+/// </summary>
+/// <param name="source">XML source stream (its contents are the whole document).</param>
+/// <param name="treeBuilder">Tree builder for the document.</param>
+/// <param name="options">Parse options.</param>
+/// <returns>True if the document was parsed, false if it must be parsed again on one thread.</returns>
+bool Default_Parser::parseInParallel(ISource &source, XML_TreeBuilder &treeBuilder, const ParseOptions &options)
+{
+  // Workers build into sub-arenas of the document's arena, so there must be one
+  XML_Arena *documentArena = allocationContext.arena;
+  if (documentArena == nullptr) { return false; }
+  const auto contents = source.contents();
+  auto shareCount = options.parseThreads != 0 ? options.parseThreads : std::max(1U, std::thread::hardware_concurrency());
+  shareCount = std::min(shareCount, contents.size() / kMinimumShareSize);
+  if (shareCount < 2) { return false; }
+  std::vector<ParallelShare> shares;
+  std::vector<std::jthread> workers;
+  ElementTag rootTag;
+  try {
+    // Prolog and root start tag on this thread
+    beginDocument(options);
+    parseProlog(source, treeBuilder);
+    parseRootStart(source);
+    rootTag = parseStartTag(source, treeBuilder);
+    if (rootTag.isSelfClosing) { return false; }
+    // Divide the root element content into shares at speculated child start tags
+    const auto contentStart = static_cast<std::size_t>(source.position());
+    const auto childTag = firstChildTag(contents, contentStart);
+    if (childTag.size() < 2) { return false; }
+    std::size_t shareStart = contentStart;
+    for (std::size_t share = 1; share < shareCount; share++) {
+      const auto split = findStartTag(contents, childTag, contentStart + share * (contents.size() - contentStart) / shareCount);
+      if (split == std::string_view::npos) { break; }
+      if (split <= shareStart) { continue; }
+      if (!shares.empty()) { shares.back().end = split; }
+      shares.push_back({ .begin = split });
+      shareStart = split;
+    }
+    if (shares.empty()) { return false; }
+    shares.back().isLast = true;
+    // The document's names are added from every thread
+    allocationContext.nameTable->markShared();
+    for (auto &share : shares) {
+      share.context = { &documentArena->addSubArena(), allocationContext.nameTable };
+      workers.emplace_back(parseShare, contents, std::cref(options), std::ref(share));
+    }
+    // First share on this thread, into the tree being built
+    const auto firstShareEnd = static_cast<long>(shares.front().begin);
+    while (source.position() < firstShareEnd) {
+      if (match(source, "</")) { return false; }
+      parseElementInternal(source, treeBuilder);
+    }
+    if (source.position() != firstShareEnd) { return false; }
+  } catch (...) {
+    return false;
+  }
+  for (auto &worker : workers) { worker.join(); }
+  if (std::ranges::any_of(shares, [](const ParallelShare &share) { return share.failed; })) { return false; }
+  // Add the children of the root parsed by the workers, close it and add any epilog
+  for (auto &share : shares) {
+    for (auto &child : share.children) { treeBuilder.addChild(std::move(child)); }
+  }
+  treeBuilder.onEndElement(rootTag.name);
+  for (auto &epilogNode : shares.back().epilog) { treeBuilder.addChild(std::move(epilogNode)); }
+  return true;
+}
+}// namespace XML_Lib
@@ -0,0 +1,167 @@
+//
+// Class: XML_TapeBuilder
+//
+// Description: Parse handler that builds the tape of a document (XMLTape) from the
+// events reported by the parser. Nodes are appended to the tape's arrays in document
+// order as they start, each linked to its parent and to the sibling before it, and
+// their text is appended to the tape's one text buffer. Content reported over several
+// calls (such as text either side of a reference) is added to a single content node.
+//
+// Dependencies: C++20 - Language standard features used.
+//
+
+#include "XML_TapeBuilder.hpp"
+
+namespace XML_Lib {
+
+/// <summary>
+/// XML_TapeBuilder constructor; the tape starts as an empty prolog.
+/// </summary>
+/// <param name="tape">Tape to build.</param>
+XML_TapeBuilder::XML_TapeBuilder(XMLTape_Impl &tape) : tape(tape)
+{
+  tape.firstAttributes.push_back(0);
+  openNodes.reserve(32);
+  lastChildren.reserve(32);
+  addNode(XMLTape_Impl::Kind::prolog, XML_NameTable::kNoSymbol, "");
+  openNodes.push_back(0);
+  lastChildren.push_back(XMLTape_Impl::kNoNode);
+}
+
+/// <summary>
+/// Append text to the tape's text.
+/// </summary>
+/// <param name="value">Text to append.</param>
+/// <returns>Offset of text appended.</returns>
+std::uint32_t XML_TapeBuilder::addText(const std::string_view value)
+{
+  if (tape.text.size() + value.size() >= XMLTape_Impl::kNoNode) {
+    XML_LIB_THROW(XMLTape::Error("Document text is too large for a tape."));
+  }
+  const auto offset = static_cast<std::uint32_t>(tape.text.size());
+  tape.text.append(value);
+  return offset;
+}
+
+/// <summary>
+/// Add a node as the last child of the innermost open node.
+/// </summary>
+/// <param name="kind">Node kind.</param>
+/// <param name="name">Node name symbol (kNoSymbol if it has no name).</param>
+/// <param name="value">Node text.</param>
+/// <returns>Index of node added.</returns>
+std::uint32_t XML_TapeBuilder::addNode(const XMLTape_Impl::Kind kind,
+  const XML_NameTable::Symbol name,
+  const std::string_view value)
+{
+  if (tape.kinds.size() + 1 >= XMLTape_Impl::kNoNode) { XML_LIB_THROW(XMLTape::Error("Document has too many nodes for a tape.")); }
+  const auto index = static_cast<std::uint32_t>(tape.kinds.size());
+  tape.kinds.push_back(kind);
+  tape.names.push_back(name);
+  tape.parents.push_back(openNodes.empty() ? XMLTape_Impl::kNoNode : openNodes.back());
+  tape.nextSiblings.push_back(XMLTape_Impl::kNoNode);
+  tape.textOffsets.push_back(addText(value));
+  tape.textLengths.push_back(static_cast<std::uint32_t>(value.size()));
+  tape.firstAttributes.push_back(tape.firstAttributes.back());
+  if (!lastChildren.empty()) {
+    if (lastChildren.back() != XMLTape_Impl::kNoNode) { tape.nextSiblings[lastChildren.back()] = index; }
+    lastChildren.back() = index;
+  }
+  return index;
+}
+
+/// <summary>
+/// Add an attribute to the last node added.
+/// </summary>
+/// <param name="name">Attribute name symbol.</param>
+/// <param name="value">Attribute value.</param>
+void XML_TapeBuilder::addAttribute(const XML_NameTable::Symbol name, const std::string_view value)
+{
+  tape.attributeNames.push_back(name);
+  tape.attributeValueOffsets.push_back(addText(value));
+  tape.attributeValueLengths.push_back(static_cast<std::uint32_t>(value.size()));
+  tape.firstAttributes.back()++;
+}
+
+void XML_TapeBuilder::onDeclaration(const std::string_view version,
+  const std::string_view encoding,
+  const std::string_view standalone)
+{
+  addNode(XMLTape_Impl::Kind::declaration, XML_NameTable::kNoSymbol, "");
+  addAttribute(tape.nameTable->intern("version"), version);
+  addAttribute(tape.nameTable->intern("encoding"), encoding);
+  addAttribute(tape.nameTable->intern("standalone"), standalone);
+}
+
+/// <summary>
+/// Add an element node and open it; the first element is the document root. Attribute
+/// names are already in the tape's name table (the current one while it is parsed).
+/// </summary>
+void XML_TapeBuilder::onStartElement(const std::string_view name,
+  const std::span<const XMLAttribute> attributes,
+  const bool isSelfClosing)
+{
+  auto kind = isSelfClosing ? XMLTape_Impl::Kind::self : XMLTape_Impl::Kind::element;
+  if (openNodes.size() == 1) { kind = XMLTape_Impl::Kind::root; }
+  const auto index = addNode(kind, tape.nameTable->intern(name), "");
+  for (const auto &attribute : attributes) {
+    addAttribute(attribute.symbolIn(*tape.nameTable), attribute.getParsed());
+  }
+  openNodes.push_back(index);
+  lastChildren.push_back(XMLTape_Impl::kNoNode);
+}
+
+void XML_TapeBuilder::onEndElement([[maybe_unused]] const std::string_view name)
+{
+  openNodes.pop_back();
+  lastChildren.pop_back();
+}
+
+/// <summary>
+/// Add characters to the content node that is the last node added, or add one to hold them.
+/// </summary>
+void XML_TapeBuilder::onCharacters(const std::string_view characters, [[maybe_unused]] const bool isWhiteSpace)
+{
+  if (const auto last = lastChildren.back(); last != XMLTape_Impl::kNoNode && last + 1 == tape.kinds.size()
+                                             && tape.kinds[last] == XMLTape_Impl::Kind::content
+                                             && tape.textOffsets[last] + tape.textLengths[last] == tape.text.size()) {
+    addText(characters);
+    tape.textLengths[last] += static_cast<std::uint32_t>(characters.size());
+    return;
+  }
+  addNode(XMLTape_Impl::Kind::content, XML_NameTable::kNoSymbol, characters);
+}
+
+void XML_TapeBuilder::onCDATA(const std::string_view cdata)
+{
+  addNode(XMLTape_Impl::Kind::cdata, XML_NameTable::kNoSymbol, cdata);
+}
+
+void XML_TapeBuilder::onComment(const std::string_view comment)
+{
+  addNode(XMLTape_Impl::Kind::comment, XML_NameTable::kNoSymbol, comment);
+}
+
+void XML_TapeBuilder::onPI(const std::string_view name, const std::string_view parameters)
+{
+  addNode(XMLTape_Impl::Kind::pi, tape.nameTable->intern(name), parameters);
+}
+
+/// <summary>
+/// Finish the tape, freeing the space its arrays were grown into but did not use.
+/// </summary>
+void XML_TapeBuilder::finish()
+{
+  tape.kinds.shrink_to_fit();
+  tape.names.shrink_to_fit();
+  tape.parents.shrink_to_fit();
+  tape.nextSiblings.shrink_to_fit();
+  tape.textOffsets.shrink_to_fit();
+  tape.textLengths.shrink_to_fit();
+  tape.firstAttributes.shrink_to_fit();
+  tape.attributeNames.shrink_to_fit();
+  tape.attributeValueOffsets.shrink_to_fit();
+  tape.attributeValueLengths.shrink_to_fit();
+  tape.text.shrink_to_fit();
+}
+}// namespace XML_Lib
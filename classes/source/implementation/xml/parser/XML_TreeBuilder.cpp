@@ -0,0 +1,215 @@
+//
+// Class: XML_TreeBuilder
+//
+// Description: Parse handler that builds the Node tree for a document from the
+// events reported by the parser (Default_Parser::parse() uses it for the tree).
+//
+// Dependencies: C++20 - Language standard features used.
+//
+
+#include "XML_Core.hpp"
+
+namespace XML_Lib {
+
+/// <summary>
+/// Mark a trailing Content child as non-whitespace.
+/// </summary>
+/// <param name="lastChild">Last child of an element Node (nullptr if it has none).</param>
+static void markTrailingContentNonWhitespace(Node *lastChild)
+{
+  if (lastChild != nullptr && isA<Content>(*lastChild)) { NRef<Content>(*lastChild).setIsWhiteSpace(false); }
+}
+
+/// <summary>
+/// Is reference an entity whose replacement is XML that belongs directly in the
+/// current element (no EntityReference Node is created for it).
+/// </summary>
+/// <param name="reference">Reference value.</param>
+/// <returns>True if the replacement is added inline.</returns>
+static bool isInlineReference(const XMLValue &reference)
+{
+  return reference.isEntityReference() && reference.getParsed().starts_with("<");
+}
+
+/// <summary>
+/// XML_TreeBuilder constructor; the tree starts as an empty prolog.
+/// </summary>
+/// <param name="context">Where the nodes built are allocated.</param>
+XML_TreeBuilder::XML_TreeBuilder(const XML_AllocationContext &context) : context(context)
+{
+  openNodes.reserve(32);
+  firstChildren.reserve(32);
+  childStack.reserve(256);
+  openNode(make<Prolog>());
+}
+
+/// <summary>
+/// Construct a builder for a subtree of a document, whose first element inherits the
+/// namespaces in scope where it occurs.
+/// </summary>
+/// <param name="context">Where the nodes built are allocated.</param>
+/// <param name="outerNameSpaces">Namespace scope of the first element.</param>
+XML_TreeBuilder::XML_TreeBuilder(const XML_AllocationContext &context, XMLNameSpaceScope::Pointer outerNameSpaces)
+  : XML_TreeBuilder(context)
+{
+  this->outerNameSpaces = std::move(outerNameSpaces);
+}
+
+/// <summary>
+/// Open a Node; children added until it is closed are its.
+/// </summary>
+/// <param name="xNode">Node to open.</param>
+void XML_TreeBuilder::openNode(Node &&xNode)
+{
+  openNodes.push_back(std::move(xNode));
+  firstChildren.push_back(childStack.size());
+}
+
+/// <summary>
+/// Move the children of the innermost open Node from the child stack into its child list,
+/// which is allocated just once at its exact size.
+/// </summary>
+void XML_TreeBuilder::commitChildren()
+{
+  const auto firstChild = static_cast<std::ptrdiff_t>(firstChildren.back());
+  openNodes.back().addChildren(openChildren());
+  childStack.erase(childStack.begin() + firstChild, childStack.end());
+}
+
+/// <summary>
+/// Close the innermost open Node and add it to its parent's children.
+/// </summary>
+void XML_TreeBuilder::closeNode()
+{
+  commitChildren();
+  Node xNode{ std::move(openNodes.back()) };
+  openNodes.pop_back();
+  firstChildren.pop_back();
+  addChild(std::move(xNode));
+}
+
+/// <summary>
+/// Return the last child added to the innermost open Node.
+/// </summary>
+/// <returns>Pointer to last child, nullptr if there is none.</returns>
+Node *XML_TreeBuilder::lastChild()
+{
+  return childStack.size() > firstChildren.back() ? &childStack.back() : nullptr;
+}
+
+/// <summary>
+/// Return the last child added to the parent of the innermost open Node.
+/// </summary>
+/// <returns>Pointer to last child, nullptr if there is none.</returns>
+Node *XML_TreeBuilder::lastParentChild()
+{
+  const auto firstChild = firstChildren.back();
+  return firstChild > firstChildren[firstChildren.size() - 2] ? &childStack[firstChild - 1] : nullptr;
+}
+
+/// <summary>
+/// Add characters to the content Node that is the last child of the innermost open Node,
+/// adding one to receive them if it is not. A new content Node leaves characters within
+/// the caller's input in situ.
+/// </summary>
+/// <param name="content">Content to add to the content Node.</param>
+/// <param name="isWhiteSpace">True if content is made up only of whitespace.</param>
+void XML_TreeBuilder::addContent(const std::string_view content, const bool isWhiteSpace)
+{
+  const Node *last = lastChild();
+  const bool isNew = last == nullptr || !isA<Content>(*last);
+  if (isNew) {
+    const bool isWhiteSpaceDefault = last == nullptr || (!isA<CDATA>(*last) && !isA<EntityReference>(*last));
+    addChild(make<Content>("", isWhiteSpaceDefault));
+  }
+  auto &xmlContent = NRef<Content>(childStack.back());
+  if (xmlContent.isWhiteSpace()) { xmlContent.setIsWhiteSpace(isWhiteSpace); }
+  if (isNew && isWithin(content, inSituInput)) {
+    xmlContent.setInSituContent(content);
+  } else {
+    xmlContent.addContent(content);
+  }
+}
+
+void XML_TreeBuilder::onDeclaration(const std::string_view version,
+  const std::string_view encoding,
+  const std::string_view standalone)
+{
+  addChild(make<Declaration>(version, encoding, standalone));
+}
+
+/// <summary>
+/// Open an element Node; the first (non self-closing) element is the document root.
+/// It inherits the namespaces of the element it is nested in.
+/// </summary>
+void XML_TreeBuilder::onStartElement(const std::string_view name,
+  const std::span<const XMLAttribute> attributes,
+  const bool isSelfClosing)
+{
+  const auto &namespaces = openNodes.size() > 1 ? NRef<Element>(openNodes.back()).getNameSpaceScope() : outerNameSpaces;
+  if (isSelfClosing) {
+    openNode(make<Self>(name, attributes, namespaces));
+  } else {
+    openNode(
+      openNodes.size() == 1 ? make<Root>(name, attributes, namespaces) : make<Element>(name, attributes, namespaces));
+  }
+}
+
+void XML_TreeBuilder::onEndElement([[maybe_unused]] const std::string_view name) { closeNode(); }
+
+void XML_TreeBuilder::onCharacters(const std::string_view characters, const bool isWhiteSpace)
+{
+  if (characterReferenceDepth == 0) { addContent(characters, isWhiteSpace); }
+}
+
+void XML_TreeBuilder::onCDATA(const std::string_view cdata)
+{
+  markTrailingContentNonWhitespace(lastChild());
+  addChild(make<CDATA>(cdata));
+}
+
+void XML_TreeBuilder::onComment(const std::string_view comment)
+{
+  addChild(make<Comment>(comment));
+}
+
+void XML_TreeBuilder::onPI(const std::string_view name, const std::string_view parameters)
+{
+  addChild(make<PI>(name, parameters));
+}
+
+/// <summary>
+/// Open an EntityReference Node; the replacement of an entity is added as its children
+/// unless it is XML, which is added to the current element. Character references have no
+/// children.
+/// </summary>
+void XML_TreeBuilder::onStartEntityReference(const XMLValue &reference)
+{
+  if (isInlineReference(reference)) { return; }
+  openNode(make<EntityReference>(reference));
+  if (!reference.isEntityReference()) { characterReferenceDepth++; }
+}
+
+void XML_TreeBuilder::onEndEntityReference(const XMLValue &reference)
+{
+  if (isInlineReference(reference)) { return; }
+  if (!reference.isEntityReference()) {
+    characterReferenceDepth--;
+  } else {
+    markTrailingContentNonWhitespace(lastParentChild());
+  }
+  closeNode();
+}
+
+void XML_TreeBuilder::onDTD(Node &dtd) { addChild(std::move(dtd)); }
+
+/// <summary>
+/// Return the prolog Node of the document built.
+/// </summary>
+/// <returns>Prolog Node.</returns>
+Node XML_TreeBuilder::releaseProlog()
+{
+  commitChildren();
+  return std::move(openNodes.front());
+}
+}// namespace XML_Lib
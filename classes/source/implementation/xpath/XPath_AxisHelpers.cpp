@@ -24,7 +24,7 @@ std::string findAttributeValue(const Node &node, const std::string_view attrName
   const auto *attrs = nodeAttributes(node);
   if (attrs == nullptr) return {};
   for (const auto &attr : *attrs) {
-    if (attr.getName() == attrName) return attr.getParsed();
+    if (attr.getName() == attrName) return std::string(attr.getParsed());
   }
   return {};
 }
@@ -1,4 +1,5 @@
 #include "XPath_EvalHelpers.hpp"
+#include "XML_NodeKindHelpers.hpp"
 
 #include <charconv>
 #include <cmath>
@@ -40,6 +41,18 @@ std::string nodeStringValue(const Node &node)
   return result;
 }
 
+std::string_view nodeStringValueView(const Node &node, std::string &scratch)
+{
+  // A text node, or a node whose only child is one, is its own string value
+  if (isA<Content>(node)) { return NRef<Content>(node).value(); }
+  if (const auto &children = node.getChildren(); children.size() == 1 && isA<Content>(children.front())) {
+    return NRef<Content>(children.front()).value();
+  }
+  scratch.clear();
+  appendNodeStringValue(node, scratch);
+  return scratch;
+}
+
 std::string_view nodeNameView(const Node &node)
 {
   if (isA<Element>(node)) return NRef<Element>(node).name();
@@ -51,17 +64,24 @@ std::string_view nodeNameView(const Node &node)
 
 std::string_view nodeLocalNameView(const Node &node)
 {
+  if (isElementLikeNode(node)) { return NRef<Element>(node).getLocalName(); }
   const std::string_view nm = nodeNameView(node);
   const auto pos = nm.find(':');
   return (pos != std::string_view::npos) ? nm.substr(pos + 1) : nm;
 }
 
-bool matchNodeName(const Node &node, const std::string_view &nameTest)
+bool matchNodeName(const Node &node, XML_NameTable::Matcher &nameTest)
 {
   const std::string_view name = nodeNameView(node);
   if (name.empty()) { return false; }
-  if (nameTest == "*") { return true; }
-  return name == nameTest || nodeLocalNameView(node) == nameTest;
+  if (nameTest.name() == "*") { return true; }
+  if (isElementLikeNode(node)) {
+    const auto &element = NRef<Element>(node);
+    if (nameTest.matches(element.getNameTable(), element.getNameSymbol())) { return true; }
+    // Otherwise only a prefixed name can match, by its local name
+    return !element.getPrefix().empty() && element.getLocalName() == nameTest.name();
+  }
+  return name == nameTest.name() || nodeLocalNameView(node) == nameTest.name();
 }
 
 double stringToNumber(std::string_view s)
@@ -78,43 +98,4 @@ double stringToNumber(std::string_view s)
   return std::numeric_limits<double>::quiet_NaN();
 }
 
-std::string resultToString(const XPathResult &r)
-{
-  switch (r.type) {
-  case XPathResultType::String:
-    return r.stringValue;
-  case XPathResultType::Number: {
-    if (std::isnan(r.numberValue)) return "NaN";
-    if (std::isinf(r.numberValue)) return (r.numberValue > 0) ? "Infinity" : "-Infinity";
-    char buffer[64];
-    const auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), r.numberValue);
-    if (ec == std::errc()) return std::string(buffer, ptr);
-    std::ostringstream os;
-    os << r.numberValue;
-    return os.str();
-  }
-  case XPathResultType::Boolean:
-    return r.boolValue ? "true" : "false";
-  case XPathResultType::NodeSet:
-    if (r.nodeSet.empty()) return "";
-    if (const auto it = r.attrValues.find(r.nodeSet.front()); it != r.attrValues.end()) return it->second;
-    return nodeStringValue(*r.nodeSet.front());
-  }
-  return "";
-}
-
-std::string_view resultToStringView(const XPathResult &r, std::string &scratch)
-{
-  switch (r.type) {
-  case XPathResultType::String:
-    return r.stringValue;
-  case XPathResultType::Number:
-  case XPathResultType::Boolean:
-  case XPathResultType::NodeSet:
-    scratch = resultToString(r);
-    return scratch;
-  }
-  return scratch;
-}
-
 } // namespace XML_Lib
@@ -1,15 +1,14 @@
 //
 // XPath_Evaluator.cpp
 //
-// Description: XPath 1.0 evaluator — walks the Node tree executing an AST
-// and returning an XPathResult.
+// Description: XPath 1.0 evaluator — walks a document executing an AST and
+// returning an XPathResult. It is written against a document model (see
+// XPath_NodeModels.hpp) and instantiated for both the Node tree and the tape.
 //
 // Dependencies: C++20 - Language standard features used.
 //
 
-#include "XPath_Impl.hpp"
-#include "XPath_EvalHelpers.hpp"
-#include "XPath_AxisHelpers.hpp"
+#include "XPath_Evaluator.hpp"
 #include "XPath_AST.hpp"
 #include "XPath_Lexer.hpp"
 #include "XPath_Parser.hpp"
@@ -26,31 +25,10 @@
 
 namespace XML_Lib {
 
-// ========================================================================
-// Forward declarations
-// ========================================================================
-static XPathResult evalExpr(const XPathExpr &expr,
-  const Node &contextNode,
-  size_t contextPosition,
-  size_t contextSize,
-  const Node &documentRoot,
-  const std::vector<const Node *> &ancestorStack);
-
-static std::string nodeNamespaceURI(const Node &node)
-{
-  if (isA<Element>(node)) return NRef<Element>(node).getNamespaceURI();
-  if (isA<Root>(node)) return NRef<Root>(node).getNamespaceURI();
-  if (isA<Self>(node)) return NRef<Self>(node).getNamespaceURI();
-  return "";
-}
-
 // ========================================================================
 // Type conversions
 // ========================================================================
-static double resultToNumber(const XPathResult &r);
-static bool resultToBool(const XPathResult &r);
-
-static double resultToNumber(const XPathResult &r)
+template<typename Model> double XPath_Evaluator<Model>::toNumber(const Result &r) const
 {
   switch (r.type) {
   case XPathResultType::Number:
@@ -64,13 +42,14 @@ static double resultToNumber(const XPathResult &r)
     if (const auto it = r.attrValues.find(r.nodeSet.front()); it != r.attrValues.end()) {
       return stringToNumber(it->second);
     }
-    return stringToNumber(nodeStringValue(*r.nodeSet.front()));
+    std::string scratch;
+    return stringToNumber(nodeStringView(r.nodeSet.front(), scratch));
   }
   }
   return 0.0;
 }
 
-static bool resultToBool(const XPathResult &r)
+template<typename Model> bool XPath_Evaluator<Model>::toBool(const Result &r)
 {
   switch (r.type) {
   case XPathResultType::Boolean:
@@ -85,65 +64,91 @@ static bool resultToBool(const XPathResult &r)
   return false;
 }
 
+template<typename Model> std::string XPath_Evaluator<Model>::toString(const Result &r) const
+{
+  switch (r.type) {
+  case XPathResultType::String:
+    return r.stringValue;
+  case XPathResultType::Number: {
+    if (std::isnan(r.numberValue)) return "NaN";
+    if (std::isinf(r.numberValue)) return (r.numberValue > 0) ? "Infinity" : "-Infinity";
+    char buffer[64];
+    const auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), r.numberValue);
+    if (ec == std::errc()) return std::string(buffer, ptr);
+    std::ostringstream os;
+    os << r.numberValue;
+    return os.str();
+  }
+  case XPathResultType::Boolean:
+    return r.boolValue ? "true" : "false";
+  case XPathResultType::NodeSet:
+    if (r.nodeSet.empty()) return "";
+    if (const auto it = r.attrValues.find(r.nodeSet.front()); it != r.attrValues.end()) return it->second;
+    return nodeStringValue(r.nodeSet.front());
+  }
+  return "";
+}
+
+template<typename Model>
+std::string_view XPath_Evaluator<Model>::toStringView(const Result &r, std::string &scratch) const
+{
+  switch (r.type) {
+  case XPathResultType::String:
+    return r.stringValue;
+  case XPathResultType::NodeSet:
+    if (r.nodeSet.empty()) { return {}; }
+    if (const auto it = r.attrValues.find(r.nodeSet.front()); it != r.attrValues.end()) { return it->second; }
+    return nodeStringView(r.nodeSet.front(), scratch);
+  case XPathResultType::Number:
+  case XPathResultType::Boolean:
+    scratch = toString(r);
+    return scratch;
+  }
+  return scratch;
+}
+
 // ========================================================================
 // XPathResult factory helpers
 // ========================================================================
-static XPathResult makeNumber(double v)
+template<typename Handle> static XPathResultOf<Handle> makeNumber(double v)
 {
-  XPathResult r;
+  XPathResultOf<Handle> r;
   r.type = XPathResultType::Number;
   r.numberValue = v;
   return r;
 }
-static XPathResult makeString(std::string s)
+template<typename Handle> static XPathResultOf<Handle> makeString(std::string s)
 {
-  XPathResult r;
+  XPathResultOf<Handle> r;
   r.type = XPathResultType::String;
   r.stringValue = std::move(s);
   return r;
 }
-static XPathResult makeBool(bool b)
+template<typename Handle> static XPathResultOf<Handle> makeBool(bool b)
 {
-  XPathResult r;
+  XPathResultOf<Handle> r;
   r.type = XPathResultType::Boolean;
   r.boolValue = b;
   return r;
 }
-static XPathResult makeNodeSet(std::vector<const Node *> ns = {},
-  std::unordered_map<const Node *, std::string> attrs = {})
+template<typename Handle>
+static XPathResultOf<Handle> makeNodeSet(std::vector<Handle> ns = {}, std::unordered_map<Handle, std::string> attrs = {})
 {
-  XPathResult r;
+  XPathResultOf<Handle> r;
   r.nodeSet = std::move(ns);
   r.attrValues = std::move(attrs);
   return r;
 }
 
-// ========================================================================
-// Collect all descendants (depth-first, not including self)
-// ========================================================================
-static void collectDescendants(const Node &node, std::vector<const Node *> &out)
-{
-  std::vector<const Node *> stack;
-  stack.reserve(16);
-  for (const auto &child : node.getChildren()) { stack.push_back(&child); }
-
-  while (!stack.empty()) {
-    const Node *current = stack.back();
-    stack.pop_back();
-    out.push_back(current);
-    const auto &children = current->getChildren();
-    for (auto it = children.rbegin(); it != children.rend(); ++it) { stack.push_back(&*it); }
-  }
-}
-
 // ========================================================================
 // Node-test match
 // ========================================================================
-static bool matchNodeTest(const Node &node,
+template<typename Model>
+bool XPath_Evaluator<Model>::matchNodeTest(const Handle node,
   const XPathNodeTest &test,
-  [[maybe_unused]] XPathAxis axis,
-  const std::string &attrName = "",
-  bool isAttrNode = false)
+  XML_NameTable::Matcher &nameTest,
+  const std::string &attrName,
+  const bool isAttrNode) const
 {
   if (isAttrNode) {
     // Attribute axis
@@ -156,14 +161,14 @@ static bool matchNodeTest(const Node &node,
   case XPathNodeTestKind::NodeType_Node:
     return true;// any node matches node()
   case XPathNodeTestKind::NodeType_Text:
-    return isA<Content>(node);
+    return model.isContent(node);
   case XPathNodeTestKind::NodeType_Comment:
-    return isA<Comment>(node);
+    return model.isComment(node);
   case XPathNodeTestKind::NodeType_PI:
-    return isA<PI>(node);
+    return model.isPI(node);
   case XPathNodeTestKind::NameTest: {
-    if (!isElementLikeNode(node)) return false;
-    return matchNodeName(node, test.name);
+    if (!model.isElementLike(node)) return false;
+    return model.matchName(node, nameTest);
   }
   }
   return false;
@@ -172,45 +177,36 @@ static bool matchNodeTest(const Node &node,
 // ========================================================================
 // Evaluate a predicate for a specific node in a candidate set
 // ========================================================================
-static bool evalPredicate(const XPathPredicate &pred,
-  const Node &node,
-  size_t position,// 1-based
-  size_t total,
-  const Node &docRoot,
-  const std::vector<const Node *> &ancestors)
+template<typename Model>
+bool XPath_Evaluator<Model>::evalPredicate(const XPathPredicate &pred,
+  const Handle node,
+  const size_t position,// 1-based
+  const size_t total,
+  const std::vector<Handle> &ancestors) const
 {
-  XPathResult r = evalExpr(*pred.expr, node, position, total, docRoot, ancestors);
+  Result r = evalExpr(*pred.expr, node, position, total, ancestors);
   // If result is a number, compare to position
   if (r.type == XPathResultType::Number) { return static_cast<size_t>(r.numberValue) == position; }
-  return resultToBool(r);
+  return toBool(r);
 }
 
 // ========================================================================
 // Axis traversal: returns candidate (node, attrname) pairs
 // ========================================================================
-struct CandidateNode
-{
-  const Node *node{ nullptr };
-  std::string attrName;// non-empty only for attribute axis
-  bool isAttr{ false };
-};
-
-
-static std::vector<CandidateNode> axisNodes(XPathAxis axis,
-  const Node &contextNode,
-  [[maybe_unused]] const Node &documentRoot,
-  const std::vector<const Node *> &ancestorStack)
+template<typename Model>
+std::vector<typename XPath_Evaluator<Model>::CandidateNode>
+  XPath_Evaluator<Model>::axisNodes(const XPathAxis axis, const Handle contextNode, const std::vector<Handle> &ancestorStack) const
 {
   std::vector<CandidateNode> result;
   result.reserve(8);
 
   switch (axis) {
   case XPathAxis::Child:
-    for (const auto &child : contextNode.getChildren()) { result.push_back({ &child, "", false }); }
+    model.forEachChild(contextNode, [&](const Handle child) { result.push_back({ child, "", false }); });
     break;
 
   case XPathAxis::Self:
-    result.push_back({ &contextNode, "", false });
+    result.push_back({ contextNode, "", false });
     break;
 
   case XPathAxis::Parent:
@@ -222,35 +218,32 @@ static std::vector<CandidateNode> axisNodes(XPathAxis axis,
     break;
 
   case XPathAxis::AncestorOrSelf:
-    result.push_back({ &contextNode, "", false });
+    result.push_back({ contextNode, "", false });
     for (auto it = ancestorStack.rbegin(); it != ancestorStack.rend(); ++it) { result.push_back({ *it, "", false }); }
     break;
 
   case XPathAxis::Descendant: {
-    std::vector<const Node *> tmp;
+    std::vector<Handle> tmp;
     tmp.reserve(16);
-    collectDescendants(contextNode, tmp);
-    for (const auto *n : tmp) result.push_back({ n, "", false });
+    model.collectDescendants(contextNode, tmp);
+    for (const auto n : tmp) result.push_back({ n, "", false });
     break;
   }
 
   case XPathAxis::DescendantOrSelf: {
-    result.push_back({ &contextNode, "", false });
-    std::vector<const Node *> tmp;
+    result.push_back({ contextNode, "", false });
+    std::vector<Handle> tmp;
     tmp.reserve(16);
-    collectDescendants(contextNode, tmp);
-    for (const auto *n : tmp) result.push_back({ n, "", false });
+    model.collectDescendants(contextNode, tmp);
+    for (const auto n : tmp) result.push_back({ n, "", false });
     break;
   }
 
   case XPathAxis::Attribute:
-    if (const auto *attrs = nodeAttributes(contextNode); attrs != nullptr) {
-      for (const auto &attr : *attrs) {
-        // Skip namespace declarations — they are on the namespace axis
-        if (attr.getName().starts_with("xmlns")) continue;
-        result.push_back({ &contextNode, attr.getName(), true });
-      }
-    }
+    model.forEachAttribute(contextNode, [&](const std::string_view attrName) {
+      // Skip namespace declarations — they are on the namespace axis
+      if (!attrName.starts_with("xmlns")) { result.push_back({ contextNode, std::string(attrName), true }); }
+    });
     break;
 
   case XPathAxis::FollowingSibling:
@@ -259,22 +252,21 @@ static std::vector<CandidateNode> axisNodes(XPathAxis axis,
   case XPathAxis::Preceding: {
     // Need parent to find siblings
     if (ancestorStack.empty()) break;
-    const Node *parent = ancestorStack.back();
-    const auto &siblings = parent->getChildren();
+    const Handle parent = ancestorStack.back();
     bool found = false;
     if (axis == XPathAxis::FollowingSibling || axis == XPathAxis::Following) {
-      for (const auto &sib : siblings) {
-        if (&sib == &contextNode) {
+      model.forEachChild(parent, [&](const Handle sib) {
+        if (found) {
+          result.push_back({ sib, "", false });
+        } else if (sib == contextNode) {
           found = true;
-          continue;
         }
-        if (found) result.push_back({ &sib, "", false });
-      }
+      });
     } else {
-      for (const auto &sib : siblings) {
-        if (&sib == &contextNode) break;
-        result.push_back({ &sib, "", false });
-      }
+      model.forEachChild(parent, [&](const Handle sib) {
+        if (sib == contextNode) { found = true; }
+        if (!found) { result.push_back({ sib, "", false }); }
+      });
       std::reverse(result.begin(), result.end());
     }
     break;
@@ -292,29 +284,29 @@ static std::vector<CandidateNode> axisNodes(XPathAxis axis,
 // ========================================================================
 // Evaluate a single step, producing a new node-set (as XPathResult)
 // ========================================================================
-static XPathResult evalStepResult(const XPathStep &step,
-  const std::vector<const Node *> &inputNodeSet,
-  [[maybe_unused]] const std::unordered_map<const Node *, std::string> &inputAttrValues,
-  const Node &docRoot,
-  const std::vector<const Node *> &ancestorsOfContext)
+template<typename Model>
+typename XPath_Evaluator<Model>::Result XPath_Evaluator<Model>::evalStepResult(const XPathStep &step,
+  const std::vector<Handle> &inputNodeSet,
+  const std::vector<Handle> &ancestorsOfContext) const
 {
-  std::vector<const Node *> output;
+  std::vector<Handle> output;
   output.reserve(inputNodeSet.size());
-  std::unordered_map<const Node *, std::string> outAttrValues;
+  std::unordered_map<Handle, std::string> outAttrValues;
   std::vector<CandidateNode> passing;
   std::vector<CandidateNode> surviving;
   passing.reserve(16);
   surviving.reserve(16);
 
-  for (const auto *inputNode : inputNodeSet) {
+  XML_NameTable::Matcher nameTest{ step.nodeTest.name };
+  for (const auto inputNode : inputNodeSet) {
     // For attribute proxies, the "real" context is still the element
-    const auto candidates = axisNodes(step.axis, *inputNode, docRoot, ancestorsOfContext);
+    const auto candidates = axisNodes(step.axis, inputNode, ancestorsOfContext);
 
     // Filter by node-test
     passing.clear();
     passing.reserve(candidates.size());
     for (const auto &c : candidates) {
-      if (matchNodeTest(*c.node, step.nodeTest, step.axis, c.attrName, c.isAttr)) { passing.push_back(c); }
+      if (matchNodeTest(c.node, step.nodeTest, nameTest, c.attrName, c.isAttr)) { passing.push_back(c); }
     }
 
     // Apply predicates
@@ -324,10 +316,10 @@ static XPathResult evalStepResult(const XPathStep &step,
       const size_t total = passing.size();
       size_t pos = 1;
       for (const auto &c : passing) {
-        std::vector<const Node *> candAncestors = ancestorsOfContext;
+        std::vector<Handle> candAncestors = ancestorsOfContext;
         candAncestors.reserve(ancestorsOfContext.size() + 1);
         candAncestors.push_back(inputNode);
-        if (evalPredicate(pred, *c.node, pos, total, docRoot, candAncestors)) { surviving.push_back(c); }
+        if (evalPredicate(pred, c.node, pos, total, candAncestors)) { surviving.push_back(c); }
         ++pos;
       }
       passing.swap(surviving);
@@ -337,7 +329,7 @@ static XPathResult evalStepResult(const XPathStep &step,
       if (std::find(output.begin(), output.end(), c.node) == output.end()) {
         output.push_back(c.node);
         if (c.isAttr) {
-          outAttrValues[c.node] = findAttributeValue(*c.node, c.attrName);
+          outAttrValues[c.node] = model.attributeValue(c.node, c.attrName);
         }
       }
     }
@@ -347,31 +339,33 @@ static XPathResult evalStepResult(const XPathStep &step,
 }
 
 // ========================================================================
-// Evaluate a PathExpr, starting from docRoot or contextNode
+// Evaluate a PathExpr, starting from the document root or contextNode
 // ========================================================================
-static XPathResult evalPathExpr(const XPathPathExpr &pathExpr,
-  const Node &contextNode,
-  const Node &docRoot,
-  const std::vector<const Node *> &ancestorStack)
+template<typename Model>
+typename XPath_Evaluator<Model>::Result XPath_Evaluator<Model>::evalPathExpr(const XPathPathExpr &pathExpr,
+  const Handle contextNode,
+  const std::vector<Handle> &ancestorStack) const
 {
-  std::vector<const Node *> current;
-  std::unordered_map<const Node *, std::string> currentAttrs;
+  std::vector<Handle> current;
+  std::unordered_map<Handle, std::string> currentAttrs;
 
   if (pathExpr.absolute) {
     if (pathExpr.steps.empty()) {
-      return makeNodeSet({ &docRoot });
+      return makeNodeSet<Handle>({ documentRoot });
     }
 
     const auto &step0 = pathExpr.steps[0];
     if (step0.axis == XPathAxis::Child) {
-      if (matchNodeTest(docRoot, step0.nodeTest, step0.axis)) { current.push_back(&docRoot); }
+      if (XML_NameTable::Matcher nameTest{ step0.nodeTest.name }; matchNodeTest(documentRoot, step0.nodeTest, nameTest)) {
+        current.push_back(documentRoot);
+      }
       if (!step0.predicates.empty()) {
-        std::vector<const Node *> surv;
+        std::vector<Handle> surv;
         const size_t total = current.size();
         for (size_t i = 0; i < current.size(); ++i) {
           bool pass = true;
           for (const auto &pred : step0.predicates) {
-            if (!evalPredicate(pred, *current[i], i + 1, total, docRoot, {})) {
+            if (!evalPredicate(pred, current[i], i + 1, total, {})) {
               pass = false;
               break;
             }
@@ -381,20 +375,20 @@ static XPathResult evalPathExpr(const XPathPathExpr &pathExpr,
         current = std::move(surv);
       }
       for (size_t i = 1; i < pathExpr.steps.size(); ++i) {
-        auto sr = evalStepResult(pathExpr.steps[i], current, currentAttrs, docRoot, {});
+        auto sr = evalStepResult(pathExpr.steps[i], current, {});
         current = std::move(sr.nodeSet);
         currentAttrs = std::move(sr.attrValues);
       }
     } else {
-      current.push_back(&docRoot);
+      current.push_back(documentRoot);
       for (size_t i = 0; i < pathExpr.steps.size(); ++i) {
         const auto &step = pathExpr.steps[i];
-        auto sr = evalStepResult(step, current, currentAttrs, docRoot, ancestorStack);
-        std::vector<const Node *> nextSet = sr.nodeSet;
+        auto sr = evalStepResult(step, current, ancestorStack);
+        std::vector<Handle> nextSet = sr.nodeSet;
         if (i == 1 && step0.axis == XPathAxis::DescendantOrSelf && step.axis == XPathAxis::Child) {
-          if (matchNodeTest(docRoot, step.nodeTest, step.axis)
-            && std::find(nextSet.begin(), nextSet.end(), &docRoot) == nextSet.end()) {
-            nextSet.insert(nextSet.begin(), &docRoot);
+          if (XML_NameTable::Matcher nameTest{ step.nodeTest.name }; matchNodeTest(documentRoot, step.nodeTest, nameTest)
+            && std::find(nextSet.begin(), nextSet.end(), documentRoot) == nextSet.end()) {
+            nextSet.insert(nextSet.begin(), documentRoot);
           }
         }
         current = std::move(nextSet);
@@ -406,9 +400,9 @@ static XPathResult evalPathExpr(const XPathPathExpr &pathExpr,
   }
 
   // Relative path
-  current.push_back(&contextNode);
+  current.push_back(contextNode);
   for (const auto &step : pathExpr.steps) {
-    auto sr = evalStepResult(step, current, currentAttrs, docRoot, ancestorStack);
+    auto sr = evalStepResult(step, current, ancestorStack);
     current = std::move(sr.nodeSet);
     currentAttrs = std::move(sr.attrValues);
   }
@@ -453,84 +447,85 @@ static std::string fnTranslate(const std::string &str, const std::string &from,
 // ========================================================================
 // Built-in function dispatch
 // ========================================================================
-static XPathResult evalBuiltinFunction(const std::string &name,
+template<typename Model>
+typename XPath_Evaluator<Model>::Result XPath_Evaluator<Model>::evalBuiltinFunction(const std::string &name,
   const std::vector<XPathExprPtr> &argExprs,
-  const Node &contextNode,
-  size_t contextPosition,
-  size_t contextSize,
-  const Node &docRoot,
-  const std::vector<const Node *> &ancestorStack)
+  const Handle contextNode,
+  const size_t contextPosition,
+  const size_t contextSize,
+  const std::vector<Handle> &ancestorStack) const
 {
   // Helper: evaluate all args
   auto evalArgs = [&]() {
-    std::vector<XPathResult> res;
+    std::vector<Result> res;
     res.reserve(argExprs.size());
     for (const auto &a : argExprs) {
-      res.push_back(evalExpr(*a, contextNode, contextPosition, contextSize, docRoot, ancestorStack));
+      res.push_back(evalExpr(*a, contextNode, contextPosition, contextSize, ancestorStack));
     }
     return res;
   };
-  auto nodeFromOptArg = [&]() -> const Node * {
+  auto nodeFromOptArg = [&]() -> Handle {
     auto args = evalArgs();
     if (!args.empty() && args[0].type == XPathResultType::NodeSet && !args[0].nodeSet.empty()) {
       return args[0].nodeSet.front();
     }
-    return &contextNode;
+    return contextNode;
   };
 
   // --- Node-set functions ---
   if (name == "position") {
-    return makeNumber(static_cast<double>(contextPosition));
+    return makeNumber<Handle>(static_cast<double>(contextPosition));
   }
   if (name == "last") {
-    return makeNumber(static_cast<double>(contextSize));
+    return makeNumber<Handle>(static_cast<double>(contextSize));
   }
   if (name == "count") {
     auto args = evalArgs();
     if (args.empty() || args[0].type != XPathResultType::NodeSet) {
-      return makeNumber(0);
+      return makeNumber<Handle>(0);
     }
-    return makeNumber(static_cast<double>(args[0].nodeSet.size()));
+    return makeNumber<Handle>(static_cast<double>(args[0].nodeSet.size()));
   }
   if (name == "name" || name == "local-name") {
-    const Node *n = nodeFromOptArg();
-    return makeString((name == "local-name") ? std::string(nodeLocalNameView(*n)) : std::string(nodeNameView(*n)));
+    const Handle n = nodeFromOptArg();
+    return makeString<Handle>((name == "local-name") ? std::string(model.localName(n)) : std::string(model.name(n)));
   }
   if (name == "namespace-uri") {
-    return makeString(nodeNamespaceURI(*nodeFromOptArg()));
+    return makeString<Handle>(std::string(model.namespaceURI(nodeFromOptArg())));
   }
 
   // --- Boolean functions ---
   if (name == "true") {
-    return makeBool(true);
+    return makeBool<Handle>(true);
   }
   if (name == "false") {
-    return makeBool(false);
+    return makeBool<Handle>(false);
   }
   if (name == "not") {
     auto args = evalArgs();
-    return makeBool(args.empty() ? true : !resultToBool(args[0]));
+    return makeBool<Handle>(args.empty() ? true : !toBool(args[0]));
   }
   if (name == "boolean") {
     auto args = evalArgs();
-    return makeBool(args.empty() ? false : resultToBool(args[0]));
+    return makeBool<Handle>(args.empty() ? false : toBool(args[0]));
   }
   if (name == "lang") {
     // Simplified: always return false
-    return makeBool(false);
+    return makeBool<Handle>(false);
   }
 
   // --- Number functions ---
   if (name == "number") {
     auto args = evalArgs();
-    return makeNumber(args.empty() ? std::numeric_limits<double>::quiet_NaN() : resultToNumber(args[0]));
+    return makeNumber<Handle>(args.empty() ? std::numeric_limits<double>::quiet_NaN() : toNumber(args[0]));
   }
   if (name == "sum") {
     auto args = evalArgs();
     double total = 0.0;
     if (!args.empty() && args[0].type == XPathResultType::NodeSet) {
-      for (const auto *n : args[0].nodeSet) {
-        const double value = resultToNumber(makeString(nodeStringValue(*n)));
+      std::string scratch;
+      for (const auto n : args[0].nodeSet) {
+        const double value = stringToNumber(nodeStringView(n, scratch));
         if (std::isnan(value)) {
           total = std::numeric_limits<double>::quiet_NaN();
           break;
@@ -538,83 +533,84 @@ static XPathResult evalBuiltinFunction(const std::string &name,
         total += value;
       }
     }
-    return makeNumber(total);
+    return makeNumber<Handle>(total);
   }
   if (name == "floor" || name == "ceiling") {
     auto args = evalArgs();
-    if (args.empty()) { return makeNumber(std::numeric_limits<double>::quiet_NaN()); }
-    const double val = resultToNumber(args[0]);
-    return makeNumber(name == "floor" ? std::floor(val) : std::ceil(val));
+    if (args.empty()) { return makeNumber<Handle>(std::numeric_limits<double>::quiet_NaN()); }
+    const double val = toNumber(args[0]);
+    return makeNumber<Handle>(name == "floor" ? std::floor(val) : std::ceil(val));
   }
   if (name == "round") {
     auto args = evalArgs();
-    if (args.empty()) { return makeNumber(std::numeric_limits<double>::quiet_NaN()); }
-    return makeNumber(std::floor(resultToNumber(args[0]) + 0.5));
+    if (args.empty()) { return makeNumber<Handle>(std::numeric_limits<double>::quiet_NaN()); }
+    return makeNumber<Handle>(std::floor(toNumber(args[0]) + 0.5));
   }
 
   // --- String functions ---
   if (name == "string") {
     auto args = evalArgs();
-    return makeString(args.empty() ? nodeStringValue(contextNode) : resultToString(args[0]));
+    return makeString<Handle>(args.empty() ? nodeStringValue(contextNode) : toString(args[0]));
   }
   if (name == "concat") {
     auto args = evalArgs();
     std::string s;
     std::string scratch;
     for (const auto &a : args) {
-      s.append(resultToStringView(a, scratch));
+      s.append(toStringView(a, scratch));
     }
-    return makeString(std::move(s));
+    return makeString<Handle>(std::move(s));
   }
   if (name == "starts-with" || name == "contains") {
     auto args = evalArgs();
-    if (args.size() < 2) { return makeBool(false); }
+    if (args.size() < 2) { return makeBool<Handle>(false); }
     std::string scratchLeft;
     std::string scratchRight;
-    const std::string_view left = resultToStringView(args[0], scratchLeft);
-    const std::string_view right = resultToStringView(args[1], scratchRight);
-    return makeBool(name == "starts-with" ? left.starts_with(right)
-                                          : left.find(right) != std::string::npos);
+    const std::string_view left = toStringView(args[0], scratchLeft);
+    const std::string_view right = toStringView(args[1], scratchRight);
+    return makeBool<Handle>(name == "starts-with" ? left.starts_with(right)
+                                                  : left.find(right) != std::string::npos);
   }
   if (name == "string-length") {
     auto args = evalArgs();
     if (args.empty()) {
-      return makeNumber(static_cast<double>(nodeStringValue(contextNode).size()));
+      std::string scratch;
+      return makeNumber<Handle>(static_cast<double>(nodeStringView(contextNode, scratch).size()));
     }
     std::string scratch;
-    return makeNumber(static_cast<double>(resultToStringView(args[0], scratch).size()));
+    return makeNumber<Handle>(static_cast<double>(toStringView(args[0], scratch).size()));
   }
   if (name == "normalize-space") {
     auto args = evalArgs();
     if (args.empty()) {
-      return makeString(fnNormalizeSpace(nodeStringValue(contextNode)));
+      return makeString<Handle>(fnNormalizeSpace(nodeStringValue(contextNode)));
     }
     std::string scratch;
-    return makeString(fnNormalizeSpace(std::string(resultToStringView(args[0], scratch))));
+    return makeString<Handle>(fnNormalizeSpace(std::string(toStringView(args[0], scratch))));
   }
   if (name == "translate") {
     auto args = evalArgs();
     if (args.size() < 3) {
-      if (args.empty()) { return makeString(""); }
+      if (args.empty()) { return makeString<Handle>(""); }
       std::string scratch;
-      return makeString(std::string(resultToStringView(args[0], scratch)));
+      return makeString<Handle>(std::string(toStringView(args[0], scratch)));
     }
     std::string scratch;
-    const std::string source(resultToStringView(args[0], scratch));
-    const std::string from(resultToStringView(args[1], scratch));
-    const std::string to(resultToStringView(args[2], scratch));
-    return makeString(fnTranslate(source, from, to));
+    const std::string source(toStringView(args[0], scratch));
+    const std::string from(toStringView(args[1], scratch));
+    const std::string to(toStringView(args[2], scratch));
+    return makeString<Handle>(fnTranslate(source, from, to));
   }
   if (name == "substring") {
     auto args = evalArgs();
-    if (args.empty()) { return makeString(""); }
+    if (args.empty()) { return makeString<Handle>(""); }
     std::string scratch;
-    const std::string s(resultToStringView(args[0], scratch));
-    const double startD = (args.size() >= 2) ? std::round(resultToNumber(args[1])) : 1.0;
+    const std::string s(toStringView(args[0], scratch));
+    const double startD = (args.size() >= 2) ? std::round(toNumber(args[1])) : 1.0;
     const long start = static_cast<long>(startD) - 1;
     std::string sub;
     if (args.size() >= 3) {
-      const long len = static_cast<long>(std::round(resultToNumber(args[2])));
+      const long len = static_cast<long>(std::round(toNumber(args[2])));
       const long begin = std::max(0L, start);
       const long end = std::min(static_cast<long>(s.size()), start + len);
       if (end > begin) sub = s.substr(static_cast<size_t>(begin), static_cast<size_t>(end - begin));
@@ -622,18 +618,18 @@ static XPathResult evalBuiltinFunction(const std::string &name,
       const long begin = std::max(0L, start);
       if (begin < static_cast<long>(s.size())) sub = s.substr(static_cast<size_t>(begin));
     }
-    return makeString(std::move(sub));
+    return makeString<Handle>(std::move(sub));
   }
   if (name == "substring-before" || name == "substring-after") {
     auto args = evalArgs();
-    if (args.size() < 2) { return makeString(""); }
+    if (args.size() < 2) { return makeString<Handle>(""); }
     std::string scratchLeft;
     std::string scratchRight;
-    const std::string_view haystack = resultToStringView(args[0], scratchLeft);
-    const std::string_view needle = resultToStringView(args[1], scratchRight);
+    const std::string_view haystack = toStringView(args[0], scratchLeft);
+    const std::string_view needle = toStringView(args[1], scratchRight);
     const auto pos = haystack.find(needle);
-    if (pos == std::string_view::npos) { return makeString(""); }
-    return makeString(name == "substring-before"
+    if (pos == std::string_view::npos) { return makeString<Handle>(""); }
+    return makeString<Handle>(name == "substring-before"
       ? std::string(haystack.substr(0, pos))
       : std::string(haystack.substr(pos + needle.size())));
   }
@@ -642,25 +638,24 @@ static XPathResult evalBuiltinFunction(const std::string &name,
   if (name == "__pathcont__") {
     // args[0] = filter expression,  args[1] = path expression
     if (argExprs.size() < 2) {
-      return makeNodeSet();
+      return makeNodeSet<Handle>();
     }
-    XPathResult filterResult =
-      evalExpr(*argExprs[0], contextNode, contextPosition, contextSize, docRoot, ancestorStack);
+    Result filterResult = evalExpr(*argExprs[0], contextNode, contextPosition, contextSize, ancestorStack);
     if (filterResult.type != XPathResultType::NodeSet) {
-      return makeNodeSet();
+      return makeNodeSet<Handle>();
     }
     // Apply the path expression to each node in the filter result
     // The path is a PathExpr (already has steps)
     const auto *pathExprPtr = dynamic_cast<const XPathPathExpr *>(argExprs[1].get());
     if (!pathExprPtr) { return filterResult; }
-    std::vector<const Node *> combined;
-    for (const auto *n : filterResult.nodeSet) {
-      auto sub = evalPathExpr(*pathExprPtr, *n, docRoot, ancestorStack);
-      for (const auto *r : sub.nodeSet) {
+    std::vector<Handle> combined;
+    for (const auto n : filterResult.nodeSet) {
+      auto sub = evalPathExpr(*pathExprPtr, n, ancestorStack);
+      for (const auto r : sub.nodeSet) {
         if (std::find(combined.begin(), combined.end(), r) == combined.end()) combined.push_back(r);
       }
     }
-    return makeNodeSet(std::move(combined));
+    return makeNodeSet<Handle>(std::move(combined));
   }
 
   XML_LIB_THROW(XPath::Error(std::string("Unknown function '") + name + "'."));
@@ -669,89 +664,80 @@ static XPathResult evalBuiltinFunction(const std::string &name,
 // ========================================================================
 // Main evaluator
 // ========================================================================
-static XPathResult evalExpr(const XPathExpr &expr,
-  const Node &contextNode,
+template<typename Model>
+typename XPath_Evaluator<Model>::Result XPath_Evaluator<Model>::evalExpr(const XPathExpr &expr,
+  const Handle contextNode,
   const size_t contextPosition,
   const size_t contextSize,
-  const Node &documentRoot,
-  const std::vector<const Node *> &ancestorStack)
+  const std::vector<Handle> &ancestorStack) const
 {
   // PathExpr (location path)
   if (const auto *p = dynamic_cast<const XPathPathExpr *>(&expr)) {
-    return evalPathExpr(*p, contextNode, documentRoot, ancestorStack);
+    return evalPathExpr(*p, contextNode, ancestorStack);
   }
 
   // Union  expr | expr
   if (const auto *u = dynamic_cast<const XPathUnionExpr *>(&expr)) {
-    auto left = evalExpr(*u->left, contextNode, contextPosition, contextSize, documentRoot, ancestorStack);
-    auto right = evalExpr(*u->right, contextNode, contextPosition, contextSize, documentRoot, ancestorStack);
-    auto ns = left.type == XPathResultType::NodeSet ? left.nodeSet : std::vector<const Node *>{};
+    auto left = evalExpr(*u->left, contextNode, contextPosition, contextSize, ancestorStack);
+    auto right = evalExpr(*u->right, contextNode, contextPosition, contextSize, ancestorStack);
+    auto ns = left.type == XPathResultType::NodeSet ? left.nodeSet : std::vector<Handle>{};
     if (right.type == XPathResultType::NodeSet) {
-      for (const auto *n : right.nodeSet) {
+      for (const auto n : right.nodeSet) {
         if (std::find(ns.begin(), ns.end(), n) == ns.end()) ns.push_back(n);
       }
     }
-    return makeNodeSet(std::move(ns));
+    return makeNodeSet<Handle>(std::move(ns));
   }
 
   // Binary expression
   if (const auto *b = dynamic_cast<const XPathBinaryExpr *>(&expr)) {
     // Short-circuit for and / or
     if (b->op == XPathBinaryExpr::Op::And) {
-      auto left = evalExpr(*b->left, contextNode, contextPosition, contextSize, documentRoot, ancestorStack);
-      if (!resultToBool(left)) {
-        return makeBool(false);
+      auto left = evalExpr(*b->left, contextNode, contextPosition, contextSize, ancestorStack);
+      if (!toBool(left)) {
+        return makeBool<Handle>(false);
       }
-      auto right = evalExpr(*b->right, contextNode, contextPosition, contextSize, documentRoot, ancestorStack);
-      return makeBool(resultToBool(right));
+      auto right = evalExpr(*b->right, contextNode, contextPosition, contextSize, ancestorStack);
+      return makeBool<Handle>(toBool(right));
     }
     if (b->op == XPathBinaryExpr::Op::Or) {
-      auto left = evalExpr(*b->left, contextNode, contextPosition, contextSize, documentRoot, ancestorStack);
-      if (resultToBool(left)) {
-        return makeBool(true);
+      auto left = evalExpr(*b->left, contextNode, contextPosition, contextSize, ancestorStack);
+      if (toBool(left)) {
+        return makeBool<Handle>(true);
       }
-      auto right = evalExpr(*b->right, contextNode, contextPosition, contextSize, documentRoot, ancestorStack);
-      return makeBool(resultToBool(right));
+      auto right = evalExpr(*b->right, contextNode, contextPosition, contextSize, ancestorStack);
+      return makeBool<Handle>(toBool(right));
     }
 
-    auto left = evalExpr(*b->left, contextNode, contextPosition, contextSize, documentRoot, ancestorStack);
-    auto right = evalExpr(*b->right, contextNode, contextPosition, contextSize, documentRoot, ancestorStack);
+    auto left = evalExpr(*b->left, contextNode, contextPosition, contextSize, ancestorStack);
+    auto right = evalExpr(*b->right, contextNode, contextPosition, contextSize, ancestorStack);
 
     // Equality / relational use special node-set comparison rules
-    auto nodeSetContains = [&](const XPathResult &nodeSetRes, const XPathResult &other) -> bool {
+    auto nodeSetContains = [&](const Result &nodeSetRes, const Result &other) -> bool {
       if (nodeSetRes.type != XPathResultType::NodeSet) return false;
       std::vector<std::string> otherStrings;
       if (other.type == XPathResultType::NodeSet) {
         otherStrings.reserve(other.nodeSet.size());
-        for (const auto *m : other.nodeSet) {
+        for (const auto m : other.nodeSet) {
           if (const auto it = other.attrValues.find(m); it != other.attrValues.end()) {
             otherStrings.push_back(it->second);
           } else {
-            otherStrings.push_back(nodeStringValue(*m));
+            otherStrings.push_back(nodeStringValue(m));
           }
         }
       }
 
-      for (const auto *n : nodeSetRes.nodeSet) {
-        std::string sv;
+      std::string scratch;
+      for (const auto n : nodeSetRes.nodeSet) {
+        std::string_view sv;
         if (const auto it = nodeSetRes.attrValues.find(n); it != nodeSetRes.attrValues.end()) {
           sv = it->second;
         } else {
-          sv = nodeStringValue(*n);
+          sv = nodeStringView(n, scratch);
         }
         if (other.type == XPathResultType::String && sv == other.stringValue) return true;
-        if (other.type == XPathResultType::Number) {
-          XPathResult nr;
-          nr.type = XPathResultType::String;
-          nr.stringValue = sv;
-          if (resultToNumber(nr) == other.numberValue) return true;
-        }
-        if (other.type == XPathResultType::Boolean) {
-          XPathResult br;
-          br.type = XPathResultType::String;
-          br.stringValue = sv;
-          if (resultToBool(br) == other.boolValue) return true;
-        }
+        if (other.type == XPathResultType::Number && stringToNumber(sv) == other.numberValue) return true;
+        if (other.type == XPathResultType::Boolean && !sv.empty() == other.boolValue) return true;
         if (other.type == XPathResultType::NodeSet) {
           for (const auto &otherSv : otherStrings) {
             if (sv == otherSv) return true;
@@ -769,56 +755,55 @@ static XPathResult evalExpr(const XPathExpr &expr,
         else
           eq = nodeSetContains(right, left);
       } else if (left.type == XPathResultType::Boolean || right.type == XPathResultType::Boolean) {
-        eq = (resultToBool(left) == resultToBool(right));
+        eq = (toBool(left) == toBool(right));
       } else if (left.type == XPathResultType::Number || right.type == XPathResultType::Number) {
-        eq = (resultToNumber(left) == resultToNumber(right));
+        eq = (toNumber(left) == toNumber(right));
       } else {
-        eq = (resultToString(left) == resultToString(right));
+        eq = (toString(left) == toString(right));
       }
-      return makeBool((b->op == XPathBinaryExpr::Op::Eq) ? eq : !eq);
+      return makeBool<Handle>((b->op == XPathBinaryExpr::Op::Eq) ? eq : !eq);
     }
 
     // Relational and arithmetic: coerce to numbers
-    const double lv = resultToNumber(left);
-    const double rv = resultToNumber(right);
+    const double lv = toNumber(left);
+    const double rv = toNumber(right);
     switch (b->op) {
-    case XPathBinaryExpr::Op::Lt:   return makeBool(lv < rv);
-    case XPathBinaryExpr::Op::Gt:   return makeBool(lv > rv);
-    case XPathBinaryExpr::Op::LtEq: return makeBool(lv <= rv);
-    case XPathBinaryExpr::Op::GtEq: return makeBool(lv >= rv);
-    case XPathBinaryExpr::Op::Add:  return makeNumber(lv + rv);
-    case XPathBinaryExpr::Op::Sub:  return makeNumber(lv - rv);
-    case XPathBinaryExpr::Op::Mul:  return makeNumber(lv * rv);
+    case XPathBinaryExpr::Op::Lt:   return makeBool<Handle>(lv < rv);
+    case XPathBinaryExpr::Op::Gt:   return makeBool<Handle>(lv > rv);
+    case XPathBinaryExpr::Op::LtEq: return makeBool<Handle>(lv <= rv);
+    case XPathBinaryExpr::Op::GtEq: return makeBool<Handle>(lv >= rv);
+    case XPathBinaryExpr::Op::Add:  return makeNumber<Handle>(lv + rv);
+    case XPathBinaryExpr::Op::Sub:  return makeNumber<Handle>(lv - rv);
+    case XPathBinaryExpr::Op::Mul:  return makeNumber<Handle>(lv * rv);
     case XPathBinaryExpr::Op::Div:
-      return makeNumber((rv == 0.0) ? std::numeric_limits<double>::infinity() : lv / rv);
-    case XPathBinaryExpr::Op::Mod:  return makeNumber(std::fmod(lv, rv));
+      return makeNumber<Handle>((rv == 0.0) ? std::numeric_limits<double>::infinity() : lv / rv);
+    case XPathBinaryExpr::Op::Mod:  return makeNumber<Handle>(std::fmod(lv, rv));
     default:                        return {};
     }
   }
 
   // Unary minus
   if (const auto *u = dynamic_cast<const XPathUnaryExpr *>(&expr)) {
-    auto val = evalExpr(*u->operand, contextNode, contextPosition, contextSize, documentRoot, ancestorStack);
-    return makeNumber(-resultToNumber(val));
+    auto val = evalExpr(*u->operand, contextNode, contextPosition, contextSize, ancestorStack);
+    return makeNumber<Handle>(-toNumber(val));
   }
 
   // Function call
   if (const auto *fc = dynamic_cast<const XPathFunctionCall *>(&expr)) {
-    return evalBuiltinFunction(
-      fc->name, fc->args, contextNode, contextPosition, contextSize, documentRoot, ancestorStack);
+    return evalBuiltinFunction(fc->name, fc->args, contextNode, contextPosition, contextSize, ancestorStack);
   }
 
   // Filter expression (primary + predicates)
   if (const auto *fe = dynamic_cast<const XPathFilterExpr *>(&expr)) {
-    auto primary = evalExpr(*fe->primary, contextNode, contextPosition, contextSize, documentRoot, ancestorStack);
+    auto primary = evalExpr(*fe->primary, contextNode, contextPosition, contextSize, ancestorStack);
     if (fe->predicates.empty()) return primary;
     if (primary.type != XPathResultType::NodeSet) return primary;
     for (const auto &pred : fe->predicates) {
-      std::vector<const Node *> surviving;
+      std::vector<Handle> surviving;
       const size_t total = primary.nodeSet.size();
       size_t pos = 1;
-      for (const auto *n : primary.nodeSet) {
-        if (evalPredicate(pred, *n, pos, total, documentRoot, ancestorStack)) surviving.push_back(n);
+      for (const auto n : primary.nodeSet) {
+        if (evalPredicate(pred, n, pos, total, ancestorStack)) surviving.push_back(n);
         ++pos;
       }
       primary.nodeSet = std::move(surviving);
@@ -828,12 +813,12 @@ static XPathResult evalExpr(const XPathExpr &expr,
 
   // String literal
   if (const auto *sl = dynamic_cast<const XPathStringLiteral *>(&expr)) {
-    return makeString(sl->value);
+    return makeString<Handle>(sl->value);
   }
 
   // Number literal
   if (const auto *nl = dynamic_cast<const XPathNumberLiteral *>(&expr)) {
-    return makeNumber(nl->value);
+    return makeNumber<Handle>(nl->value);
   }
 
   XML_LIB_THROW(XPath::Error("Internal evaluator error: unknown AST node type."));
@@ -843,29 +828,35 @@ static XPathResult evalExpr(const XPathExpr &expr,
 // Shared evaluation entry point
 // ========================================================================
 /// <summary>
-/// Tokenize, parse and evaluate an XPath expression against docRoot.
+/// Tokenize, parse and evaluate an XPath expression against the document root.
 /// Throws XPath::Error on empty expression, syntax errors, or runtime errors.
 /// </summary>
-static XPathResult evalExpression(const std::string_view expression, const Node &docRoot)
+template<typename Model>
+typename XPath_Evaluator<Model>::Result XPath_Evaluator<Model>::evaluate(const std::string_view expression) const
 {
   if (expression.empty()) { XML_LIB_THROW(XPath::Error("Empty expression.")); }
   const auto tokens = xpathTokenize(expression);
   const auto ast = xpathParse(tokens);
-  const std::vector<const Node *> emptyAncestors;
-  return evalExpr(*ast, docRoot, 1, 1, docRoot, emptyAncestors);
+  const std::vector<Handle> emptyAncestors;
+  return evalExpr(*ast, documentRoot, 1, 1, emptyAncestors);
 }
 
+template class XPath_Evaluator<XPath_TreeModel>;
+template class XPath_Evaluator<XPath_TapeModel>;
+
 // ========================================================================
 // XPath_Impl public methods (called from XPath::evaluate etc.)
 // ========================================================================
-XPath_Impl::XPath_Impl(const Node &root) : xmlRoot(root) {}
+XPath_Impl::XPath_Impl(const Node &root) : xmlRoot(&root) {}
+XPath_Impl::XPath_Impl(const XMLTape_Impl &tape) : xmlTape(&tape) {}
 
-std::vector<const Node *> XPath_Impl::evaluate(const std::string_view expression) const
+/// <summary>
+/// Run an evaluation, reporting any failure as an XPath::Error.
+/// </summary>
+template<typename Evaluate> static auto reportErrors(Evaluate &&evaluate)
 {
   try {
-    XPathResult result = evalExpression(expression, xmlRoot);
-    if (result.type == XPathResultType::NodeSet) return result.nodeSet;
-    return {};
+    return evaluate();
   } catch (const XPath::Error &) {
     throw;
   } catch (const std::exception &e) {
@@ -873,37 +864,67 @@ std::vector<const Node *> XPath_Impl::evaluate(const std::string_view expression
   }
 }
 
+/// <summary>
+/// Evaluate an expression against the bound document (Node tree or tape) and
+/// convert its result with convert.
+/// </summary>
+template<typename Convert>
+static auto evaluateWith(const Node *xmlRoot, const XMLTape_Impl *xmlTape, const std::string_view expression, Convert &&convert)
+{
+  return reportErrors([&] {
+    if (xmlTape != nullptr) {
+      const XPath_Evaluator<XPath_TapeModel> evaluator{ XPath_TapeModel{ *xmlTape }, xmlTape->root().index() };
+      return convert(evaluator, evaluator.evaluate(expression));
+    }
+    const XPath_Evaluator<XPath_TreeModel> evaluator{ XPath_TreeModel{}, xmlRoot };
+    return convert(evaluator, evaluator.evaluate(expression));
+  });
+}
+
+std::vector<const Node *> XPath_Impl::evaluate(const std::string_view expression) const
+{
+  if (xmlRoot == nullptr) { XML_LIB_THROW(XPath::Error("Evaluator is bound to a tape; use evaluateTape().")); }
+  return reportErrors([&] {
+    auto result = XPath_Evaluator<XPath_TreeModel>{ XPath_TreeModel{}, xmlRoot }.evaluate(expression);
+    if (result.type == XPathResultType::NodeSet) return std::move(result.nodeSet);
+    return std::vector<const Node *>{};
+  });
+}
+
+std::vector<XMLTapeNode> XPath_Impl::evaluateTape(const std::string_view expression) const
+{
+  if (xmlTape == nullptr) { XML_LIB_THROW(XPath::Error("Evaluator is bound to a Node tree; use evaluate().")); }
+  return reportErrors([&] {
+    const auto result =
+      XPath_Evaluator<XPath_TapeModel>{ XPath_TapeModel{ *xmlTape }, xmlTape->root().index() }.evaluate(expression);
+    std::vector<XMLTapeNode> nodes;
+    if (result.type == XPathResultType::NodeSet) {
+      nodes.reserve(result.nodeSet.size());
+      for (const auto index : result.nodeSet) { nodes.push_back(xmlTape->node(index)); }
+    }
+    return nodes;
+  });
+}
+
 std::string XPath_Impl::evaluateString(const std::string_view expression) const
 {
-  try {
-    return resultToString(evalExpression(expression, xmlRoot));
-  } catch (const XPath::Error &) {
-    throw;
-  } catch (const std::exception &e) {
-    XML_LIB_THROW(XPath::Error(e.what()));
-  }
+  return evaluateWith(xmlRoot, xmlTape, expression, [](const auto &evaluator, const auto &result) {
+    return evaluator.toString(result);
+  });
 }
 
 bool XPath_Impl::evaluateBool(const std::string_view expression) const
 {
-  try {
-    return resultToBool(evalExpression(expression, xmlRoot));
-  } catch (const XPath::Error &) {
-    throw;
-  } catch (const std::exception &e) {
-    XML_LIB_THROW(XPath::Error(e.what()));
-  }
+  return evaluateWith(xmlRoot, xmlTape, expression, [](const auto &evaluator, const auto &result) {
+    return evaluator.toBool(result);
+  });
 }
 
 double XPath_Impl::evaluateNumber(const std::string_view expression) const
 {
-  try {
-    return resultToNumber(evalExpression(expression, xmlRoot));
-  } catch (const XPath::Error &) {
-    throw;
-  } catch (const std::exception &e) {
-    XML_LIB_THROW(XPath::Error(e.what()));
-  }
+  return evaluateWith(xmlRoot, xmlTape, expression, [](const auto &evaluator, const auto &result) {
+    return evaluator.toNumber(result);
+  });
 }
 
 }// namespace XML_Lib
@@ -4,13 +4,7 @@
 
 namespace XML_Lib {
 
-std::string_view localTagView(const Node &node)
-{
-  const auto &name = NRef<Element>(node).name();
-  const auto pos = name.find(':');
-  const auto view = std::string_view(name);
-  return pos != std::string::npos ? view.substr(pos + 1) : view;
-}
+std::string_view localTagView(const Node &node) { return NRef<Element>(node).getLocalName(); }
 
 std::string_view attrValueView(const Node &node, const std::string_view &attrName)
 {
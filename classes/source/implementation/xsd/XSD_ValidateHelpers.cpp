@@ -20,15 +20,19 @@ std::unordered_map<std::string, uint32_t> collectElementChildCounts(const Node &
 {
   std::unordered_map<std::string, uint32_t> counts;
   for (const auto &child : xNode.getChildren()) {
-    if (isElementLikeNode(child)) { ++counts[NRef<Element>(child).name()]; }
+    if (isElementLikeNode(child)) { ++counts[std::string(NRef<Element>(child).name())]; }
   }
   return counts;
 }
 
-const XSD_Particle *findDeclaredParticle(const XSD_ComplexType &type, const std::string_view childName)
+const XSD_Particle *findDeclaredParticle(const XSD_ComplexType &type, const Element &child)
 {
+  // Names in the schema's table are matched by symbol, others by string
+  const auto *childTable = &child.getNameTable();
   for (const auto &p : type.particles) {
-    if (p.elementName == childName) { return &p; }
+    if (p.nameTable == childTable ? p.elementSymbol == child.getNameSymbol() : p.elementName == child.name()) {
+      return &p;
+    }
   }
   return nullptr;
 }
@@ -163,6 +163,9 @@ void XSD_Impl::parseAttributeDecl(const Node &attrNode, XSD_AttributeDecl &attr)
 void XSD_Impl::parseParticle(const Node &particleNode, XSD_Particle &particle)
 {
   particle.elementName = std::string(attrValue(particleNode, "name"));
+  auto &nameTable = NRef<Element>(particleNode).getNameTable();
+  particle.nameTable = &nameTable;
+  particle.elementSymbol = nameTable.intern(particle.elementName);
   parseOccurrenceBounds(particleNode, particle.minOccurs, particle.maxOccurs);
   particle.typeRef = resolveType(attrValue(particleNode, "type"));
 
@@ -296,7 +299,7 @@ void XSD_Impl::parseSchema(const Node &schemaNode)
 {
   const auto tag = localTag(schemaNode);
   if (tag != "schema") {
-    XML_LIB_THROW(IValidator::Error("XSD root element must be 'xs:schema', found: '" + NRef<Element>(schemaNode).name() + "'."));
+    XML_LIB_THROW(IValidator::Error("XSD root element must be 'xs:schema', found: '" + std::string(NRef<Element>(schemaNode).name()) + "'."));
   }
 
   targetNamespace = attrValue(schemaNode, "targetNamespace");
@@ -185,7 +185,7 @@ void XSD_Impl::validateSimpleValue(const std::string &value, const std::string &
 void XSD_Impl::validateAttributes(const Node &xNode, const XSD_ComplexType &type)
 {
   const auto &elem = NRef<Element>(xNode);
-  const std::string &elemName = elem.name();
+  const std::string elemName{ elem.name() };
 
   // Check declared attributes
   for (const auto &declAttr : type.attributes) {
@@ -197,7 +197,7 @@ void XSD_Impl::validateAttributes(const Node &xNode, const XSD_ComplexType &type
       xsdError(elemName, "attribute '" + declAttr.name + "' is prohibited.");
     }
     if (present) {
-      const auto attrVal = elem[declAttr.name].getParsed();
+      const std::string attrVal{ elem[declAttr.name].getParsed() };
       if (!declAttr.fixedValue.empty() && attrVal != declAttr.fixedValue) {
         xsdError(elemName,
           "attribute '" + declAttr.name + "' must have fixed value '" + declAttr.fixedValue + "' but got '" + attrVal
@@ -212,7 +212,7 @@ void XSD_Impl::validateAttributes(const Node &xNode, const XSD_ComplexType &type
   // Check for undeclared attributes (skip xmlns* always)
   if (!type.hasAnyAttribute) {
     for (const auto &attr : elem.getAttributes()) {
-      const auto &attrName = attr.getName();
+      const std::string attrName{ attr.getName() };
       if (attrName.starts_with("xmlns")) { continue; }
       const bool declared =
         std::ranges::any_of(type.attributes, [&](const XSD_AttributeDecl &d) { return d.name == attrName; });
@@ -228,14 +228,21 @@ void XSD_Impl::validateAttributes(const Node &xNode, const XSD_ComplexType &type
 /// Return the text content of a node (concatenated content children, trimmed).
 static std::string getTextContent(const Node &xNode)
 {
-  std::string result;
-  for (const auto &child : xNode.getChildren()) {
-    if (isA<Content>(child)) { result += child.getContents(); }
+  // Text of a single content child is trimmed where it is, otherwise it is concatenated first
+  std::string concatenated;
+  std::string_view text;
+  if (const auto &children = xNode.getChildren(); children.size() == 1 && isA<Content>(children.front())) {
+    text = NRef<Content>(children.front()).value();
+  } else {
+    for (const auto &child : children) {
+      if (isA<Content>(child)) { concatenated += child.getContents(); }
+    }
+    text = concatenated;
   }
   // Trim leading/trailing whitespace
-  const auto start = result.find_first_not_of(" \t\r\n");
-  if (start == std::string::npos) { return ""; }
-  return result.substr(start, result.find_last_not_of(" \t\r\n") - start + 1);
+  const auto start = text.find_first_not_of(" \t\r\n");
+  if (start == std::string_view::npos) { return ""; }
+  return std::string(text.substr(start, text.find_last_not_of(" \t\r\n") - start + 1));
 }
 
 /// Extract text content from xNode, then validate it against a named type
@@ -257,7 +264,7 @@ void XSD_Impl::validateNodeText(const Node &xNode, const std::string &typeRef, c
 void XSD_Impl::validateElement(const Node &xNode, const XSD_ComplexType &type)
 {
   const auto &elem = NRef<Element>(xNode);
-  const std::string &elemName = elem.name();
+  const std::string elemName{ elem.name() };
 
   // Validate attributes
   validateAttributes(xNode, type);
@@ -311,10 +318,10 @@ void XSD_Impl::validateElement(const Node &xNode, const XSD_ComplexType &type)
   for (const auto &child : xNode.getChildren()) {
     if (!isElementLikeNode(child)) { continue; }
     const auto &childElem = NRef<Element>(child);
-    const auto &childName = childElem.name();
+    const std::string childName{ childElem.name() };
 
     // Find this child's declared particle
-    const XSD_Particle *particle = findDeclaredParticle(type, childName);
+    const XSD_Particle *particle = findDeclaredParticle(type, childElem);
     if (!particle) { continue; }
 
     // Resolve type for child
@@ -344,13 +351,13 @@ void XSD_Impl::validate(const Node &xNode)
 {
   // xNode is the root element of the XML
   const auto &rootElem = NRef<Element>(xNode);
-  const auto &rootName = rootElem.name();
+  const std::string rootName{ rootElem.name() };
 
   // Find matching top-level element declaration
   const auto *decl = findTopLevelElement(rootName);
   if (!decl) {
     // Check local name only (in case of namespace prefix)
-    const auto localName = rootName.find(':') != std::string::npos ? rootName.substr(rootName.find(':') + 1) : rootName;
+    const auto localName = rootElem.getLocalName();
     for (const auto &d : rootElements) {
       if (d.name == localName) {
         decl = &d;
@@ -60,7 +60,7 @@ static void query(const std::string &label, const std::string &expr)
         xp.evaluateString("string(title)");// evaluated from context — use evaluateString for display
       // Just show the element name; use a separate XPath for title text
       if (xl::isA<xl::Element>(*n) || xl::isA<xl::Root>(*n)) {
-        const std::string nm = xl::NRef<xl::Element>(*n).name();
+        const std::string nm{ xl::NRef<xl::Element>(*n).name() };
         PLOG_INFO << "    element     : <" << nm << ">";
       }
     }
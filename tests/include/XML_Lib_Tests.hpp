@@ -5,6 +5,10 @@
 #include "catch2/catch_all.hpp"
 
 #include "XML.hpp"
+#include "XMLFeedParser.hpp"
+#include "XMLReader.hpp"
+#include "XMLRecordReader.hpp"
+#include "XMLTape.hpp"
 #if defined(XML_LIB_TEST_INTERNALS)
 #include "XML_Core.hpp"
 #endif
@@ -29,6 +29,8 @@ struct Mock_IParser : IParser
     return Node{};
   }
 
+  void parse(ISource &, IParseHandler &, const ParseOptions &) override { parseCalled = true; }
+
   bool canValidate() override { return canValidateResult; }
 
   void validate(Node &) override { validateCalled = true; }
@@ -110,4 +110,45 @@ TEST_CASE("XML attribute usage tests cases.", "[XML][Value]")
     REQUIRE(attr.getUnparsed().empty());
     REQUIRE(attr.getParsed().empty());
   }
-}
\ No newline at end of file
+
+  SECTION("Attribute keeps value and quote when parsed and unparsed are the same.", "[XML][Attribute][Create]")
+  {
+    XMLAttribute attr("plain", XMLValue("value", "value", '\''));
+    REQUIRE(attr.getUnparsed() == "value");
+    REQUIRE(attr.getParsed() == "value");
+    REQUIRE(attr.getQuote() == '\'');
+    REQUIRE_FALSE(attr.isReference());
+  }
+  SECTION("Attributes moved into storage with another memory resource keep their values.", "[XML][Attribute][Allocator]")
+  {
+    std::pmr::monotonic_buffer_resource resource;
+    std::pmr::vector<XMLAttribute> attributes{ &resource };
+    XMLAttribute attr("moved", XMLValue("&amp;", "&"));
+    attributes.push_back(std::move(attr));
+    attributes.emplace_back("added", XMLValue("a&lt;b", "a<b"));
+    REQUIRE(attributes[0].get_allocator().resource() == &resource);
+    REQUIRE(attributes[0].getName() == "moved");
+    REQUIRE(attributes[0].getUnparsed() == "&amp;");
+    REQUIRE(attributes[0].getParsed() == "&");
+    REQUIRE(attributes[1].getUnparsed() == "a&lt;b");
+    REQUIRE(attributes[1].getParsed() == "a<b");
+  }
+  SECTION("Attribute with its value in situ refers to the caller's characters and so do its copies.", "[XML][Attribute][InSitu]")
+  {
+    const std::string buffer{ "id=\"order-1\"" };
+    const XMLAttribute attr = XMLAttribute::inSitu("id", std::string_view(buffer).substr(4, 7), '"');
+    REQUIRE(attr.isInSitu());
+    REQUIRE(attr.getParsed() == "order-1");
+    REQUIRE(attr.getUnparsed() == "order-1");
+    REQUIRE(attr.getParsed().data() == buffer.data() + 4);
+    std::pmr::monotonic_buffer_resource resource;
+    std::pmr::vector<XMLAttribute> attributes{ &resource };
+    attributes.push_back(attr);
+    REQUIRE(attributes[0].isInSitu());
+    REQUIRE(attributes[0].getParsed().data() == buffer.data() + 4);
+    attributes[0] = XMLValue{ "&amp;", "&" };
+    REQUIRE_FALSE(attributes[0].isInSitu());
+    REQUIRE(attributes[0].getParsed() == "&");
+    REQUIRE(attr.getParsed() == "order-1");
+  }
+}
@@ -0,0 +1,133 @@
+#include "XML_Lib_Tests.hpp"
+
+#include <thread>
+
+TEST_CASE("Check the interning of names in a name table.", "[XML][NameTable]")
+{
+  SECTION("Intern a name twice returns the same symbol.", "[XML][NameTable][Intern]")
+  {
+    XML_NameTable nameTable;
+    const auto symbol = nameTable.intern("element");
+    REQUIRE(nameTable.intern("element") == symbol);
+    REQUIRE(nameTable.intern("other") != symbol);
+    REQUIRE(nameTable.name(symbol) == "element");
+    REQUIRE(nameTable.size() == 2);
+  }
+  SECTION("Find a name returns its symbol only if it has been interned.", "[XML][NameTable][Find]")
+  {
+    XML_NameTable nameTable;
+    const auto symbol = nameTable.intern("h:td");
+    REQUIRE(nameTable.find("h:td") == symbol);
+    REQUIRE(nameTable.find("td") == XML_NameTable::kNoSymbol);
+    REQUIRE(nameTable.size() == 1);
+  }
+  SECTION("The prefix and local name of an interned name are those either side of its colon.", "[XML][NameTable][QName]")
+  {
+    XML_NameTable nameTable;
+    const auto prefixed = nameTable.intern("h:td");
+    const auto unprefixed = nameTable.intern("td");
+    REQUIRE(nameTable.prefix(prefixed) == "h");
+    REQUIRE(nameTable.localName(prefixed) == "td");
+    REQUIRE(nameTable.prefix(unprefixed).empty());
+    REQUIRE(nameTable.localName(unprefixed) == "td");
+    REQUIRE(nameTable.size() == 2);
+  }
+  SECTION("Intern many names leaves those already interned where they were.", "[XML][NameTable][Intern]")
+  {
+    XML_NameTable nameTable;
+    const auto first = nameTable.name(nameTable.intern("a name long enough not to be held in a small string buffer"));
+    for (int name = 0; name < 10000; name++) { REQUIRE(nameTable.intern("name" + std::to_string(name)) == name + 1); }
+    REQUIRE(nameTable.name(nameTable.find("a name long enough not to be held in a small string buffer")).data() == first.data());
+    REQUIRE(nameTable.name(5001) == "name5000");
+    REQUIRE(nameTable.size() == 10001);
+  }
+  SECTION("Intern the same names on several threads in a shared table gives each one symbol.", "[XML][NameTable][Threads]")
+  {
+    XML_NameTable nameTable;
+    nameTable.markShared();
+    std::vector<std::vector<XML_NameTable::Symbol>> symbols(4);
+    {
+      std::vector<std::jthread> threads;
+      for (auto &threadSymbols : symbols) {
+        threads.emplace_back([&nameTable, &threadSymbols] {
+          for (int name = 0; name < 1000; name++) { threadSymbols.push_back(nameTable.intern("name" + std::to_string(name))); }
+        });
+      }
+    }
+    REQUIRE(nameTable.size() == 1000);
+    for (const auto &threadSymbols : symbols) {
+      REQUIRE(threadSymbols == symbols.front());
+      for (int name = 0; name < 1000; name++) { REQUIRE(nameTable.name(threadSymbols[name]) == "name" + std::to_string(name)); }
+    }
+  }
+  SECTION("Match a name against names in different tables.", "[XML][NameTable][Match]")
+  {
+    XML_NameTable first;
+    XML_NameTable second;
+    const auto firstItem = first.intern("item");
+    const auto firstOther = first.intern("other");
+    const auto secondPadding = second.intern("padding");
+    const auto secondItem = second.intern("item");
+    XML_NameTable::Matcher matcher{ "item" };
+    REQUIRE(matcher.matches(first, firstItem));
+    REQUIRE_FALSE(matcher.matches(second, secondPadding));
+    REQUIRE(matcher.matches(second, secondItem));
+    REQUIRE_FALSE(matcher.matches(first, firstOther));
+    REQUIRE_FALSE(XML_NameTable::Matcher{ "none" }.matches(first, firstItem));
+  }
+}
+
+TEST_CASE("Check the names of parsed documents.", "[XML][NameTable][Parse]")
+{
+  SECTION("Parse a document gives elements of the same name the same symbol.", "[XML][NameTable][Parse]")
+  {
+    XML xml;
+    xml.parse(BufferSource{ "<root><item id=\"1\"/><item id=\"2\"/><other id=\"3\"/></root>" });
+    const auto &first = NRef<Element>(xml.root()[0]);
+    const auto &second = NRef<Element>(xml.root()[1]);
+    const auto &other = NRef<Element>(xml.root()[2]);
+    REQUIRE(&first.getNameTable() == &second.getNameTable());
+    REQUIRE(first.getNameSymbol() == second.getNameSymbol());
+    REQUIRE(first.getNameSymbol() != other.getNameSymbol());
+    REQUIRE(first.getAttributes()[0].getNameSymbol() == other.getAttributes()[0].getNameSymbol());
+    REQUIRE(&first.getNameTable() != &XML_NameTable::global());
+  }
+  SECTION("Parse two documents gives each its own name table.", "[XML][NameTable][Parse]")
+  {
+    XML first{ "<root><a/></root>" };
+    XML second{ "<root><b/></root>" };
+    REQUIRE(&NRef<Root>(first.root()).getNameTable() != &NRef<Root>(second.root()).getNameTable());
+    REQUIRE(NRef<Root>(first.root()).getNameTable().find("b") == XML_NameTable::kNoSymbol);
+    REQUIRE_FALSE(NRef<Root>(first.root()).getNameTable().isShared());
+    REQUIRE(XML_NameTable::global().isShared());
+  }
+  SECTION("Parse two documents sharing a name table gives their names the same symbols.", "[XML][NameTable][Parse]")
+  {
+    const auto nameTable = std::make_shared<XML_NameTable>();
+    XML first;
+    XML second;
+    first.parse(BufferSource{ "<root><a/></root>" }, ParseOptions{ .nameTable = nameTable });
+    second.parse(BufferSource{ "<root><b/><a/></root>" }, ParseOptions{ .nameTable = nameTable });
+    REQUIRE(&NRef<Self>(first.root()[0]).getNameTable() == nameTable.get());
+    REQUIRE(NRef<Self>(first.root()[0]).getNameSymbol() == NRef<Self>(second.root()[1]).getNameSymbol());
+    REQUIRE(nameTable->size() == 3);
+    REQUIRE(nameTable->isShared());
+  }
+  SECTION("Find a child made outside of a parse in a parsed document.", "[XML][NameTable][Parse]")
+  {
+    XML xml{ "<root><a/></root>" };
+    xml.root().addChild(Node::make<Element>("added"));
+    REQUIRE(&NRef<Element>(xml.root()["added"]).getNameTable() == &XML_NameTable::global());
+    REQUIRE(NRef<Element>(xml.root()["a"]).name() == "a");
+    REQUIRE_THROWS_WITH(xml.root()["none"], "Node Error: Element 'none' does not exist.");
+  }
+  SECTION("Assign a parsed attribute keeps the name table of the attribute assigned to.", "[XML][NameTable][Attribute]")
+  {
+    XML xml{ "<root name=\"value\"/>" };
+    XMLAttribute attribute{ "other", XMLValue{ "" } };
+    attribute = NRef<Self>(xml.root()).getAttributes()[0];
+    REQUIRE(&attribute.getNameTable() == &XML_NameTable::global());
+    REQUIRE(attribute.getName() == "name");
+    REQUIRE(attribute.getParsed() == "value");
+  }
+}
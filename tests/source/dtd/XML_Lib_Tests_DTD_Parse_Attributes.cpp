@@ -55,6 +55,8 @@ TEST_CASE("Parse XML DTD with attributes and check values.", "[XML][DTD][Parse][
     REQUIRE(xDTD.getType() == DTD::Type::internal);
     REQUIRE(xDTD.getRootName() == NRef<Element>(xml.root()).name());
     REQUIRE(xDTD.getRootName() == "TVSCHEDULE");
+    REQUIRE(xDTD.unparsed().starts_with("<!DOCTYPE TVSCHEDULE ["));
+    REQUIRE(xDTD.unparsed().ends_with("<!ATTLIST TITLE LANGUAGE CDATA #IMPLIED>]>"));
     REQUIRE(xDTD.getElement("TVSCHEDULE").name == "TVSCHEDULE");
     REQUIRE(xDTD.getElement("CHANNEL").name == "CHANNEL");
     REQUIRE(xDTD.getElement("BANNER").name == "BANNER");
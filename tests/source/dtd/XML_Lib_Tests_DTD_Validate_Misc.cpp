@@ -42,4 +42,23 @@ TEST_CASE("Parse XML with various DTD issues.", "[XML][DTD][Validate]")
     xml.parse(source1);
     REQUIRE_NOTHROW(xml.parse(source2));
   }
+  SECTION("XML with DTD validated after another document is parsed.", "[XML][DTD][Validate]")
+  {
+    BufferSource source1{
+      "<?xml version=\"1.0\"?>\n"
+      "<!DOCTYPE root [\n"
+      "<!ELEMENT root (child1)+ >\n"
+      "<!ELEMENT child1 (#PCDATA)>\n"
+      "]>\n"
+      "<root>\n"
+      "<child1>contents</child1>\n"
+      "</root>\n"
+    };
+    BufferSource source2{ "<root></root>" };
+    xml.parse(source1);
+    const XML other;
+    other.parse(source2);
+    REQUIRE_NOTHROW(xml.validate());
+    REQUIRE_THROWS_WITH(other.validate(), "IParser Error: No DTD specified for validation.");
+  }
 }
\ No newline at end of file
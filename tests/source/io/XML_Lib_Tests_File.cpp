@@ -45,20 +45,19 @@ TEST_CASE("Check file format API.", "[XML][File][Format]")
   SECTION("Check UTF-8 file with byte order mark and parse.", "[XML][File][Format]")
   {
     REQUIRE(XML::getFileFormat(prefixTestDataPath("testfile017.xml")) == XML::Format::utf8BOM);
-    REQUIRE_THROWS_WITH(xml.parse(FileSource(prefixTestDataPath("testfile017.xml"))),
-      "XML Syntax Error [Line: 1 Column: 1] Content detected before root element.");
+    REQUIRE_NOTHROW(xml.parse(FileSource(prefixTestDataPath("testfile017.xml"))));
   }
   SECTION("Check UTF-16BE file with byte order mark and parse.", "[XML][File][Format]")
   {
     REQUIRE(XML::getFileFormat(prefixTestDataPath("testfile018.xml")) == XML::Format::utf16BE);
-    REQUIRE_THROWS_WITH(xml.parse(FileSource(prefixTestDataPath("testfile017.xml"))),
-      "XML Syntax Error [Line: 1 Column: 1] Content detected before root element.");
+    REQUIRE_THROWS_WITH(xml.parse(FileSource(prefixTestDataPath("testfile018.xml"))),
+      "FileSource Error: Invalid UTF-8 sequence encountered.");
   }
   SECTION("Check UTF-16LE file with byte order mark and parse.", "[XML][File][Format]")
   {
     REQUIRE(XML::getFileFormat(prefixTestDataPath("testfile019.xml")) == XML::Format::utf16LE);
-    REQUIRE_THROWS_WITH(xml.parse(FileSource(prefixTestDataPath("testfile017.xml"))),
-      "XML Syntax Error [Line: 1 Column: 1] Content detected before root element.");
+    REQUIRE_THROWS_WITH(xml.parse(FileSource(prefixTestDataPath("testfile019.xml"))),
+      "FileSource Error: Invalid UTF-8 sequence encountered.");
   }
   SECTION("Check UTF-8 file with byte order mark load into buffer and parse.", "[XML][File][Format]")
   {
@@ -157,6 +156,23 @@ TEST_CASE("Check file format API.", "[XML][File][Format]")
     REQUIRE(readBack.find("<child>value</child>") != std::string::npos);
     std::filesystem::remove(generatedFileName);
   }
+  SECTION("Read back a file with CRLF and lone CR line endings as LF", "[XML][File][Output]")
+  {
+    const std::string xmlString{ "<root>\r\n<child>a\r\r\nb\rc</child>\r\n</root>\r\n" };
+    const std::string expected{ "<root>\n<child>a\n\nb\nc</child>\n</root>\n" };
+    for (const auto format : { XML::Format::utf8, XML::Format::utf8BOM, XML::Format::utf16BE, XML::Format::utf16LE }) {
+      std::string generatedFileName{ generateRandomFileName() };
+      XML::toFile(generatedFileName, xmlString, format);
+      REQUIRE(XML::fromFile(generatedFileName) == expected);
+      if (format == XML::Format::utf8) {
+        FileSource source{ generatedFileName };
+        xml.parse(source);
+        REQUIRE(xml.root()["child"].getContents() == "a\n\nb\nc");
+        source.close();
+      }
+      std::filesystem::remove(generatedFileName);
+    }
+  }
   SECTION("FileDestination throws on unwritable location", "[XML][File][Output][Error]")
   {
     // Try to write to a location that should not be writable (root on Unix, or invalid path on Windows)
@@ -1,5 +1,9 @@
 #include "XML_Lib_Tests.hpp"
 
+#include <fstream>
+#include <sstream>
+#include <vector>
+
 TEST_CASE("ISource (File) interface.", "[XML][FileSource]")
 {
   SECTION("Create FileSource with testfile001.xml.", "[XML][FileSource]")
@@ -77,7 +81,7 @@ TEST_CASE("ISource (File) interface.", "[XML][FileSource]")
     std::string generatedFileName{ generateRandomFileName() };
     XML::toFile(generatedFileName, xmlString, XML::Format::utf8);
     FileSource source{ generatedFileName };
-    verifyCRLFCount(source, 28, 3);
+    verifyCRLFCount(source, 31, 0);
     source.close();
     std::filesystem::remove(generatedFileName);
   }
@@ -115,7 +119,7 @@ TEST_CASE("ISource (File) interface.", "[XML][FileSource]")
     std::string generatedFileName{ generateRandomFileName() };
     XML::toFile(generatedFileName, xmlString, XML::Format::utf8);
     FileSource source{ generatedFileName };
-    verifyCRLFCount(source, 28, 3);
+    verifyCRLFCount(source, 31, 0);
     source.close();
     std::filesystem::remove(generatedFileName);
   }
@@ -131,7 +135,8 @@ TEST_CASE("ISource (File) interface.", "[XML][FileSource]")
       xmlResult += source.current();
       source.next();
     }
-    REQUIRE(xmlResult == u"<root>TestTestTest</root>");
+    // A form feed is not XML whitespace
+    REQUIRE(xmlResult == u"<root>Test\fTestTest</root>");
     REQUIRE(source.current() == static_cast<XML_Lib::Char>(EOF));
     source.close();
     std::filesystem::remove(generatedFileName);
@@ -245,6 +250,29 @@ TEST_CASE("ISource (File) interface.", "[XML][FileSource]")
     source.close();
     std::filesystem::remove(generatedFileName);
   }
+  SECTION("FileSource decodes UTF-8 and reads back ranges and resets once blocks are discarded.", "[XML][FileSource]")
+  {
+    xmlString = "\xEF\xBB\xBF<root>caf\xC3\xA9\r\n\xF0\x9F\x98\x80";
+    while (xmlString.size() < 4 * FileSource::kBlockSize) { xmlString += "caf\xC3\xA9\r\n"; }
+    std::string generatedFileName{ generateRandomFileName() };
+    std::ofstream{ generatedFileName, std::ios_base::binary } << xmlString;
+    FileSource source{ generatedFileName };
+    REQUIRE_FALSE(!match(source, "<root>caf"));
+    REQUIRE(source.current() == u'\u00E9');
+    source.next();
+    REQUIRE(source.current() == kLineFeed);
+    source.next();
+    REQUIRE(source.current() == 0xD83D);
+    source.next();
+    REQUIRE(source.current() == 0xDE00);
+    while (source.more()) { source.next(); }
+    REQUIRE(source.getRange(0, 17) == "<root>caf\xC3\xA9\n\xF0\x9F\x98\x80");
+    source.reset();
+    REQUIRE(source.position() == 0);
+    REQUIRE(source.current() == '<');
+    source.close();
+    std::filesystem::remove(generatedFileName);
+  }
 }
 TEST_CASE("ISource (Buffer) interface (buffer contains file testfile001.xml).", "[XML][BufferSource]")
 {
@@ -315,7 +343,7 @@ TEST_CASE("ISource (Buffer) interface (buffer contains file testfile001.xml).",
       "]>\r\n"
       "<REPORT>\r\r </REPORT>\r\n";
     BufferSource source{ xmlString };
-    verifyCRLFCount(source, 28, 3);
+    verifyCRLFCount(source, 31, 0);
   }
   SECTION("Check that BufferSource is  performing CRLF to LF conversion on linux format data correctly.",
     "[XML][BufferSource]")
@@ -349,7 +377,7 @@ TEST_CASE("ISource (Buffer) interface (buffer contains file testfile001.xml).",
       "]>\n"
       "<REPORT>\r\r </REPORT>\n";
     BufferSource source{ xmlString };
-    verifyCRLFCount(source, 28, 3);
+    verifyCRLFCount(source, 31, 0);
   }
   SECTION("Check that BufferSource is ignoring whitespace correctly.", "[XML][BufferSource]")
   {
@@ -361,7 +389,8 @@ TEST_CASE("ISource (Buffer) interface (buffer contains file testfile001.xml).",
       xmlResult += source.current();
       source.next();
     }
-    REQUIRE(xmlResult == u"<root>TestTestTest</root>");
+    // A form feed is not XML whitespace
+    REQUIRE(xmlResult == u"<root>Test\fTestTest</root>");
     REQUIRE(source.current() == static_cast<XML_Lib::Char>(EOF));
   }
   SECTION("Check that BufefrSource ignoreWS() at end of file does not throw but next() does.", "[XML][BufferSource]")
@@ -492,4 +521,245 @@ TEST_CASE("ISource (Buffer) interface (buffer contains file testfile001.xml).",
     source.close();
     std::filesystem::remove(generatedFileName);
   }
+  SECTION("Check that BufferSource steps through UTF-8 input as UTF-16 characters.", "[XML][BufferSource][UTF8]")
+  {
+    xmlString = "<a>\xC3\xA9\xE6\xB1\x89\xF0\x9D\x84\x9E</a>";// é汉𝄞
+    BufferSource source{ xmlString };
+    REQUIRE_FALSE(!match(source, "<a>"));
+    REQUIRE(source.current() == u'\u00E9');
+    source.next();
+    REQUIRE(source.current() == u'\u6C49');
+    source.next();
+    REQUIRE(source.current() == 0xD834);
+    source.next();
+    REQUIRE(source.current() == 0xDD1E);
+    REQUIRE(source.getPosition() == std::make_pair(1L, 7L));
+    source.backup(3);
+    REQUIRE(source.current() == u'\u00E9');
+    REQUIRE(source.position() == 3);
+    REQUIRE_FALSE(!match(source, "\xC3\xA9\xE6\xB1\x89\xF0\x9D\x84\x9E"));
+    REQUIRE(source.position() == 12);
+    REQUIRE(source.getRange(3, 12) == "\xC3\xA9\xE6\xB1\x89\xF0\x9D\x84\x9E");
+  }
+  SECTION("Check that BufferSource rejects invalid UTF-8 input.", "[XML][BufferSource][UTF8][Exception]")
+  {
+    REQUIRE_THROWS_WITH(BufferSource{ "\xC3\x28" }, "BufferSource Error: Invalid UTF-8 sequence encountered.");
+    BufferSource source{ "<a>\xED\xA0\x80</a>" };// Encoded surrogate
+    REQUIRE_FALSE(!match(source, "<a"));
+    REQUIRE_THROWS_WITH(source.next(), "BufferSource Error: Invalid UTF-8 sequence encountered.");
+  }
+}
+#if defined(__linux__)
+TEST_CASE("ISource (MappedFile) interface.", "[XML][MappedFileSource]")
+{
+  std::string xmlString;
+  SECTION("Create MappedFileSource with testfile001.xml.", "[XML][MappedFileSource]")
+  {
+    REQUIRE_NOTHROW(MappedFileSource(prefixTestDataPath(kSingleXMLFile)));
+  }
+  SECTION("Create MappedFileSource with empty.xml.", "[XML][MappedFileSource]")
+  {
+    MappedFileSource source{ prefixTestDataPath(KEmptyXMLFile) };
+    REQUIRE_FALSE(source.more());
+    REQUIRE(source.current() == static_cast<XML_Lib::Char>(EOF));
+  }
+  SECTION("Create MappedFileSource with non existent file.", "[XML][MappedFileSource][Exception]")
+  {
+    REQUIRE_THROWS_AS(MappedFileSource(prefixTestDataPath(kNonExistantXMLFile)), MappedFileSource::Error);
+    REQUIRE_THROWS_WITH(MappedFileSource(prefixTestDataPath(kNonExistantXMLFile)),
+      "MappedFileSource Error: File input stream failed to open or does not exist.");
+  }
+  SECTION("Create MappedFileSource with testfile001.xml move past last character, check it and the characters moved.",
+    "[XML][MappedFileSource]")
+  {
+    MappedFileSource source{ prefixTestDataPath(kSingleXMLFile) };
+    REQUIRE(source.current() == '<');
+    long length = 0;
+    while (source.more()) {
+      source.next();
+      length++;
+    }
+    REQUIRE(length == 8752);
+    REQUIRE(source.current() == static_cast<XML_Lib::Char>(EOF));
+    REQUIRE_THROWS_WITH(source.next(), "MappedFileSource Error: Parse buffer empty before parse complete.");
+  }
+  SECTION("Check that MappedFileSource performs CRLF to LF conversion and skips a UTF-8 byte order mark.",
+    "[XML][MappedFileSource]")
+  {
+    xmlString = "\r\r\n<root>\r\nMatch1\r\n\r\r </root>\r\n";
+    std::string generatedFileName{ generateRandomFileName() };
+    XML::toFile(generatedFileName, xmlString, XML::Format::utf8BOM);
+    MappedFileSource source{ generatedFileName };
+    verifyCRLFCount(source, 7, 0);
+    source.reset();
+    source.next();
+    REQUIRE(source.current() == kLineFeed);
+    REQUIRE(source.getPosition() == std::make_pair(2L, 1L));
+    const long start = source.position();
+    REQUIRE_FALSE(!match(source, "\n<root>\nMatch1"));
+    REQUIRE(source.current() == kLineFeed);
+    REQUIRE(source.getPosition() == std::make_pair(4L, 1L));
+    REQUIRE(source.getRange(start, source.position()) == "\n<root>\nMatch1");
+    source.backup(7);
+    REQUIRE(source.current() == kLineFeed);
+    source.backup(1);
+    REQUIRE(source.current() == '>');
+    std::filesystem::remove(generatedFileName);
+  }
+  SECTION("Check that MappedFileSource match and backup work correctly.", "[XML][MappedFileSource]")
+  {
+    xmlString = "<root>Match1    Match2 2hctam        MMAATTCCHHHXML_Lib &</root>";
+    std::string generatedFileName{ generateRandomFileName() };
+    XML::toFile(generatedFileName, xmlString, XML::Format::utf8);
+    MappedFileSource source{ generatedFileName };
+    REQUIRE_FALSE(match(source, "<root> "));
+    REQUIRE_FALSE(!match(source, "<root>Match1"));
+    REQUIRE(source.current() == ' ');
+    source.backup(12);
+    REQUIRE(source.current() == '<');
+    source.backup(12);
+    REQUIRE(source.current() == '<');
+    while (source.more() && !match(source, "Match2")) { source.next(); }
+    REQUIRE(source.position() == 22);
+    REQUIRE(source.getFileName() == generatedFileName);
+    std::filesystem::remove(generatedFileName);
+  }
+  SECTION("Parse the same non-ASCII content from files below and above the mapping threshold.",
+    "[XML][MappedFileSource][FileSource][Parse]")
+  {
+    const std::string item{ "\r\n  <item>caf\xC3\xA9 \xE8\xBB\xA2\xE9\x80\x81</item>" };
+    std::string largeString{ "<root>" };
+    while (largeString.size() < MappedFileSource::kMappedFileThreshold) { largeString += item; }
+    std::vector<std::string> contents;
+    for (const auto &fileString : { "<root>" + item + "</root>", largeString + "</root>" }) {
+      std::string generatedFileName{ generateRandomFileName() };
+      XML::toFile(generatedFileName, fileString, XML::Format::utf8);
+      XML xml;
+      xml.parse(std::filesystem::path{ generatedFileName });
+      contents.emplace_back(xml.root()["item"].getContents());
+      std::filesystem::remove(generatedFileName);
+    }
+    REQUIRE(contents[0] == "caf\xC3\xA9 \xE8\xBB\xA2\xE9\x80\x81");
+    REQUIRE(contents[1] == contents[0]);
+  }
+  SECTION("Parse a file larger than the mapping threshold from its path.", "[XML][MappedFileSource][Parse]")
+  {
+    xmlString = "<root>";
+    while (xmlString.size() < MappedFileSource::kMappedFileThreshold) { xmlString += "\r\n  <item>caf\xC3\xA9</item>"; }
+    xmlString += "</root>";
+    std::string generatedFileName{ generateRandomFileName() };
+    XML::toFile(generatedFileName, xmlString, XML::Format::utf8);
+    XML xml;
+    REQUIRE_NOTHROW(xml.parse(std::filesystem::path{ generatedFileName }));
+    REQUIRE(xml.root()["item"].getContents() == "caf\xC3\xA9");
+    REQUIRE(xml.root().getChildren().size() > 1000);
+    std::filesystem::remove(generatedFileName);
+  }
+}
+#endif
+TEST_CASE("ISource (Stream) interface.", "[XML][StreamSource]")
+{
+  SECTION("Create StreamSource and check it is positioned on the first character.", "[XML][StreamSource]")
+  {
+    std::istringstream stream{ "<root></root>" };
+    StreamSource source{ stream };
+    REQUIRE_FALSE(!source.more());
+    REQUIRE(source.current() == '<');
+  }
+  SECTION("Create StreamSource on an empty stream.", "[XML][StreamSource]")
+  {
+    std::istringstream stream;
+    StreamSource source{ stream };
+    REQUIRE_FALSE(source.more());
+    REQUIRE(source.current() == static_cast<XML_Lib::Char>(EOF));
+  }
+  SECTION("Create StreamSource with an invalid block size.", "[XML][StreamSource][Exception]")
+  {
+    std::istringstream stream{ "<root></root>" };
+    REQUIRE_THROWS_WITH(StreamSource(stream, 0), "StreamSource Error: Invalid block or look-behind size.");
+  }
+  SECTION("Create StreamSource on testfile001.xml move past last character, check it and the characters moved.",
+    "[XML][StreamSource]")
+  {
+    std::ifstream stream{ prefixTestDataPath(kSingleXMLFile), std::ios_base::binary };
+    StreamSource source{ stream };
+    long length = 0;
+    while (source.more()) {
+      source.next();
+      length++;
+    }
+    REQUIRE(length == 8752);
+    REQUIRE(source.current() == static_cast<XML_Lib::Char>(EOF));
+    REQUIRE_THROWS_WITH(source.next(), "StreamSource Error: Parse buffer empty before parse complete.");
+  }
+  SECTION("Check that StreamSource performs CRLF to LF conversion across block boundaries.", "[XML][StreamSource]")
+  {
+    for (const long blockSize : { 1L, 2L, 3L, 5L, StreamSource::kBlockSize }) {
+      std::istringstream stream{ "\xEF\xBB\xBF\r\r\n<root>\r\nMatch1\r\n\r\r </root>\r\n" };
+      StreamSource source{ stream, blockSize };
+      verifyCRLFCount(source, 7, 0);
+    }
+  }
+  SECTION("Check that StreamSource match, backup and getRange work across block boundaries.", "[XML][StreamSource]")
+  {
+    for (const long blockSize : { 1L, 4L, 7L, StreamSource::kBlockSize }) {
+      std::istringstream stream{ "<root>Match1\r\n    Match2 caf\xC3\xA9 \xF0\x9F\x98\x80 XML_Lib &</root>" };
+      StreamSource source{ stream, blockSize };
+      REQUIRE_FALSE(match(source, "<root> "));
+      REQUIRE_FALSE(!match(source, "<root>Match1"));
+      REQUIRE(source.current() == kLineFeed);
+      source.backup(12);
+      REQUIRE(source.current() == '<');
+      while (source.more() && !match(source, "Match2")) { source.next(); }
+      REQUIRE(source.getPosition() == std::make_pair(3L, 12L));
+      const long start = source.position();
+      REQUIRE_FALSE(!match(source, " caf\xC3\xA9 \xF0\x9F\x98\x80"));
+      REQUIRE(source.getRange(start, source.position()) == " caf\xC3\xA9 \xF0\x9F\x98\x80");
+      source.backup(1);
+      REQUIRE(source.current() == 0xDE00);
+      source.backup(1);
+      REQUIRE(source.current() == 0xD83D);
+      source.backup(2);
+      REQUIRE(source.current() == 0x00E9);
+    }
+  }
+  SECTION("Check that StreamSource only holds a bounded window of the stream.", "[XML][StreamSource][Exception]")
+  {
+    std::istringstream stream{ "<root>" + std::string(1000, 'x') + "</root>" };
+    StreamSource source{ stream, 16, 32 };
+    const long start = source.position();
+    while (source.more() && !match(source, "</root>")) { source.next(); }
+    REQUIRE_FALSE(source.more());
+    REQUIRE(source.getRange(source.position() - 32, source.position()) == std::string(25, 'x') + "</root>");
+    REQUIRE_THROWS_WITH(source.getRange(start, source.position()), "StreamSource Error: Range is no longer held by the source.");
+    REQUIRE_THROWS_WITH(source.reset(), "StreamSource Error: Cannot reset once the start of the stream has been discarded.");
+  }
+  SECTION("Parse testfile001.xml through a StreamSource with small blocks and look-behind window.", "[XML][StreamSource][Parse]")
+  {
+    const XML bufferXML;
+    bufferXML.parse(BufferSource{ XML::fromFile(prefixTestDataPath(kSingleXMLFile)) });
+    for (const long blockSize : { 1L, 7L, 64L, StreamSource::kBlockSize }) {
+      std::ifstream stream{ prefixTestDataPath(kSingleXMLFile), std::ios_base::binary };
+      StreamSource source{ stream, blockSize, 64 };
+      const XML streamXML;
+      REQUIRE_NOTHROW(streamXML.parse(source));
+      REQUIRE(streamXML.stringify() == bufferXML.stringify());
+    }
+  }
+  SECTION("Parse multilingual CRLF document through a StreamSource with small blocks.", "[XML][StreamSource][Parse]")
+  {
+    const std::string xmlString{
+      "<?xml version=\"1.0\"?>\r\n<r\xC3\xA9sum\xC3\xA9 \xE5\x90\x8D=\"\xE5\x80\xA4\">\r\n"
+      "<!-- \xF0\x9F\x98\x80 comment -->\r\n<![CDATA[ \xF0\x9F\x98\x80 <raw> ]]>\r\n"
+      "<\xE5\x90\x8D>\xCE\xB1\xCE\xB2\xCE\xB3 &amp; text</\xE5\x90\x8D>\r\n</r\xC3\xA9sum\xC3\xA9>\r\n"
+    };
+    const XML bufferXML;
+    bufferXML.parse(BufferSource{ xmlString });
+    for (const long blockSize : { 1L, 2L, 3L, 5L, 13L }) {
+      std::istringstream stream{ xmlString };
+      const XML streamXML;
+      REQUIRE_NOTHROW(streamXML.parse(StreamSource{ stream, blockSize, 16 }));
+      REQUIRE(streamXML.stringify() == bufferXML.stringify());
+    }
+  }
 }
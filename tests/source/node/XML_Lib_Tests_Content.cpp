@@ -32,6 +32,13 @@ TEST_CASE("Create and use Content Node.", "[Node][Content][API]")
     REQUIRE(content.value() == large);
     REQUIRE(content.getContents() == large);
   }
+  SECTION("Content Node text is read in place.", "[XML][Node][Content][API]")
+  {
+    Content content("Text long enough not to be held in a small string.");
+    REQUIRE(content.value().data() == content.getContents().data());
+    Node xNode = Node::make<Content>("Text long enough not to be held in a small string.");
+    REQUIRE(xNode.getContents().data() == NRef<Content>(xNode).value().data());
+  }
   SECTION("Create Content Node with special characters.", "[XML][Node][Content][Special]")
   {
     std::string special = "<>&\"'\n\t";
@@ -70,7 +70,7 @@ TEST_CASE("Create and use Element Node.","[Node][Element][API]")
   }
   SECTION("Create Element with a given name.", "[XML][Node][Element][API]")
   {
-    auto xElement = Element("test", {}, {});
+    auto xElement = Element("test", {}, nullptr);
     REQUIRE( xElement.name() == "test");
     REQUIRE_FALSE(!xElement.getAttributes().empty());
     REQUIRE_FALSE(!xElement.getNameSpaces().empty());
@@ -78,7 +78,7 @@ TEST_CASE("Create and use Element Node.","[Node][Element][API]")
   }
   SECTION("Create Element with a given name and add attributes to it.", "[XML][Node][Element][API]")
   {
-    auto xElement = Element("test", {}, {});
+    auto xElement = Element("test", {}, nullptr);
     REQUIRE( xElement.name() == "test");
     addAttributes(xElement);
     REQUIRE(xElement.getAttributes().size()==3);
@@ -86,7 +86,7 @@ TEST_CASE("Create and use Element Node.","[Node][Element][API]")
   }
   SECTION("Create Element with a given name and add namespaces to it.", "[XML][Node][Element][API]")
   {
-    auto xElement = Element("test", {}, {});
+    auto xElement = Element("test", {}, nullptr);
     REQUIRE( xElement.name() == "test");
     addNameSpaces(xElement);
     REQUIRE(xElement.getAttributes().size()==3);
@@ -94,7 +94,7 @@ TEST_CASE("Create and use Element Node.","[Node][Element][API]")
   }
   SECTION("Create Element with a given name, add attributes to it, check that attr2 exists and get its values.", "[XML][Node][Element][API]")
   {
-    auto xElement = Element("test", {}, {});
+    auto xElement = Element("test", {}, nullptr);
     REQUIRE( xElement.name() == "test");
     addAttributes(xElement);
     REQUIRE(xElement.getAttributes().size()==3);
@@ -104,7 +104,7 @@ TEST_CASE("Create and use Element Node.","[Node][Element][API]")
   }
   SECTION("Create Element with a given name, add namespaces to it, check that b exists and get its values.", "[XML][Node][Element][API]")
   {
-    auto xElement = Element("test", {}, {});
+    auto xElement = Element("test", {}, nullptr);
     REQUIRE( xElement.name() == "test");
     addNameSpaces(xElement);
     REQUIRE(xElement.getNameSpaces().size()==3);
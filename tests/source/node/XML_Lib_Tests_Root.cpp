@@ -10,7 +10,7 @@ TEST_CASE("Create and use Root Node.","[Node][Root][API]")
   }
   SECTION("Create Root with a given name.", "[XML][Node][Root][API]")
   {
-    auto xRoot = Root("test", {}, {});
+    auto xRoot = Root("test", {}, nullptr);
     REQUIRE( xRoot.name() == "test");
     REQUIRE_FALSE(!xRoot.getAttributes().empty());
     REQUIRE_FALSE(!xRoot.getNameSpaces().empty());
@@ -8,7 +8,7 @@ TEST_CASE("Create and use Self Node.","[Node][Self][API]")
   }
   SECTION("Create Self with a given name.", "[XML][Node][Self][API]")
   {
-    auto xSelf = Self("test", {}, {});
+    auto xSelf = Self("test", {}, nullptr);
     REQUIRE( xSelf.name() == "test");
     REQUIRE_FALSE(!xSelf.getAttributes().empty());
     REQUIRE_FALSE(!xSelf.getNameSpaces().empty());
@@ -74,4 +74,27 @@ TEST_CASE("Variant edge cases and integration", "[XML][Node][Variant][Edge][Inte
     variant.addChild(Node());
     REQUIRE(variant.getChildren().size() == 2);
   }
+
+  SECTION("Variant addChildren moves a run of children in", "[XML][Variant][AddChild]")
+  {
+    Variant variant;
+    std::vector<Node> children;
+    children.push_back(Node::make<Content>("one"));
+    children.push_back(Node::make<Content>("two"));
+    variant.addChildren(children);
+    REQUIRE(variant.getChildren().size() == 2);
+    REQUIRE(variant.getChildren().capacity() == 2);
+    REQUIRE(variant.getChildren()[1].getContents() == "two");
+  }
+
+  SECTION("Variant compactChildren frees unused child storage", "[XML][Variant][Compact]")
+  {
+    Variant variant;
+    for (int child = 0; child < 5; child++) { variant.addChild(Node::make<Content>(std::to_string(child))); }
+    REQUIRE(variant.getChildren().capacity() > 5);
+    variant.compactChildren();
+    REQUIRE(variant.getChildren().size() == 5);
+    REQUIRE(variant.getChildren().capacity() == 5);
+    REQUIRE(variant.getChildren()[4].getContents() == "4");
+  }
 }
@@ -1,6 +1,16 @@
 #include "XML_Lib_Tests.hpp"
 #include "io/XML_BufferSource.hpp"
+#include <atomic>
+#include <codecvt>
+#include <cwctype>
+#include <fstream>
+#include <iterator>
+#include <locale>
+#include <numeric>
+#include <sstream>
 #include <string>
+#include <optional>
+#include <thread>
 
 static std::string makeLargeXML(const size_t itemCount)
 {
@@ -16,6 +26,156 @@ static std::string makeLargeXML(const size_t itemCount)
   return xml;
 }
 
+static std::string makeLongStringXML(const size_t itemCount)
+{
+  std::string xml;
+  xml.reserve(itemCount * 200 + 64);
+  xml += "<root>";
+  for (size_t i = 0; i < itemCount; ++i) {
+    xml += "<item name=\"an attribute value past the small string size\">some item text that is past the small string size ";
+    xml += std::to_string(i);
+    xml += "</item><!-- a comment that is longer than the small string size --><a_rather_long_element_name_here/>";
+  }
+  xml += "</root>";
+  return xml;
+}
+
+static std::string makeMarkupHeavyXML(const size_t itemCount)
+{
+  std::string xml;
+  xml.reserve(itemCount * 120 + 64);
+  xml += "<catalogue>\n";
+  for (size_t i = 0; i < itemCount; ++i) {
+    xml += "    <!-- catalogue entry ";
+    xml += std::to_string(i);
+    xml += " -->\n    <catalogueEntry>\n        <description><![CDATA[Entry <";
+    xml += std::to_string(i);
+    xml += "> raw text]]></description>\n    </catalogueEntry>\n";
+  }
+  xml += "</catalogue>";
+  return xml;
+}
+
+static std::string makeMultilingualXML(const size_t itemCount)
+{
+  std::string xml;
+  xml.reserve(itemCount * 160 + 64);
+  xml += "<catalogue>\n";
+  for (size_t i = 0; i < itemCount; ++i) {
+    xml += "    <!-- \xC3\xA9l\xC3\xA9ment ";
+    xml += std::to_string(i);
+    xml += " \xE7\x9B\xAE\xE5\xBD\x95 -->\n    <\xD0\xB7\xD0\xB0\xD0\xBF\xD0\xB8\xD1\x81\xD1\x8C>\n";
+    xml += "        <description><![CDATA[\xE8\xBD\xAC\xE9\x80\x81 <";
+    xml += std::to_string(i);
+    xml += "> \xF0\x9D\x84\x9E text]]></description>\n    </\xD0\xB7\xD0\xB0\xD0\xBF\xD0\xB8\xD1\x81\xD1\x8C>\n";
+  }
+  xml += "</catalogue>";
+  return xml;
+}
+
+static std::string makeTextHeavyXML(const size_t paragraphCount)
+{
+  static constexpr std::string_view kSentence{
+    "The quick brown fox jumps over the lazy dog while the log collector keeps on writing lines. "
+  };
+  std::string xml;
+  xml.reserve(paragraphCount * (kSentence.size() * 8 + 64) + 64);
+  xml += "<article>\n";
+  for (size_t i = 0; i < paragraphCount; ++i) {
+    xml += "  <para>";
+    for (int sentence = 0; sentence < 8; ++sentence) { xml += kSentence; }
+    xml += "Fish &amp; chips &#169; ";
+    xml += std::to_string(i);
+    xml += "</para>\n";
+  }
+  xml += "</article>";
+  return xml;
+}
+
+// Namespaced document with a DTD, its entries grouped into sections (each entry's text naming the tag given)
+static std::string makeValidatedNameSpacedXML(const size_t sectionCount, const std::string_view &tag)
+{
+  constexpr size_t kSectionSize = 50;
+  std::string xml;
+  xml.reserve(sectionCount * kSectionSize * 48 + 384);
+  xml += "<?xml version=\"1.0\"?>\n<!DOCTYPE c:catalogue [\n<!ELEMENT c:catalogue (c:section)*>\n";
+  xml += "<!ELEMENT c:section (c:entry)*>\n<!ELEMENT c:entry (#PCDATA)>\n";
+  xml += "<!ATTLIST c:catalogue xmlns:c CDATA #FIXED \"urn:catalogue\">\n<!ATTLIST c:entry c:id CDATA #REQUIRED>\n]>\n";
+  xml += "<c:catalogue xmlns:c=\"urn:catalogue\">";
+  for (size_t section = 0; section < sectionCount; ++section) {
+    xml += "<c:section>";
+    for (size_t entry = 0; entry < kSectionSize; ++entry) {
+      xml += "<c:entry c:id=\"";
+      xml += std::to_string(section * kSectionSize + entry);
+      xml += "\">";
+      xml += tag;
+      xml += " &amp; more</c:entry>";
+    }
+    xml += "</c:section>";
+  }
+  xml += "</c:catalogue>";
+  return xml;
+}
+
+// Holds the whole input transcoded to UTF-16 and exposes it through peek()/skip(), so the
+// parser converts every token back to UTF-8 exactly as it did before UTF-8 sources existed.
+class Utf16BufferSource final : public ISource
+{
+public:
+  explicit Utf16BufferSource(const std::string &xmlString) : buffer(toUtf16(xmlString)) {}
+  [[nodiscard]] Char current() const override { return more() ? buffer[bufferPosition] : static_cast<Char>(EOF); }
+  void next() override
+  {
+    bufferPosition++;
+    columnNo++;
+    if (current() == kLineFeed) {
+      lineNo++;
+      columnNo = 1;
+    }
+  }
+  [[nodiscard]] bool more() const override { return bufferPosition < static_cast<long>(buffer.size()); }
+  void backup(const long length) override { bufferPosition = std::max(0L, bufferPosition - length); }
+  [[nodiscard]] long position() const override { return bufferPosition; }
+  std::string getRange(const long start, const long end) override
+  {
+    return toUtf8(buffer.substr(static_cast<std::size_t>(start), static_cast<std::size_t>(end - start)));
+  }
+  void reset() override { bufferPosition = 0; }
+  [[nodiscard]] std::u16string_view peek() const override
+  {
+    return std::u16string_view{ buffer }.substr(static_cast<std::size_t>(bufferPosition));
+  }
+  void skip(const long count) override
+  {
+    const auto landedLength = std::min(count, static_cast<long>(buffer.size()) - bufferPosition - 1);
+    trackPosition(peek().substr(1, static_cast<std::size_t>(std::max(0L, landedLength))));
+    columnNo += count - std::max(0L, landedLength);
+    bufferPosition += count;
+  }
+
+private:
+  String buffer;
+  long bufferPosition = 0;
+};
+
+// Forwards only the per-character ISource API, so the parser is driven one virtual
+// current()/next() call at a time exactly as it was before the bulk span API existed.
+class CharacterSource final : public ISource
+{
+public:
+  explicit CharacterSource(ISource &source) : source(source) {}
+  [[nodiscard]] Char current() const override { return source.current(); }
+  void next() override { source.next(); }
+  [[nodiscard]] bool more() const override { return source.more(); }
+  void backup(const long length) override { source.backup(length); }
+  [[nodiscard]] long position() const override { return source.position(); }
+  std::string getRange(const long start, const long end) override { return source.getRange(start, end); }
+  void reset() override { source.reset(); }
+
+private:
+  ISource &source;
+};
+
 TEST_CASE("Performance regression: parse large XML document", "[performance]")
 {
   constexpr size_t kLargeItemCount = 5000;
@@ -82,3 +242,701 @@ TEST_CASE("Performance regression: XSD validation throughput", "[performance]")
 
   REQUIRE(xml.root().getChildren().size() == kLargeItemCount);
 }
+
+// Markup-heavy document (names, comments, CDATA, indentation), 2000 entries, Release build:
+//   per-character source (before) ~ 33.8 ms, bulk span source (after) ~ 20.0 ms.
+TEST_CASE("Performance regression: bulk span source versus per-character source", "[performance]")
+{
+  constexpr size_t kEntryCount = 2000;
+  const std::string xmlString = makeMarkupHeavyXML(kEntryCount);
+
+  BENCHMARK("parse markup heavy document per character (before)") {
+    BufferSource source(xmlString);
+    CharacterSource characterSource(source);
+    XML xml;
+    xml.parse(characterSource);
+    return xml.root().getChildren().size();
+  };
+
+  BENCHMARK("parse markup heavy document using spans (after)") {
+    BufferSource source(xmlString);
+    XML xml;
+    xml.parse(source);
+    return xml.root().getChildren().size();
+  };
+
+  BufferSource source(xmlString);
+  CharacterSource characterSource(source);
+  XML before;
+  before.parse(characterSource);
+  XML after;
+  after.parse(BufferSource(xmlString));
+  REQUIRE(before.stringify() == after.stringify());
+}
+
+// Multilingual document (non-ASCII names, comments and CDATA), 2000 entries, Release build:
+//   UTF-16 round trip (before) ~ 24.1 ms, native UTF-8 (after) ~ 20.5 ms.
+TEST_CASE("Performance regression: native UTF-8 source versus UTF-16 round trip", "[performance]")
+{
+  constexpr size_t kEntryCount = 2000;
+  const std::string xmlString = makeMultilingualXML(kEntryCount);
+
+  BENCHMARK("parse multilingual document via UTF-16 (before)") {
+    Utf16BufferSource source(xmlString);
+    XML xml;
+    xml.parse(source);
+    return xml.root().getChildren().size();
+  };
+
+  BENCHMARK("parse multilingual document as UTF-8 (after)") {
+    BufferSource source(xmlString);
+    XML xml;
+    xml.parse(source);
+    return xml.root().getChildren().size();
+  };
+
+  Utf16BufferSource source(xmlString);
+  XML before;
+  before.parse(source);
+  XML after;
+  after.parse(BufferSource(xmlString));
+  REQUIRE(before.stringify() == after.stringify());
+}
+
+// Text-heavy document (long paragraphs of character data), 2000 paragraphs, Release build:
+//   per-character content (before) ~ 274 ms, run-based content (after) ~ 18.6 ms.
+TEST_CASE("Performance regression: parse text heavy document", "[performance]")
+{
+  constexpr size_t kParagraphCount = 2000;
+  const std::string xmlString = makeTextHeavyXML(kParagraphCount);
+
+  BENCHMARK("parse text heavy document") {
+    BufferSource source(xmlString);
+    XML xml;
+    xml.parse(source);
+    return xml.root().getChildren().size();
+  };
+
+  BufferSource source(xmlString);
+  XML xml;
+  xml.parse(source);
+  REQUIRE(xml.root().getChildren().size() == 2 * kParagraphCount + 1);
+  REQUIRE(xml.stringify().ends_with(xmlString));
+}
+
+// Markup-heavy document (20000 entries, ~2.9 MB) read from a non-seekable stream, Release build:
+//   whole stream read into a BufferSource (before) ~ 135.2 ms, block-buffered StreamSource (after) ~ 128.0 ms.
+TEST_CASE("Performance regression: block-buffered stream source versus reading the whole stream", "[performance]")
+{
+  constexpr size_t kEntryCount = 20000;
+  const std::string xmlString = makeMarkupHeavyXML(kEntryCount);
+
+  BENCHMARK("parse stream read whole into a buffer (before)") {
+    std::istringstream stream{ xmlString };
+    std::ostringstream contents;
+    contents << stream.rdbuf();
+    BufferSource source(contents.str());
+    XML xml;
+    xml.parse(source);
+    return xml.root().getChildren().size();
+  };
+
+  BENCHMARK("parse stream a block at a time (after)") {
+    std::istringstream stream{ xmlString };
+    StreamSource source(stream);
+    XML xml;
+    xml.parse(source);
+    return xml.root().getChildren().size();
+  };
+
+  std::istringstream stream{ xmlString };
+  XML before;
+  before.parse(BufferSource(xmlString));
+  XML after;
+  after.parse(StreamSource(stream));
+  REQUIRE(before.stringify() == after.stringify());
+}
+
+#if defined(__linux__)
+// Markup-heavy file (20000 entries, ~2.9 MB) parsed from disk, Release build:
+//   block-buffered file source (before) ~ 72.2 ms, memory mapped file source (after) ~ 68.2 ms.
+// Both decode UTF-8 through Utf8Source (the buffered source took ~ 121.5 ms widening bytes one at a time).
+TEST_CASE("Performance regression: memory mapped file source versus buffered file source", "[performance]")
+{
+  constexpr size_t kEntryCount = 20000;
+  const std::string generatedFileName{ (std::filesystem::temp_directory_path() / "XML_Lib_Mapped_Benchmark.xml").string() };
+  XML::toFile(generatedFileName, makeMarkupHeavyXML(kEntryCount), XML::Format::utf8);
+  REQUIRE(std::filesystem::file_size(generatedFileName) >= MappedFileSource::kMappedFileThreshold);
+
+  BENCHMARK("parse large file buffered (before)") {
+    FileSource source(generatedFileName);
+    XML xml;
+    xml.parse(source);
+    return xml.root().getChildren().size();
+  };
+
+  BENCHMARK("parse large file memory mapped (after)") {
+    MappedFileSource source(generatedFileName);
+    XML xml;
+    xml.parse(source);
+    return xml.root().getChildren().size();
+  };
+
+  XML before;
+  before.parse(FileSource(generatedFileName));
+  XML after;
+  after.parse(std::filesystem::path{ generatedFileName });
+  REQUIRE(before.stringify() == after.stringify());
+  std::filesystem::remove(generatedFileName);
+}
+#endif
+
+// Counts elements and character data reported by the parser without keeping any of it
+class CountingHandler final : public IParseHandler
+{
+public:
+  void onStartElement(std::string_view, std::span<const XMLAttribute>, bool) override { elements++; }
+  void onCharacters(const std::string_view characters, bool) override { characterCount += characters.size(); }
+  std::size_t elements{ 0 };
+  std::size_t characterCount{ 0 };
+};
+
+// Markup-heavy document (20000 entries, ~2.9 MB), Release build:
+//   build Node tree (before) ~ 98.9 ms, event handler counting elements (after) ~ 75.9 ms when added;
+//   with nodes since built in the document arena and element content markup matched in one look,
+//   tree ~ 36.6 ms and events ~ 27.3 ms (against ~ 83.6 ms for the tree as built when added).
+TEST_CASE("Performance regression: parse handler events versus building the tree", "[performance]")
+{
+  constexpr size_t kEntryCount = 20000;
+  const std::string xmlString = makeMarkupHeavyXML(kEntryCount);
+
+  BENCHMARK("parse large document into a tree (before)") {
+    BufferSource source(xmlString);
+    XML xml;
+    xml.parse(source);
+    return xml.root().getChildren().size();
+  };
+
+  BENCHMARK("parse large document reporting events (after)") {
+    BufferSource source(xmlString);
+    CountingHandler handler;
+    XML xml;
+    xml.parse(source, handler);
+    return handler.elements;
+  };
+
+  CountingHandler handler;
+  XML xml;
+  xml.parse(BufferSource(xmlString), handler);
+  REQUIRE(handler.elements == 2 * kEntryCount + 1);
+}
+
+// Markup-heavy document (20000 entries, ~2.9 MB), Release build:
+//   reader returning every token (before) ~ 55.6 ms, reader skipping each entry's subtree (after) ~ 29.0 ms
+//   (skipped content is only scanned to balance its tags; tokens returned view the buffer rather than
+//   copying it, every token having taken ~ 62.6 ms when copied).
+TEST_CASE("Performance regression: reader skipping subtrees versus reading every token", "[performance]")
+{
+  constexpr size_t kEntryCount = 20000;
+  const std::string xmlString = makeMarkupHeavyXML(kEntryCount);
+
+  BENCHMARK("read every token of large document (before)") {
+    BufferSource source(xmlString);
+    XMLReader reader(source);
+    std::size_t entries = 0;
+    while (reader.next() != XMLReader::TokenType::endOfDocument) {
+      if (reader.tokenType() == XMLReader::TokenType::startElement && reader.name() == "catalogueEntry") { entries++; }
+    }
+    return entries;
+  };
+
+  BENCHMARK("read large document skipping entry subtrees (after)") {
+    BufferSource source(xmlString);
+    XMLReader reader(source);
+    std::size_t entries = 0;
+    while (reader.next() != XMLReader::TokenType::endOfDocument) {
+      if (reader.tokenType() == XMLReader::TokenType::startElement && reader.name() == "catalogueEntry") {
+        entries++;
+        reader.skipSubtree();
+      }
+    }
+    return entries;
+  };
+
+  BufferSource source(xmlString);
+  XMLReader reader(source);
+  std::size_t entries = 0;
+  while (reader.next() != XMLReader::TokenType::endOfDocument) {
+    if (reader.tokenType() == XMLReader::TokenType::startElement && reader.name() == "catalogueEntry") {
+      entries++;
+      reader.skipSubtree();
+    }
+  }
+  REQUIRE(entries == kEntryCount);
+}
+
+// Markup-heavy document (20000 entries, ~2.9 MB), Release build:
+//   handler parse of the whole buffer (before) ~ 65.0 ms, fed in 1460 byte chunks (after) ~ 94.9 ms;
+//   the feed holds only the unparsed tail of the last chunk rather than the whole document.
+TEST_CASE("Performance regression: feeding a document in chunks versus parsing it whole", "[performance]")
+{
+  constexpr size_t kEntryCount = 20000;
+  constexpr size_t kChunkSize = 1460;
+  const std::string xmlString = makeMarkupHeavyXML(kEntryCount);
+
+  BENCHMARK("parse large document held whole (before)") {
+    BufferSource source(xmlString);
+    CountingHandler handler;
+    XML xml;
+    xml.parse(source, handler);
+    return handler.elements;
+  };
+
+  BENCHMARK("parse large document fed in chunks (after)") {
+    CountingHandler handler;
+    XMLFeedParser parser(handler);
+    for (size_t offset = 0; offset < xmlString.size(); offset += kChunkSize) {
+      parser.feed(std::string_view(xmlString).substr(offset, kChunkSize));
+    }
+    parser.finish();
+    return handler.elements;
+  };
+
+  CountingHandler handler;
+  XMLFeedParser parser(handler);
+  for (size_t offset = 0; offset < xmlString.size(); offset += kChunkSize) {
+    parser.feed(std::string_view(xmlString).substr(offset, kChunkSize));
+  }
+  parser.finish();
+  REQUIRE(handler.elements == 2 * kEntryCount + 1);
+}
+
+// Markup-heavy document (20000 entries, ~2.9 MB), Release build on a one core machine:
+//   one thread (before) ~ 102.4 ms, two threads (after) ~ 98.5 ms; with one core the workers
+//   only take turns, so this shows the cost of sharing out the document (each worker parsing
+//   the prolog again and its children being moved to the root) to be within the noise, not a
+//   speedup; on a machine with more cores each thread added should take a share off the time.
+TEST_CASE("Performance regression: parsing a document on one thread versus several", "[performance]")
+{
+  constexpr size_t kEntryCount = 20000;
+  const std::string xmlString = makeMarkupHeavyXML(kEntryCount);
+  const std::size_t maxThreads = std::max(2U, std::thread::hardware_concurrency());
+
+  for (std::size_t threads = 1; threads <= maxThreads; threads++) {
+    BENCHMARK("parse large document on " + std::to_string(threads) + " thread(s)" + (threads == 1 ? " (before)" : " (after)")) {
+      XML xml;
+      xml.parse(BufferSource{ xmlString }, ParseOptions{ .parseThreads = threads });
+      return xml.root().getChildren().size();
+    };
+  }
+
+  XML sequential;
+  sequential.parse(BufferSource{ xmlString });
+  XML parallel;
+  parallel.parse(BufferSource{ xmlString }, ParseOptions{ .parseThreads = maxThreads });
+  REQUIRE(parallel.root().getChildren().size() == sequential.root().getChildren().size());
+}
+
+// One namespaced document with a DTD per thread (5000 entries each, ~250 KB), parsed and validated,
+// Release build on a one core machine with four threads:
+//   one after another on one thread (before) ~ 90.0 ms, each on its own thread (after) ~ 87.5 ms;
+//   with one core the threads only take turns, so this shows only that they do not contend. Parse
+//   state is per parser and names go to each document's own table, so on a machine with a core per
+//   thread the time should fall close to linearly with the thread count.
+TEST_CASE("Performance regression: parsing documents one after another versus one per thread", "[performance]")
+{
+  constexpr size_t kSectionCount = 100;
+  constexpr int kStressRounds = 20;
+  const std::size_t threadCount = std::max(4U, std::thread::hardware_concurrency());
+  std::vector<std::string> documents;
+  for (std::size_t thread = 0; thread < threadCount; thread++) {
+    documents.push_back(makeValidatedNameSpacedXML(kSectionCount, "thread " + std::to_string(thread)));
+  }
+  // Parse and validate a document, returning the text of its first entry (empty if a section is missing)
+  const auto parseDocument = [](const std::string &document) {
+    XML xml;
+    xml.parse(BufferSource{ document });
+    xml.validate();
+    if (xml.root().getChildren().size() != kSectionCount) { return std::string{}; }
+    return std::string(xml.root()[0][0].getContents());
+  };
+
+  BENCHMARK("parse " + std::to_string(threadCount) + " documents one after another (before)") {
+    std::size_t entries = 0;
+    for (const auto &document : documents) { entries += parseDocument(document).size(); }
+    return entries;
+  };
+
+  BENCHMARK("parse " + std::to_string(threadCount) + " documents each on its own thread (after)") {
+    std::vector<std::size_t> entries(threadCount);
+    {
+      std::vector<std::jthread> workers;
+      for (std::size_t thread = 0; thread < threadCount; thread++) {
+        workers.emplace_back([&, thread] { entries[thread] = parseDocument(documents[thread]).size(); });
+      }
+    }
+    return std::accumulate(entries.begin(), entries.end(), std::size_t{ 0 });
+  };
+
+  // Every thread parses and validates its own document repeatedly, concurrently with the others
+  std::atomic<std::size_t> failures{ 0 };
+  {
+    std::vector<std::jthread> workers;
+    for (std::size_t thread = 0; thread < threadCount; thread++) {
+      workers.emplace_back([&, thread] {
+        for (int round = 0; round < kStressRounds; round++) {
+          try {
+            if (parseDocument(documents[thread]) != "thread " + std::to_string(thread) + " & more") { failures++; }
+          } catch (...) {
+            failures++;
+          }
+        }
+      });
+    }
+  }
+  REQUIRE(failures == 0);
+}
+
+// Markup-heavy document (20000 entries, ~2.9 MB), Release build:
+//   whole document tree then visiting each entry (before) ~ 77.2 ms, a tree per entry read
+//   by the record reader (after) ~ 71.9 ms; the record reader holds one entry's nodes at a time.
+TEST_CASE("Performance regression: record reader versus parsing the whole document tree", "[performance]")
+{
+  constexpr size_t kEntryCount = 20000;
+  const std::string xmlString = makeMarkupHeavyXML(kEntryCount);
+
+  BENCHMARK("parse whole document then visit each entry (before)") {
+    XML xml;
+    xml.parse(BufferSource{ xmlString });
+    std::size_t descriptionBytes = 0;
+    for (const auto &entry : xml.root().getChildren()) {
+      if (isA<Element>(entry)) { descriptionBytes += entry["description"].getContents().size(); }
+    }
+    return descriptionBytes;
+  };
+
+  BENCHMARK("read each entry as a record (after)") {
+    BufferSource source(xmlString);
+    XMLRecordReader reader(source, "/catalogue/catalogueEntry");
+    std::size_t descriptionBytes = 0;
+    while (reader.next()) { descriptionBytes += reader.record()["description"].getContents().size(); }
+    return descriptionBytes;
+  };
+
+  BufferSource source(xmlString);
+  XMLRecordReader reader(source, "/catalogue/catalogueEntry");
+  while (reader.next()) {}
+  REQUIRE(reader.recordCount() == kEntryCount);
+}
+
+// One million node document (500000 items each holding text), Release build:
+//   variants allocated with new and deleted node by node (before) parse ~ 533 ms, teardown ~ 62 ms;
+//   variants allocated from the document arena, destroyed node by node, parse ~ 545 ms, teardown ~ 36 ms;
+//   the root element's tree dropped with the arena unwalked (after) parse ~ 430 ms, teardown ~ 9 ms.
+//   Parse time is the grammar's far more than allocation's (profiled: reading the source ~ 35%,
+//   building elements, interning names included, ~ 20%, text nodes ~ 12%), so it moves only
+//   within the run to run noise (~90 ms) of the machine measured on.
+TEST_CASE("Performance regression: parse and teardown of a one million node document", "[performance]")
+{
+  constexpr size_t kItemCount = 500000;
+  const std::string xmlString = makeLargeXML(kItemCount);
+
+  BENCHMARK_ADVANCED("parse one million node document")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<std::optional<XML>> documents(static_cast<std::size_t>(meter.runs()));
+    for (auto &document : documents) { document.emplace(); }
+    meter.measure([&](const int run) { documents[static_cast<std::size_t>(run)]->parse(BufferSource{ xmlString }); });
+  };
+
+  BENCHMARK_ADVANCED("tear down one million node document")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<std::optional<XML>> documents(static_cast<std::size_t>(meter.runs()));
+    for (auto &document : documents) { document.emplace(xmlString); }
+    meter.measure([&](const int run) { documents[static_cast<std::size_t>(run)].reset(); });
+  };
+
+  XML xml{ xmlString };
+  REQUIRE(xml.root().getChildren().size() == kItemCount);
+}
+
+// Document of 100000 items whose names, attribute values, text and comments are all too long
+// for a string's small buffer, Release build (heap allocations counted with a replaced
+// operator new):
+//   node strings on the heap (before) 1900097 allocations per parse, parse ~ 558 ms, teardown ~ 32 ms;
+//   node strings in the document arena (after) 1000127 allocations per parse, parse ~ 599 ms,
+//   teardown ~ 16 ms. The allocations left are the parser's own, not the document's; parse time
+//   is again within the run to run noise of the machine measured on.
+TEST_CASE("Performance regression: parse and teardown of a document of long strings", "[performance]")
+{
+  constexpr size_t kItemCount = 100000;
+  const std::string xmlString = makeLongStringXML(kItemCount);
+
+  BENCHMARK_ADVANCED("parse document of long strings")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<std::optional<XML>> documents(static_cast<std::size_t>(meter.runs()));
+    for (auto &document : documents) { document.emplace(); }
+    meter.measure([&](const int run) { documents[static_cast<std::size_t>(run)]->parse(BufferSource{ xmlString }); });
+  };
+
+  BENCHMARK_ADVANCED("tear down document of long strings")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<std::optional<XML>> documents(static_cast<std::size_t>(meter.runs()));
+    for (auto &document : documents) { document.emplace(xmlString); }
+    meter.measure([&](const int run) { documents[static_cast<std::size_t>(run)].reset(); });
+  };
+
+  XML xml{ xmlString };
+  REQUIRE(xml.root().getChildren().size() == kItemCount * 3);
+}
+
+// Document of 100000 items whose element and attribute names repeat, Release build:
+//   a string for each name on each node (before) Element 200 bytes, XMLAttribute 136 bytes,
+//   peak resident memory of document ~ 132 MB, parse ~ 760 ms, XPath name test ~ 1834 ms;
+//   names interned in the document's name table (after) Element 176 bytes, XMLAttribute
+//   112 bytes, peak resident memory ~ 122 MB, parse ~ 716 ms, XPath name test ~ 1809 ms.
+//   Names are compared as symbols but XPath time is mostly that of building its node sets,
+//   and the times are within the run to run noise of the machine measured on.
+TEST_CASE("Performance regression: matching the names of a document of repeated names", "[performance]")
+{
+  constexpr size_t kItemCount = 10000;
+  const std::string xmlString = makeLongStringXML(kItemCount);
+  XML xml{ xmlString };
+
+  BENCHMARK("XPath name test over repeated names")
+  {
+    XPath xpath{ xml.root() };
+    return xpath.evaluate("/root/a_rather_long_element_name_here").size();
+  };
+
+  BENCHMARK("find attribute by name on each element")
+  {
+    std::size_t found = 0;
+    for (const auto &child : xml.root().getChildren()) {
+      if (isA<Element>(child) && NRef<Element>(child).hasAttribute("name")) { found++; }
+    }
+    return found;
+  };
+
+  XPath xpath{ xml.root() };
+  REQUIRE(xpath.evaluate("/root/a_rather_long_element_name_here").size() == kItemCount);
+}
+
+// Markup-heavy document (20000 entries, ~2.9 MB, 160004 nodes; 2000 entries for XPath), Release build:
+//   Node tree (before) parse ~ 104 ms, resident memory of document ~ 27 MB, traverse ~ 4.2 ms,
+//   XPath ~ 71 ms; tape (after) parse ~ 101 ms, resident memory ~ 9.6 MB (5.4 MB held by the tape,
+//   ~ 33 bytes a node), traverse ~ 0.66 ms, XPath ~ 72 ms. Parse time is the grammar's, and XPath
+//   time is that of building its node sets, which is the same for both.
+TEST_CASE("Performance regression: Node tree versus tape for a read-only document", "[performance]")
+{
+  constexpr size_t kEntryCount = 20000;
+  const std::string xmlString = makeMarkupHeavyXML(kEntryCount);
+  const std::string xpathString = makeMarkupHeavyXML(kEntryCount / 10);
+
+  struct CountTreeElements final : IAction
+  {
+    void onElement([[maybe_unused]] const Node &node) override { count++; }
+    std::size_t count{ 0 };
+  };
+  struct CountTapeElements final : ITapeAction
+  {
+    void onElement([[maybe_unused]] const XMLTapeNode &node) override { count++; }
+    std::size_t count{ 0 };
+  };
+
+  BENCHMARK("parse document into a Node tree (before)") { return XML{ xmlString }.root().getChildren().size(); };
+  BENCHMARK("parse document into a tape (after)") { return XMLTape{ BufferSource{ xmlString } }.size(); };
+
+  const XML xml{ xmlString };
+  const XMLTape tape{ BufferSource{ xmlString } };
+
+  BENCHMARK("traverse Node tree (before)")
+  {
+    CountTreeElements counter;
+    xml.traverse(counter);
+    return counter.count;
+  };
+  BENCHMARK("traverse tape (after)")
+  {
+    CountTapeElements counter;
+    tape.traverse(counter);
+    return counter.count;
+  };
+
+  const XML xpathXML{ xpathString };
+  const XMLTape xpathTape{ BufferSource{ xpathString } };
+
+  BENCHMARK("XPath over Node tree (before)") { return xpathXML.xpath("//catalogueEntry/description").size(); };
+  BENCHMARK("XPath over tape (after)") { return xpathTape.xpath("//catalogueEntry/description").size(); };
+
+  CountTapeElements counter;
+  tape.traverse(counter);
+  REQUIRE(counter.count == kEntryCount * 2);
+  REQUIRE(xpathTape.xpath("//catalogueEntry/description").size() == kEntryCount / 10);
+}
+
+// Transcoding a text heavy (mostly ASCII) and a multilingual document, and encoding every
+// character of the latter one at a time, Release build:
+//   std::wstring_convert (before) ~ 2.65 ms, hand-written converter (after) ~ 1.15 ms (text heavy);
+//   2.45 ms / 1.60 ms (multilingual); 6.50 ms / 2.57 ms (a character at a time).
+TEST_CASE("Performance regression: std::wstring_convert versus hand-written UTF-8/UTF-16 converter", "[performance]")
+{
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> wstringConvert;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  const std::string textString = makeTextHeavyXML(500);
+  const std::string multilingualString = makeMultilingualXML(2000);
+  const std::u16string textUtf16 = wstringConvert.from_bytes(textString);
+  const std::u16string multilingualUtf16 = wstringConvert.from_bytes(multilingualString);
+
+  BENCHMARK("round trip text heavy document with std::wstring_convert (before)") {
+    return wstringConvert.to_bytes(wstringConvert.from_bytes(textString)).size();
+  };
+  BENCHMARK("round trip text heavy document with converter (after)") { return toUtf8(toUtf16(textString)).size(); };
+  BENCHMARK("round trip multilingual document with std::wstring_convert (before)") {
+    return wstringConvert.to_bytes(wstringConvert.from_bytes(multilingualString)).size();
+  };
+  BENCHMARK("round trip multilingual document with converter (after)") {
+    return toUtf8(toUtf16(multilingualString)).size();
+  };
+  BENCHMARK("encode multilingual document a character at a time with std::wstring_convert (before)") {
+    std::size_t length = 0;
+    for (const char16_t unit : multilingualUtf16) {
+      if (unit < 0xD800 || unit > 0xDFFF) { length += wstringConvert.to_bytes(unit).size(); }
+    }
+    return length;
+  };
+  BENCHMARK("encode multilingual document a character at a time with converter (after)") {
+    std::size_t length = 0;
+    for (const char16_t unit : multilingualUtf16) {
+      if (unit < 0xD800 || unit > 0xDFFF) { length += toUtf8(unit).size(); }
+    }
+    return length;
+  };
+
+  REQUIRE(toUtf16(textString) == textUtf16);
+  REQUIRE(toUtf16(multilingualString) == multilingualUtf16);
+  REQUIRE(toUtf8(textUtf16) == textString);
+  REQUIRE(toUtf8(multilingualUtf16) == multilingualString);
+}
+
+// Document of lineCount short elements, one to a line, with Windows (CRLF) line endings
+static std::string makeCRLFXML(const size_t lineCount)
+{
+  std::string xml;
+  xml.reserve(lineCount * 48 + 32);
+  xml += "<lines>\r\n";
+  for (size_t i = 0; i < lineCount; ++i) {
+    xml += "    <line n=\"";
+    xml += std::to_string(i);
+    xml += "\">some text on the line</line>\r\n";
+  }
+  xml += "</lines>\r\n";
+  return xml;
+}
+
+// CRLF document read with XML::fromFile, Release build:
+//   5000 lines (~230 KB): find/replace per CRLF (before) ~ 15.2 ms, one pass (after) ~ 84 us;
+//   200000 lines (~9 MB): one pass ~ 3.9 ms (find/replace takes minutes);
+//   5000 lines parsed from a file source ~ 8.7 ms.
+TEST_CASE("Performance regression: reading a large CRLF document", "[performance]")
+{
+  const auto writeFile = [](const std::string &fileName, const std::string &xmlString) {
+    std::ofstream file{ fileName, std::ios_base::binary };
+    file << xmlString;
+  };
+  const std::string smallFileName{ (std::filesystem::temp_directory_path() / "XML_Lib_CRLF_Small.xml").string() };
+  const std::string largeFileName{ (std::filesystem::temp_directory_path() / "XML_Lib_CRLF_Large.xml").string() };
+  writeFile(smallFileName, makeCRLFXML(5000));
+  writeFile(largeFileName, makeCRLFXML(200000));
+
+  BENCHMARK("read 5000 line CRLF file translating with find/replace (before)") {
+    std::ifstream file{ smallFileName, std::ios_base::binary };
+    std::string translated{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    size_t pos = translated.find("\r\n");
+    while (pos != std::string::npos) {
+      translated.replace(pos, 2, "\n");
+      pos = translated.find("\r\n", pos + 1);
+    }
+    return translated.size();
+  };
+  BENCHMARK("read 5000 line CRLF file translating in one pass (after)") { return XML::fromFile(smallFileName).size(); };
+  BENCHMARK("read 200000 line CRLF file translating in one pass (after)") {
+    return XML::fromFile(largeFileName).size();
+  };
+  BENCHMARK("parse 5000 line CRLF file from a file source") {
+    FileSource source{ smallFileName };
+    XML xml;
+    xml.parse(source);
+    return xml.root().getChildren().size();
+  };
+
+  const std::string translated{ XML::fromFile(largeFileName) };
+  REQUIRE(translated.find('\r') == std::string::npos);
+  REQUIRE(translated.size() == makeCRLFXML(200000).size() - 200002);
+  std::filesystem::remove(smallFileName);
+  std::filesystem::remove(largeFileName);
+}
+
+// Document of long element and attribute names, indented, a few of them beyond ASCII
+static std::string makeNameHeavyXML(const size_t entryCount)
+{
+  std::string xml;
+  xml.reserve(entryCount * 200 + 32);
+  xml += "<inventoryCatalogue>\n";
+  for (size_t i = 0; i < entryCount; ++i) {
+    xml += "    <catalogue.entry-record stockKeepingUnit=\"";
+    xml += std::to_string(i);
+    xml += "\" warehouse_location=\"A\" \xC3\xA9tag\xC3\xA8re=\"3\">\n";
+    xml += "        <product_description_text>item</product_description_text>\n";
+    xml += "        <\xD0\xBA\xD0\xBE\xD0\xBB\xD0\xB8\xD1\x87\xD0\xB5\xD1\x81\xD1\x82\xD0\xB2\xD0\xBE/>\n";
+    xml += "    </catalogue.entry-record>\n";
+  }
+  xml += "</inventoryCatalogue>";
+  return xml;
+}
+
+// Name heavy document (20000 entries, ~3.3 MB), Release build:
+//   classifying each character by range comparisons and std::iswspace (before) ~ 34.2 ms,
+//   by lookup tables (after) ~ 9.7 ms; parse ~ 135 ms (~ 155 ms before the tables).
+TEST_CASE("Performance regression: character classification by range comparisons versus tables", "[performance]")
+{
+  constexpr size_t kEntryCount = 20000;
+  const std::string xmlString = makeNameHeavyXML(kEntryCount);
+  const std::u16string utf16 = toUtf16(xmlString);
+  const auto rangeNameStartChar = [](const Char c) {
+    return c == ':' || c == '_' || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= 0xC0 && c <= 0xD6)
+           || (c >= 0xD8 && c <= 0xF6) || (c >= 0xF8 && c <= 0x2FF) || (c >= 0x370 && c <= 0x37D)
+           || (c >= 0x37F && c <= 0x1FFF) || (c >= 0x200C && c <= 0x200D) || (c >= 0x2070 && c <= 0x218F)
+           || (c >= 0x2C00 && c <= 0x2FEF) || (c >= 0x3001 && c <= 0xD7FF) || (c >= 0xF900 && c <= 0xFDCF)
+           || (c >= 0xFDF0 && c <= 0xFFFD);
+  };
+  const auto rangeNameChar = [&rangeNameStartChar](const Char c) {
+    return rangeNameStartChar(c) || c == '-' || c == '.' || (c >= '0' && c <= '9') || c == 0xB7
+           || (c >= 0x0300 && c <= 0x036F) || (c >= 0x203F && c <= 0x2040);
+  };
+
+  BENCHMARK("classify characters by range comparisons (before)") {
+    std::size_t count = 0;
+    for (const Char c : utf16) { count += rangeNameChar(c) + rangeNameStartChar(c) + (std::iswspace(c) != 0); }
+    return count;
+  };
+  BENCHMARK("classify characters by lookup tables (after)") {
+    std::size_t count = 0;
+    for (const Char c : utf16) { count += validNameChar(c) + validNameStartChar(c) + validWhiteSpaceChar(c); }
+    return count;
+  };
+  BENCHMARK("parse name heavy document") {
+    XML xml;
+    xml.parse(BufferSource{ xmlString });
+    return xml.root().getChildren().size();
+  };
+
+  XML xml;
+  xml.parse(BufferSource{ xmlString });
+  REQUIRE(NRef<Element>(xml.root()[kEntryCount - 1])["\xC3\xA9tag\xC3\xA8re"].getParsed() == "3");
+}
@@ -57,4 +57,14 @@ TEST_CASE("Parse CDATA section.", "[XML][Parse][CDATA]")
     REQUIRE_NOTHROW(xml.parse(source));
     REQUIRE(xml.root().getContents() == "]]>");
   }
-}
\ No newline at end of file
+  SECTION("Parse XML root containing CDATA left unterminated at the end of the document", "[XML][Parse][CDATA]")
+  {
+    BufferSource source{
+      "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n"
+      "<root>"
+      "<![CDATA[< Test text </root>\n"
+    };
+    REQUIRE_THROWS_WITH(
+      xml.parse(source), "XML Syntax Error [Line: 3 Column: 2] Missing closing ']]>' for CDATA section.");
+  }
+}
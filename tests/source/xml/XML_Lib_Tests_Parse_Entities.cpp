@@ -48,6 +48,23 @@ TEST_CASE("Check the parsing of character entities/reference.", "[XML][Parse][En
     xml.parse(source);
     REQUIRE(NRef<Element>(xml.root()).getContents() == " £ ");
   }
+  SECTION("Parse reference &#x1D11E; (beyond a single UTF-16 code unit) in contents area", "[XML][Parse][Entities]")
+  {
+    BufferSource source{
+      "<?xml version=\"1.0\"?>\n"
+      "<root> &#x1D11E;&#119070; </root>\n"
+    };
+    xml.parse(source);
+    REQUIRE(NRef<Element>(xml.root()).getContents() == " \xF0\x9D\x84\x9E\xF0\x9D\x84\x9E ");
+  }
+  SECTION("Parse reference &#x110000; (beyond Unicode) in contents area", "[XML][Parse][Entities]")
+  {
+    BufferSource source{
+      "<?xml version=\"1.0\"?>\n"
+      "<root> &#x110000; </root>\n"
+    };
+    REQUIRE_THROWS_WITH(xml.parse(source), "XML Syntax Error [Line: 2 Column: 22] Character reference invalid character.");
+  }
   SECTION("Parse reference &#x00As; (invalid hex value) in contents area", "[XML][Parse][Entities]")
   {
     BufferSource source{
@@ -0,0 +1,142 @@
+#include "XML_Lib_Tests.hpp"
+
+namespace {
+// Parse handler that records the events it is passed as one line each
+class EventLog final : public IParseHandler
+{
+public:
+  void onDeclaration(const std::string_view version, const std::string_view encoding, const std::string_view standalone) override
+  {
+    record("declaration", std::string(version) + "," + std::string(encoding) + "," + std::string(standalone));
+  }
+  void onStartElement(const std::string_view name, const std::span<const XMLAttribute> attributes, const bool isSelfClosing) override
+  {
+    std::string text{ name };
+    for (const auto &attribute : attributes) { text += " " + std::string(attribute.getName()) + "=" + std::string(attribute.getParsed()); }
+    record(isSelfClosing ? "self" : "start", text);
+  }
+  void onEndElement(const std::string_view name) override { record("end", name); }
+  void onCharacters(const std::string_view characters, const bool isWhiteSpace) override
+  {
+    record(isWhiteSpace ? "whitespace" : "characters", characters);
+  }
+  void onCDATA(const std::string_view cdata) override { record("cdata", cdata); }
+  void onComment(const std::string_view comment) override { record("comment", comment); }
+  void onPI(const std::string_view name, const std::string_view parameters) override
+  {
+    record("pi", std::string(name) + "," + std::string(parameters));
+  }
+  void onStartEntityReference(const XMLValue &reference) override { record("startReference", reference.getUnparsed()); }
+  void onEndEntityReference(const XMLValue &reference) override { record("endReference", reference.getUnparsed()); }
+  std::vector<std::string> events;
+
+private:
+  void record(const std::string_view event, const std::string_view text)
+  {
+    events.push_back(std::string(event) + "(" + std::string(text) + ")");
+  }
+};
+
+// Feed a document to a parser in chunks of the given size returning the events reported
+std::vector<std::string> feedInChunks(const std::string_view xmlString, const std::size_t chunkSize)
+{
+  EventLog log;
+  XMLFeedParser parser{ log };
+  for (std::size_t offset = 0; offset < xmlString.size(); offset += chunkSize) {
+    parser.feed(xmlString.substr(offset, chunkSize));
+  }
+  parser.finish();
+  return log.events;
+}
+
+// Parse a document whole returning the events reported
+std::vector<std::string> parseWhole(const std::string_view xmlString)
+{
+  EventLog log;
+  XML xml;
+  BufferSource source{ xmlString };
+  xml.parse(source, log);
+  return log.events;
+}
+}// namespace
+
+TEST_CASE("Check the parsing of XML fed a chunk at a time", "[XML][Parse][Feed]")
+{
+  SECTION("Parse XML fed whole reports the same events as parsing it from a source", "[XML][Parse][Feed]")
+  {
+    const std::string xmlString{
+      "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n"
+      "<!-- A comment --><?display table-view?>"
+      "<root a=\"1\" xmlns:h=\"http://www.w3.org/TR/html4/\">text<h:child/><![CDATA[<data>]]>A&#66;&amp;</root>\n"
+      "<!--end-->"
+    };
+    REQUIRE(feedInChunks(xmlString, xmlString.size()) == parseWhole(xmlString));
+  }
+  SECTION("Parse XML fed a byte at a time reports the same events as parsing it whole", "[XML][Parse][Feed]")
+  {
+    const std::string xmlString{
+      "<?xml version=\"1.0\"?>\n"
+      "<!DOCTYPE root [<!ENTITY name \"<b>entity</b>\">]>\n"
+      "<root><a x='1'>&name;</a><!-- comment --><?pi value?><![CDATA[x]]>tail</root>"
+    };
+    REQUIRE(feedInChunks(xmlString, 1) == parseWhole(xmlString));
+  }
+  SECTION("Parse test files fed in chunks reports the same events as parsing them whole", "[XML][Parse][Feed]")
+  {
+    TEST_FILE_LIST(testFile);
+    const std::string xmlString{ XML::fromFile(prefixTestDataPath(testFile)) };
+    const auto wholeEvents = parseWhole(xmlString);
+    REQUIRE(feedInChunks(xmlString, 1) == wholeEvents);
+    REQUIRE(feedInChunks(xmlString, 7) == wholeEvents);
+    REQUIRE(feedInChunks(xmlString, 1500) == wholeEvents);
+  }
+  SECTION("Parse XML reports what a chunk completes before the next arrives", "[XML][Parse][Feed]")
+  {
+    EventLog log;
+    XMLFeedParser parser{ log };
+    parser.feed(std::string_view{ "<root><a>1</a><b>2" });
+    REQUIRE(log.events
+            == std::vector<std::string>{
+              "declaration(1.0,UTF-8,no)", "start(root)", "start(a)", "characters(1)", "end(a)" });
+    REQUIRE_FALSE(parser.isComplete());
+    parser.feed(std::string_view{ "</b></root>" });
+    parser.finish();
+    REQUIRE(log.events.back() == "end(root)");
+    REQUIRE(parser.isComplete());
+  }
+  SECTION("Parse XML with a character and a line break split between chunks", "[XML][Parse][Feed]")
+  {
+    EventLog log;
+    XMLFeedParser parser{ log };
+    parser.feed(std::string_view{ "\xEF\xBB\xBF<root>caf\xC3" });
+    parser.feed(std::string_view{ "\xA9\x0D" });
+    parser.feed(std::string_view{ "\x0A</root>" });
+    parser.finish();
+    REQUIRE(log.events
+            == std::vector<std::string>{ "declaration(1.0,UTF-8,no)", "start(root)", "characters(caf\xC3\xA9\n)", "end(root)" });
+  }
+  SECTION("Parse XML with a syntax error reports it at the same position as a whole parse", "[XML][Parse][Feed]")
+  {
+    EventLog log;
+    XMLFeedParser parser{ log };
+    parser.feed(std::string_view{ "<?xml version=\"1.0\"?>\n<AddressBook> </add" });
+    REQUIRE_THROWS_WITH(parser.feed(std::string_view{ "ressbook>\n" }),
+      "XML Syntax Error [Line: 2 Column: 21] Missing closing tag.");
+  }
+  SECTION("Parse XML that ends before the document is complete reports it at finish", "[XML][Parse][Feed]")
+  {
+    EventLog log;
+    XMLFeedParser parser{ log };
+    parser.feed(std::string_view{ "<root><a>text</a>" });
+    REQUIRE_THROWS_AS(parser.finish(), SyntaxError);
+  }
+  SECTION("Feeding XML after finish throws", "[XML][Parse][Feed]")
+  {
+    EventLog log;
+    XMLFeedParser parser{ log };
+    parser.feed(std::string_view{ "<root/>" });
+    parser.finish();
+    REQUIRE_THROWS_WITH(
+      parser.feed(std::string_view{ "<more/>" }), "XMLFeedParser Error: Chunk fed after the end of the document.");
+  }
+}
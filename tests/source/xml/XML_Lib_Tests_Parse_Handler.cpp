@@ -0,0 +1,146 @@
+#include "XML_Lib_Tests.hpp"
+
+// Parse handler that records the events it is passed as one line each
+class RecordingHandler final : public IParseHandler
+{
+public:
+  void onDeclaration(const std::string_view version, const std::string_view encoding, const std::string_view standalone) override
+  {
+    record("declaration", std::string(version) + "," + std::string(encoding) + "," + std::string(standalone));
+  }
+  void onStartElement(const std::string_view name, const std::span<const XMLAttribute> attributes, const bool isSelfClosing) override
+  {
+    std::string text{ name };
+    for (const auto &attribute : attributes) { text += " " + std::string(attribute.getName()) + "=" + std::string(attribute.getParsed()); }
+    record(isSelfClosing ? "self" : "start", text);
+  }
+  void onEndElement(const std::string_view name) override { record("end", name); }
+  void onCharacters(const std::string_view characters, const bool isWhiteSpace) override
+  {
+    record(isWhiteSpace ? "whitespace" : "characters", characters);
+  }
+  void onCDATA(const std::string_view cdata) override { record("cdata", cdata); }
+  void onComment(const std::string_view comment) override { record("comment", comment); }
+  void onPI(const std::string_view name, const std::string_view parameters) override
+  {
+    record("pi", std::string(name) + "," + std::string(parameters));
+  }
+  void onStartEntityReference(const XMLValue &reference) override { record("startReference", reference.getUnparsed()); }
+  void onEndEntityReference(const XMLValue &reference) override { record("endReference", reference.getUnparsed()); }
+  std::vector<std::string> events;
+
+private:
+  void record(const std::string_view event, const std::string_view text)
+  {
+    events.push_back(std::string(event) + "(" + std::string(text) + ")");
+  }
+};
+
+TEST_CASE("Check the parsing of XML reporting events to a parse handler", "[XML][Parse][Handler]")
+{
+  XML xml;
+  RecordingHandler handler;
+  SECTION("Parse XML reporting events in document order", "[XML][Parse][Handler]")
+  {
+    BufferSource source{
+      "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n"
+      "<!-- A comment --><?display table-view?>"
+      "<root a=\"1\">text<child/><![CDATA[<data>]]></root>"
+    };
+    xml.parse(source, handler);
+    REQUIRE(handler.events
+            == std::vector<std::string>{ "declaration(1.0,UTF-8,no)",
+              "whitespace(\n)",
+              "comment( A comment )",
+              "pi(display,table-view)",
+              "start(root a=1)",
+              "characters(text)",
+              "self(child)",
+              "end(child)",
+              "cdata(<data>)",
+              "end(root)" });
+  }
+  SECTION("Parse XML with no declaration reports the default one", "[XML][Parse][Handler]")
+  {
+    BufferSource source{ "<root/>" };
+    xml.parse(source, handler);
+    REQUIRE(handler.events == std::vector<std::string>{ "declaration(1.0,UTF-8,no)", "self(root)", "end(root)" });
+  }
+  SECTION("Parse XML with references bracketing their replacement text", "[XML][Parse][Handler]")
+  {
+    BufferSource source{ "<root>A&#66;&amp;</root>" };
+    xml.parse(source, handler);
+    REQUIRE(handler.events
+            == std::vector<std::string>{ "declaration(1.0,UTF-8,no)",
+              "start(root)",
+              "characters(A)",
+              "startReference(&#66;)",
+              "characters(B)",
+              "endReference(&#66;)",
+              "startReference(&amp;)",
+              "startReference(&#x26;)",
+              "characters(&)",
+              "endReference(&#x26;)",
+              "endReference(&amp;)",
+              "end(root)" });
+  }
+  SECTION("Parse XML with nested elements reports epilog after root end", "[XML][Parse][Handler]")
+  {
+    BufferSource source{ "<root><a><b>x</b></a></root><!--end-->" };
+    xml.parse(source, handler);
+    REQUIRE(handler.events
+            == std::vector<std::string>{ "declaration(1.0,UTF-8,no)",
+              "start(root)",
+              "start(a)",
+              "start(b)",
+              "characters(x)",
+              "end(b)",
+              "end(a)",
+              "end(root)",
+              "comment(end)" });
+  }
+  SECTION("Parse XML with a syntax error reports it as for a tree parse", "[XML][Parse][Handler]")
+  {
+    BufferSource source{
+      "<?xml version=\"1.0\"?>\n"
+      "<AddressBook> </addressbook>\n"
+    };
+    REQUIRE_THROWS_WITH(xml.parse(source, handler), "XML Syntax Error [Line: 2 Column: 21] Missing closing tag.");
+  }
+  SECTION("Parse XML using an undefined namespace reports it as for a tree parse", "[XML][Parse][Handler]")
+  {
+    BufferSource source{
+      "<root>\n"
+      "<table x:border=\"1\"></table>\n"
+      "</root>\n"
+    };
+    REQUIRE_THROWS_WITH(xml.parse(source, handler),
+      "XML Syntax Error [Line: 3 Column: 1] Namespace used but not defined in attribute 'x:border'.");
+  }
+  SECTION("Parse XML using namespaces declared by an outer element", "[XML][Parse][Handler]")
+  {
+    BufferSource source{ "<root xmlns:h=\"http://www.w3.org/TR/html4/\"><h:table><h:tr/></h:table></root>" };
+    REQUIRE_NOTHROW(xml.parse(source, handler));
+  }
+  SECTION("Parse XML with a handler that throws stops the parse", "[XML][Parse][Handler]")
+  {
+    class StopHandler final : public IParseHandler
+    {
+    public:
+      void onStartElement(const std::string_view name, std::span<const XMLAttribute>, bool) override
+      {
+        if (name == "stop") { throw Error("Stopped at element."); }
+      }
+    } stopHandler;
+    BufferSource source{ "<root><stop/></root>" };
+    REQUIRE_THROWS_WITH(xml.parse(source, stopHandler), "IParseHandler Error: Stopped at element.");
+  }
+  SECTION("Parse XML with a handler leaves the tree unchanged", "[XML][Parse][Handler]")
+  {
+    BufferSource treeSource{ "<root>tree</root>" };
+    xml.parse(treeSource);
+    BufferSource source{ "<other>events</other>" };
+    xml.parse(source, handler);
+    REQUIRE(NRef<Root>(xml.root()).name() == "root");
+  }
+}
@@ -69,6 +69,19 @@ TEST_CASE("Make sure whitespace is whitespace.", "[XML][Access][ByName]")
     xml.parse(source);
     REQUIRE(NRef<Content>(xml.root().getChildren()[0]).isWhiteSpace() == true);
   }
+  SECTION("Content made up of several text runs is whitespace only if every run is.", "[XML][Parse][Whitespace]")
+  {
+    XML xml;
+    BufferSource source{
+      "<?xml version=\"1.0\"?>\n"
+      "<root><a> \t ] \n </a><b>  \n\t  </b><c>text ]]] more text</c></root>\n"
+    };
+    xml.parse(source);
+    REQUIRE(NRef<Content>(xml.root()[0][0]).isWhiteSpace() == false);
+    REQUIRE(NRef<Content>(xml.root()[0][0]).getContents() == " \t ] \n ");
+    REQUIRE(NRef<Content>(xml.root()[1][0]).isWhiteSpace() == true);
+    REQUIRE(xml.root()[2][0].getContents() == "text ]]] more text");
+  }
   SECTION("Parse CDATA section with boundary characters.", "[XML][Parse][CDATA]")
   {
     XML xml;
@@ -135,4 +148,52 @@ TEST_CASE("Check R-Value reference parse/stringify.", "[XML][Node][R-Value Refer
     REQUIRE(XML::fromFile(generatedFileName) == XML::fromFile(prefixTestDataPath(kSingleXMLFile)));
     std::filesystem::remove(generatedFileName);
   }
-}
\ No newline at end of file
+}
+TEST_CASE("Check parsing in situ.", "[XML][Parse][InSitu]")
+{
+  const std::string xmlString{ "<?xml version=\"1.0\"?>\n"
+                               "<root id=\"r1\" note=\"a &amp; b\">\n"
+                               "<item>plain text</item><item>fish &amp; chips</item><item>line\r\nbreak</item>"
+                               "</root>" };
+  const auto within = [&xmlString](const std::string_view &value) {
+    return value.data() >= xmlString.data() && value.data() + value.size() <= xmlString.data() + xmlString.size();
+  };
+  SECTION("Attribute values without references are left in the caller's buffer.", "[XML][Parse][InSitu]")
+  {
+    const XML xml;
+    xml.parse(std::string_view{ xmlString }, ParseOptions{ .inSitu = true });
+    const auto &root = NRef<Element>(xml.root());
+    REQUIRE(root["id"].isInSitu());
+    REQUIRE(within(root["id"].getParsed()));
+    REQUIRE_FALSE(root["note"].isInSitu());
+    REQUIRE(root["note"].getUnparsed() == "a &amp; b");
+  }
+  SECTION("Text is the same parsed in situ or not, only that decoded or normalised being copied.", "[XML][Parse][InSitu]")
+  {
+    const XML copied;
+    copied.parse(std::string_view{ xmlString });
+    const XML inSitu;
+    inSitu.parse(std::string_view{ xmlString }, ParseOptions{ .inSitu = true });
+    REQUIRE_FALSE(NRef<Element>(copied.root())["id"].isInSitu());
+    for (int index = 0; index < 4; index++) {
+      REQUIRE(inSitu.root()[index].getContents() == copied.root()[index].getContents());
+    }
+    REQUIRE(inSitu.root()[1].getContents() == "plain text");
+    REQUIRE(inSitu.root()[2].getContents() == "fish & chips");
+    REQUIRE(inSitu.root()[3].getContents() == "line\nbreak");
+  }
+  SECTION("A source holding its own copy of the XML is never referred to.", "[XML][Parse][InSitu]")
+  {
+    const XML xml;
+    xml.parse(BufferSource{ xmlString }, ParseOptions{ .inSitu = true });
+    REQUIRE_FALSE(NRef<Element>(xml.root())["id"].isInSitu());
+    REQUIRE(NRef<Element>(xml.root())["id"].getParsed() == "r1");
+  }
+  SECTION("A view source is read in situ.", "[XML][Parse][InSitu]")
+  {
+    const XML xml;
+    xml.parse(ViewSource{ xmlString }, ParseOptions{ .inSitu = true });
+    REQUIRE(NRef<Element>(xml.root())["id"].isInSitu());
+    REQUIRE(xml.root()[1].getContents() == "plain text");
+  }
+}
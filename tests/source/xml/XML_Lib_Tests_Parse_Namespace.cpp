@@ -212,6 +212,38 @@ TEST_CASE("QName API for namespace-aware elements.", "[XML][Namespace][QName]")
     auto &xRoot = NRef<Element>(xml.root());
     REQUIRE(xRoot[0].getNamespaceURI() == "http://www.w3.org/TR/html4/");
   }
+  SECTION("Elements in the same namespace have the same namespace symbol whatever their prefix", "[XML][Namespace][QName]")
+  {
+    BufferSource source{
+      "<root xmlns:h=\"http://www.w3.org/TR/html4/\" xmlns=\"http://www.w3.org/TR/html4/\">\n"
+      "<h:table><tr/></h:table><other xmlns=\"urn:other\"/>\n"
+      "</root>\n"
+    };
+    xml.parse(source);
+    auto &xRoot = NRef<Element>(xml.root());
+    REQUIRE(xRoot.getNameSpaceSymbol() != XML_NameTable::kNoSymbol);
+    REQUIRE(xRoot[0].getNameSpaceSymbol() == xRoot.getNameSpaceSymbol());
+    REQUIRE(xRoot[0][0].getNameSpaceSymbol() == xRoot.getNameSpaceSymbol());
+    REQUIRE(xRoot[1].getNameSpaceSymbol() != xRoot.getNameSpaceSymbol());
+    REQUIRE(xRoot[1].getNamespaceURI() == "urn:other");
+  }
+  SECTION("A prefixed attribute is in the namespace of its prefix and an unprefixed one in none", "[XML][Namespace][QName]")
+  {
+    BufferSource source{
+      "<root xmlns=\"urn:default\" xmlns:h=\"http://www.w3.org/TR/html4/\">\n"
+      "<table h:border=\"1\" width=\"2\"></table>\n"
+      "</root>\n"
+    };
+    xml.parse(source);
+    const auto &attributes = NRef<Element>(xml.root())[0].getAttributes();
+    REQUIRE(attributes[0].getPrefix() == "h");
+    REQUIRE(attributes[0].getLocalName() == "border");
+    REQUIRE(attributes[0].getNamespaceURI() == "http://www.w3.org/TR/html4/");
+    REQUIRE(attributes[1].getPrefix().empty());
+    REQUIRE(attributes[1].getLocalName() == "width");
+    REQUIRE(attributes[1].getNamespaceURI().empty());
+    REQUIRE(attributes[1].getNameSpaceSymbol() == XML_NameTable::kNoSymbol);
+  }
   SECTION("getNamespaceURI resolves default namespace URI", "[XML][Namespace][QName]")
   {
     BufferSource source{ "<table xmlns=\"http://www.w3.org/TR/html4/\"><tr></tr></table>\n" };
@@ -285,4 +317,53 @@ TEST_CASE("Attribute namespace validation.", "[XML][Namespace][Attribute]")
     REQUIRE_THROWS_WITH(xml.parse(source),
       "XML Syntax Error [Line: 3 Column: 1] Namespace used but not defined in attribute 'x:border'.");
   }
-}
\ No newline at end of file
+}
+TEST_CASE("Namespace scope chain of parsed elements.", "[XML][Parse][Namespace][Scope]")
+{
+  XML xml;
+  SECTION("Elements that declare no namespaces share the scope of the element they are in.", "[XML][Parse][Namespace][Scope]")
+  {
+    BufferSource source{ "<root xmlns:h=\"http://www.w3.org/TR/html4/\"><h:table><h:tr><h:td/></h:tr></h:table></root>" };
+    xml.parse(source);
+    const auto &xRoot = NRef<Element>(xml.root());
+    REQUIRE(xRoot.getNameSpaceScope() != nullptr);
+    REQUIRE(xRoot[0].getNameSpaceScope() == xRoot.getNameSpaceScope());
+    REQUIRE(xRoot[0][0][0].getNameSpaceScope() == xRoot.getNameSpaceScope());
+    REQUIRE(xRoot[0][0][0].getNamespaceURI() == "http://www.w3.org/TR/html4/");
+  }
+  SECTION("An inner declaration of a prefix hides the outer one.", "[XML][Parse][Namespace][Scope]")
+  {
+    BufferSource source{ "<root xmlns=\"urn:outer\" xmlns:a=\"urn:a\"><child xmlns=\"urn:inner\"><leaf/></child><other/></root>" };
+    xml.parse(source);
+    const auto &xRoot = NRef<Element>(xml.root());
+    REQUIRE(xRoot[0].getNameSpaceScope()->getOuter() == xRoot.getNameSpaceScope());
+    REQUIRE(xRoot[0][0].getNamespaceURI() == "urn:inner");
+    REQUIRE(xRoot[0][0].getNameSpace("a").getParsed() == "urn:a");
+    REQUIRE(xRoot[0][0].getNameSpaces().size() == 3);
+    REQUIRE(xRoot[1].getNamespaceURI() == "urn:outer");
+  }
+  SECTION("The namespaces in scope are listed in place, outermost first.", "[XML][Parse][Namespace][Scope]")
+  {
+    BufferSource source{ "<root xmlns=\"urn:outer\" xmlns:a=\"urn:a\"><child xmlns=\"urn:inner\"><leaf xmlns:b=\"urn:b\"/></child></root>" };
+    xml.parse(source);
+    const auto &xLeaf = NRef<Element>(xml.root())[0][0];
+    std::vector<std::string> listed;
+    for (const auto &nameSpace : xLeaf.getNameSpaces()) {
+      listed.push_back(std::string(nameSpace.getName()) + "=" + std::string(nameSpace.getParsed()));
+    }
+    REQUIRE(listed == std::vector<std::string>{ ":=urn:outer", "a=urn:a", ":=urn:inner", "b=urn:b" });
+    REQUIRE(&*xLeaf.getNameSpaces().begin() == &NRef<Element>(xml.root()).getNameSpaceScope()->getDeclarations()[0]);
+    const auto copies = xLeaf.collectNameSpaces();
+    REQUIRE(copies.size() == 4);
+    REQUIRE(copies[3].getName() == "b");
+    REQUIRE(copies[3].getParsed() == "urn:b");
+  }
+  SECTION("Elements outside any namespace declaration have no scope.", "[XML][Parse][Namespace][Scope]")
+  {
+    BufferSource source{ "<root><child/></root>" };
+    xml.parse(source);
+    REQUIRE(NRef<Element>(xml.root()).getNameSpaceScope() == nullptr);
+    REQUIRE(NRef<Element>(xml.root())[0].getNamespaceURI().empty());
+    REQUIRE_FALSE(NRef<Element>(xml.root())[0].hasNameSpace(":"));
+  }
+}
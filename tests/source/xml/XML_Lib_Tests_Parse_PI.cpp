@@ -114,4 +114,14 @@ TEST_CASE("Check the parsing of XML containing program instructions", "[XML][Par
     };
     REQUIRE_NOTHROW(xml.parse(source));
   }
-}
\ No newline at end of file
+  SECTION("Parse PI left unterminated at the end of the document", "[XML][Parse][PI]")
+  {
+    BufferSource source{
+      "<?xml version=\"1.0\"?>\n"
+      "<root></root>\n"
+      "<?display end"
+    };
+    REQUIRE_THROWS_WITH(
+      xml.parse(source), "XML Syntax Error [Line: 3 Column: 16] Missing closing '?>' for processing instruction.");
+  }
+}
@@ -0,0 +1,177 @@
+#include "XML_Lib_Tests.hpp"
+
+namespace {
+// Build a document of the given prolog, root element start and end, and epilog around
+// enough copies of a record (each with its number appended) to be shared between threads
+std::string makeDocument(const std::string_view prolog,
+  const std::string_view rootStart,
+  const std::string_view record,
+  const std::string_view rootEnd,
+  const std::string_view epilog,
+  const std::size_t recordCount = 4000)
+{
+  std::string xmlString{ prolog };
+  xmlString += rootStart;
+  for (std::size_t recordNo = 0; recordNo < recordCount; recordNo++) {
+    xmlString += record;
+    xmlString += std::to_string(recordNo);
+    xmlString += "\n";
+  }
+  xmlString += rootEnd;
+  xmlString += epilog;
+  return xmlString;
+}
+
+// Parse a document with the given number of threads returning it stringified
+std::string parseWithThreads(const std::string_view xmlString, const std::size_t threads)
+{
+  XML xml;
+  xml.parse(BufferSource{ xmlString }, ParseOptions{ .parseThreads = threads });
+  return xml.stringify();
+}
+
+// Parse a document with the given number of threads returning the error reported
+std::string parseErrorWithThreads(const std::string_view xmlString, const std::size_t threads)
+{
+  try {
+    XML xml;
+    xml.parse(BufferSource{ xmlString }, ParseOptions{ .parseThreads = threads });
+  } catch (const std::exception &ex) {
+    return ex.what();
+  }
+  return "";
+}
+
+// Build a document whose records are interrupted by a construct (its text holding a record)
+// placed so that a parse on three threads is made to start its third share inside it
+std::string makeDocumentSplitInside(const std::string_view constructStart, const std::string_view constructEnd)
+{
+  std::string xmlString{ "<records>\n" };
+  for (std::size_t recordNo = 0; recordNo < 6000; recordNo++) { xmlString += "<record>value</record>\n"; }
+  xmlString += constructStart;
+  xmlString += std::string(80 * 1024, 'x');
+  xmlString += " <record>fake</record> ";
+  xmlString += constructEnd;
+  for (std::size_t recordNo = 0; recordNo < 2000; recordNo++) { xmlString += "<record>value</record>\n"; }
+  xmlString += "</records>\n";
+  return xmlString;
+}
+}// namespace
+
+TEST_CASE("Check the parsing of XML on several threads", "[XML][Parse][Parallel]")
+{
+  SECTION("Parse XML on several threads builds the same tree as parsing it on one", "[XML][Parse][Parallel]")
+  {
+    const auto xmlString = makeDocument("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n",
+      "<records>\n",
+      "<record id=\"1\"><name>A &amp; B</name><value>12.5</value></record>",
+      "</records>\n",
+      "");
+    REQUIRE(xmlString.size() > 128 * 1024);
+    const auto sequential = parseWithThreads(xmlString, 1);
+    REQUIRE(parseWithThreads(xmlString, 2) == sequential);
+    REQUIRE(parseWithThreads(xmlString, 3) == sequential);
+    REQUIRE(parseWithThreads(xmlString, 8) == sequential);
+    REQUIRE(parseWithThreads(xmlString, 0) == sequential);
+    XML xml;
+    xml.parse(BufferSource{ xmlString }, ParseOptions{ .parseThreads = 4 });
+    REQUIRE(NRef<Root>(xml.root()).getNameTable().isShared());
+  }
+  SECTION("Parse XML on several threads with namespaces declared on the root element", "[XML][Parse][Parallel]")
+  {
+    const auto xmlString = makeDocument("",
+      "<h:table xmlns:h=\"http://www.w3.org/TR/html4/\" xmlns:f=\"https://www.w3schools.com/furniture\">\n",
+      "<h:tr><h:td>Apples</h:td><f:name>Coffee Table</f:name></h:tr>",
+      "</h:table>",
+      "");
+    REQUIRE(parseWithThreads(xmlString, 4) == parseWithThreads(xmlString, 1));
+  }
+  SECTION("Parse XML on several threads with entities defined in its DTD", "[XML][Parse][Parallel]")
+  {
+    const auto xmlString = makeDocument(
+      "<!DOCTYPE notes [<!ENTITY author \"Jane Doe\"><!ENTITY note \"<b>noted</b>\">]>\n",
+      "<notes>\n",
+      "<entry by=\"&author;\">&note; by &author;</entry>",
+      "</notes>",
+      "");
+    REQUIRE(parseWithThreads(xmlString, 4) == parseWithThreads(xmlString, 1));
+  }
+  SECTION("Parse XML on several threads with CRLF line endings", "[XML][Parse][Parallel]")
+  {
+    const auto xmlString = makeDocument("<?xml version=\"1.0\"?>\r\n",
+      "<records>\r\n",
+      "<record>\r\nline one\r\nline two</record>\r\n",
+      "</records>\r\n",
+      "");
+    REQUIRE(parseWithThreads(xmlString, 4) == parseWithThreads(xmlString, 1));
+  }
+  SECTION("Parse XML on several threads with comments, PIs and an epilog", "[XML][Parse][Parallel]")
+  {
+    const auto xmlString = makeDocument("<!-- prolog comment -->\n",
+      "<records>\n",
+      "<!-- next record --><?record-pi value?><record><![CDATA[data]]></record>",
+      "</records>\n",
+      "<!-- epilog comment -->\n<?epilog-pi value?>\n");
+    REQUIRE(parseWithThreads(xmlString, 4) == parseWithThreads(xmlString, 1));
+  }
+  SECTION("Parse XML on several threads whose records nest elements of the same name", "[XML][Parse][Parallel]")
+  {
+    // Shares may be made to start at a nested record, or inside a comment or CDATA section
+    const auto xmlString = makeDocument("",
+      "<records>\n",
+      "<record><record><record/></record><!-- <record> --><![CDATA[<record>]]></record>",
+      "</records>",
+      "");
+    REQUIRE(parseWithThreads(xmlString, 4) == parseWithThreads(xmlString, 1));
+  }
+  SECTION("Parse XML on several threads whose root holds only text", "[XML][Parse][Parallel]")
+  {
+    const auto xmlString = makeDocument("", "<text>", "Some text that is not in any child element ", "</text>", "");
+    REQUIRE(parseWithThreads(xmlString, 4) == parseWithThreads(xmlString, 1));
+  }
+  SECTION("Parse XML too small to share between threads", "[XML][Parse][Parallel]")
+  {
+    const auto xmlString = makeDocument("", "<records>", "<record/>", "</records>", "", 10);
+    REQUIRE(parseWithThreads(xmlString, 4) == parseWithThreads(xmlString, 1));
+  }
+  SECTION("Parse XML on several threads with an error in a record reports it as on one", "[XML][Parse][Parallel]")
+  {
+    auto xmlString = makeDocument("", "<records>\n", "<record><value>1</value></record>", "</records>", "");
+    xmlString.replace(xmlString.find("</value>", xmlString.size() / 2), 8, "</vaule>");
+    const auto error = parseErrorWithThreads(xmlString, 1);
+    REQUIRE_FALSE(error.empty());
+    REQUIRE(parseErrorWithThreads(xmlString, 4) == error);
+  }
+  SECTION("Parse XML on several threads missing its root end tag reports it as on one", "[XML][Parse][Parallel]")
+  {
+    const auto xmlString = makeDocument("", "<records>\n", "<record><value>1</value></record>", "", "");
+    const auto error = parseErrorWithThreads(xmlString, 1);
+    REQUIRE_FALSE(error.empty());
+    REQUIRE(parseErrorWithThreads(xmlString, 4) == error);
+  }
+  SECTION("Parse XML on several threads with content after its root element reports it as on one", "[XML][Parse][Parallel]")
+  {
+    const auto xmlString = makeDocument("", "<records>\n", "<record/>", "</records>", "<extra/>");
+    const auto error = parseErrorWithThreads(xmlString, 1);
+    REQUIRE_FALSE(error.empty());
+    REQUIRE(parseErrorWithThreads(xmlString, 4) == error);
+  }
+  SECTION("Parse XML on several threads with a share made to start inside a PI", "[XML][Parse][Parallel]")
+  {
+    const auto xmlString = makeDocumentSplitInside("<?note ", "?>\n");
+    const auto splitOffset = 2 * xmlString.size() / 3;
+    REQUIRE(xmlString.find("<?note ") < splitOffset);
+    REQUIRE(xmlString.find("<record>fake") > splitOffset);
+    const auto sequential = parseWithThreads(xmlString, 1);
+    REQUIRE(parseWithThreads(xmlString, 3) == sequential);
+  }
+  SECTION("Parse XML on several threads with a share made to start inside a CDATA section", "[XML][Parse][Parallel]")
+  {
+    const auto xmlString = makeDocumentSplitInside("<![CDATA[", "]]>\n");
+    const auto splitOffset = 2 * xmlString.size() / 3;
+    REQUIRE(xmlString.find("<![CDATA[") < splitOffset);
+    REQUIRE(xmlString.find("<record>fake") > splitOffset);
+    const auto sequential = parseWithThreads(xmlString, 1);
+    REQUIRE(parseWithThreads(xmlString, 3) == sequential);
+  }
+}
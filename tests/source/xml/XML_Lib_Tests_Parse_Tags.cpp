@@ -78,4 +78,43 @@ TEST_CASE("Checks for tag names", "[XML][Parse][Tags]")
     REQUIRE_THROWS_WITH(
       xml.parse(source), "XML Syntax Error [Line: 1 Column: 41] Invalid name 'XmlAddressBook' encountered.");
   }
+  SECTION("Tag names with characters beyond ASCII", "[XML][Parse][Tags]")
+  {
+    // Latin-1 letters, a combining mark and a supplementary plane character (U+10000) are name characters
+    BufferSource source{ "<\xC3\xA9l\xC3\xA9ment\xC2\xB7" "a\xCC\x80\xF0\x90\x80\x80> </\xC3\xA9l\xC3\xA9ment\xC2\xB7" "a\xCC\x80\xF0\x90\x80\x80>" };
+    REQUIRE_NOTHROW(xml.parse(source));
+    REQUIRE(NRef<Element>(xml.root()).name() == "\xC3\xA9l\xC3\xA9ment\xC2\xB7" "a\xCC\x80\xF0\x90\x80\x80");
+  }
+  SECTION("Tag starts with a Latin-1 character that is only a name character", "[XML][Parse][Tags]")
+  {
+    BufferSource source{ "<\xC2\xB7root> </\xC2\xB7root>" };
+    REQUIRE_THROWS_WITH(xml.parse(source), "XML Syntax Error [Line: 1 Column: 11] Invalid name '\xC2\xB7root' encountered.");
+  }
+  SECTION("Character classes match the XML 1.0 productions", "[XML][Parse][Tags]")
+  {
+    // NameStartChar and NameChar as written in the recommendation; supplementary plane characters
+    // [#x10000-#xEFFFF] are UTF-16 surrogate pairs, each half of which is matched on its own
+    const auto nameStartChar = [](const Char c) {
+      return c == ':' || c == '_' || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= 0xC0 && c <= 0xD6)
+             || (c >= 0xD8 && c <= 0xF6) || (c >= 0xF8 && c <= 0x2FF) || (c >= 0x370 && c <= 0x37D)
+             || (c >= 0x37F && c <= 0x1FFF) || (c >= 0x200C && c <= 0x200D) || (c >= 0x2070 && c <= 0x218F)
+             || (c >= 0x2C00 && c <= 0x2FEF) || (c >= 0x3001 && c <= 0xD7FF) || (c >= 0xF900 && c <= 0xFDCF)
+             || (c >= 0xFDF0 && c <= 0xFFFD) || (c >= 0xD800 && c <= 0xDB7F) || (c >= 0xDC00 && c <= 0xDFFF);
+    };
+    const auto nameChar = [&nameStartChar](const Char c) {
+      return nameStartChar(c) || c == '-' || c == '.' || (c >= '0' && c <= '9') || c == 0xB7
+             || (c >= 0x0300 && c <= 0x036F) || (c >= 0x203F && c <= 0x2040);
+    };
+    std::size_t mismatches = 0;
+    for (std::size_t code = 0; code <= 0xFFFF; code++) {
+      const auto c = static_cast<Char>(code);
+      const bool valid = c == 0x09 || c == 0x0A || c == 0x0D || (c >= 0x20 && c <= 0xD7FF) || (c >= 0xE000 && c <= 0xFFFD);
+      if (validNameStartChar(c) != nameStartChar(c) || validNameChar(c) != nameChar(c)
+          || validChar(c) != valid || validWhiteSpaceChar(c) != (c == 0x20 || c == 0x09 || c == 0x0D || c == 0x0A)
+          || validTextChar(c) != (valid && c != '<' && c != '&' && c != ']')) {
+        mismatches++;
+      }
+    }
+    REQUIRE(mismatches == 0);
+  }
 }
@@ -75,4 +75,53 @@ TEST_CASE("Parse XML with Unicode characters. ", "[XML][Parse][Unicode]")
     REQUIRE_NOTHROW(NRef<Element>(specialXml.root()["cjk"]));
     REQUIRE_NOTHROW(NRef<Element>(specialXml.root()["cyrillic"]));
   }
+  SECTION("Parse UTF-8 supplementary characters in comments, CDATA and PI", "[XML][Parse][Unicode][UTF8]")
+  {
+    const std::string xmlString{ "<root><!-- \xF0\x9D\x84\x9E --><![CDATA[\xF0\x9D\x84\xA2]]><?pi \xF0\x9D\x84\xAB?></root>" };
+    BufferSource source{ xmlString };
+    XML utf8Xml;
+    REQUIRE_NOTHROW(utf8Xml.parse(source));
+    REQUIRE(NRef<Comment>(utf8Xml.root().getChildren()[0]).value() == " \xF0\x9D\x84\x9E ");
+    REQUIRE(NRef<CDATA>(utf8Xml.root().getChildren()[1]).value() == "\xF0\x9D\x84\xA2");
+    REQUIRE(NRef<PI>(utf8Xml.root().getChildren()[2]).parameters() == "\xF0\x9D\x84\xAB");
+  }
+  SECTION("UTF-8 and UTF-16 input report the same error position", "[XML][Parse][Unicode][UTF8]")
+  {
+    BufferSource utf8Source{ "<root>\n<!--\xE6\xB1\x89\xF0\x9D\x84\x9E--><\xE5\xAD\x97>\xC3\xA9</\xE5\xAD\x97x></root>" };
+    BufferSource utf16Source{ u"<root>\n<!--\u6C49\U0001D11E--><\u5B57>\u00E9</\u5B57x></root>" };
+    XML utf8Xml;
+    XML utf16Xml;
+    REQUIRE_THROWS_WITH(utf8Xml.parse(utf8Source), "XML Syntax Error [Line: 2 Column: 24] Missing closing tag.");
+    REQUIRE_THROWS_WITH(utf16Xml.parse(utf16Source), "XML Syntax Error [Line: 2 Column: 24] Missing closing tag.");
+  }
+  SECTION("Parse XML containing invalid UTF-8", "[XML][Parse][Unicode][UTF8]")
+  {
+    BufferSource source{ "<root>caf\xC3</root>" };
+    XML utf8Xml;
+    REQUIRE_THROWS_WITH(utf8Xml.parse(source), "BufferSource Error: Invalid UTF-8 sequence encountered.");
+  }
+  SECTION("Convert between UTF-8 and UTF-16 across runs of ASCII", "[XML][Parse][Unicode][Convert]")
+  {
+    // Runs longer than the sixteen characters converted at once, broken by every length of sequence
+    const std::string ascii{ "abcdefghijklmnopqrstuvwxyz0123456789" };
+    const std::string utf8{ ascii + "\xC3\xA9" + ascii + "\xE6\xB1\x89" + ascii + "\xF0\x9D\x84\x9E" + ascii };
+    const std::u16string utf16{ toUtf16(utf8) };
+    REQUIRE(utf16.size() == ascii.size() * 4 + 4);
+    REQUIRE(utf16[ascii.size()] == 0x00E9);
+    REQUIRE(utf16[ascii.size() * 2 + 1] == 0x6C49);
+    REQUIRE(utf16[ascii.size() * 3 + 2] == 0xD834);
+    REQUIRE(utf16[ascii.size() * 3 + 3] == 0xDD1E);
+    REQUIRE(toUtf8(utf16) == utf8);
+    REQUIRE(toUtf8(u'\u00E9') == "\xC3\xA9");
+    std::string encoded;
+    appendUtf8(encoded, U'\U0001D11E');
+    REQUIRE(encoded == "\xF0\x9D\x84\x9E");
+  }
+  SECTION("Convert malformed UTF-8 and UTF-16", "[XML][Parse][Unicode][Convert]")
+  {
+    REQUIRE_THROWS_AS(toUtf16("0123456789abcdef\xC3"), std::range_error);
+    REQUIRE_THROWS_AS(toUtf16("\x80"), std::range_error);
+    REQUIRE_THROWS_AS(toUtf8(u'\xD834'), std::range_error);
+    REQUIRE_THROWS_AS(toUtf8(std::u16string{ u'\xDD1E', u'a' }), std::range_error);
+  }
 }
\ No newline at end of file
@@ -0,0 +1,311 @@
+#include "XML_Lib_Tests.hpp"
+
+using TokenType = XMLReader::TokenType;
+
+// Read every token from a reader returning their types
+static std::vector<TokenType> readTokenTypes(XMLReader &reader)
+{
+  std::vector<TokenType> types;
+  while (reader.next() != TokenType::endOfDocument) { types.push_back(reader.tokenType()); }
+  return types;
+}
+
+TEST_CASE("Check the reading of XML a token at a time", "[XML][Reader]")
+{
+  SECTION("Reader has no token before next is called", "[XML][Reader]")
+  {
+    BufferSource source{ "<root/>" };
+    XMLReader reader{ source };
+    REQUIRE(reader.tokenType() == TokenType::none);
+  }
+  SECTION("Read XML returning tokens in document order", "[XML][Reader]")
+  {
+    BufferSource source{
+      "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n"
+      "<!-- A comment --><?display table-view?>"
+      "<root a=\"1\">text<child/><![CDATA[<data>]]></root>"
+    };
+    XMLReader reader{ source };
+    REQUIRE(readTokenTypes(reader)
+            == std::vector{ TokenType::declaration,
+              TokenType::characters,
+              TokenType::comment,
+              TokenType::pi,
+              TokenType::startElement,
+              TokenType::characters,
+              TokenType::startElement,
+              TokenType::endElement,
+              TokenType::cdata,
+              TokenType::endElement });
+  }
+  SECTION("Read XML returning token names and values", "[XML][Reader]")
+  {
+    BufferSource source{ "<?xml version=\"1.0\"?><!--note--><?display table-view?><root a=\"1\" b='2'>text</root>" };
+    XMLReader reader{ source };
+    REQUIRE(reader.next() == TokenType::declaration);
+    REQUIRE(reader.attributes().size() == 3);
+    REQUIRE(reader.attributes()[0].getName() == "version");
+    REQUIRE(reader.attributes()[0].getParsed() == "1.0");
+    REQUIRE(reader.attributes()[1].getParsed() == "UTF-8");
+    REQUIRE(reader.next() == TokenType::comment);
+    REQUIRE(reader.value() == "note");
+    REQUIRE(reader.next() == TokenType::pi);
+    REQUIRE(reader.name() == "display");
+    REQUIRE(reader.value() == "table-view");
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.name() == "root");
+    REQUIRE_FALSE(reader.isSelfClosing());
+    REQUIRE(reader.attributes().size() == 2);
+    REQUIRE(reader.attributes()[1].getName() == "b");
+    REQUIRE(reader.attributes()[1].getParsed() == "2");
+    REQUIRE(reader.next() == TokenType::characters);
+    REQUIRE(reader.value() == "text");
+    REQUIRE_FALSE(reader.isWhiteSpace());
+    REQUIRE(reader.next() == TokenType::endElement);
+    REQUIRE(reader.name() == "root");
+    REQUIRE(reader.next() == TokenType::endOfDocument);
+    REQUIRE(reader.next() == TokenType::endOfDocument);
+  }
+  SECTION("Read XML with a self-closing element followed by its end", "[XML][Reader]")
+  {
+    BufferSource source{ "<root><empty/></root>" };
+    XMLReader reader{ source };
+    REQUIRE(reader.next() == TokenType::declaration);
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.name() == "empty");
+    REQUIRE(reader.isSelfClosing());
+    REQUIRE(reader.next() == TokenType::endElement);
+    REQUIRE(reader.name() == "empty");
+  }
+  SECTION("Read XML returning the depth of each token", "[XML][Reader]")
+  {
+    BufferSource source{ "<root><a><b>x</b></a></root>" };
+    XMLReader reader{ source };
+    std::vector<long> depths;
+    while (reader.next() != TokenType::endOfDocument) { depths.push_back(reader.depth()); }
+    REQUIRE(depths == std::vector<long>{ 0, 0, 1, 2, 3, 2, 1, 0 });
+  }
+  SECTION("Read XML with references bracketing their replacement", "[XML][Reader]")
+  {
+    BufferSource source{ "<root>A&#66;</root>" };
+    XMLReader reader{ source };
+    REQUIRE(reader.next() == TokenType::declaration);
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.next() == TokenType::characters);
+    REQUIRE(reader.next() == TokenType::startEntityReference);
+    REQUIRE(reader.name() == "&#66;");
+    REQUIRE(reader.value() == "B");
+    REQUIRE(reader.next() == TokenType::characters);
+    REQUIRE(reader.value() == "B");
+    REQUIRE(reader.next() == TokenType::endEntityReference);
+    REQUIRE(reader.next() == TokenType::endElement);
+  }
+  SECTION("Read XML stopping early leaves the rest unparsed", "[XML][Reader]")
+  {
+    BufferSource source{ "<root><first/><second></root>" };
+    XMLReader reader{ source };
+    REQUIRE(reader.next() == TokenType::declaration);
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.name() == "first");
+  }
+  SECTION("Read XML skipping the subtree of an element", "[XML][Reader]")
+  {
+    BufferSource source{ "<root><skip><a>1</a><!--c--><b/></skip><keep>2</keep></root>" };
+    XMLReader reader{ source };
+    REQUIRE(reader.next() == TokenType::declaration);
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.name() == "skip");
+    reader.skipSubtree();
+    REQUIRE(reader.tokenType() == TokenType::endElement);
+    REQUIRE(reader.name() == "skip");
+    REQUIRE(reader.depth() == 1);
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.name() == "keep");
+    REQUIRE(reader.next() == TokenType::characters);
+    REQUIRE(reader.value() == "2");
+    REQUIRE(reader.next() == TokenType::endElement);
+    REQUIRE(reader.next() == TokenType::endElement);
+    REQUIRE(reader.name() == "root");
+    REQUIRE(reader.next() == TokenType::endOfDocument);
+  }
+  SECTION("Read XML skipping the subtree of a self-closing element", "[XML][Reader]")
+  {
+    BufferSource source{ "<root><skip/><keep/></root>" };
+    XMLReader reader{ source };
+    REQUIRE(reader.next() == TokenType::declaration);
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.next() == TokenType::startElement);
+    reader.skipSubtree();
+    REQUIRE(reader.tokenType() == TokenType::endElement);
+    REQUIRE(reader.name() == "skip");
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.name() == "keep");
+  }
+  SECTION("Read XML skipping the root element subtree", "[XML][Reader]")
+  {
+    BufferSource source{ "<root><a>1</a></root><!--end-->" };
+    XMLReader reader{ source };
+    REQUIRE(reader.next() == TokenType::declaration);
+    REQUIRE(reader.next() == TokenType::startElement);
+    reader.skipSubtree();
+    REQUIRE(reader.name() == "root");
+    REQUIRE(reader.next() == TokenType::comment);
+    REQUIRE(reader.next() == TokenType::endOfDocument);
+  }
+  SECTION("Read XML skipping a subtree whose markup holds what looks like its end tag", "[XML][Reader]")
+  {
+    const std::string xml{
+      "<root><skip a=\"x>y\" b='/>'><!-- </skip> --><![CDATA[</skip>]]><?pi </skip>?>"
+      "<n x=\"/>\"/><n>&lt;/skip&gt;</n></skip><keep/></root>"
+    };
+    BufferSource bufferSource{ xml };
+    std::istringstream stream{ xml };
+    StreamSource streamSource{ stream, 8, 8 };
+    for (ISource *source : { static_cast<ISource *>(&bufferSource), static_cast<ISource *>(&streamSource) }) {
+      XMLReader reader{ *source };
+      REQUIRE(reader.next() == TokenType::declaration);
+      REQUIRE(reader.next() == TokenType::startElement);
+      REQUIRE(reader.next() == TokenType::startElement);
+      reader.skipSubtree();
+      REQUIRE(reader.tokenType() == TokenType::endElement);
+      REQUIRE(reader.name() == "skip");
+      REQUIRE(reader.next() == TokenType::startElement);
+      REQUIRE(reader.name() == "keep");
+      REQUIRE(reader.next() == TokenType::endElement);
+      REQUIRE(reader.next() == TokenType::endElement);
+      REQUIRE(reader.name() == "root");
+      REQUIRE(reader.next() == TokenType::endOfDocument);
+    }
+  }
+  SECTION("Read XML skipping a subtree with a character across a block boundary", "[XML][Reader]")
+  {
+    // The 'é' (two bytes) starts on the last byte of the first 64 KiB block read
+    std::string xml{ "<root><skip>" };
+    xml += std::string(65535 - xml.size(), 'a');
+    xml += "\xC3\xA9 and more text</skip><keep/></root>";
+    const std::string fileName = generateRandomFileName();
+    XML::toFile(fileName, xml, XML::Format::utf8);
+    std::istringstream stream{ xml };
+    StreamSource streamSource{ stream };
+    FileSource fileSource{ fileName };
+    for (ISource *source : { static_cast<ISource *>(&streamSource), static_cast<ISource *>(&fileSource) }) {
+      XMLReader reader{ *source };
+      REQUIRE(reader.next() == TokenType::declaration);
+      REQUIRE(reader.next() == TokenType::startElement);
+      REQUIRE(reader.next() == TokenType::startElement);
+      REQUIRE_NOTHROW(reader.skipSubtree());
+      REQUIRE(reader.name() == "skip");
+      REQUIRE(reader.next() == TokenType::startElement);
+      REQUIRE(reader.name() == "keep");
+    }
+    fileSource.close();
+    std::filesystem::remove(fileName);
+  }
+  SECTION("Read XML skipping a subtree does not check its content", "[XML][Reader]")
+  {
+    BufferSource source{ "<root><skip><a></b></skip><keep/></root>" };
+    XMLReader reader{ source };
+    REQUIRE(reader.next() == TokenType::declaration);
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE_NOTHROW(reader.skipSubtree());
+    REQUIRE(reader.name() == "skip");
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.name() == "keep");
+  }
+  SECTION("Read XML from memory returning names and text as views into the input", "[XML][Reader]")
+  {
+    BufferSource source{ "<root a=\"1\"><item>text</item><item>a &#66; b</item></root>" };
+    const auto input = source.contents();
+    const auto inInput = [&input](const std::string_view view) {
+      return view.data() >= input.data() && view.data() + view.size() <= input.data() + input.size();
+    };
+    XMLReader reader{ source };
+    REQUIRE(reader.next() == TokenType::declaration);
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.name() == "root");
+    REQUIRE(inInput(reader.name()));
+    REQUIRE(reader.attributes().size() == 1);
+    REQUIRE(reader.attributes()[0].getParsed() == "1");
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(inInput(reader.name()));
+    REQUIRE(reader.next() == TokenType::characters);
+    REQUIRE(reader.value() == "text");
+    REQUIRE(inInput(reader.value()));
+    REQUIRE(reader.next() == TokenType::endElement);
+    REQUIRE(reader.name() == "item");
+    REQUIRE(inInput(reader.name()));
+    REQUIRE(reader.next() == TokenType::startElement);
+    REQUIRE(reader.next() == TokenType::characters);
+    REQUIRE(reader.value() == "a ");
+    REQUIRE(reader.next() == TokenType::startEntityReference);
+    REQUIRE(reader.name() == "&#66;");
+    REQUIRE(reader.next() == TokenType::characters);
+    REQUIRE(reader.value() == "B");
+    REQUIRE(reader.next() == TokenType::endEntityReference);
+    REQUIRE(reader.next() == TokenType::characters);
+    REQUIRE(reader.value() == " b");
+    REQUIRE(inInput(reader.value()));
+  }
+  SECTION("Skipping a subtree when not on a start element throws", "[XML][Reader]")
+  {
+    BufferSource source{ "<root/>" };
+    XMLReader reader{ source };
+    REQUIRE(reader.next() == TokenType::declaration);
+    REQUIRE_THROWS_WITH(reader.skipSubtree(), "XMLReader Error: The current token is not a start element.");
+  }
+  SECTION("Read XML with a syntax error reports it as for a tree parse", "[XML][Reader]")
+  {
+    BufferSource source{
+      "<?xml version=\"1.0\"?>\n"
+      "<AddressBook> </addressbook>\n"
+    };
+    XMLReader reader{ source };
+    REQUIRE_THROWS_WITH(readTokenTypes(reader), "XML Syntax Error [Line: 2 Column: 21] Missing closing tag.");
+  }
+  SECTION("Read XML with an unclosed element reports it", "[XML][Reader]")
+  {
+    BufferSource source{ "<root><a>" };
+    XMLReader reader{ source };
+    REQUIRE_THROWS_AS(readTokenTypes(reader), SyntaxError);
+  }
+  SECTION("Read XML using an undefined namespace reports it as for a tree parse", "[XML][Reader]")
+  {
+    BufferSource source{
+      "<root>\n"
+      "<x:table>\n"
+      "<x:tr><x:td>Apples</x:td><x:td>Bananas</x:td></x:tr>\n"
+      "</x:table>\n"
+      "</root>\n"
+    };
+    XMLReader reader{ source };
+    REQUIRE_THROWS_WITH(readTokenTypes(reader), "XML Syntax Error [Line: 3 Column: 35] Namespace used but not defined.");
+  }
+  SECTION("Readers interleaved on one thread keep their own namespaces in scope", "[XML][Reader]")
+  {
+    BufferSource source1{ "<a:root xmlns:a=\"urn:a\"><a:item/></a:root>" };
+    XMLReader reader1{ source1 };
+    while (reader1.next() != TokenType::startElement) {}
+    REQUIRE(reader1.name() == "a:root");
+    BufferSource source2{ "<root><child><a:item/></child></root>" };
+    XMLReader reader2{ source2 };
+    REQUIRE_THROWS_WITH(readTokenTypes(reader2), "XML Syntax Error [Line: 1 Column: 35] Namespace used but not defined.");
+    REQUIRE(readTokenTypes(reader1) == std::vector{ TokenType::startElement, TokenType::endElement, TokenType::endElement });
+  }
+  SECTION("Read XML with no root element reports it", "[XML][Reader]")
+  {
+    BufferSource source{ "<?xml version=\"1.0\"?>\n" };
+    XMLReader reader{ source };
+    REQUIRE_THROWS_WITH(readTokenTypes(reader), "XML Syntax Error [Line: 2 Column: 2] Missing root element.");
+  }
+  SECTION("Read all the tokens of test files without error", "[XML][Reader]")
+  {
+    TEST_FILE_LIST(testFile);
+    FileSource source{ prefixTestDataPath(testFile) };
+    XMLReader reader{ source };
+    REQUIRE_NOTHROW(readTokenTypes(reader));
+  }
+}
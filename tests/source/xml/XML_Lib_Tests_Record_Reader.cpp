@@ -0,0 +1,140 @@
+#include "XML_Lib_Tests.hpp"
+
+// Read every record from a reader returning the contents of each
+static std::vector<std::string> readRecordContents(XMLRecordReader &reader)
+{
+  std::vector<std::string> contents;
+  while (reader.next()) { contents.emplace_back(reader.record().getContents()); }
+  return contents;
+}
+
+TEST_CASE("Check the reading of XML a record at a time", "[XML][RecordReader]")
+{
+  SECTION("Read records at a path returning each as a tree", "[XML][RecordReader]")
+  {
+    BufferSource source{
+      "<?xml version=\"1.0\"?>\n"
+      "<feed><title>Feed</title>"
+      "<entry id=\"1\"><title>First</title><body>One</body></entry>"
+      "<entry id=\"2\"><title>Second</title><body>Two</body></entry>"
+      "</feed>"
+    };
+    XMLRecordReader reader{ source, "/feed/entry" };
+    REQUIRE(reader.next());
+    REQUIRE(isA<Root>(reader.record()));
+    REQUIRE(NRef<Root>(reader.record()).name() == "entry");
+    REQUIRE(NRef<Root>(reader.record()).getAttributes()[0].getParsed() == "1");
+    REQUIRE(reader.record()["title"].getContents() == "First");
+    REQUIRE(reader.next());
+    REQUIRE(reader.record()["body"].getContents() == "Two");
+    REQUIRE_FALSE(reader.next());
+    REQUIRE(reader.recordCount() == 2);
+  }
+  SECTION("Read records skipping elements not on the record path", "[XML][RecordReader]")
+  {
+    BufferSource source{
+      "<feed><entry>1</entry><other><entry>not a record</entry></other>"
+      "<!-- comment --><entry>2</entry><meta/><entry/></feed>"
+    };
+    XMLRecordReader reader{ source, "/feed/entry" };
+    REQUIRE(readRecordContents(reader) == std::vector<std::string>{ "1", "2", "" });
+    REQUIRE(reader.recordCount() == 3);
+  }
+  SECTION("Read a self-closing record as a self-closing element", "[XML][RecordReader]")
+  {
+    BufferSource source{ "<feed><entry a=\"x\"/></feed>" };
+    XMLRecordReader reader{ source, "/feed/entry" };
+    REQUIRE(reader.next());
+    REQUIRE(isA<Self>(reader.record()));
+    REQUIRE(NRef<Self>(reader.record()).getAttributes()[0].getParsed() == "x");
+    REQUIRE_FALSE(reader.next());
+  }
+  SECTION("Read records at a path with a wildcard step", "[XML][RecordReader]")
+  {
+    BufferSource source{
+      "<catalog><books><item>A</item></books><music><item>B</item><item>C</item></music></catalog>"
+    };
+    XMLRecordReader reader{ source, "/catalog/*/item" };
+    REQUIRE(readRecordContents(reader) == std::vector<std::string>{ "A", "B", "C" });
+  }
+  SECTION("Read the root element as the one record", "[XML][RecordReader]")
+  {
+    BufferSource source{ "<root><a>1</a><b>2</b></root>" };
+    XMLRecordReader reader{ source, "/root" };
+    REQUIRE(readRecordContents(reader) == std::vector<std::string>{ "12" });
+  }
+  SECTION("Read records inheriting the namespaces declared outside them", "[XML][RecordReader]")
+  {
+    BufferSource source{
+      "<feed xmlns=\"http://www.w3.org/2005/Atom\" xmlns:h=\"http://www.w3.org/TR/html4/\">"
+      "<entry><h:td>Apples</h:td></entry></feed>"
+    };
+    XMLRecordReader reader{ source, "/feed/entry" };
+    REQUIRE(reader.next());
+    const auto &entry = NRef<Root>(reader.record());
+    REQUIRE(entry.getNameSpace("h").getParsed() == "http://www.w3.org/TR/html4/");
+    REQUIRE(entry.getNameSpace(":").getParsed() == "http://www.w3.org/2005/Atom");
+    REQUIRE(NRef<Element>(reader.record()["h:td"]).getNameSpace("h").getParsed() == "http://www.w3.org/TR/html4/");
+  }
+  SECTION("Read records with entities and CDATA expanded as in a whole parse", "[XML][RecordReader]")
+  {
+    BufferSource source{
+      "<!DOCTYPE feed [<!ENTITY name \"Jane Doe\">]>"
+      "<feed><entry>&name; &amp; <![CDATA[<data>]]></entry></feed>"
+    };
+    XMLRecordReader reader{ source, "/feed/entry" };
+    REQUIRE(readRecordContents(reader) == std::vector<std::string>{ "Jane Doe & <data>" });
+  }
+#if defined(XML_LIB_ENABLE_XPATH)
+  SECTION("Read records that can be searched with XPath", "[XML][RecordReader]")
+  {
+    BufferSource source{
+      "<feed><entry><title>First</title><tag>a</tag><tag>b</tag></entry>"
+      "<entry><title>Second</title><tag>c</tag></entry></feed>"
+    };
+    XMLRecordReader reader{ source, "/feed/entry" };
+    std::vector<std::size_t> tagCounts;
+    while (reader.next()) {
+      XPath xpath{ reader.record() };
+      tagCounts.push_back(xpath.evaluate("/entry/tag").size());
+    }
+    REQUIRE(tagCounts == std::vector<std::size_t>{ 2, 1 });
+  }
+#endif
+  SECTION("Read many records without the memory used growing", "[XML][RecordReader]")
+  {
+    std::string xmlString{ "<feed>" };
+    for (int entry = 0; entry < 20000; entry++) {
+      xmlString += "<entry id=\"" + std::to_string(entry) + "\"><title>Title</title><body>Some body text</body></entry>";
+    }
+    xmlString += "</feed>";
+    BufferSource source{ xmlString };
+    XMLRecordReader reader{ source, "/feed/entry" };
+    std::size_t lastId = 0;
+    while (reader.next()) { lastId = std::stoul(std::string(NRef<Root>(reader.record()).getAttributes()[0].getParsed())); }
+    REQUIRE(reader.recordCount() == 20000);
+    REQUIRE(lastId == 19999);
+  }
+  SECTION("Read XML with a syntax error in a record reports it as a whole parse does", "[XML][RecordReader]")
+  {
+    BufferSource source{ "<?xml version=\"1.0\"?>\n<feed><entry></entyr></feed>" };
+    XMLRecordReader reader{ source, "/feed/entry" };
+    REQUIRE_THROWS_WITH(reader.next(), "XML Syntax Error [Line: 2 Column: 27] Missing closing tag.");
+  }
+  SECTION("Asking for the record before one has been read throws", "[XML][RecordReader]")
+  {
+    BufferSource source{ "<feed/>" };
+    XMLRecordReader reader{ source, "/feed/entry" };
+    REQUIRE_THROWS_WITH(reader.record(), "XMLRecordReader Error: There is no current record.");
+    REQUIRE_FALSE(reader.next());
+    REQUIRE_THROWS_WITH(reader.record(), "XMLRecordReader Error: There is no current record.");
+  }
+  SECTION("Record paths that are not absolute paths of names throw", "[XML][RecordReader]")
+  {
+    BufferSource source{ "<feed/>" };
+    REQUIRE_THROWS_WITH(XMLRecordReader(source, "feed/entry"), "XMLRecordReader Error: Invalid record path 'feed/entry'.");
+    REQUIRE_THROWS_WITH(XMLRecordReader(source, "/"), "XMLRecordReader Error: Invalid record path '/'.");
+    REQUIRE_THROWS_WITH(XMLRecordReader(source, "/feed//entry"), "XMLRecordReader Error: Invalid record path '/feed//entry'.");
+    REQUIRE_THROWS_WITH(XMLRecordReader(source, "/feed/"), "XMLRecordReader Error: Invalid record path '/feed/'.");
+  }
+}
@@ -0,0 +1,240 @@
+#include "XML_Lib_Tests.hpp"
+
+// Record each node visited by a tape traversal as its kind letter and name or value
+class XMLTape_Recorder final : public ITapeAction
+{
+public:
+  void onNode([[maybe_unused]] const XMLTapeNode &node) override { nodeCount++; }
+  void onCDATA(const XMLTapeNode &node) override { visited.append("D(").append(node.value()).append(")"); }
+  void onComment(const XMLTapeNode &node) override { visited.append("C(").append(node.value()).append(")"); }
+  void onContent(const XMLTapeNode &node) override { visited.append("T(").append(node.value()).append(")"); }
+  void onDeclaration([[maybe_unused]] const XMLTapeNode &node) override { visited.append("X"); }
+  void onElement(const XMLTapeNode &node) override { visited.append("E(").append(node.name()).append(")"); }
+  void onPI(const XMLTapeNode &node) override { visited.append("P(").append(node.name()).append(")"); }
+  void onProlog([[maybe_unused]] const XMLTapeNode &node) override { visited.append("O"); }
+  void onRoot(const XMLTapeNode &node) override { visited.append("R(").append(node.name()).append(")"); }
+  void onSelf(const XMLTapeNode &node) override { visited.append("S(").append(node.name()).append(")"); }
+  std::string visited;
+  std::size_t nodeCount{ 0 };
+};
+
+// Return the names of a tape node's child elements
+static std::vector<std::string> childNames(const XMLTapeNode &node)
+{
+  std::vector<std::string> names;
+  for (auto child = node.firstChild(); !child.isEmpty(); child = child.nextSibling()) {
+    if (!child.name().empty()) { names.emplace_back(child.name()); }
+  }
+  return names;
+}
+
+TEST_CASE("Check the parsing of XML into a tape", "[XML][Tape]")
+{
+  SECTION("Parse a document into a tape of its nodes in document order", "[XML][Tape]")
+  {
+    XMLTape tape{ BufferSource{ "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                                "<catalog><book><title>XML</title></book><book/></catalog>" } };
+    REQUIRE(tape.prolog().kind() == XMLTapeNode::Kind::prolog);
+    REQUIRE(tape.declaration().kind() == XMLTapeNode::Kind::declaration);
+    REQUIRE(tape.root().kind() == XMLTapeNode::Kind::root);
+    REQUIRE(tape.root().name() == "catalog");
+    REQUIRE(tape.root().parent() == tape.prolog());
+    REQUIRE(tape.prolog().parent().isEmpty());
+    REQUIRE(childNames(tape.root()) == std::vector<std::string>{ "book", "book" });
+    REQUIRE(tape.root().childCount() == 2);
+    const auto book = tape.root().firstChild();
+    REQUIRE(book.kind() == XMLTapeNode::Kind::element);
+    REQUIRE(book.index() == tape.root().index() + 1);
+    REQUIRE(book.firstChild().name() == "title");
+    REQUIRE(book.firstChild().firstChild().kind() == XMLTapeNode::Kind::content);
+    REQUIRE(book.firstChild().firstChild().value() == "XML");
+    REQUIRE(book.nextSibling().kind() == XMLTapeNode::Kind::self);
+    REQUIRE(book.nextSibling().firstChild().isEmpty());
+    REQUIRE(book.nextSibling().nextSibling().isEmpty());
+    REQUIRE(tape.node(static_cast<std::uint32_t>(tape.size() - 1)) == book.nextSibling());
+  }
+  SECTION("Parse a declaration into a tape node with version, encoding and standalone", "[XML][Tape]")
+  {
+    XMLTape tape{ BufferSource{ "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?><root/>" } };
+    const auto declaration = tape.declaration();
+    REQUIRE(declaration.attributeCount() == 3);
+    REQUIRE(declaration.attribute("version") == "1.0");
+    REQUIRE(declaration.attribute("encoding") == "UTF-8");
+    REQUIRE(declaration.attribute("standalone") == "yes");
+    REQUIRE(tape.root().kind() == XMLTapeNode::Kind::root);
+    REQUIRE(tape.root().name() == "root");
+  }
+  SECTION("Parse element attributes into a tape with their values parsed as for a tree", "[XML][Tape]")
+  {
+    XMLTape tape{ BufferSource{ "<root><item id=\"1\" title=\"Fish &amp; Chips\" price=\"&#x34;2\"/></root>" } };
+    const auto item = tape.root().firstChild();
+    REQUIRE(item.attributeCount() == 3);
+    REQUIRE(item.attributeName(0) == "id");
+    REQUIRE(item.attributeValue(0) == "1");
+    REQUIRE(item.attributeName(1) == "title");
+    REQUIRE(item.attributeValue(1) == "Fish &#x26; Chips");
+    REQUIRE(item.attribute("price") == "42");
+    REQUIRE(item.hasAttribute("id"));
+    REQUIRE_FALSE(item.hasAttribute("missing"));
+    REQUIRE(item.attribute("missing").empty());
+    REQUIRE(tape.root().attributeCount() == 0);
+  }
+  SECTION("Parse content either side of references into one tape content node", "[XML][Tape]")
+  {
+    XMLTape tape{ BufferSource{ "<root>Fish &amp; Chips &#x26; peas</root>" } };
+    REQUIRE(tape.root().childCount() == 1);
+    REQUIRE(tape.root().firstChild().kind() == XMLTapeNode::Kind::content);
+    REQUIRE(tape.root().firstChild().value() == "Fish & Chips & peas");
+  }
+  SECTION("Parse CDATA, comments and processing instructions into tape nodes", "[XML][Tape]")
+  {
+    XMLTape tape{ BufferSource{ "<root><![CDATA[a < b]]><!-- note --><?target some data?></root>" } };
+    auto node = tape.root().firstChild();
+    REQUIRE(node.kind() == XMLTapeNode::Kind::cdata);
+    REQUIRE(node.value() == "a < b");
+    node = node.nextSibling();
+    REQUIRE(node.kind() == XMLTapeNode::Kind::comment);
+    REQUIRE(node.value() == " note ");
+    node = node.nextSibling();
+    REQUIRE(node.kind() == XMLTapeNode::Kind::pi);
+    REQUIRE(node.name() == "target");
+    REQUIRE(node.value() == "some data");
+  }
+  SECTION("Check the contents of tape nodes match those of the tree", "[XML][Tape]")
+  {
+    const std::string xmlString{ "<root><a>one<b>two</b>three</a><c><![CDATA[four]]></c><d/></root>" };
+    XMLTape tape{ BufferSource{ xmlString } };
+    XML xml{ xmlString };
+    REQUIRE(tape.root().getContents() == xml.root().getContents());
+    REQUIRE(tape.root().firstChild().getContents() == xml.root()["a"].getContents());
+    REQUIRE(tape.root().firstChild().nextSibling().getContents() == xml.root()["c"].getContents());
+  }
+  SECTION("Parse into a tape with a shared name table", "[XML][Tape]")
+  {
+    const auto nameTable = std::make_shared<XML_NameTable>();
+    XMLTape first{ BufferSource{ "<root><item a=\"1\"/></root>" }, ParseOptions{ .nameTable = nameTable } };
+    XMLTape second{ BufferSource{ "<root><item a=\"2\"/></root>" }, ParseOptions{ .nameTable = nameTable } };
+    REQUIRE(nameTable->size() == 6);
+    REQUIRE(first.root().firstChild().name().data() == second.root().firstChild().name().data());
+    REQUIRE(second.root().firstChild().attribute("a") == "2");
+  }
+  SECTION("Check the memory used by a tape is little more than that of its text", "[XML][Tape]")
+  {
+    std::string xmlString{ "<root>" };
+    for (int entry = 0; entry < 1000; entry++) { xmlString += "<entry id=\"" + std::to_string(entry) + "\">text</entry>"; }
+    xmlString += "</root>";
+    XMLTape tape{ BufferSource{ xmlString } };
+    REQUIRE(tape.size() == 2 + 1 + 2000);
+    REQUIRE(tape.memoryUsed() < xmlString.size() + tape.size() * 32);
+  }
+  SECTION("Traverse a tape in document order calling the action for each node", "[XML][Tape]")
+  {
+    XMLTape tape{ BufferSource{ "<?xml version=\"1.0\"?><root><a>x</a><b/><!--c--><?p q?><![CDATA[d]]></root>" } };
+    XMLTape_Recorder recorder;
+    tape.traverse(recorder);
+    REQUIRE(recorder.visited == "OXR(root)E(a)T(x)S(b)C(c)P(p)D(d)");
+    REQUIRE(recorder.nodeCount == tape.size());
+  }
+  SECTION("Check tape errors are reported", "[XML][Tape]")
+  {
+    REQUIRE_THROWS_AS(XMLTape(BufferSource{ "<root><a></root>" }), SyntaxError);
+    XMLTape tape{ BufferSource{ "<root a=\"1\"/>" } };
+    REQUIRE_THROWS_WITH(tape.node(100), "XMLTape Error: Node index 100 is past the end of the tape.");
+    REQUIRE_THROWS_WITH(tape.root().attributeName(1), "XMLTape Error: Attribute index out of range.");
+    REQUIRE_THROWS_WITH(tape.root().attributeValue(1), "XMLTape Error: Attribute index out of range.");
+  }
+}
+
+#if defined(XML_LIB_ENABLE_XPATH)
+// Return the names and contents of the nodes an expression selects from a tree, in order
+static std::vector<std::string> treeXPath(XML &xml, const std::string &expression)
+{
+  std::vector<std::string> results;
+  for (const auto *node : xml.xpath(expression)) {
+    std::string name;
+    if (isA<Root>(*node) || isA<Element>(*node) || isA<Self>(*node)) { name = NRef<Element>(*node).name(); }
+    results.push_back(name + "=" + std::string(node->getContents()));
+  }
+  std::ranges::sort(results);
+  return results;
+}
+
+// Return the names and contents of the nodes an expression selects from a tape, in order
+static std::vector<std::string> tapeXPath(const XMLTape &tape, const std::string &expression)
+{
+  std::vector<std::string> results;
+  for (const auto &node : tape.xpath(expression)) {
+    const bool isElement = node.kind() == XMLTapeNode::Kind::root || node.kind() == XMLTapeNode::Kind::element
+                           || node.kind() == XMLTapeNode::Kind::self;
+    results.push_back((isElement ? std::string(node.name()) : std::string{}) + "=" + node.getContents());
+  }
+  std::ranges::sort(results);
+  return results;
+}
+
+TEST_CASE("Check XPath evaluation against a tape", "[XML][Tape][XPath]")
+{
+  const std::string kLibrary{ "<?xml version=\"1.0\"?>"
+                              "<library>"
+                              "<book category=\"cooking\"><title lang=\"en\">Everyday Italian</title><price>30.00</price></book>"
+                              "<book category=\"web\"><title lang=\"fr\">Learning XML</title><price>39.95</price></book>"
+                              "<book category=\"web\"><title lang=\"en\">XQuery</title><price>49.99</price><!--x--></book>"
+                              "<magazine><title>Monthly</title></magazine>"
+                              "</library>" };
+  SECTION("Check tape node sets match those selected from the tree", "[XML][Tape][XPath]")
+  {
+    XML xml{ kLibrary };
+    XMLTape tape{ BufferSource{ kLibrary } };
+    for (const std::string expression : { "/library",
+           "/library/book",
+           "//title",
+           "//book[@category='web']/title",
+           "//book[price > 35]",
+           "//book[1]/title",
+           "//title[@lang='en']/..",
+           "/library/*[last()]",
+           "//book/title/text()",
+           "//comment()",
+           "//title | //price",
+           "/library/book[2]/following-sibling::*",
+           "//price/ancestor::*" }) {
+      INFO(expression);
+      REQUIRE(tapeXPath(tape, expression) == treeXPath(xml, expression));
+    }
+  }
+  SECTION("Check tape string, number and boolean results match those of the tree", "[XML][Tape][XPath]")
+  {
+    XML xml{ kLibrary };
+    XMLTape tape{ BufferSource{ kLibrary } };
+    XPath treeXPath{ xml.root() };
+    XPath tapeXPath{ tape };
+    REQUIRE(tapeXPath.evaluateNumber("count(//book)") == 3.0);
+    REQUIRE(tapeXPath.evaluateNumber("sum(//price)") == treeXPath.evaluateNumber("sum(//price)"));
+    REQUIRE(tapeXPath.evaluateString("string(//book[2]/title)") == "Learning XML");
+    REQUIRE(tapeXPath.evaluateString("//book[3]/@category") == "web");
+    REQUIRE(tapeXPath.evaluateString("name(/*)") == "library");
+    REQUIRE(tapeXPath.evaluateBool("//magazine/title = 'Monthly'"));
+    REQUIRE_FALSE(tapeXPath.evaluateBool("//book[@category='music']"));
+  }
+  SECTION("Check namespace names and URIs are found on a tape", "[XML][Tape][XPath]")
+  {
+    XMLTape tape{ BufferSource{ "<root xmlns=\"urn:default\" xmlns:h=\"urn:html\"><h:td>x</h:td><item/></root>" } };
+    XPath xpath{ tape };
+    REQUIRE(xpath.evaluateTape("//td").size() == 1);
+    REQUIRE(xpath.evaluateTape("//h:td").size() == 1);
+    REQUIRE(xpath.evaluateString("local-name(//h:td)") == "td");
+    REQUIRE(xpath.evaluateString("namespace-uri(//h:td)") == "urn:html");
+    REQUIRE(xpath.evaluateString("namespace-uri(//item)") == "urn:default");
+  }
+  SECTION("Check tape XPath errors are reported", "[XML][Tape][XPath]")
+  {
+    XML xml{ kLibrary };
+    XMLTape tape{ BufferSource{ kLibrary } };
+    REQUIRE_THROWS_WITH(XPath(tape).evaluate("//book"), "XPath Error: Evaluator is bound to a tape; use evaluateTape().");
+    REQUIRE_THROWS_WITH(
+      XPath(xml.root()).evaluateTape("//book"), "XPath Error: Evaluator is bound to a Node tree; use evaluate().");
+    REQUIRE_THROWS_AS(tape.xpath("//book["), XPath::Error);
+    REQUIRE_THROWS_AS(tape.xpath(""), XPath::Error);
+  }
+}
+#endif
@@ -1,4 +1,6 @@
 #include "XML_Lib_Tests.hpp"
+#include <atomic>
+#include <thread>
 
 TEST_CASE("Check XML top level apis.", "[XML][Top Level][API]")
 {
@@ -325,4 +327,284 @@ TEST_CASE("Check XML creation/read apis.", "[XML][Creation][API]")
     // Change does not get passed through to cache at present
     REQUIRE(NRef<Element>(xml.root()).getNameSpace("f").getUnparsed() == "http://www.w3.org/TR/html4/");
   }
-}
\ No newline at end of file
+}
+TEST_CASE("Check the lifetime of a parsed document's nodes.", "[XML][Parse][Arena]")
+{
+  SECTION("Parse a second document into the same XML replaces the first.", "[XML][Parse][Arena]")
+  {
+    XML xml;
+    xml.parse(BufferSource{ "<first><a>a long enough text to be on the heap</a></first>" });
+    xml.parse(BufferSource{ "<second><b>another long enough text to be on the heap</b></second>" });
+    REQUIRE(NRef<Root>(xml.root()).name() == "second");
+    REQUIRE(xml.root()["b"].getContents() == "another long enough text to be on the heap");
+  }
+  SECTION("Parse that fails leaves the last document in place.", "[XML][Parse][Arena]")
+  {
+    XML xml;
+    xml.parse(BufferSource{ "<first><a>text</a></first>" });
+    REQUIRE_THROWS_AS(xml.parse(BufferSource{ "<second><b>text</second>" }), SyntaxError);
+    REQUIRE(NRef<Root>(xml.root()).name() == "first");
+    xml.parse(BufferSource{ "<third/>" });
+    REQUIRE(NRef<Self>(xml.root()).name() == "third");
+  }
+  SECTION("Parse many documents into the same XML.", "[XML][Parse][Arena]")
+  {
+    XML xml;
+    for (int document = 0; document < 100; document++) {
+      std::string xmlString{ "<root>" };
+      for (int item = 0; item < 1000; item++) { xmlString += "<item>" + std::to_string(document) + "</item>"; }
+      xmlString += "</root>";
+      xml.parse(BufferSource{ xmlString });
+      REQUIRE(xml.root()[999].getContents() == std::to_string(document));
+    }
+  }
+  SECTION("Parsed attribute strings are allocated with the document's nodes.", "[XML][Parse][Arena]")
+  {
+    XML xml;
+    xml.parse(BufferSource{ "<root name=\"a value too long to fit in a small string buffer\"/>" });
+    const auto &attribute = NRef<Self>(xml.root()).getAttributes()[0];
+    REQUIRE(attribute.get_allocator().resource() != std::pmr::get_default_resource());
+  }
+  SECTION("A copy of a parsed attribute outlives the document it was parsed in.", "[XML][Parse][Arena]")
+  {
+    XML xml;
+    xml.parse(BufferSource{ "<root name=\"a value too long to fit in a small string buffer\"/>" });
+    const XMLAttribute attribute{ NRef<Self>(xml.root()).getAttributes()[0] };
+    REQUIRE(attribute.get_allocator().resource() == std::pmr::get_default_resource());
+    xml.parse(BufferSource{ "<other/>" });
+    REQUIRE(attribute.getName() == "name");
+    REQUIRE(attribute.getParsed() == "a value too long to fit in a small string buffer");
+  }
+  SECTION("A copy of a parsed attribute keeps its name out of the global name table.", "[XML][Parse][Arena]")
+  {
+    XML xml;
+    xml.parse(BufferSource{ "<root xmlns:n=\"urn:copy-test\" n:copied-name=\"value\"/>" });
+    const auto globalNames = XML_NameTable::global().size();
+    const XMLAttribute attribute{ NRef<Self>(xml.root()).getAttributes()[1] };
+    REQUIRE(attribute.isDetached());
+    xml.parse(BufferSource{ "<other/>" });
+    REQUIRE(XML_NameTable::global().size() == globalNames);
+    REQUIRE(attribute.getName() == "n:copied-name");
+    REQUIRE(attribute.getPrefix() == "n");
+    REQUIRE(attribute.getLocalName() == "copied-name");
+    REQUIRE(attribute.getNamespaceURI() == "urn:copy-test");
+    REQUIRE(attribute.getParsed() == "value");
+  }
+  SECTION("Nodes made after a parse can be added to the parsed document.", "[XML][Parse][Arena]")
+  {
+    XML xml;
+    xml.parse(BufferSource{ "<root></root>" });
+    xml.root().addChild(Node::make<Comment>("a comment added after the document was parsed"));
+    BufferDestination destination;
+    xml.stringify(destination);
+    REQUIRE(destination.toString()
+            == "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?><root><!--a comment added after the document was parsed--></root>");
+  }
+  SECTION("Parse over a document that nodes made after its parse were added to.", "[XML][Parse][Arena]")
+  {
+    XML xml;
+    xml.parse(BufferSource{ "<root><item>a text long enough to be on the heap</item></root>" });
+    xml.root()[0].addChild(Node::make<Comment>("a comment added after the document was parsed"));
+    xml.prolog().addChild(Node::make<Comment>("another comment added after the document was parsed"));
+    xml.parse(BufferSource{ "<second/>" });
+    REQUIRE(NRef<Self>(xml.root()).name() == "second");
+    xml.parse(BufferSource{ "<third>text</third>" });
+    REQUIRE(xml.root().getContents() == "text");
+  }
+  SECTION("Parse documents with a DTD, namespaces and references into the same XML.", "[XML][Parse][Arena]")
+  {
+    const std::string xmlString{
+      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      "<!DOCTYPE root [<!ENTITY name \"a replacement long enough to be on the heap\">]>\n"
+      "<!-- a comment in the prolog long enough to be on the heap -->"
+      "<root xmlns:a=\"http://www.example.com/a-namespace-uri\"><a:item a:b=\"1\">&name; &#65;</a:item></root>"
+    };
+    XML xml;
+    for (int document = 0; document < 3; document++) {
+      xml.parse(BufferSource{ xmlString });
+      REQUIRE(NRef<Element>(xml.root()[0]).getNamespaceURI() == "http://www.example.com/a-namespace-uri");
+      REQUIRE(xml.root()[0].getContents() == "a replacement long enough to be on the heap A");
+    }
+  }
+}
+namespace {
+// Node variant allocated on the heap (made outside any parse) that counts its destruction
+struct CountedVariant final : Variant
+{
+  CountedVariant() = default;
+  CountedVariant(const CountedVariant &) = delete;
+  CountedVariant &operator=(const CountedVariant &) = delete;
+  CountedVariant(CountedVariant &&) = delete;
+  CountedVariant &operator=(CountedVariant &&) = delete;
+  ~CountedVariant() override { destroyed++; }
+  static inline int destroyed{ 0 };
+};
+// Action that replaces the content of every element with a counted node
+struct ReplaceContent final : IAction
+{
+  void onContent(Node &node) override { node = Node::make<CountedVariant>(); }
+};
+// Parse a document, change it with mutate, destroy it and return the counted nodes destroyed
+template<typename Mutate> int countedDestroyed(Mutate mutate)
+{
+  CountedVariant::destroyed = 0;
+  {
+    XML xml;
+    xml.parse(BufferSource{ "<root><item>one</item><item>two</item></root>" });
+    mutate(xml);
+  }
+  return CountedVariant::destroyed;
+}
+}// namespace
+
+TEST_CASE("Check nodes made after a parse are destroyed with the document.", "[XML][Parse][Arena]")
+{
+  SECTION("A node added with addChild is destroyed with the document.", "[XML][Parse][Arena]")
+  {
+    REQUIRE(countedDestroyed([](XML &xml) { xml.root()[0].addChild(Node::make<CountedVariant>()); }) == 1);
+  }
+  SECTION("A node assigned to a child of the document is destroyed with it.", "[XML][Parse][Arena]")
+  {
+    REQUIRE(countedDestroyed([](XML &xml) { xml.root().getChildren()[0] = Node::make<CountedVariant>(); }) == 1);
+  }
+  SECTION("A node emplaced among the children of the document is destroyed with it.", "[XML][Parse][Arena]")
+  {
+    REQUIRE(countedDestroyed([](XML &xml) { xml.root().getChildren().emplace_back(Node::make<CountedVariant>()); }) == 1);
+  }
+  SECTION("A node pushed onto the children of the document is destroyed with it.", "[XML][Parse][Arena]")
+  {
+    REQUIRE(countedDestroyed([](XML &xml) { xml.root().getChildren().push_back(Node::make<CountedVariant>()); }) == 1);
+  }
+  SECTION("A node inserted among the children of the document is destroyed with it.", "[XML][Parse][Arena]")
+  {
+    REQUIRE(countedDestroyed([](XML &xml) {
+      auto &children = xml.root().getChildren();
+      children.insert(children.begin(), Node::make<CountedVariant>());
+    }) == 1);
+  }
+  SECTION("A node assigned to a grandchild of the document is destroyed with it.", "[XML][Parse][Arena]")
+  {
+    REQUIRE(countedDestroyed([](XML &xml) {
+      xml.root().getChildren()[1].getChildren()[0] = Node::make<CountedVariant>();
+    }) == 1);
+  }
+  SECTION("Nodes assigned during a traversal of the document are destroyed with it.", "[XML][Parse][Arena]")
+  {
+    REQUIRE(countedDestroyed([](XML &xml) {
+      ReplaceContent action;
+      xml.traverse(action);
+    }) == 2);
+  }
+  SECTION("A node assigned to a child of the document is destroyed when another is parsed.", "[XML][Parse][Arena]")
+  {
+    REQUIRE(countedDestroyed([](XML &xml) {
+      xml.root().getChildren()[0] = Node::make<CountedVariant>();
+      xml.parse(BufferSource{ "<second/>" });
+      REQUIRE(CountedVariant::destroyed == 1);
+    }) == 1);
+  }
+}
+
+TEST_CASE("Check documents parsed and destroyed on several threads at once.", "[XML][Parse][Arena][Threads]")
+{
+  SECTION("Documents parsed concurrently each hold their own content.", "[XML][Parse][Arena][Threads]")
+  {
+    // Each thread parses, checks and destroys documents of its own (with DTD, namespaces and
+    // long text) while the others do the same; failures are counted, not asserted, on the threads
+    constexpr int kThreads = 4;
+    constexpr int kDocuments = 50;
+    std::atomic<int> failures{ 0 };
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < kThreads; thread++) {
+      threads.emplace_back([thread, &failures] {
+        try {
+          for (int document = 0; document < kDocuments; document++) {
+            const std::string text{ "thread " + std::to_string(thread) + " document " + std::to_string(document)
+                                    + " text too long for a small string buffer" };
+            std::string xmlString{ "<!DOCTYPE root [<!ELEMENT root (t:item*)><!ELEMENT t:item (#PCDATA)>"
+                                   "<!ATTLIST root xmlns:t CDATA #FIXED \"urn:t\">"
+                                   "<!ATTLIST t:item id CDATA #REQUIRED>]><root xmlns:t=\"urn:t\">" };
+            for (int item = 0; item < 20; item++) {
+              xmlString += "<t:item id=\"" + std::to_string(item) + "\">" + text + "</t:item>";
+            }
+            xmlString += "</root>";
+            auto xml = std::make_unique<XML>();
+            xml->parse(BufferSource{ xmlString });
+            xml->validate();
+            const auto &item = NRef<Element>(xml->root()[19]);
+            if (item.getContents() != text || item.getNamespaceURI() != "urn:t" || item["id"].getParsed() != "19"
+                || XML_Arena::getCurrent() != nullptr) {
+              failures++;
+            }
+            xml.reset();
+          }
+        } catch (...) {
+          failures++;
+        }
+      });
+    }
+    for (auto &thread : threads) { thread.join(); }
+    REQUIRE(failures == 0);
+  }
+  SECTION("Nodes made on a thread after a parse are not allocated from its document.", "[XML][Parse][Arena][Threads]")
+  {
+    std::atomic<int> failures{ 0 };
+    std::thread thread([&failures] {
+      XML xml;
+      xml.parse(BufferSource{ "<root>a text too long for a small string buffer</root>" });
+      const Node comment = Node::make<Comment>("a comment too long for a small string buffer");
+      if (XML_Arena::getCurrent() != nullptr || XML_Arena::getCurrentResource() != std::pmr::get_default_resource()) {
+        failures++;
+      }
+      xml.parse(BufferSource{ "<other/>" });
+      if (NRef<Comment>(comment).value() != "a comment too long for a small string buffer") { failures++; }
+    });
+    thread.join();
+    REQUIRE(failures == 0);
+    REQUIRE(XML_Arena::getCurrent() == nullptr);
+  }
+}
+TEST_CASE("Check the child storage of a document's nodes.", "[XML][Parse][Compact]")
+{
+  SECTION("A parsed element holds storage for exactly its children.", "[XML][Parse][Compact]")
+  {
+    XML xml;
+    xml.parse(BufferSource{ "<root><item>1</item><item>2</item><item>3</item><empty></empty></root>" });
+    REQUIRE(xml.root().getChildren().size() == 4);
+    REQUIRE(xml.root().getChildren().capacity() == 4);
+    REQUIRE(xml.root()[0].getChildren().capacity() == 1);
+    REQUIRE(xml.root()[3].getChildren().capacity() == 0);
+  }
+  SECTION("Every node of a parsed document holds storage for exactly its children.", "[XML][Parse][Compact]")
+  {
+    XML xml;
+    xml.parse(BufferSource{ "<?xml version=\"1.0\"?>\n<!-- head -->\n<root a=\"1\"><b><c>text<![CDATA[cdata]]></c><?pi x?></b>tail<d/></root>\n<!-- tail -->\n" });
+    std::vector<const Node *> nodes{ &xml.prolog() };
+    while (!nodes.empty()) {
+      const Node *xNode = nodes.back();
+      nodes.pop_back();
+      REQUIRE(xNode->getChildren().capacity() == xNode->getChildren().size());
+      for (const auto &child : xNode->getChildren()) { nodes.push_back(&child); }
+    }
+  }
+  SECTION("Compact a parsed document whose root has had children added.", "[XML][Compact]")
+  {
+    XML xml;
+    xml.parse(BufferSource{ "<root></root>" });
+    for (int item = 0; item < 9; item++) {
+      xml.root().addChild(Node::make<Comment>("comment " + std::to_string(item)));
+    }
+    REQUIRE(xml.root().getChildren().capacity() > 9);
+    xml.compact();
+    REQUIRE(xml.root().getChildren().size() == 9);
+    REQUIRE(xml.root().getChildren().capacity() == 9);
+    BufferDestination destination;
+    xml.stringify(destination);
+    REQUIRE(destination.toString().ends_with("<root><!--comment 0--><!--comment 1--><!--comment 2--><!--comment 3--><!--comment 4--><!--comment 5--><!--comment 6--><!--comment 7--><!--comment 8--></root>"));
+  }
+  SECTION("Compact with no parsed XML throws an error.", "[XML][Compact][Exception]")
+  {
+    XML xml;
+    REQUIRE_THROWS_WITH(xml.compact(), "XML Error: No XML to compact.");
+  }
+}